@@ -46,13 +46,14 @@ DEFINE_int32(dimension, 16, "dimension");
 DEFINE_int32(count, 50, "count");
 DEFINE_int32(vector_id, 0, "vector_id");
 DEFINE_int32(topn, 10, "top n");
+DEFINE_string(sst_files, "", "Comma separated sst file paths of bulk load");
 
 bvar::LatencyRecorder g_latency_recorder("dingo-store");
 
 const std::map<std::string, std::vector<std::string>> kParamConstraint = {
     {"RaftGroup", {"AddRegion", "ChangeRegion", "BatchAddRegion", "TestBatchPutGet"}},
     {"RaftAddrs", {"AddRegion", "ChangeRegion", "BatchAddRegion", "TestBatchPutGet"}},
-    {"ThreadNum", {"BatchAddRegion", "TestBatchPutGet", "TestBatchPutGet"}},
+    {"ThreadNum", {"BatchAddRegion", "TestBatchPutGet", "TestBatchPutGet", "YcsbLoad", "YcsbRun"}},
     {"RegionCount", {"BatchAddRegion", "TestBatchPutGet"}},
     {"ReqNum", {"KvBatchGet", "TestBatchPutGet", "TestBatchPutGet", "AutoTest"}},
     {"TableName", {"AutoTest"}},
@@ -200,6 +201,10 @@ void Sender(std::shared_ptr<client::Context> ctx, const std::string& method, int
       client::SendKvDeleteRange(ctx->store_interaction, FLAGS_region_id, FLAGS_prefix);
     } else if (method == "KvScan") {
       client::SendKvScan(ctx->store_interaction, FLAGS_region_id, FLAGS_prefix);
+    } else if (method == "KvBulkLoad") {
+      std::vector<std::string> sst_files;
+      butil::SplitString(FLAGS_sst_files, ',', &sst_files);
+      client::SendKvBulkLoad(ctx->store_interaction, FLAGS_region_id, sst_files);
     } else if (method == "KvCompareAndSet") {
       client::SendKvCompareAndSet(ctx->store_interaction, FLAGS_region_id, FLAGS_key);
     } else if (method == "KvBatchCompareAndSet") {
@@ -227,6 +232,13 @@ void Sender(std::shared_ptr<client::Context> ctx, const std::string& method, int
       client::TestDeleteRangeWhenTransferLeader(ctx, FLAGS_region_id, FLAGS_req_num, FLAGS_prefix);
     }
 
+    // Workload
+    if (method == "YcsbLoad") {
+      client::YcsbLoad(ctx, FLAGS_region_id);
+    } else if (method == "YcsbRun") {
+      client::YcsbRun(ctx, FLAGS_region_id);
+    }
+
     // Auto test
     if (method == "AutoTest") {
       ctx->table_name = FLAGS_table_name;
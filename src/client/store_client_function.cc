@@ -18,6 +18,8 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <functional>
 #include <memory>
 #include <string>
@@ -257,6 +259,53 @@ void SendKvScan(ServerInteractionPtr interaction, uint64_t region_id, const std:
   interaction->SendRequest("StoreService", "KvScanRelease", release_request, release_response);
 }
 
+void SendKvBulkLoad(ServerInteractionPtr interaction, uint64_t region_id, const std::vector<std::string>& sst_files) {
+  const size_t chunk_size = 4 * 1024 * 1024;
+  uint64_t load_id = dingodb::Helper::TimestampMs();
+
+  dingodb::pb::store::KvBulkLoadIngestRequest ingest_request;
+  dingodb::pb::store::KvBulkLoadIngestResponse ingest_response;
+  ingest_request.set_region_id(region_id);
+  ingest_request.set_load_id(load_id);
+
+  std::vector<char> buffer(chunk_size);
+  for (const auto& sst_file : sst_files) {
+    std::ifstream file(sst_file, std::ios::binary);
+    if (!file.is_open()) {
+      DINGO_LOG(ERROR) << "Open sst file failed: " << sst_file;
+      return;
+    }
+
+    std::string file_name = std::filesystem::path(sst_file).filename().string();
+    uint64_t offset = 0;
+    while (file) {
+      file.read(buffer.data(), chunk_size);
+      if (file.gcount() == 0) {
+        break;
+      }
+
+      dingodb::pb::store::KvBulkLoadUploadRequest request;
+      dingodb::pb::store::KvBulkLoadUploadResponse response;
+      request.set_region_id(region_id);
+      request.set_load_id(load_id);
+      request.set_file_name(file_name);
+      request.set_offset(offset);
+      request.set_data(buffer.data(), file.gcount());
+      interaction->SendRequest("StoreService", "KvBulkLoadUpload", request, response);
+      if (response.error().errcode() != 0) {
+        return;
+      }
+      offset = response.file_size();
+    }
+    DINGO_LOG(INFO) << fmt::format("upload sst file {} size {}", file_name, offset);
+
+    ingest_request.add_file_names(file_name);
+  }
+
+  interaction->SendRequest("StoreService", "KvBulkLoadIngest", ingest_request, ingest_response);
+  DINGO_LOG(INFO) << fmt::format("bulk load load_id {} kv_count {}", load_id, ingest_response.kv_count());
+}
+
 void SendKvCompareAndSet(ServerInteractionPtr interaction, uint64_t region_id, const std::string& key) {
   dingodb::pb::store::KvCompareAndSetRequest request;
   dingodb::pb::store::KvCompareAndSetResponse response;
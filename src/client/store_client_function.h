@@ -17,6 +17,8 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "client/client_interation.h"
 
@@ -61,6 +63,7 @@ void SendKvBatchPutIfAbsent(ServerInteractionPtr interaction, uint64_t region_id
 void SendKvBatchDelete(ServerInteractionPtr interaction, uint64_t region_id, const std::string& key);
 void SendKvDeleteRange(ServerInteractionPtr interaction, uint64_t region_id, const std::string& prefix);
 void SendKvScan(ServerInteractionPtr interaction, uint64_t region_id, const std::string& prefix);
+void SendKvBulkLoad(ServerInteractionPtr interaction, uint64_t region_id, const std::vector<std::string>& sst_files);
 void SendKvCompareAndSet(ServerInteractionPtr interaction, uint64_t region_id, const std::string& key);
 void SendKvBatchCompareAndSet(ServerInteractionPtr interaction, uint64_t region_id, const std::string& prefix,
                               int count);
@@ -87,6 +90,10 @@ void TestDeleteRangeWhenTransferLeader(std::shared_ptr<Context> ctx, uint64_t re
                                        const std::string& prefix);
 void AutoTest(std::shared_ptr<Context> ctx);
 
+// Workload, YCSB style load and run phase on a region.
+void YcsbLoad(std::shared_ptr<Context> ctx, uint64_t region_id);
+void YcsbRun(std::shared_ptr<Context> ctx, uint64_t region_id);
+
 // Table
 void AutoDropTable(std::shared_ptr<Context> ctx);
 
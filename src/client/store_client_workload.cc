@@ -0,0 +1,621 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bthread/bthread.h"
+#include "bthread/mutex.h"
+#include "butil/time.h"
+#include "client/client_helper.h"
+#include "client/store_client_function.h"
+#include "common/helper.h"
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "gflags/gflags.h"
+#include "proto/index.pb.h"
+#include "proto/store.pb.h"
+
+DECLARE_bool(log_each_request);
+DECLARE_int32(thread_num);
+DECLARE_string(prefix);
+DECLARE_int32(dimension);
+DECLARE_int32(topn);
+
+DEFINE_uint64(workload_record_count, 100000, "Key count of workload, load phase insert these keys");
+DEFINE_int32(workload_load_batch_size, 100, "Batch size of load phase");
+DEFINE_int32(workload_value_size, 256, "Value size of workload");
+DEFINE_string(workload_key_distribution, "uniform", "Key distribution of workload, uniform/zipfian/latest");
+DEFINE_double(workload_zipfian_constant, 0.99, "Zipfian constant of zipfian/latest distribution");
+DEFINE_double(workload_read_proportion, 0.5, "Proportion of read operation");
+DEFINE_double(workload_update_proportion, 0.5, "Proportion of update operation");
+DEFINE_double(workload_insert_proportion, 0.0, "Proportion of insert operation");
+DEFINE_double(workload_scan_proportion, 0.0, "Proportion of scan operation");
+DEFINE_double(workload_vector_search_proportion, 0.0, "Proportion of vector search operation");
+DEFINE_int32(workload_scan_length, 100, "Max keys of one scan operation");
+DEFINE_uint64(workload_vector_region_id, 0, "Vector index region of vector search operation");
+DEFINE_int32(workload_target_qps, 0, "Open loop with target qps if > 0, otherwise closed loop with thread_num");
+DEFINE_int32(workload_duration_s, 60, "Duration of run phase, include warmup");
+DEFINE_int32(workload_warmup_s, 10, "Warmup duration, statistics in warmup are dropped");
+DEFINE_int32(workload_report_interval_s, 10, "Interval of reporting statistics");
+DEFINE_uint32(workload_seed, 0, "Random seed of workload, 0 means random");
+
+namespace client {
+
+// Log-linear histogram like HdrHistogram. Values are grouped by power of two, each group is split into
+// kHalfSubBucketNum linear sub buckets, so relative error is less than 1 / kHalfSubBucketNum.
+class LatencyHistogram {
+ public:
+  static const int kSubBucketBits = 7;
+  static const uint64_t kSubBucketNum = 1 << kSubBucketBits;
+  static const uint64_t kHalfSubBucketNum = kSubBucketNum / 2;
+  // Max value is 2^40 us, about 12 days.
+  static const int kMaxValueBits = 40;
+  static const int kMaxGroup = kMaxValueBits - kSubBucketBits + 1;
+  static const size_t kBucketNum = (kMaxGroup + 2) * kHalfSubBucketNum;
+
+  LatencyHistogram() : counts_(kBucketNum, 0), total_count_(0), sum_(0), max_(0) {}
+
+  static size_t BucketIndex(uint64_t value) {
+    value = std::min(value, (static_cast<uint64_t>(1) << kMaxValueBits) - 1);
+    int highest_bit = value == 0 ? 0 : 63 - __builtin_clzll(value);
+    int group = std::max(0, highest_bit - kSubBucketBits + 1);
+    return group * kHalfSubBucketNum + (value >> group);
+  }
+
+  // Highest value of bucket.
+  static uint64_t BucketValue(size_t index) {
+    if (index < kSubBucketNum) {
+      return index;
+    }
+    uint64_t group = index / kHalfSubBucketNum - 1;
+    uint64_t sub_bucket = index - group * kHalfSubBucketNum;
+    return (sub_bucket << group) + (static_cast<uint64_t>(1) << group) - 1;
+  }
+
+  void Record(uint64_t value) {
+    ++counts_[BucketIndex(value)];
+    ++total_count_;
+    sum_ += value;
+    max_ = std::max(max_, value);
+  }
+
+  void Merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < kBucketNum; ++i) {
+      counts_[i] += other.counts_[i];
+    }
+    total_count_ += other.total_count_;
+    sum_ += other.sum_;
+    max_ = std::max(max_, other.max_);
+  }
+
+  void Clear() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    total_count_ = 0;
+    sum_ = 0;
+    max_ = 0;
+  }
+
+  uint64_t Percentile(double percentile) const {
+    if (total_count_ == 0) {
+      return 0;
+    }
+    auto target = static_cast<uint64_t>(std::ceil(percentile / 100 * total_count_));
+    target = std::max(target, static_cast<uint64_t>(1));
+    uint64_t count = 0;
+    for (size_t i = 0; i < kBucketNum; ++i) {
+      count += counts_[i];
+      if (count >= target) {
+        return std::min(BucketValue(i), max_);
+      }
+    }
+    return max_;
+  }
+
+  uint64_t TotalCount() const { return total_count_; }
+  uint64_t Mean() const { return total_count_ == 0 ? 0 : sum_ / total_count_; }
+  uint64_t Max() const { return max_; }
+
+ private:
+  std::vector<uint64_t> counts_;
+  uint64_t total_count_;
+  uint64_t sum_;
+  uint64_t max_;
+};
+
+// Zipfian generator of YCSB, "Quickly Generating Billion-Record Synthetic Databases", Gray et al.
+// Item count may grow for latest distribution, zeta is updated incrementally.
+class ZipfianGenerator {
+ public:
+  ZipfianGenerator(uint64_t item_count, double theta, double zetan)
+      : theta_(theta), item_count_(item_count), zetan_(zetan) {
+    alpha_ = 1.0 / (1.0 - theta_);
+    zeta2_ = Zeta(0, 2, theta_, 0);
+    UpdateEta();
+  }
+
+  static double Zeta(uint64_t start, uint64_t end, double theta, double initial_sum) {
+    double sum = initial_sum;
+    for (uint64_t i = start; i < end; ++i) {
+      sum += 1 / std::pow(i + 1, theta);
+    }
+    return sum;
+  }
+
+  // Return [0, item_count), 0 is the most popular.
+  uint64_t Next(std::mt19937_64& rng, uint64_t item_count) {
+    if (item_count > item_count_) {
+      zetan_ = Zeta(item_count_, item_count, theta_, zetan_);
+      item_count_ = item_count;
+      UpdateEta();
+    }
+
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    double uz = u * zetan_;
+    if (uz < 1.0) {
+      return 0;
+    }
+    if (uz < 1.0 + std::pow(0.5, theta_)) {
+      return 1;
+    }
+    auto result = static_cast<uint64_t>(item_count_ * std::pow(eta_ * u - eta_ + 1, alpha_));
+    return std::min(result, item_count_ - 1);
+  }
+
+ private:
+  void UpdateEta() { eta_ = (1 - std::pow(2.0 / item_count_, 1 - theta_)) / (1 - zeta2_ / zetan_); }
+
+  double theta_;
+  double alpha_;
+  double zeta2_;
+  double eta_;
+  uint64_t item_count_;
+  double zetan_;
+};
+
+enum WorkloadOp { kRead = 0, kUpdate, kInsert, kScan, kVectorSearch, kLoad, kOpNum };
+
+static const char* kWorkloadOpNames[] = {"read", "update", "insert", "scan", "vector_search", "load"};
+
+static uint64_t FnvHash64(uint64_t value) {
+  uint64_t hash = 0xCBF29CE484222325ULL;
+  for (int i = 0; i < 8; ++i) {
+    hash ^= value & 0xff;
+    hash *= 0x100000001B3ULL;
+    value >>= 8;
+  }
+  return hash;
+}
+
+// Run workload with thread_num bthreads, closed loop or open loop with target qps.
+// Latency of open loop is measured from the intended start time, so queueing delay of an overloaded
+// cluster is counted, avoid coordinated omission.
+class Workload {
+ public:
+  Workload(std::shared_ptr<Context> ctx, uint64_t region_id)
+      : ctx_(ctx),
+        region_id_(region_id),
+        insert_key_num_(0),
+        ticket_(0),
+        running_worker_num_(0),
+        in_warmup_(false),
+        start_us_(0),
+        warmup_end_us_(0),
+        deadline_us_(0) {
+    // Per request log slow down the driver, turn it off unless it is set explicitly.
+    if (google::GetCommandLineFlagInfoOrDie("log_each_request").is_default) {
+      FLAGS_log_each_request = false;
+    }
+    seed_ = FLAGS_workload_seed > 0 ? FLAGS_workload_seed : std::random_device()();
+    // Random value pool, value of each operation is a slice of it.
+    value_pool_ = Helper::GenRandomString(std::max(FLAGS_workload_value_size, 1) * 64);
+  }
+
+  void Load() {
+    is_load_ = true;
+    insert_key_num_.store(0);
+    start_us_ = butil::gettimeofday_us();
+    warmup_end_us_ = start_us_;
+    deadline_us_ = INT64_MAX;
+    Drive();
+  }
+
+  void Run() {
+    if (!InitOpProportion()) {
+      return;
+    }
+    if (FLAGS_workload_vector_search_proportion > 0 && !InitVectorInteraction()) {
+      return;
+    }
+
+    is_load_ = false;
+    insert_key_num_.store(FLAGS_workload_record_count);
+    zetan_ = ZipfianGenerator::Zeta(0, FLAGS_workload_record_count, FLAGS_workload_zipfian_constant, 0);
+    start_us_ = butil::gettimeofday_us();
+    warmup_end_us_ = start_us_ + FLAGS_workload_warmup_s * 1000000L;
+    deadline_us_ = start_us_ + FLAGS_workload_duration_s * 1000000L;
+    in_warmup_ = FLAGS_workload_warmup_s > 0;
+    Drive();
+  }
+
+ private:
+  struct Worker {
+    Workload* workload;
+    int id;
+    std::mt19937_64 rng;
+    std::unique_ptr<ZipfianGenerator> zipfian;
+  };
+
+  struct OpStats {
+    // Written by workers.
+    bthread::Mutex mutex;
+    LatencyHistogram interval;
+    uint64_t interval_errors = 0;
+    // Owned by reporter.
+    LatencyHistogram total;
+    uint64_t total_errors = 0;
+  };
+
+  bool InitOpProportion() {
+    std::array<double, kOpNum> proportions = {
+        FLAGS_workload_read_proportion, FLAGS_workload_update_proportion, FLAGS_workload_insert_proportion,
+        FLAGS_workload_scan_proportion, FLAGS_workload_vector_search_proportion, 0};
+    double sum = 0;
+    for (int i = 0; i < kOpNum; ++i) {
+      sum += std::max(proportions[i], 0.0);
+      op_cumulative_[i] = sum;
+    }
+    if (sum <= 0) {
+      DINGO_LOG(ERROR) << "[workload] sum of operation proportion is 0";
+      return false;
+    }
+    for (auto& cumulative : op_cumulative_) {
+      cumulative /= sum;
+    }
+
+    if (FLAGS_workload_key_distribution != "uniform" && FLAGS_workload_key_distribution != "zipfian" &&
+        FLAGS_workload_key_distribution != "latest") {
+      DINGO_LOG(ERROR) << "[workload] unknown key distribution " << FLAGS_workload_key_distribution;
+      return false;
+    }
+
+    return true;
+  }
+
+  bool InitVectorInteraction() {
+    if (FLAGS_workload_vector_region_id == 0) {
+      DINGO_LOG(ERROR) << "[workload] missing param workload_vector_region_id";
+      return false;
+    }
+
+    auto region = SendQueryRegion(ctx_->coordinator_interaction, FLAGS_workload_vector_region_id);
+    std::vector<std::string> addrs;
+    for (const auto& peer : region.definition().peers()) {
+      addrs.push_back(fmt::format("{}:{}", peer.server_location().host(), peer.server_location().port()));
+    }
+    vector_interaction_ = std::make_shared<ServerInteraction>();
+    if (!vector_interaction_->Init(addrs)) {
+      DINGO_LOG(ERROR) << "[workload] init vector region interaction failed";
+      return false;
+    }
+
+    return true;
+  }
+
+  std::string GenKey(uint64_t key_num) const { return fmt::format("{}user{:012}", FLAGS_prefix, key_num); }
+
+  std::string GenValue(Worker& worker) const {
+    size_t size = FLAGS_workload_value_size;
+    size_t offset = worker.rng() % (value_pool_.size() - size + 1);
+    return value_pool_.substr(offset, size);
+  }
+
+  uint64_t ChooseKeyNum(Worker& worker) {
+    uint64_t key_count = std::max(insert_key_num_.load(std::memory_order_relaxed), static_cast<uint64_t>(1));
+    if (FLAGS_workload_key_distribution == "zipfian") {
+      // Scramble popular items, hot keys are not clustered in one range.
+      return FnvHash64(worker.zipfian->Next(worker.rng, key_count)) % key_count;
+    } else if (FLAGS_workload_key_distribution == "latest") {
+      return key_count - 1 - worker.zipfian->Next(worker.rng, key_count);
+    }
+    return worker.rng() % key_count;
+  }
+
+  WorkloadOp ChooseOp(Worker& worker) {
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(worker.rng);
+    for (int i = 0; i < kOpNum; ++i) {
+      if (u < op_cumulative_[i]) {
+        return static_cast<WorkloadOp>(i);
+      }
+    }
+    return kRead;
+  }
+
+  butil::Status DoRead(Worker& worker) {
+    dingodb::pb::store::KvGetRequest request;
+    dingodb::pb::store::KvGetResponse response;
+    request.set_region_id(region_id_);
+    request.set_key(GenKey(ChooseKeyNum(worker)));
+    return ctx_->store_interaction->SendRequest("StoreService", "KvGet", request, response);
+  }
+
+  butil::Status DoPut(Worker& worker, uint64_t key_num) {
+    dingodb::pb::store::KvPutRequest request;
+    dingodb::pb::store::KvPutResponse response;
+    request.set_region_id(region_id_);
+    request.mutable_kv()->set_key(GenKey(key_num));
+    request.mutable_kv()->set_value(GenValue(worker));
+    return ctx_->store_interaction->SendRequest("StoreService", "KvPut", request, response);
+  }
+
+  butil::Status DoScan(Worker& worker) {
+    dingodb::pb::store::KvScanBeginRequest request;
+    dingodb::pb::store::KvScanBeginResponse response;
+    request.set_region_id(region_id_);
+    request.mutable_range()->mutable_range()->set_start_key(GenKey(ChooseKeyNum(worker)));
+    request.mutable_range()->mutable_range()->set_end_key(dingodb::Helper::PrefixNext(FLAGS_prefix));
+    request.mutable_range()->set_with_start(true);
+    request.mutable_range()->set_with_end(false);
+    request.set_max_fetch_cnt(FLAGS_workload_scan_length);
+    auto status = ctx_->store_interaction->SendRequest("StoreService", "KvScanBegin", request, response);
+    if (!status.ok()) {
+      return status;
+    }
+
+    dingodb::pb::store::KvScanReleaseRequest release_request;
+    dingodb::pb::store::KvScanReleaseResponse release_response;
+    release_request.set_region_id(region_id_);
+    release_request.set_scan_id(response.scan_id());
+    return ctx_->store_interaction->SendRequest("StoreService", "KvScanRelease", release_request, release_response);
+  }
+
+  butil::Status DoVectorSearch(Worker& worker) {
+    dingodb::pb::index::VectorSearchRequest request;
+    dingodb::pb::index::VectorSearchResponse response;
+    request.set_region_id(FLAGS_workload_vector_region_id);
+    std::uniform_real_distribution<float> distrib(0.0F, 10.0F);
+    for (int i = 0; i < FLAGS_dimension; ++i) {
+      request.mutable_vector()->mutable_vector()->add_float_values(distrib(worker.rng));
+    }
+    request.mutable_parameter()->set_top_n(FLAGS_topn);
+    return vector_interaction_->SendRequest("IndexService", "VectorSearch", request, response);
+  }
+
+  butil::Status DoLoad(Worker& worker, uint64_t start_key_num, uint64_t end_key_num) {
+    dingodb::pb::store::KvBatchPutRequest request;
+    dingodb::pb::store::KvBatchPutResponse response;
+    request.set_region_id(region_id_);
+    for (uint64_t key_num = start_key_num; key_num < end_key_num; ++key_num) {
+      auto* kv = request.add_kvs();
+      kv->set_key(GenKey(key_num));
+      kv->set_value(GenValue(worker));
+    }
+    return ctx_->store_interaction->SendRequest("StoreService", "KvBatchPut", request, response);
+  }
+
+  void Record(WorkloadOp op, int64_t latency_us, bool ok) {
+    auto& stats = stats_[op];
+    BAIDU_SCOPED_LOCK(stats.mutex);
+    stats.interval.Record(std::max(latency_us, static_cast<int64_t>(0)));
+    if (!ok) {
+      ++stats.interval_errors;
+    }
+  }
+
+  // Return false when no more operation.
+  bool RunOnce(Worker& worker) {
+    if (is_load_) {
+      uint64_t start_key_num = insert_key_num_.fetch_add(FLAGS_workload_load_batch_size);
+      if (start_key_num >= FLAGS_workload_record_count) {
+        return false;
+      }
+      uint64_t end_key_num =
+          std::min(start_key_num + FLAGS_workload_load_batch_size, FLAGS_workload_record_count);
+      int64_t start_us = butil::gettimeofday_us();
+      auto status = DoLoad(worker, start_key_num, end_key_num);
+      Record(kLoad, butil::gettimeofday_us() - start_us, status.ok());
+      return true;
+    }
+
+    int64_t start_us = butil::gettimeofday_us();
+    if (FLAGS_workload_target_qps > 0) {
+      // Open loop, wait until intended start time of the ticket.
+      uint64_t ticket = ticket_.fetch_add(1);
+      int64_t intended_us = start_us_ + static_cast<int64_t>(ticket * 1000000.0 / FLAGS_workload_target_qps);
+      if (intended_us >= deadline_us_) {
+        return false;
+      }
+      if (intended_us > start_us) {
+        bthread_usleep(intended_us - start_us);
+      }
+      start_us = intended_us;
+    } else if (start_us >= deadline_us_) {
+      return false;
+    }
+
+    auto op = ChooseOp(worker);
+    butil::Status status;
+    switch (op) {
+      case kRead:
+        status = DoRead(worker);
+        break;
+      case kUpdate:
+        status = DoPut(worker, ChooseKeyNum(worker));
+        break;
+      case kInsert:
+        status = DoPut(worker, insert_key_num_.fetch_add(1));
+        break;
+      case kScan:
+        status = DoScan(worker);
+        break;
+      case kVectorSearch:
+        status = DoVectorSearch(worker);
+        break;
+      default:
+        break;
+    }
+    Record(op, butil::gettimeofday_us() - start_us, status.ok());
+
+    return true;
+  }
+
+  static void* WorkerRoutine(void* arg) {
+    std::unique_ptr<Worker> worker(static_cast<Worker*>(arg));
+    auto* workload = worker->workload;
+    while (workload->RunOnce(*worker)) {
+    }
+    workload->running_worker_num_.fetch_sub(1);
+    return nullptr;
+  }
+
+  void Report(const std::string& phase, int64_t now_us, int64_t interval_us) {
+    int64_t elapsed_s = (now_us - start_us_) / 1000000;
+    for (int i = 0; i < kOpNum; ++i) {
+      auto& stats = stats_[i];
+      LatencyHistogram interval;
+      uint64_t errors = 0;
+      {
+        BAIDU_SCOPED_LOCK(stats.mutex);
+        interval.Merge(stats.interval);
+        errors = stats.interval_errors;
+        stats.interval.Clear();
+        stats.interval_errors = 0;
+      }
+      if (interval.TotalCount() == 0) {
+        continue;
+      }
+
+      DINGO_LOG(INFO) << fmt::format(
+          "[workload][{}] {}s {}: ops {} qps {} errors {} avg {}us p50 {}us p90 {}us p99 {}us p999 {}us max {}us",
+          phase, elapsed_s, kWorkloadOpNames[i], interval.TotalCount(),
+          interval.TotalCount() * 1000000 / std::max(interval_us, static_cast<int64_t>(1)), errors, interval.Mean(),
+          interval.Percentile(50), interval.Percentile(90), interval.Percentile(99), interval.Percentile(99.9),
+          interval.Max());
+      // Drop statistics of warmup.
+      if (phase != "warmup") {
+        stats.total.Merge(interval);
+        stats.total_errors += errors;
+      }
+    }
+  }
+
+  void ReportTotal(int64_t duration_us) {
+    for (int i = 0; i < kOpNum; ++i) {
+      const auto& total = stats_[i].total;
+      if (total.TotalCount() == 0) {
+        continue;
+      }
+      DINGO_LOG(INFO) << fmt::format(
+          "[workload][summary] {}: ops {} qps {} errors {} avg {}us p50 {}us p90 {}us p99 {}us p999 {}us p9999 {}us "
+          "max {}us",
+          kWorkloadOpNames[i], total.TotalCount(),
+          total.TotalCount() * 1000000 / std::max(duration_us, static_cast<int64_t>(1)), stats_[i].total_errors,
+          total.Mean(), total.Percentile(50), total.Percentile(90), total.Percentile(99), total.Percentile(99.9),
+          total.Percentile(99.99), total.Max());
+    }
+  }
+
+  void Drive() {
+    DINGO_LOG(INFO) << fmt::format(
+        "[workload] {} start, region {} threads {} records {} distribution {} target_qps {} duration {}s warmup {}s "
+        "seed {}",
+        is_load_ ? "load" : "run", region_id_, FLAGS_thread_num, FLAGS_workload_record_count,
+        FLAGS_workload_key_distribution, FLAGS_workload_target_qps, FLAGS_workload_duration_s,
+        FLAGS_workload_warmup_s, seed_);
+
+    std::vector<bthread_t> tids(FLAGS_thread_num);
+    running_worker_num_.store(FLAGS_thread_num);
+    for (int i = 0; i < FLAGS_thread_num; ++i) {
+      auto* worker = new Worker;
+      worker->workload = this;
+      worker->id = i;
+      worker->rng.seed(seed_ + i);
+      worker->zipfian = std::make_unique<ZipfianGenerator>(
+          std::max(FLAGS_workload_record_count, static_cast<uint64_t>(1)), FLAGS_workload_zipfian_constant, zetan_);
+      if (bthread_start_background(&tids[i], nullptr, WorkerRoutine, worker) != 0) {
+        DINGO_LOG(ERROR) << "Fail to create bthread";
+        running_worker_num_.fetch_sub(1);
+        tids[i] = 0;
+        delete worker;
+      }
+    }
+
+    int64_t last_report_us = start_us_;
+    int64_t measure_start_us = warmup_end_us_;
+    while (running_worker_num_.load() > 0) {
+      bthread_usleep(100 * 1000);
+      int64_t now_us = butil::gettimeofday_us();
+      if (in_warmup_ && now_us >= warmup_end_us_) {
+        Report("warmup", now_us, now_us - last_report_us);
+        DINGO_LOG(INFO) << "[workload] warmup finished";
+        in_warmup_ = false;
+        last_report_us = now_us;
+        measure_start_us = now_us;
+      } else if (now_us - last_report_us >= FLAGS_workload_report_interval_s * 1000000L) {
+        Report(in_warmup_ ? "warmup" : "interval", now_us, now_us - last_report_us);
+        last_report_us = now_us;
+      }
+    }
+    for (auto tid : tids) {
+      if (tid != 0) {
+        bthread_join(tid, nullptr);
+      }
+    }
+
+    int64_t now_us = butil::gettimeofday_us();
+    Report(in_warmup_ ? "warmup" : "interval", now_us, now_us - last_report_us);
+    ReportTotal(now_us - measure_start_us);
+  }
+
+  std::shared_ptr<Context> ctx_;
+  ServerInteractionPtr vector_interaction_;
+  uint64_t region_id_;
+  uint32_t seed_;
+  std::string value_pool_;
+  bool is_load_{false};
+  double zetan_{1.0};
+  std::array<double, kOpNum> op_cumulative_{};
+
+  // Next key number to insert, also the key count.
+  std::atomic<uint64_t> insert_key_num_;
+  // Operation sequence of open loop.
+  std::atomic<uint64_t> ticket_;
+  std::atomic<int> running_worker_num_;
+  bool in_warmup_;
+
+  int64_t start_us_;
+  int64_t warmup_end_us_;
+  int64_t deadline_us_;
+
+  std::array<OpStats, kOpNum> stats_;
+};
+
+void YcsbLoad(std::shared_ptr<Context> ctx, uint64_t region_id) {
+  Workload workload(ctx, region_id);
+  workload.Load();
+}
+
+void YcsbRun(std::shared_ptr<Context> ctx, uint64_t region_id) {
+  Workload workload(ctx, region_id);
+  workload.Run();
+}
+
+}  // namespace client
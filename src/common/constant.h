@@ -77,6 +77,16 @@ class Constant {
 
   static const int kRocksdbBackgroundThreadNumDefault = 16;
   static const int kStatsDumpPeriodSecDefault = 600;
+  // Readahead of bulk sequential scan, e.g. snapshot and build index.
+  static const size_t kRocksdbBulkScanReadaheadSize = 2 * 1024 * 1024;
+
+  // store level rocksdb resource config
+  inline static const std::string kStoreResource = "store.resource";
+  inline static const std::string kResourceBlockCacheType = "block_cache_type";
+  inline static const std::string kResourceBlockCacheSize = "block_cache_size";
+  inline static const std::string kResourceWriteBufferManagerSize = "write_buffer_manager_size";
+  inline static const std::string kResourceWriteBufferChargeCache = "write_buffer_charge_cache";
+  inline static const std::string kResourceRateLimitBytesPerSec = "rate_limit_bytes_per_sec";
 
   // scan config
   inline static const std::string kStoreScan = "store.scan";
@@ -85,6 +95,18 @@ class Constant {
   inline static const std::string kStoreScanMaxFetchCntByServer = "max_fetch_cnt_by_server";
   inline static const std::string kStoreScanScanIntervalMs = "scan_interval_ms";
 
+  // write batch config
+  inline static const std::string kStoreWriteBatch = "store.write_batch";
+  inline static const std::string kWriteBatchWindowUs = "window_us";
+  inline static const std::string kWriteBatchMaxCount = "max_count";
+  inline static const std::string kWriteBatchMaxBytes = "max_bytes";
+  inline static const std::string kWriteBatchMaxRequestBytes = "max_request_bytes";
+
+  // vector index save config
+  inline static const std::string kVectorIndexSave = "vector.index_save";
+  inline static const std::string kVectorIndexSaveIntervalMs = "interval_ms";
+  inline static const std::string kVectorIndexSaveLogGap = "log_gap";
+
   inline static const std::string kMetaRegionName = "COORDINATOR";
   inline static const std::string kAutoIncrementRegionName = "AUTO_INCREMENT";
 
@@ -15,10 +15,13 @@
 #ifndef DINGODB_COMMON_CONTEXT_H_
 #define DINGODB_COMMON_CONTEXT_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "brpc/controller.h"
+#include "butil/time.h"
 #include "common/synchronization.h"
 #include "proto/common.pb.h"
 #include "proto/store.pb.h"
@@ -29,6 +32,20 @@ class Context;
 
 using WriteCbFunc = std::function<void(std::shared_ptr<Context>, butil::Status)>;
 
+// Stages of write pipeline, timestamps of them break down write latency.
+// kCommit is the time committed entries are handed to state machine.
+enum class WriteStage {
+  kReceive = 0,
+  kValidate,
+  kPropose,
+  kLogAppend,
+  kCommit,
+  kApplyStart,
+  kApplyEnd,
+  kResponse,
+  kStageNum,
+};
+
 class Context {
  public:
   Context()
@@ -127,6 +144,21 @@ class Context {
   WriteCbFunc WriteCb() { return write_cb_; }
   void SetWriteCb(WriteCbFunc write_cb) { write_cb_ = write_cb; }
 
+  // For write batch, one raft log carry multiple requests, every request has its own context.
+  bool IsBatch() const { return !batch_ctxs_.empty(); }
+  const std::vector<std::shared_ptr<Context>>& BatchCtxs() const { return batch_ctxs_; }
+  void AddBatchCtx(std::shared_ptr<Context> ctx) { batch_ctxs_.push_back(ctx); }
+
+  // Stage timestamp(us), 0 means not recorded. Batch contexts share stages after merged.
+  int64_t StageTimeUs(WriteStage stage) const { return stage_time_us_[static_cast<int>(stage)]; }
+  void RecordStage(WriteStage stage) { RecordStage(stage, butil::gettimeofday_us()); }
+  void RecordStage(WriteStage stage, int64_t time_us) {
+    stage_time_us_[static_cast<int>(stage)] = time_us;
+    for (const auto& batch_ctx : batch_ctxs_) {
+      batch_ctx->RecordStage(stage, time_us);
+    }
+  }
+
  private:
   // brpc framework free resource
   brpc::Controller* cntl_;
@@ -150,6 +182,12 @@ class Context {
   std::shared_ptr<BthreadCond> cond_;
 
   WriteCbFunc write_cb_;
+
+  // For write batch
+  std::vector<std::shared_ptr<Context>> batch_ctxs_;
+
+  // For write latency trace
+  int64_t stage_time_us_[static_cast<int>(WriteStage::kStageNum)] = {0};
 };
 
 }  // namespace dingodb
@@ -543,6 +543,20 @@ void Helper::SetPbMessageError(butil::Status status, google::protobuf::Message*
   error_ref->SetString(error, errmsg_field, status.error_str());
 }
 
+void Helper::SetPbMessageErrorLeader(butil::EndPoint endpoint, google::protobuf::Message* message) {
+  const google::protobuf::FieldDescriptor* error_field = message->GetDescriptor()->FindFieldByName("error");
+  google::protobuf::Message* error = message->GetReflection()->MutableMessage(message, error_field);
+  const google::protobuf::FieldDescriptor* leader_location_field =
+      error->GetDescriptor()->FindFieldByName("leader_location");
+  google::protobuf::Message* leader_location = error->GetReflection()->MutableMessage(error, leader_location_field);
+
+  const google::protobuf::Reflection* location_ref = leader_location->GetReflection();
+  const google::protobuf::Descriptor* location_desc = leader_location->GetDescriptor();
+  location_ref->SetString(leader_location, location_desc->FindFieldByName("host"),
+                          std::string(butil::ip2str(endpoint.ip).c_str()));
+  location_ref->SetInt32(leader_location, location_desc->FindFieldByName("port"), endpoint.port);
+}
+
 std::string Helper::MessageToJsonString(const google::protobuf::Message& message) {
   std::string json_string;
   google::protobuf::util::JsonOptions options;
@@ -126,6 +126,8 @@ class Helper {
     leader_location->set_host(std::string(butil::ip2str(endpoint.ip).c_str()));
     leader_location->set_port(endpoint.port);
   }
+  // For response of unknown type, e.g. response of context.
+  static void SetPbMessageErrorLeader(butil::EndPoint endpoint, google::protobuf::Message* message);
 
   static std::string MessageToJsonString(const google::protobuf::Message& message);
 
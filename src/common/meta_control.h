@@ -25,6 +25,7 @@
 #include "bthread/types.h"
 #include "butil/scoped_lock.h"
 #include "engine/snapshot.h"
+#include "meta/meta_snapshot_file.h"
 #include "proto/common.pb.h"
 #include "proto/coordinator.pb.h"
 #include "proto/coordinator_internal.pb.h"
@@ -58,11 +59,17 @@ class MetaControl {
   // return: Snapshot
   virtual std::shared_ptr<Snapshot> PrepareRaftSnapshot() = 0;
 
-  // LoadMetaToSnapshotFile
+  // LoadMetaToSnapshotFile, for snapshot of old format
   virtual bool LoadMetaToSnapshotFile(std::shared_ptr<Snapshot> snapshot,
                                       pb::coordinator_internal::MetaSnapshotFile &meta_snapshot_file) = 0;
 
-  // LoadMetaFromSnapshotFile
+  // SaveMetaToSnapshotFile, stream meta of snapshot to file chunk by chunk
+  virtual bool SaveMetaToSnapshotFile(std::shared_ptr<Snapshot> snapshot, MetaSnapshotFileWriter &writer) = 0;
+
+  // LoadMetaFromSnapshotFile, stream chunks of file into meta
+  virtual bool LoadMetaFromSnapshotFile(MetaSnapshotFileReader &reader) = 0;
+
+  // LoadMetaFromSnapshotFile, for snapshot of old format
   virtual bool LoadMetaFromSnapshotFile(pb::coordinator_internal::MetaSnapshotFile &meta_snapshot_file) = 0;
 };
 
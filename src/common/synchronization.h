@@ -125,6 +125,67 @@ class BthreadCond {
   bthread_mutex_t mutex_;
 };
 
+// Read write lock for bthread, it yield bthread instead of blocking worker pthread.
+// Waiting writer blocks new readers, so writer is not starved by continuous readers, don't lock shared recursively.
+// Work with std::unique_lock and std::shared_lock.
+class BthreadRWLock {
+ public:
+  BthreadRWLock() {
+    bthread_mutex_init(&mutex_, nullptr);
+    bthread_cond_init(&cond_, nullptr);
+  }
+  ~BthreadRWLock() {
+    bthread_cond_destroy(&cond_);
+    bthread_mutex_destroy(&mutex_);
+  }
+
+  BthreadRWLock(const BthreadRWLock&) = delete;
+  BthreadRWLock& operator=(const BthreadRWLock&) = delete;
+
+  void lock() {
+    bthread_mutex_lock(&mutex_);
+    ++waiting_writers_;
+    while (is_writing_ || readers_ > 0) {
+      bthread_cond_wait(&cond_, &mutex_);
+    }
+    --waiting_writers_;
+    is_writing_ = true;
+    bthread_mutex_unlock(&mutex_);
+  }
+
+  void unlock() {
+    bthread_mutex_lock(&mutex_);
+    is_writing_ = false;
+    bthread_cond_broadcast(&cond_);
+    bthread_mutex_unlock(&mutex_);
+  }
+
+  void lock_shared() {
+    bthread_mutex_lock(&mutex_);
+    while (is_writing_ || waiting_writers_ > 0) {
+      bthread_cond_wait(&cond_, &mutex_);
+    }
+    ++readers_;
+    bthread_mutex_unlock(&mutex_);
+  }
+
+  void unlock_shared() {
+    bthread_mutex_lock(&mutex_);
+    --readers_;
+    if (readers_ == 0 && waiting_writers_ > 0) {
+      bthread_cond_broadcast(&cond_);
+    }
+    bthread_mutex_unlock(&mutex_);
+  }
+
+ private:
+  bthread_mutex_t mutex_;
+  bthread_cond_t cond_;
+  int readers_ = 0;
+  int waiting_writers_ = 0;
+  bool is_writing_ = false;
+};
+
 // wrapper bthread functions for c++ style
 class Bthread {
  public:
@@ -18,6 +18,7 @@
 #include <fstream>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "butil/containers/flat_map.h"
 #include "butil/status.h"
@@ -26,20 +27,33 @@
 #include "common/synchronization.h"
 #include "coordinator/coordinator_interaction.h"
 #include "engine/snapshot.h"
+#include "engine/write_data.h"
+#include "fmt/core.h"
+#include "gflags/gflags.h"
 #include "proto/error.pb.h"
 #include "server/server.h"
 
 namespace dingodb {
 
+DEFINE_uint32(auto_increment_segment_size, 10000, "Id count of segment reserved by leader, 0 is disable segment");
+
 AutoIncrementControl::AutoIncrementControl() {
   // init bthread mutex
   bthread_mutex_init(&auto_increment_map_mutex_, nullptr);
+  bthread_mutex_init(&segments_mutex_, nullptr);
+  bthread_cond_init(&segments_cond_, nullptr);
 
   CHECK_EQ(0, auto_increment_map_.init(256, 70));
 
   leader_term_.store(-1, butil::memory_order_release);
 }
 
+AutoIncrementControl::~AutoIncrementControl() {
+  bthread_cond_destroy(&segments_cond_);
+  bthread_mutex_destroy(&segments_mutex_);
+  bthread_mutex_destroy(&auto_increment_map_mutex_);
+}
+
 bool AutoIncrementControl::Init() {
   DINGO_LOG(INFO) << "init";
   return true;
@@ -64,6 +78,13 @@ butil::Status AutoIncrementControl::GetAutoIncrement(uint64_t table_id, uint64_t
     } else {
       start_id = *start_id_ptr;
       status = butil::Status::OK();
+
+      // ids in leader cached segment are not generated yet
+      BAIDU_SCOPED_LOCK(segments_mutex_);
+      auto it = segments_.find(table_id);
+      if (it != segments_.end() && it->second.end_id > 0) {
+        start_id = it->second.next_id;
+      }
     }
   }
   return status;
@@ -138,6 +159,26 @@ butil::Status AutoIncrementControl::GenerateAutoIncrement(uint64_t table_id, uin
     return ret;
   }
 
+  ret = CheckGenerateParameter(table_id, count, auto_increment_increment, auto_increment_offset);
+  if (!ret.ok()) {
+    return ret;
+  }
+
+  auto* auto_increment = meta_increment.add_auto_increment();
+  auto_increment->set_id(table_id);
+  auto* increment = auto_increment->mutable_increment();
+  increment->set_update_type(pb::coordinator_internal::AutoIncrementUpdateType::READ_MODIFY_WRITE);
+  increment->set_generate_count(count);
+  increment->set_increment(auto_increment_increment);
+  increment->set_offset(auto_increment_offset);
+
+  auto_increment->set_op_type(pb::coordinator_internal::MetaIncrementOpType::UPDATE);
+  return butil::Status::OK();
+}
+
+butil::Status AutoIncrementControl::CheckGenerateParameter(uint64_t table_id, uint32_t count,
+                                                           uint32_t auto_increment_increment,
+                                                           uint32_t auto_increment_offset) {
   if (count == 0 || count > kAutoIncrementGenerateCountMax || auto_increment_increment == 0 ||
       auto_increment_increment > kAutoIncrementOffsetMax || auto_increment_offset == 0 ||
       auto_increment_offset > kAutoIncrementOffsetMax) {
@@ -146,16 +187,115 @@ butil::Status AutoIncrementControl::GenerateAutoIncrement(uint64_t table_id, uin
     return butil::Status(pb::error::Errno::EILLEGAL_PARAMTETERS, "illegal parameters");
   }
 
+  return butil::Status::OK();
+}
+
+bool AutoIncrementControl::CanGenerateFromSegment(uint32_t count, uint32_t auto_increment_increment) {
+  // raw id count which a request may need
+  uint64_t need_count = static_cast<uint64_t>(count + 1) * auto_increment_increment;
+  return engine_ != nullptr && FLAGS_auto_increment_segment_size > 0 && need_count <= FLAGS_auto_increment_segment_size;
+}
+
+butil::Status AutoIncrementControl::GenerateAutoIncrementFromSegment(uint64_t table_id, uint32_t count,
+                                                                     uint32_t auto_increment_increment,
+                                                                     uint32_t auto_increment_offset,
+                                                                     uint64_t& start_id, uint64_t& end_id) {
+  uint64_t source_start_id = 0;
+  butil::Status ret = GetAutoIncrement(table_id, source_start_id);
+  if (!ret.ok()) {
+    DINGO_LOG(WARNING) << "cannot find table_id: " << table_id;
+    return ret;
+  }
+
+  ret = CheckGenerateParameter(table_id, count, auto_increment_increment, auto_increment_offset);
+  if (!ret.ok()) {
+    return ret;
+  }
+
+  bthread_mutex_lock(&segments_mutex_);
+  while (true) {
+    auto& segment = segments_[table_id];
+    if (segment.end_id > 0) {
+      uint64_t generate_end_id =
+          GetGenerateEndId(segment.next_id, count, auto_increment_increment, auto_increment_offset);
+      if (generate_end_id <= segment.end_id) {
+        start_id = segment.next_id;
+        end_id = generate_end_id;
+        segment.next_id = generate_end_id;
+        bthread_mutex_unlock(&segments_mutex_);
+
+        DINGO_LOG(DEBUG) << "generate auto increment from segment: [" << start_id << ", " << end_id
+                         << "), table id: " << table_id;
+        return butil::Status::OK();
+      }
+    }
+
+    // Coalesce with the reservation in flight.
+    if (segment.reserving) {
+      bthread_cond_wait(&segments_cond_, &segments_mutex_);
+      continue;
+    }
+
+    segment.reserving = true;
+    bthread_mutex_unlock(&segments_mutex_);
+
+    ret = ReserveSegment(table_id, FLAGS_auto_increment_segment_size);
+
+    bthread_mutex_lock(&segments_mutex_);
+    segments_[table_id].reserving = false;
+    bthread_cond_broadcast(&segments_cond_);
+    if (!ret.ok()) {
+      bthread_mutex_unlock(&segments_mutex_);
+      DINGO_LOG(ERROR) << "reserve auto increment segment failed, table id: " << table_id << " | " << ret.error_str();
+      return ret;
+    }
+  }
+}
+
+butil::Status AutoIncrementControl::ReserveSegment(uint64_t table_id, uint32_t count) {
+  pb::coordinator_internal::MetaIncrement meta_increment;
   auto* auto_increment = meta_increment.add_auto_increment();
   auto_increment->set_id(table_id);
   auto* increment = auto_increment->mutable_increment();
   increment->set_update_type(pb::coordinator_internal::AutoIncrementUpdateType::READ_MODIFY_WRITE);
   increment->set_generate_count(count);
-  increment->set_increment(auto_increment_increment);
-  increment->set_offset(auto_increment_offset);
-
+  increment->set_increment(1);
+  increment->set_offset(1);
+  increment->set_is_segment(true);
   auto_increment->set_op_type(pb::coordinator_internal::MetaIncrementOpType::UPDATE);
-  return butil::Status::OK();
+
+  std::shared_ptr<Context> ctx = std::make_shared<Context>();
+  ctx->SetRegionId(Constant::kAutoIncrementRegionId);
+  return engine_->Write(ctx, WriteDataBuilder::BuildWrite(ctx->CfName(), meta_increment));
+}
+
+void AutoIncrementControl::ApplySegment(uint64_t table_id, uint64_t source_start_id, uint64_t end_id) {
+  BAIDU_SCOPED_LOCK(segments_mutex_);
+  auto& segment = segments_[table_id];
+  // The remainder of current segment is still usable when the new one follow it.
+  if (segment.end_id == 0 || segment.end_id != source_start_id) {
+    segment.next_id = source_start_id;
+  }
+  segment.end_id = end_id;
+  DINGO_LOG(INFO) << "apply auto increment segment, table id: " << table_id << ", [" << segment.next_id << ", "
+                  << segment.end_id << ")";
+}
+
+void AutoIncrementControl::ResetSegment(uint64_t table_id) {
+  BAIDU_SCOPED_LOCK(segments_mutex_);
+  auto it = segments_.find(table_id);
+  if (it != segments_.end()) {
+    it->second.next_id = 0;
+    it->second.end_id = 0;
+  }
+}
+
+void AutoIncrementControl::ResetAllSegment() {
+  BAIDU_SCOPED_LOCK(segments_mutex_);
+  for (auto& [table_id, segment] : segments_) {
+    segment.next_id = 0;
+    segment.end_id = 0;
+  }
 }
 
 butil::Status AutoIncrementControl::DeleteAutoIncrement(uint64_t table_id,
@@ -223,9 +363,16 @@ bool AutoIncrementControl::IsLeader() { return leader_term_.load(butil::memory_o
 
 void AutoIncrementControl::SetLeaderTerm(int64_t term) { leader_term_.store(term, butil::memory_order_release); }
 
-void AutoIncrementControl::OnLeaderStart(int64_t term) { DINGO_LOG(INFO) << "OnLeaderStart, term=" << term; }
+// The segment of previous leader term is discarded, its unused ids are skipped.
+void AutoIncrementControl::OnLeaderStart(int64_t term) {
+  DINGO_LOG(INFO) << "OnLeaderStart, term=" << term;
+  ResetAllSegment();
+}
 
-void AutoIncrementControl::OnLeaderStop() { DINGO_LOG(INFO) << "OnLeaderStop"; }
+void AutoIncrementControl::OnLeaderStop() {
+  DINGO_LOG(INFO) << "OnLeaderStop";
+  ResetAllSegment();
+}
 
 // set raft_node to coordinator_control
 void AutoIncrementControl::SetRaftNode(std::shared_ptr<RaftNode> raft_node) { raft_node_ = raft_node; }
@@ -242,6 +389,7 @@ void AutoIncrementControl::ApplyMetaIncrement(pb::coordinator_internal::MetaIncr
       DINGO_LOG(INFO) << "create auto increment, table id: " << table_id
                       << ", start id: " << auto_increment.increment().start_id();
       auto_increment_map_[table_id] = auto_increment.increment().start_id();
+      ResetSegment(table_id);
     } else if (auto_increment.op_type() == pb::coordinator_internal::MetaIncrementOpType::UPDATE) {
       uint64_t* start_id_ptr = auto_increment_map_.seek(table_id);
       if (start_id_ptr == nullptr) {
@@ -263,6 +411,9 @@ void AutoIncrementControl::ApplyMetaIncrement(pb::coordinator_internal::MetaIncr
           DINGO_LOG(INFO) << "leader grenerate auto increment response: " << generate_response->ShortDebugString();
         }
         auto_increment_map_[table_id] = end_id;
+        if (is_leader && auto_increment.increment().is_segment()) {
+          ApplySegment(table_id, source_start_id, end_id);
+        }
         DINGO_LOG(INFO) << "generate auto increment: [" << source_start_id << ", " << end_id
                         << ") request: " << auto_increment.ShortDebugString();
       } else {
@@ -272,6 +423,7 @@ void AutoIncrementControl::ApplyMetaIncrement(pb::coordinator_internal::MetaIncr
                              << auto_increment.increment().source_start_id();
         }
         auto_increment_map_[table_id] = auto_increment.increment().start_id();
+        ResetSegment(table_id);
         DINGO_LOG(INFO) << "update auto increment, table id: " << table_id
                         << ", old start id: " << auto_increment.increment().source_start_id()
                         << ", start id: " << auto_increment.increment().start_id();
@@ -279,6 +431,7 @@ void AutoIncrementControl::ApplyMetaIncrement(pb::coordinator_internal::MetaIncr
     } else if (auto_increment.op_type() == pb::coordinator_internal::MetaIncrementOpType::DELETE) {
       DINGO_LOG(INFO) << "delete auto increment " << auto_increment.ShortDebugString();
       auto_increment_map_.erase(table_id);
+      ResetSegment(table_id);
     }
   }
 }
@@ -376,16 +529,84 @@ bool AutoIncrementControl::LoadMetaToSnapshotFile(std::shared_ptr<Snapshot> snap
   return true;
 }
 
+static const std::string kAutoIncrementSnapshotPrefix = "auto_increment";
+
+bool AutoIncrementControl::SaveMetaToSnapshotFile(std::shared_ptr<Snapshot> snapshot, MetaSnapshotFileWriter& writer) {
+  DINGO_LOG(INFO) << "AutoIncrementControl start to SaveMetaToSnapshotFile";
+
+  auto auto_increment_snapshot = std::dynamic_pointer_cast<AutoIncrementSnapshot>(snapshot);
+  if (auto_increment_snapshot == nullptr) {
+    DINGO_LOG(ERROR) << "Failed to dynamic cast snapshot to auto increment snapshot";
+    return false;
+  }
+
+  const auto* flatmap_of_snapshot = auto_increment_snapshot->GetSnapshot();
+
+  for (auto it : (*flatmap_of_snapshot)) {
+    pb::coordinator_internal::AutoIncrementStorageElement element;
+    element.set_table_id(it.first);
+    element.set_start_id(it.second);
+
+    pb::common::KeyValue kv;
+    kv.set_key(fmt::format("{}_{}", kAutoIncrementSnapshotPrefix, it.first));
+    kv.set_value(element.SerializeAsString());
+    auto status = writer.Append(kAutoIncrementSnapshotPrefix, std::move(kv));
+    if (!status.ok()) {
+      DINGO_LOG(ERROR) << "AutoIncrementControl write snapshot file failed, error: " << status.error_str();
+      return false;
+    }
+  }
+
+  DINGO_LOG(INFO) << "AutoIncrementControl SaveMetaToSnapshotFile success, elements_size="
+                  << flatmap_of_snapshot->size();
+
+  return true;
+}
+
+bool AutoIncrementControl::LoadMetaFromSnapshotFile(MetaSnapshotFileReader& reader) {
+  DINGO_LOG(INFO) << "AutoIncrementControl start to LoadMetaFromSnapshotFile by stream";
+
+  ResetAllSegment();
+
+  BAIDU_SCOPED_LOCK(auto_increment_map_mutex_);
+  auto_increment_map_.clear();
+
+  pb::coordinator_internal::MetaSnapshotChunk chunk;
+  do {
+    auto status = reader.Read(chunk);
+    if (!status.ok()) {
+      DINGO_LOG(ERROR) << "Read auto increment snapshot chunk failed, error: " << status.error_str();
+      return false;
+    }
+
+    for (const auto& kv : chunk.kvs()) {
+      pb::coordinator_internal::AutoIncrementStorageElement element;
+      if (!element.ParseFromString(kv.value())) {
+        DINGO_LOG(ERROR) << "Parse auto increment snapshot element failed, key: " << kv.key();
+        return false;
+      }
+      auto_increment_map_[element.table_id()] = element.start_id();
+    }
+  } while (!chunk.is_last());
+
+  DINGO_LOG(INFO) << "AutoIncrementControl LoadMetaFromSnapshotFile success, elements_size="
+                  << auto_increment_map_.size();
+
+  return true;
+}
+
 bool AutoIncrementControl::LoadMetaFromSnapshotFile(pb::coordinator_internal::MetaSnapshotFile& meta_snapshot_file) {
   DINGO_LOG(INFO) << "AutoIncrementControl start to LoadMetaFromSnapshotFile";
 
   const auto& storage = meta_snapshot_file.auto_increment_storage();
 
+  ResetAllSegment();
+
   BAIDU_SCOPED_LOCK(auto_increment_map_mutex_);
   auto_increment_map_.clear();
   for (int i = 0; i < storage.elements_size(); i++) {
     const auto& element = storage.elements(i);
-    auto_increment_map_[element.table_id()] = auto_increment_map_[element.start_id()];
+    auto_increment_map_[element.table_id()] = element.start_id();
   }
 
   DINGO_LOG(INFO) << "AutoIncrementControl LoadMetaFromSnapshotFile success, elements_size=" << storage.elements_size();
@@ -407,7 +628,7 @@ int AutoIncrementControl::LoadAutoIncrement(const std::string& auto_increment_fi
   BAIDU_SCOPED_LOCK(auto_increment_map_mutex_);
   for (int i = 0; i < storage.elements_size(); i++) {
     const auto& element = storage.elements(i);
-    auto_increment_map_[element.table_id()] = auto_increment_map_[element.start_id()];
+    auto_increment_map_[element.table_id()] = element.start_id();
   }
   return 0;
 }
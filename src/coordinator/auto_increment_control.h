@@ -23,6 +23,7 @@
 
 #include "butil/containers/flat_map.h"
 #include "common/meta_control.h"
+#include "engine/engine.h"
 #include "proto/coordinator_internal.pb.h"
 
 namespace dingodb {
@@ -38,10 +39,18 @@ class AutoIncrementSnapshot : public dingodb::Snapshot {
   const butil::FlatMap<uint64_t, uint64_t> *snapshot_;
 };
 
+// Raw ids [next_id, end_id) reserved by leader through one raft write, generate request is served from it in memory.
+struct AutoIncrementSegment {
+  uint64_t next_id = 0;
+  uint64_t end_id = 0;
+  // A reservation is in flight, requests which can't be served wait for it.
+  bool reserving = false;
+};
+
 class AutoIncrementControl : public MetaControl {
  public:
   AutoIncrementControl();
-  ~AutoIncrementControl() override = default;
+  ~AutoIncrementControl() override;
   ;
 
   static bool Init();
@@ -58,6 +67,14 @@ class AutoIncrementControl : public MetaControl {
                                       pb::coordinator_internal::MetaIncrement &meta_increment);
   butil::Status DeleteAutoIncrement(uint64_t table_id, pb::coordinator_internal::MetaIncrement &meta_increment);
 
+  // Generate from leader cached segment, concurrent requests share one reservation.
+  // Large request which exceed segment size should use GenerateAutoIncrement.
+  bool CanGenerateFromSegment(uint32_t count, uint32_t auto_increment_increment);
+  butil::Status GenerateAutoIncrementFromSegment(uint64_t table_id, uint32_t count, uint32_t auto_increment_increment,
+                                                 uint32_t auto_increment_offset, uint64_t &start_id, uint64_t &end_id);
+
+  void SetKvEngine(std::shared_ptr<Engine> engine) { engine_ = engine; };
+
   // Get raft leader's server location
   void GetLeaderLocation(pb::common::Location &leader_server_location) override;
 
@@ -84,6 +101,8 @@ class AutoIncrementControl : public MetaControl {
   std::shared_ptr<Snapshot> PrepareRaftSnapshot() override;
   bool LoadMetaToSnapshotFile(std::shared_ptr<Snapshot> snapshot,
                               pb::coordinator_internal::MetaSnapshotFile &meta_snapshot_file) override;
+  bool SaveMetaToSnapshotFile(std::shared_ptr<Snapshot> snapshot, MetaSnapshotFileWriter &writer) override;
+  bool LoadMetaFromSnapshotFile(MetaSnapshotFileReader &reader) override;
   bool LoadMetaFromSnapshotFile(pb::coordinator_internal::MetaSnapshotFile &meta_snapshot_file) override;
 
   int SaveAutoIncrement(std::string &auto_increment_data);
@@ -99,6 +118,15 @@ class AutoIncrementControl : public MetaControl {
  private:
   static uint64_t GetGenerateEndId(uint64_t start_id, uint32_t count, uint32_t increment, uint32_t offset);
   static uint64_t GetRealStartId(uint64_t start_id, uint32_t auto_increment_increment, uint32_t auto_increment_offset);
+  static butil::Status CheckGenerateParameter(uint64_t table_id, uint32_t count, uint32_t auto_increment_increment,
+                                              uint32_t auto_increment_offset);
+
+  // Propose reservation and wait it applied, the segment is set when apply.
+  butil::Status ReserveSegment(uint64_t table_id, uint32_t count);
+  // Must hold auto_increment_map_mutex_, called when apply.
+  void ApplySegment(uint64_t table_id, uint64_t source_start_id, uint64_t end_id);
+  void ResetSegment(uint64_t table_id);
+  void ResetAllSegment();
 
   butil::FlatMap<uint64_t, uint64_t> auto_increment_map_;
   bthread_mutex_t auto_increment_map_mutex_;
@@ -112,6 +140,14 @@ class AutoIncrementControl : public MetaControl {
   // coordinator raft_location to server_location cache
   std::map<std::string, pb::common::Location> auto_increment_location_cache_;
 
+  // raft kv engine
+  std::shared_ptr<Engine> engine_;
+
+  // table_id: segment, only leader has segment
+  std::map<uint64_t, AutoIncrementSegment> segments_;
+  bthread_mutex_t segments_mutex_;
+  bthread_cond_t segments_cond_;
+
   inline static const uint32_t kAutoIncrementGenerateCountMax = 100000;
   inline static const uint32_t kAutoIncrementOffsetMax = 65535;
 };
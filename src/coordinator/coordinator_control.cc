@@ -524,6 +524,28 @@ uint64_t CoordinatorControl::GetNextId(const pb::coordinator_internal::IdEpochTy
   return next_id;
 }
 
+uint64_t CoordinatorControl::GetNextIds(const pb::coordinator_internal::IdEpochType& key, uint32_t count,
+                                        pb::coordinator_internal::MetaIncrement& meta_increment) {
+  if (count == 0) {
+    return 0;
+  }
+
+  // reserve ids from id_epoch_map_safe_temp_
+  uint64_t end_id = 0;
+  id_epoch_map_safe_temp_.GetNextIds(key, count, end_id);
+
+  // only the last id is needed, on_apply will update to the larger one
+  auto* idepoch = meta_increment.add_idepochs();
+  idepoch->set_id(key);
+  idepoch->set_op_type(::dingodb::pb::coordinator_internal::MetaIncrementOpType::UPDATE);
+
+  auto* idepoch_internal = idepoch->mutable_idepoch();
+  idepoch_internal->set_id(key);
+  idepoch_internal->set_value(end_id);
+
+  return end_id - count + 1;
+}
+
 uint64_t CoordinatorControl::GetPresentId(const pb::coordinator_internal::IdEpochType& key) {
   uint64_t value = 0;
   id_epoch_map_safe_temp_.GetPresentId(key, value);
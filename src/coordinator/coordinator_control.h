@@ -16,6 +16,7 @@
 #define DINGODB_COORDINATOR_CONTROL_H_
 
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <shared_mutex>
@@ -31,6 +32,7 @@
 #include "engine/engine.h"
 #include "engine/snapshot.h"
 #include "meta/meta_reader.h"
+#include "meta/meta_snapshot_file.h"
 #include "meta/meta_writer.h"
 #include "metrics/coordinator_bvar_metrics.h"
 #include "proto/common.pb.h"
@@ -163,6 +165,10 @@ class CoordinatorControl : public MetaControl {
   butil::Status SelectStore(pb::common::StoreType store_type, int32_t replica_num, const std::string &resource_tag,
                             std::vector<uint64_t> &store_ids,
                             std::vector<pb::common::Store> &selected_stores_for_regions);
+  // select all available stores, sorted by weight, at least replica_num
+  butil::Status SelectStoreCandidates(pb::common::StoreType store_type, int32_t replica_num,
+                                      const std::string &resource_tag, std::vector<uint64_t> &store_ids,
+                                      std::vector<pb::common::Store> &candidate_stores);
   butil::Status CreateRegion(const std::string &region_name, pb::common::RegionType region_type,
                              const std::string &resource_tag, int32_t replica_num, pb::common::Range region_range,
                              uint64_t schema_id, uint64_t table_id, uint64_t index_id,
@@ -174,6 +180,16 @@ class CoordinatorControl : public MetaControl {
                              uint64_t schema_id, uint64_t table_id, uint64_t index_id,
                              const pb::common::IndexParameter &index_parameter, uint64_t &new_region_id,
                              pb::coordinator_internal::MetaIncrement &meta_increment);
+  // create regions in one pass, stores are selected once and id are reserved by range
+  // in: region_names, region_ranges, must be same size
+  // out: new_region_ids
+  // return: errno, nothing is added to meta_increment if failed, but the region ids reserved in memory are skipped
+  butil::Status CreateRegions(const std::vector<std::string> &region_names, pb::common::RegionType region_type,
+                              const std::string &resource_tag, int32_t replica_num,
+                              const std::vector<pb::common::Range> &region_ranges, uint64_t schema_id,
+                              uint64_t table_id, uint64_t index_id, const pb::common::IndexParameter &index_parameter,
+                              std::vector<uint64_t> &new_region_ids,
+                              pb::coordinator_internal::MetaIncrement &meta_increment);
   butil::Status CreateRegionForSplit(const std::string &region_name, pb::common::RegionType region_type,
                                      const std::string &resource_tag, pb::common::Range region_range,
                                      uint64_t schema_id, uint64_t table_id, uint64_t index_id,
@@ -346,6 +362,10 @@ class CoordinatorControl : public MetaControl {
   // delete store metrics
   void DeleteStoreMetrics(uint64_t store_id);
 
+  // get top n hot regions order by the given statistic
+  void GetHotRegions(pb::coordinator::HotRegionOrder order, uint32_t top_n,
+                     std::vector<pb::coordinator::HotRegion> &hot_regions);
+
   // get orphan region
   butil::Status GetOrphanRegion(uint64_t store_id, std::map<uint64_t, pb::common::RegionMetrics> &orphan_regions);
 
@@ -498,6 +518,11 @@ class CoordinatorControl : public MetaControl {
   uint64_t GetNextId(const pb::coordinator_internal::IdEpochType &key,
                      pb::coordinator_internal::MetaIncrement &meta_increment);
 
+  // get count continuous ids with one id_epoch increment
+  // return: the first id, ids are [first_id, first_id + count)
+  uint64_t GetNextIds(const pb::coordinator_internal::IdEpochType &key, uint32_t count,
+                      pb::coordinator_internal::MetaIncrement &meta_increment);
+
   // get present id/epoch
   uint64_t GetPresentId(const pb::coordinator_internal::IdEpochType &key);
 
@@ -552,10 +577,23 @@ class CoordinatorControl : public MetaControl {
   bool LoadMetaToSnapshotFile(std::shared_ptr<Snapshot> snapshot,
                               pb::coordinator_internal::MetaSnapshotFile &meta_snapshot_file) override;  // for raft fsm
 
+  // SaveMetaToSnapshotFile
+  bool SaveMetaToSnapshotFile(std::shared_ptr<Snapshot> snapshot,
+                              MetaSnapshotFileWriter &writer) override;  // for raft fsm
+
   // LoadMetaFromSnapshotFile
+  bool LoadMetaFromSnapshotFile(MetaSnapshotFileReader &reader) override;  // for raft fsm
   bool LoadMetaFromSnapshotFile(
       pb::coordinator_internal::MetaSnapshotFile &meta_snapshot_file) override;  // for raft fsm
 
+  // One meta map of snapshot, kvs of a section share the same prefix.
+  struct MetaSection {
+    std::string name;
+    std::string prefix;
+    std::function<void()> clear;
+    std::function<void(const std::vector<pb::common::KeyValue> &)> append;
+  };
+
   void GetTaskList(butil::FlatMap<uint64_t, pb::coordinator::TaskList> &task_lists);
 
   pb::coordinator::TaskList *CreateTaskList(pb::coordinator_internal::MetaIncrement &meta_increment);
@@ -597,6 +635,11 @@ class CoordinatorControl : public MetaControl {
  private:
   butil::Status ValidateTaskListConflict(uint64_t region_id, uint64_t second_region_id);
 
+  // Meta sections in snapshot order.
+  std::vector<MetaSection> GetMetaSections();
+  // Rebuild leader temp maps from meta maps after snapshot loaded.
+  void RebuildTempMaps();
+
   // ids_epochs_temp (out of state machine, only for leader use)
   DingoSafeIdEpochMap id_epoch_map_safe_temp_;
 
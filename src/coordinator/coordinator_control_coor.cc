@@ -19,6 +19,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <map>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -34,6 +35,7 @@
 #include "common/helper.h"
 #include "common/logging.h"
 #include "coordinator/coordinator_control.h"
+#include "fmt/core.h"
 #include "gflags/gflags.h"
 #include "metrics/coordinator_bvar_metrics.h"
 #include "proto/common.pb.h"
@@ -144,6 +146,59 @@ void CoordinatorControl::DeleteStoreMetrics(uint64_t store_id) {
   }
 }
 
+static uint64_t GetHotValue(const pb::common::RegionHotStats& hot_stats, pb::coordinator::HotRegionOrder order) {
+  switch (order) {
+    case pb::coordinator::HotRegionOrder::HOT_ORDER_READ_QPS:
+      return hot_stats.read_qps();
+    case pb::coordinator::HotRegionOrder::HOT_ORDER_WRITE_QPS:
+      return hot_stats.write_qps();
+    case pb::coordinator::HotRegionOrder::HOT_ORDER_READ_BYTES:
+      return hot_stats.read_bytes_per_second();
+    case pb::coordinator::HotRegionOrder::HOT_ORDER_WRITE_BYTES:
+      return hot_stats.write_bytes_per_second();
+    default:
+      return 0;
+  }
+}
+
+void CoordinatorControl::GetHotRegions(pb::coordinator::HotRegionOrder order, uint32_t top_n,
+                                       std::vector<pb::coordinator::HotRegion>& hot_regions) {
+  // Every peer report its own statistics, requests are mostly served by leader, so keep the hottest one.
+  std::map<uint64_t, pb::coordinator::HotRegion> region_map;
+  {
+    BAIDU_SCOPED_LOCK(store_metrics_map_mutex_);
+    for (const auto& it : store_metrics_map_) {
+      for (const auto& [region_id, region_metrics] : it.second.region_metrics_map()) {
+        uint64_t value = GetHotValue(region_metrics.hot_stats(), order);
+        if (value == 0) {
+          continue;
+        }
+
+        auto region_it = region_map.find(region_id);
+        if (region_it != region_map.end() && GetHotValue(region_it->second.hot_stats(), order) >= value) {
+          continue;
+        }
+
+        auto& hot_region = region_map[region_id];
+        hot_region.set_region_id(region_id);
+        hot_region.set_store_id(it.first);
+        hot_region.mutable_hot_stats()->CopyFrom(region_metrics.hot_stats());
+      }
+    }
+  }
+
+  for (auto& [_, hot_region] : region_map) {
+    hot_regions.push_back(std::move(hot_region));
+  }
+  std::sort(hot_regions.begin(), hot_regions.end(),
+            [order](const pb::coordinator::HotRegion& a, const pb::coordinator::HotRegion& b) {
+              return GetHotValue(a.hot_stats(), order) > GetHotValue(b.hot_stats(), order);
+            });
+  if (hot_regions.size() > top_n) {
+    hot_regions.resize(top_n);
+  }
+}
+
 butil::Status CoordinatorControl::GetOrphanRegion(uint64_t store_id,
                                                   std::map<uint64_t, pb::common::RegionMetrics>& orphan_regions) {
   BAIDU_SCOPED_LOCK(this->store_metrics_map_mutex_);
@@ -777,6 +832,31 @@ butil::Status CoordinatorControl::SelectStore(pb::common::StoreType store_type,
   DINGO_LOG(INFO) << "SelectStore replica_num=" << replica_num << ", resource_tag=" << resource_tag
                   << ", store_ids.size=" << store_ids.size();
 
+  std::vector<pb::common::Store> candidate_stores;
+  auto ret = SelectStoreCandidates(store_type, replica_num, resource_tag, store_ids, candidate_stores);
+  if (!ret.ok()) {
+    return ret;
+  }
+
+  // select replica_num stores
+  std::string store_ids_str;
+  selected_stores_for_regions.reserve(replica_num);
+  for (int i = 0; i < replica_num; i++) {
+    selected_stores_for_regions.push_back(candidate_stores[i]);
+    store_ids_str += std::to_string(candidate_stores[i].id()) + ",";
+  }
+
+  DINGO_LOG(INFO) << "selected_stores_for_regions.size=" << selected_stores_for_regions.size()
+                  << ", store_ids_str=" << store_ids_str;
+
+  return butil::Status::OK();
+}
+
+butil::Status CoordinatorControl::SelectStoreCandidates(pb::common::StoreType store_type, int32_t replica_num,
+                                                        const std::string& resource_tag,
+                                                        std::vector<uint64_t>& store_ids,
+                                                        std::vector<pb::common::Store>& candidate_stores) {
+
   std::vector<pb::common::Store> stores_for_regions;
 
   // if store_ids is not null, select store with store_ids
@@ -893,17 +973,11 @@ butil::Status CoordinatorControl::SelectStore(pb::common::StoreType store_type,
 
   DINGO_LOG(INFO) << "store_more_vec.size=" << store_more_vec.size() << ", replica_num=" << replica_num;
 
-  // select replica_num stores
-  std::string store_ids_str;
-  selected_stores_for_regions.reserve(replica_num);
-  for (int i = 0; i < replica_num; i++) {
-    selected_stores_for_regions.push_back(store_more_vec[i].store);
-    store_ids_str += std::to_string(store_more_vec[i].store.id()) + ",";
+  candidate_stores.reserve(store_more_vec.size());
+  for (auto& store_more : store_more_vec) {
+    candidate_stores.push_back(std::move(store_more.store));
   }
 
-  DINGO_LOG(INFO) << "selected_stores_for_regions.size=" << selected_stores_for_regions.size()
-                  << ", store_ids_str=" << store_ids_str;
-
   return butil::Status::OK();
 }
 
@@ -914,6 +988,41 @@ std::string EncodeIndexRegionHeader(uint64_t region_id) {
   return buf.GetString();
 }
 
+// Build region definition of new region, peers are the given stores.
+static void GenRegionDefinition(uint64_t region_id, const std::string& region_name, pb::common::RegionType region_type,
+                                const pb::common::Range& region_range, uint64_t schema_id, uint64_t table_id,
+                                uint64_t index_id, const pb::common::IndexParameter& index_parameter,
+                                const std::vector<const pb::common::Store*>& stores,
+                                pb::common::RegionDefinition* region_definition) {
+  region_definition->set_id(region_id);
+  region_definition->set_name(region_name + std::string("_") + std::to_string(region_id));
+  region_definition->set_epoch(1);
+  region_definition->set_schema_id(schema_id);
+  region_definition->set_table_id(table_id);
+  region_definition->set_index_id(index_id);
+  if (index_parameter.index_type() != pb::common::IndexType::INDEX_TYPE_NONE) {
+    region_definition->mutable_index_parameter()->CopyFrom(index_parameter);
+  }
+  auto* range_in_definition = region_definition->mutable_range();
+  // for index region, the region key header is start with region_id
+  // for table region, the region range is defined by user
+  if (region_type == pb::common::RegionType::INDEX_REGION) {
+    range_in_definition->set_start_key(EncodeIndexRegionHeader(region_id));
+    range_in_definition->set_end_key(EncodeIndexRegionHeader(region_id + 1));
+  } else {
+    range_in_definition->CopyFrom(region_range);
+  }
+
+  // add store_id and its peer location to region
+  for (const auto* store : stores) {
+    auto* peer = region_definition->add_peers();
+    peer->set_store_id(store->id());
+    peer->set_role(::dingodb::pb::common::PeerRole::VOTER);
+    peer->mutable_server_location()->CopyFrom(store->server_location());
+    peer->mutable_raft_location()->CopyFrom(store->raft_location());
+  }
+}
+
 butil::Status CoordinatorControl::CreateRegion(const std::string& region_name, pb::common::RegionType region_type,
                                                const std::string& resource_tag, int32_t replica_num,
                                                pb::common::Range region_range, uint64_t schema_id, uint64_t table_id,
@@ -972,34 +1081,12 @@ butil::Status CoordinatorControl::CreateRegion(const std::string& region_name, p
 
   // create region definition begin
   auto* region_definition = new_region.mutable_metrics()->mutable_region_definition();
-  region_definition->set_id(create_region_id);
-  region_definition->set_name(region_name + std::string("_") + std::to_string(create_region_id));
-  region_definition->set_epoch(1);
-  region_definition->set_schema_id(schema_id);
-  region_definition->set_table_id(table_id);
-  region_definition->set_index_id(index_id);
-  if (index_parameter.index_type() != pb::common::IndexType::INDEX_TYPE_NONE) {
-    region_definition->mutable_index_parameter()->CopyFrom(index_parameter);
-  }
-  auto* range_in_definition = region_definition->mutable_range();
-  // for index region, the region key header is start with region_id
-  // for table region, the region range is defined by user
-  if (region_type == pb::common::RegionType::INDEX_REGION) {
-    range_in_definition->set_start_key(EncodeIndexRegionHeader(create_region_id));
-    range_in_definition->set_end_key(EncodeIndexRegionHeader(create_region_id + 1));
-  } else {
-    range_in_definition->CopyFrom(region_range);
-  }
-
-  // add store_id and its peer location to region
+  std::vector<const pb::common::Store*> region_stores;
   for (int i = 0; i < replica_num; i++) {
-    auto store = selected_stores_for_regions[i];
-    auto* peer = region_definition->add_peers();
-    peer->set_store_id(store.id());
-    peer->set_role(::dingodb::pb::common::PeerRole::VOTER);
-    peer->mutable_server_location()->CopyFrom(store.server_location());
-    peer->mutable_raft_location()->CopyFrom(store.raft_location());
+    region_stores.push_back(&selected_stores_for_regions[i]);
   }
+  GenRegionDefinition(create_region_id, region_name, region_type, region_range, schema_id, table_id, index_id,
+                      index_parameter, region_stores, region_definition);
 
   new_region.mutable_definition()->CopyFrom(*region_definition);
   // create region definition end
@@ -1079,6 +1166,114 @@ butil::Status CoordinatorControl::CreateRegion(const std::string& region_name, p
   return butil::Status::OK();
 }
 
+butil::Status CoordinatorControl::CreateRegions(const std::vector<std::string>& region_names,
+                                                pb::common::RegionType region_type, const std::string& resource_tag,
+                                                int32_t replica_num,
+                                                const std::vector<pb::common::Range>& region_ranges, uint64_t schema_id,
+                                                uint64_t table_id, uint64_t index_id,
+                                                const pb::common::IndexParameter& index_parameter,
+                                                std::vector<uint64_t>& new_region_ids,
+                                                pb::coordinator_internal::MetaIncrement& meta_increment) {
+  if (region_names.size() != region_ranges.size() || region_names.empty()) {
+    return butil::Status(pb::error::Errno::EILLEGAL_PARAMTETERS, "region_names and region_ranges size not match");
+  }
+  if (replica_num < 1) {
+    return butil::Status(pb::error::Errno::EILLEGAL_PARAMTETERS, "replica_num is illegal");
+  }
+
+  // setup store_type
+  pb::common::StoreType store_type = pb::common::StoreType::NODE_TYPE_STORE;
+  if (region_type == pb::common::RegionType::INDEX_REGION) {
+    store_type = pb::common::StoreType::NODE_TYPE_INDEX;
+  }
+
+  // select stores once for all regions
+  std::vector<uint64_t> store_ids;
+  std::vector<pb::common::Store> candidate_stores;
+  auto ret = SelectStoreCandidates(store_type, replica_num, resource_tag, store_ids, candidate_stores);
+  if (!ret.ok()) {
+    return ret;
+  }
+
+  uint32_t region_count = region_names.size();
+  int idepochs_size = meta_increment.idepochs_size();
+  uint64_t first_region_id =
+      GetNextIds(pb::coordinator_internal::IdEpochType::ID_NEXT_REGION, region_count, meta_increment);
+  for (uint64_t region_id = first_region_id; region_id < first_region_id + region_count; ++region_id) {
+    if (region_map_.Exists(region_id)) {
+      DINGO_LOG(ERROR) << "create_region_id =" << region_id << " is illegal, cannot create region!!";
+      // The reserved ids are skipped, drop the id increment only.
+      meta_increment.mutable_idepochs()->DeleteSubrange(idepochs_size, meta_increment.idepochs_size() - idepochs_size);
+      return butil::Status(pb::error::Errno::EREGION_UNAVAILABLE, "create_region_id is illegal");
+    }
+  }
+
+  uint64_t first_region_cmd_id =
+      GetNextIds(pb::coordinator_internal::IdEpochType::ID_NEXT_REGION_CMD, region_count * replica_num, meta_increment);
+
+  // regions of one store are merged into one store operation
+  std::map<uint64_t, pb::coordinator::StoreOperation> store_operations;
+  new_region_ids.reserve(region_count);
+  std::vector<const pb::common::Store*> region_stores;
+  region_stores.reserve(replica_num);
+  uint64_t create_timestamp = butil::gettimeofday_ms();
+  for (uint32_t i = 0; i < region_count; ++i) {
+    uint64_t create_region_id = first_region_id + i;
+
+    // round robin over candidates, so regions spread evenly on stores
+    region_stores.clear();
+    for (int j = 0; j < replica_num; ++j) {
+      region_stores.push_back(&candidate_stores[(i + j) % candidate_stores.size()]);
+    }
+
+    auto* region_increment = meta_increment.add_regions();
+    region_increment->set_id(create_region_id);
+    region_increment->set_op_type(::dingodb::pb::coordinator_internal::MetaIncrementOpType::CREATE);
+    region_increment->set_table_id(table_id);
+
+    auto* new_region = region_increment->mutable_region();
+    new_region->set_id(create_region_id);
+    new_region->set_epoch(1);
+    new_region->set_state(::dingodb::pb::common::RegionState::REGION_NEW);
+    new_region->set_create_timestamp(create_timestamp);
+    new_region->set_region_type(region_type);
+
+    auto* region_definition = new_region->mutable_definition();
+    GenRegionDefinition(create_region_id, region_names[i], region_type, region_ranges[i], schema_id, table_id,
+                        index_id, index_parameter, region_stores, region_definition);
+    new_region->mutable_metrics()->mutable_region_definition()->CopyFrom(*region_definition);
+
+    for (int j = 0; j < replica_num; ++j) {
+      uint64_t store_id = region_stores[j]->id();
+      auto& store_operation = store_operations[store_id];
+      store_operation.set_id(store_id);
+
+      auto* region_cmd = store_operation.add_region_cmds();
+      region_cmd->set_id(first_region_cmd_id + i * replica_num + j);
+      region_cmd->set_create_timestamp(create_timestamp);
+      region_cmd->set_region_id(create_region_id);
+      region_cmd->set_region_cmd_type(::dingodb::pb::coordinator::RegionCmdType::CMD_CREATE);
+      region_cmd->set_is_notify(true);  // for create region, we need immediately heartbeat
+      region_cmd->mutable_create_request()->mutable_region_definition()->CopyFrom(*region_definition);
+    }
+
+    new_region_ids.push_back(create_region_id);
+  }
+
+  // add store operations to meta_increment
+  for (auto& [store_id, store_operation] : store_operations) {
+    auto* store_operation_increment = meta_increment.add_store_operations();
+    store_operation_increment->set_id(store_id);
+    store_operation_increment->set_op_type(::dingodb::pb::coordinator_internal::MetaIncrementOpType::CREATE);
+    *store_operation_increment->mutable_store_operation() = std::move(store_operation);
+  }
+
+  DINGO_LOG(INFO) << fmt::format("CreateRegions success, region_count={} first_region_id={} store_count={}",
+                                 region_count, first_region_id, store_operations.size());
+
+  return butil::Status::OK();
+}
+
 butil::Status CoordinatorControl::DropRegion(uint64_t region_id,
                                              pb::coordinator_internal::MetaIncrement& meta_increment) {
   return DropRegion(region_id, false, meta_increment);
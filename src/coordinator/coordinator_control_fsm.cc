@@ -16,6 +16,7 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -27,6 +28,8 @@
 #include "common/logging.h"
 #include "coordinator/coordinator_control.h"
 #include "engine/snapshot.h"
+#include "fmt/core.h"
+#include "gflags/gflags.h"
 #include "google/protobuf/unknown_field_set.h"
 #include "proto/common.pb.h"
 #include "proto/coordinator.pb.h"
@@ -37,6 +40,8 @@
 
 namespace dingodb {
 
+DECLARE_uint32(meta_snapshot_chunk_kv_count);
+
 bool CoordinatorControl::IsLeader() { return leader_term_.load(butil::memory_order_acquire) > 0; }
 
 void CoordinatorControl::SetLeaderTerm(int64_t term) {
@@ -330,6 +335,120 @@ bool CoordinatorControl::LoadMetaToSnapshotFile(std::shared_ptr<Snapshot> snapsh
   return true;
 }
 
+template <typename Storage>
+static CoordinatorControl::MetaSection GenMetaSection(const std::string& name, Storage* storage) {
+  return CoordinatorControl::MetaSection{
+      name, storage->Prefix(), [storage]() { storage->Recover({}); },
+      [storage](const std::vector<pb::common::KeyValue>& kvs) { storage->TransformFromKv(kvs); }};
+}
+
+std::vector<CoordinatorControl::MetaSection> CoordinatorControl::GetMetaSections() {
+  auto store_metrics_section = GenMetaSection("store_metrics_meta", store_metrics_meta_);
+  store_metrics_section.clear = [this]() {
+    BAIDU_SCOPED_LOCK(store_metrics_map_mutex_);
+    store_metrics_meta_->Recover({});
+  };
+  store_metrics_section.append = [this](const std::vector<pb::common::KeyValue>& kvs) {
+    BAIDU_SCOPED_LOCK(store_metrics_map_mutex_);
+    store_metrics_meta_->TransformFromKv(kvs);
+  };
+
+  return {GenMetaSection("id_epoch_meta", id_epoch_meta_),
+          GenMetaSection("coordinator_meta", coordinator_meta_),
+          GenMetaSection("store_meta", store_meta_),
+          GenMetaSection("executor_meta", executor_meta_),
+          GenMetaSection("schema_meta", schema_meta_),
+          GenMetaSection("region_meta", region_meta_),
+          GenMetaSection("deleted_region_meta", deleted_region_meta_),
+          GenMetaSection("table_meta", table_meta_),
+          store_metrics_section,
+          GenMetaSection("table_metrics_meta", table_metrics_meta_),
+          GenMetaSection("store_operation_meta", store_operation_meta_),
+          GenMetaSection("executor_user_meta", executor_user_meta_),
+          GenMetaSection("task_list_meta", task_list_meta_),
+          GenMetaSection("index_meta", index_meta_),
+          GenMetaSection("index_metrics_meta", index_metrics_meta_)};
+}
+
+bool CoordinatorControl::SaveMetaToSnapshotFile(std::shared_ptr<Snapshot> snapshot, MetaSnapshotFileWriter& writer) {
+  DINGO_LOG(INFO) << "Coordinator start to SaveMetaToSnapshotFile";
+
+  for (const auto& section : GetMetaSections()) {
+    uint64_t count = 0;
+    butil::Status status;
+    bool ret = meta_reader_->Scan(snapshot, section.prefix, FLAGS_meta_snapshot_chunk_kv_count,
+                                  [&](std::vector<pb::common::KeyValue>& kvs) -> bool {
+                                    for (auto& kv : kvs) {
+                                      status = writer.Append(section.prefix, std::move(kv));
+                                      if (!status.ok()) {
+                                        return false;
+                                      }
+                                    }
+                                    count += kvs.size();
+                                    return true;
+                                  });
+    if (!ret || !status.ok()) {
+      DINGO_LOG(ERROR) << fmt::format("Snapshot {} failed, error: {}", section.name, status.error_cstr());
+      return false;
+    }
+    DINGO_LOG(INFO) << fmt::format("Snapshot {}, count={}", section.name, count);
+  }
+
+  return true;
+}
+
+bool CoordinatorControl::LoadMetaFromSnapshotFile(MetaSnapshotFileReader& reader) {
+  DINGO_LOG(INFO) << "Coordinator start to LoadMetaFromSnapshotFile by stream";
+
+  auto sections = GetMetaSections();
+  std::map<std::string, const MetaSection*> section_map;
+  for (const auto& section : sections) {
+    section.clear();
+    if (!meta_writer_->DeletePrefix(section.prefix)) {
+      DINGO_LOG(ERROR) << fmt::format("Coordinator delete {} range failed in LoadMetaFromSnapshotFile", section.name);
+      return false;
+    }
+    section_map[section.prefix] = &section;
+  }
+
+  // Chunk is bounded by count and bytes, so memory of load is bounded by one chunk.
+  pb::coordinator_internal::MetaSnapshotChunk chunk;
+  std::vector<pb::common::KeyValue> kvs;
+  do {
+    auto status = reader.Read(chunk);
+    if (!status.ok()) {
+      DINGO_LOG(ERROR) << "Read meta snapshot chunk failed, error: " << status.error_cstr();
+      return false;
+    }
+    if (chunk.kvs_size() == 0) {
+      continue;
+    }
+
+    auto it = section_map.find(chunk.prefix());
+    if (it == section_map.end()) {
+      DINGO_LOG(ERROR) << "Unknown meta snapshot chunk prefix: " << chunk.prefix();
+      return false;
+    }
+
+    kvs.clear();
+    kvs.reserve(chunk.kvs_size());
+    for (auto& kv : *chunk.mutable_kvs()) {
+      kvs.push_back(std::move(kv));
+    }
+    it->second->append(kvs);
+    if (!meta_writer_->Put(std::move(kvs))) {
+      DINGO_LOG(ERROR) << fmt::format("Coordinator write {} failed in LoadMetaFromSnapshotFile", it->second->name);
+      return false;
+    }
+  } while (!chunk.is_last());
+
+  DINGO_LOG(INFO) << "LoadSnapshot by stream, count=" << reader.KvCount();
+
+  RebuildTempMaps();
+
+  return true;
+}
+
 bool CoordinatorControl::LoadMetaFromSnapshotFile(pb::coordinator_internal::MetaSnapshotFile& meta_snapshot_file) {
   DINGO_LOG(INFO) << "Coordinator start to LoadMetaFromSnapshotFile";
 
@@ -753,6 +872,12 @@ bool CoordinatorControl::LoadMetaFromSnapshotFile(pb::coordinator_internal::Meta
   DINGO_LOG(INFO) << "LoadSnapshot index_metrics_meta, count=" << kvs.size();
   kvs.clear();
 
+  RebuildTempMaps();
+
+  return true;
+}
+
+void CoordinatorControl::RebuildTempMaps() {
   // init id_epoch_map_temp_
   // copy id_epoch_map_ to id_epoch_map_temp_
   {
@@ -807,8 +932,6 @@ bool CoordinatorControl::LoadMetaFromSnapshotFile(pb::coordinator_internal::Meta
   }
 
   DINGO_LOG(INFO) << "LoadSnapshot index_name_map_safe_temp, count=" << index_name_map_safe_temp_.Size();
-
-  return true;
 }
 
 void LogMetaIncrementSize(pb::coordinator_internal::MetaIncrement& meta_increment) {
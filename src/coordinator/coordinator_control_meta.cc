@@ -447,43 +447,31 @@ butil::Status CoordinatorControl::CreateTable(uint64_t schema_id, const pb::meta
     replica = 3;
   }
 
-  pb::common::IndexParameter index_parameter;
+  // create all regions in one pass, so ids are reserved by range and stores are selected once
+  std::vector<std::string> region_names;
+  std::vector<pb::common::Range> region_ranges;
+  region_names.reserve(range_partition.ranges_size());
+  region_ranges.reserve(range_partition.ranges_size());
   for (int i = 0; i < range_partition.ranges_size(); i++) {
-    // int ret = CreateRegion(const std::string &region_name, const std::string
-    // &resource_tag, int32_t replica_num, pb::common::Range region_range,
-    // uint64_t schema_id, uint64_t table_id, uint64_t &new_region_id)
-    std::string const region_name = std::string("T_") + std::to_string(schema_id) + std::string("_") +
-                                    table_definition.name() + std::string("_part_") + std::to_string(i);
-    uint64_t new_region_id = 0;
-
-    auto ret = CreateRegion(region_name, pb::common::RegionType::STORE_REGION, "", replica, range_partition.ranges(i),
-                            schema_id, new_table_id, 0, index_parameter, new_region_id, meta_increment);
-    if (!ret.ok()) {
-      DINGO_LOG(ERROR) << "CreateRegion failed in CreateTable table_name=" << table_definition.name();
-      break;
-    }
-
-    DINGO_LOG(INFO) << "CreateTable create region success, region_id=" << new_region_id;
-
-    new_region_ids.push_back(new_region_id);
+    region_names.push_back(std::string("T_") + std::to_string(schema_id) + std::string("_") + table_definition.name() +
+                           std::string("_part_") + std::to_string(i));
+    region_ranges.push_back(range_partition.ranges(i));
   }
 
-  if (new_region_ids.size() < range_partition.ranges_size()) {
-    DINGO_LOG(ERROR) << "Not enough regions is created, drop residual regions need=" << range_partition.ranges_size()
-                     << " created=" << new_region_ids.size();
-    for (auto region_id_to_delete : new_region_ids) {
-      auto ret = DropRegion(region_id_to_delete, meta_increment);
-      if (!ret.ok()) {
-        DINGO_LOG(ERROR) << "DropRegion failed in CreateTable table_name=" << table_definition.name()
-                         << " region_id =" << region_id_to_delete;
-      }
-    }
+  pb::common::IndexParameter index_parameter;
+  ret = CreateRegions(region_names, pb::common::RegionType::STORE_REGION, "", replica, region_ranges, schema_id,
+                      new_table_id, 0, index_parameter, new_region_ids, meta_increment);
+  if (!ret.ok()) {
+    DINGO_LOG(ERROR) << "CreateRegions failed in CreateTable table_name=" << table_definition.name()
+                     << " error: " << ret.error_str();
 
     // remove table_name from map
     table_name_map_safe_temp_.Erase(std::to_string(schema_id) + table_definition.name());
     return butil::Status(pb::error::Errno::ETABLE_REGION_CREATE_FAILED, "Not enough regions is created");
   }
 
+  DINGO_LOG(INFO) << "CreateTable create region success, region_count=" << new_region_ids.size();
+
   // bumper up EPOCH_REGION
   GetNextId(pb::coordinator_internal::IdEpochType::EPOCH_REGION, meta_increment);
 
@@ -699,43 +687,31 @@ butil::Status CoordinatorControl::CreateIndex(uint64_t schema_id, const pb::meta
   if (replica < 1) {
     replica = 3;
   }
-  for (int i = 0; i < range_partition.ranges_size(); i++) {
-    // int ret = CreateRegion(const std::string &region_name, const std::string
-    // &resource_tag, int32_t replica_num, pb::common::Range region_range,
-    // uint64_t schema_id, uint64_t index_id, uint64_t &new_region_id)
-    std::string const region_name = std::string("I_") + std::to_string(schema_id) + std::string("_") +
-                                    index_definition.name() + std::string("_part_") + std::to_string(i);
-    uint64_t new_region_id = 0;
-
-    auto ret =
-        CreateRegion(region_name, pb::common::RegionType::INDEX_REGION, "", replica, range_partition.ranges(i),
-                     schema_id, 0, new_index_id, index_definition.index_parameter(), new_region_id, meta_increment);
-    if (!ret.ok()) {
-      DINGO_LOG(ERROR) << "CreateRegion failed in CreateIndex index_name=" << index_definition.name();
-      break;
-    }
 
-    DINGO_LOG(INFO) << "CreateIndex create region success, region_id=" << new_region_id;
-
-    new_region_ids.push_back(new_region_id);
+  // create all regions in one pass, so ids are reserved by range and stores are selected once
+  std::vector<std::string> region_names;
+  std::vector<pb::common::Range> region_ranges;
+  region_names.reserve(range_partition.ranges_size());
+  region_ranges.reserve(range_partition.ranges_size());
+  for (int i = 0; i < range_partition.ranges_size(); i++) {
+    region_names.push_back(std::string("I_") + std::to_string(schema_id) + std::string("_") + index_definition.name() +
+                           std::string("_part_") + std::to_string(i));
+    region_ranges.push_back(range_partition.ranges(i));
   }
 
-  if (new_region_ids.size() < range_partition.ranges_size()) {
-    DINGO_LOG(ERROR) << "Not enough regions is created, drop residual regions need=" << range_partition.ranges_size()
-                     << " created=" << new_region_ids.size();
-    for (auto region_id_to_delete : new_region_ids) {
-      auto ret = DropRegion(region_id_to_delete, meta_increment);
-      if (!ret.ok()) {
-        DINGO_LOG(ERROR) << "DropRegion failed in CreateIndex index_name=" << index_definition.name()
-                         << " region_id =" << region_id_to_delete;
-      }
-    }
+  auto ret = CreateRegions(region_names, pb::common::RegionType::INDEX_REGION, "", replica, region_ranges, schema_id, 0,
+                           new_index_id, index_definition.index_parameter(), new_region_ids, meta_increment);
+  if (!ret.ok()) {
+    DINGO_LOG(ERROR) << "CreateRegions failed in CreateIndex index_name=" << index_definition.name()
+                     << " error: " << ret.error_str();
 
     // remove index_name from map
     index_name_map_safe_temp_.Erase(std::to_string(schema_id) + index_definition.name());
     return butil::Status(pb::error::Errno::EINDEX_REGION_CREATE_FAILED, "Not enough regions is created");
   }
 
+  DINGO_LOG(INFO) << "CreateIndex create region success, region_count=" << new_region_ids.size();
+
   // bumper up EPOCH_REGION
   GetNextId(pb::coordinator_internal::IdEpochType::EPOCH_REGION, meta_increment);
 
@@ -85,6 +85,17 @@ class DingoSafeIdEpochMap : public DingoSafeIdEpochMapBase {
     }
   }
 
+  // Reserve count continuous ids, out: end_id is the last reserved id, ids are [end_id - count + 1, end_id]
+  int GetNextIds(const uint64_t &key, uint32_t count, uint64_t &end_id) {
+    IdRange range{count, 0};
+    if (safe_map.Modify(InnerGetNextIds, key, range) > 0) {
+      end_id = range.end_id;
+      return 1;
+    } else {
+      return -1;
+    }
+  }
+
   int UpdatePresentId(const uint64_t &key, const uint64_t &value) {
     if (safe_map.Modify(InnerUpdatePresentId, key, value) > 0) {
       return 1;
@@ -94,6 +105,32 @@ class DingoSafeIdEpochMap : public DingoSafeIdEpochMapBase {
   }
 
  private:
+  struct IdRange {
+    uint32_t count;
+    uint64_t end_id;
+  };
+
+  static size_t InnerGetNextIds(TypeFlatMap &map, const uint64_t &key, const IdRange &range) {
+    // Same as InnerGetNextId, Modify is called on both buffers, count must not be changed
+    auto &range_mod = const_cast<IdRange &>(range);
+
+    auto *value_ptr = map.seek(key);
+    if (value_ptr == nullptr) {
+      pb::coordinator_internal::IdEpochInternal new_value;
+      new_value.set_id(key);
+      new_value.set_value(COORDINATOR_ID_OF_MAP_MIN + range.count);
+      map.insert(key, new_value);
+
+      range_mod.end_id = new_value.value();
+    } else {
+      value_ptr->set_value(value_ptr->value() + range.count);
+
+      range_mod.end_id = value_ptr->value();
+    }
+
+    return 1;
+  }
+
   static size_t InnerGetNextId(TypeFlatMap &map, const uint64_t &key, const uint64_t &value) {
     // Notice: The brpc's template restrict to return value in Modify process, but we need to do this, so use a
     // const_cast to modify the input parameter here
@@ -234,6 +234,7 @@ butil::Status AggregationManager::Open(
 
   size_t i = 0;
   aggregation_functions_.reserve(aggregation_operators.size());
+  merge_functions_.reserve(aggregation_operators.size());
   for (const auto& aggregation_operator : aggregation_operators) {
     int32_t index = aggregation_operator.index_of_column();
     const auto& oper = aggregation_operator.oper();
@@ -243,7 +244,7 @@ butil::Status AggregationManager::Open(
       case pb::store::AggregationType::SUM0:
         [[fallthrough]];
       case pb::store::AggregationType::SUM: {
-        status = AddSumFunction(serial_schema_type, result_schema_type);
+        status = AddSumFunction(serial_schema_type, result_schema_type, &aggregation_functions_);
         if (!status.ok()) {
           DINGO_LOG(ERROR) << fmt::format(
               "AddSumFunction failed index : {} serial_schema_type : {} result_schema_type : {}", index,
@@ -284,7 +285,7 @@ butil::Status AggregationManager::Open(
         break;
       }
       case pb::store::AggregationType::MAX: {
-        status = AddMaxFunction(serial_schema_type, result_schema_type);
+        status = AddMaxFunction(serial_schema_type, result_schema_type, &aggregation_functions_);
         if (!status.ok()) {
           DINGO_LOG(ERROR) << fmt::format(
               "AddMaxFunction failed index : {} serial_schema_type : {} result_schema_type : {}", index,
@@ -294,7 +295,7 @@ butil::Status AggregationManager::Open(
         break;
       }
       case pb::store::AggregationType::MIN: {
-        status = AddMinFunction(serial_schema_type, result_schema_type);
+        status = AddMinFunction(serial_schema_type, result_schema_type, &aggregation_functions_);
         if (!status.ok()) {
           DINGO_LOG(ERROR) << fmt::format(
               "AddMinFunction failed index : {} serial_schema_type : {} result_schema_type : {}", index,
@@ -311,40 +312,248 @@ butil::Status AggregationManager::Open(
         return butil::Status(pb::error::ENOT_SUPPORT, error_message);
       }
     }
+
+    status = AddMergeFunction(oper, result_schema_type);
+    if (!status.ok()) {
+      DINGO_LOG(ERROR) << fmt::format("AddMergeFunction failed index : {} oper : {} result_schema_type : {}", index,
+                                      static_cast<int>(oper), BaseSchema::GetTypeString(result_schema_type));
+      return status;
+    }
     i++;
   }
 
   return butil::Status();
 }
 
+butil::Status AggregationManager::GetAggregation(const std::string& group_by_key,
+                                                 std::shared_ptr<Aggregation>* aggregation) {
+  if (!aggregations_) {
+    using MapType = std::map<std::string, std::shared_ptr<Aggregation>>;
+    aggregations_ = std::make_shared<MapType>();
+  }
+
+  const auto& iter = aggregations_->find(group_by_key);
+  if (iter != aggregations_->end()) {
+    *aggregation = iter->second;
+    return butil::Status();
+  }
+
+  const auto& [iter_new, _] = aggregations_->emplace(group_by_key, std::make_shared<Aggregation>());
+  *aggregation = iter_new->second;
+
+  size_t start_aggregation_operators_index = result_serial_schemas_->size() - group_by_operator_serial_schemas_->size();
+  butil::Status status =
+      (*aggregation)->Open(start_aggregation_operators_index, result_serial_schemas_, aggregation_operators_);
+  if (!status.ok()) {
+    DINGO_LOG(ERROR) << fmt::format("Aggregation::Open failed");
+    return status;
+  }
+
+  return butil::Status();
+}
+
 butil::Status AggregationManager::Execute(const std::string& group_by_key,
                                           const std::vector<std::any>& group_by_operator_record) {
-  butil::Status status;
   std::shared_ptr<Aggregation> aggregation;
+  butil::Status status = GetAggregation(group_by_key, &aggregation);
+  if (!status.ok()) {
+    return status;
+  }
+
+  status = aggregation->Execute(aggregation_functions_, group_by_operator_record);
+  if (!status.ok()) {
+    DINGO_LOG(ERROR) << fmt::format("Aggregation::Execute failed");
+    return status;
+  }
+
+  return butil::Status();
+}
+
+butil::Status AggregationManager::Merge(const std::shared_ptr<AggregationManager>& other) {
+  if (!other || !other->aggregations_) {
+    return butil::Status();
+  }
 
   if (!aggregations_) {
     using MapType = std::map<std::string, std::shared_ptr<Aggregation>>;
     aggregations_ = std::make_shared<MapType>();
   }
 
-  const auto& iter = aggregations_->find(group_by_key);
-  if (iter == aggregations_->end()) {
-    const auto& [iter_new, _] = aggregations_->emplace(group_by_key, std::make_shared<Aggregation>());
-    aggregation = iter_new->second;
+  for (const auto& [group_by_key, other_aggregation] : *other->aggregations_) {
+    const auto& iter = aggregations_->find(group_by_key);
+    if (iter == aggregations_->end()) {
+      aggregations_->emplace(group_by_key, other_aggregation);
+      continue;
+    }
 
-    status = aggregation->Open(result_serial_schemas_->size() - group_by_operator_serial_schemas_->size(),
-                               result_serial_schemas_, aggregation_operators_);
+    butil::Status status = iter->second->Execute(merge_functions_, *other_aggregation->GetResult());
     if (!status.ok()) {
-      DINGO_LOG(ERROR) << fmt::format("Aggregation::Open failed");
+      DINGO_LOG(ERROR) << fmt::format("Aggregation::Execute merge failed");
       return status;
     }
-  } else {
-    aggregation = iter->second;
   }
 
-  status = aggregation->Execute(aggregation_functions_, group_by_operator_record);
+  return butil::Status();
+}
+
+butil::Status AggregationManager::SerializePartialStates(const std::vector<std::any>& result_record,
+                                                         std::string* output) {
+  size_t start_aggregation_operators_index = result_serial_schemas_->size() - aggregation_operators_.size();
+
+  pb::store::AggregationPartialStates partial_states;
+  for (size_t i = 0; i < result_record.size(); i++) {
+    auto type = (*result_serial_schemas_)[i + start_aggregation_operators_index]->GetType();
+    const auto& column = result_record[i];
+    auto* state = partial_states.add_states();
+    try {
+      switch (type) {
+        case BaseSchema::Type::kBool: {
+          const auto& value = std::any_cast<const std::optional<bool>&>(column);
+          if (value.has_value()) {
+            state->set_bool_value(value.value());
+          }
+          break;
+        }
+        case BaseSchema::Type::kInteger: {
+          const auto& value = std::any_cast<const std::optional<int32_t>&>(column);
+          if (value.has_value()) {
+            state->set_int_value(value.value());
+          }
+          break;
+        }
+        case BaseSchema::Type::kFloat: {
+          const auto& value = std::any_cast<const std::optional<float>&>(column);
+          if (value.has_value()) {
+            state->set_float_value(value.value());
+          }
+          break;
+        }
+        case BaseSchema::Type::kLong: {
+          const auto& value = std::any_cast<const std::optional<int64_t>&>(column);
+          if (value.has_value()) {
+            state->set_long_value(value.value());
+          }
+          break;
+        }
+        case BaseSchema::Type::kDouble: {
+          const auto& value = std::any_cast<const std::optional<double>&>(column);
+          if (value.has_value()) {
+            state->set_double_value(value.value());
+          }
+          break;
+        }
+        case BaseSchema::Type::kString: {
+          const auto& value = std::any_cast<const std::optional<std::shared_ptr<std::string>>&>(column);
+          if (value.has_value() && value.value() != nullptr) {
+            state->set_string_value(*value.value());
+          }
+          break;
+        }
+        default: {
+          std::string error_message = fmt::format("unsupported partial state type: {}", static_cast<int>(type));
+          DINGO_LOG(ERROR) << error_message;
+          return butil::Status(pb::error::ENOT_SUPPORT, error_message);
+        }
+      }
+    } catch (const std::exception& my_exception) {
+      std::string error_message =
+          fmt::format("SerializePartialStates index : {} exception : {}", i, my_exception.what());
+      DINGO_LOG(ERROR) << error_message;
+      return butil::Status(pb::error::EILLEGAL_PARAMTETERS, error_message);
+    }
+  }
+
+  if (!partial_states.SerializeToString(output)) {
+    return butil::Status(pb::error::EINTERNAL, "Serialize partial states failed");
+  }
+
+  return butil::Status();
+}
+
+butil::Status AggregationManager::MergePartialStates(const std::string& group_by_key, const std::string& input) {
+  pb::store::AggregationPartialStates partial_states;
+  if (!partial_states.ParseFromString(input)) {
+    return butil::Status(pb::error::EILLEGAL_PARAMTETERS, "Parse partial states failed");
+  }
+  if (partial_states.states_size() != aggregation_operators_.size()) {
+    std::string error_message = fmt::format("partial states size : {} unequal aggregation_operators size : {}",
+                                            partial_states.states_size(), aggregation_operators_.size());
+    DINGO_LOG(ERROR) << error_message;
+    return butil::Status(pb::error::EILLEGAL_PARAMTETERS, error_message);
+  }
+
+  size_t start_aggregation_operators_index = result_serial_schemas_->size() - aggregation_operators_.size();
+
+  std::vector<std::any> partial_record;
+  partial_record.reserve(partial_states.states_size());
+  for (int i = 0; i < partial_states.states_size(); i++) {
+    auto type = (*result_serial_schemas_)[i + start_aggregation_operators_index]->GetType();
+    const auto& state = partial_states.states(i);
+    bool is_null = state.value_case() == pb::store::AggregationState::VALUE_NOT_SET;
+
+    pb::store::AggregationState::ValueCase expect_value_case;
+    switch (type) {
+      case BaseSchema::Type::kBool: {
+        expect_value_case = pb::store::AggregationState::kBoolValue;
+        partial_record.emplace_back(is_null ? std::optional<bool>(std::nullopt)
+                                            : std::optional<bool>(state.bool_value()));
+        break;
+      }
+      case BaseSchema::Type::kInteger: {
+        expect_value_case = pb::store::AggregationState::kIntValue;
+        partial_record.emplace_back(is_null ? std::optional<int32_t>(std::nullopt)
+                                            : std::optional<int32_t>(state.int_value()));
+        break;
+      }
+      case BaseSchema::Type::kFloat: {
+        expect_value_case = pb::store::AggregationState::kFloatValue;
+        partial_record.emplace_back(is_null ? std::optional<float>(std::nullopt)
+                                            : std::optional<float>(state.float_value()));
+        break;
+      }
+      case BaseSchema::Type::kLong: {
+        expect_value_case = pb::store::AggregationState::kLongValue;
+        partial_record.emplace_back(is_null ? std::optional<int64_t>(std::nullopt)
+                                            : std::optional<int64_t>(state.long_value()));
+        break;
+      }
+      case BaseSchema::Type::kDouble: {
+        expect_value_case = pb::store::AggregationState::kDoubleValue;
+        partial_record.emplace_back(is_null ? std::optional<double>(std::nullopt)
+                                            : std::optional<double>(state.double_value()));
+        break;
+      }
+      case BaseSchema::Type::kString: {
+        expect_value_case = pb::store::AggregationState::kStringValue;
+        partial_record.emplace_back(
+            is_null ? std::optional<std::shared_ptr<std::string>>(std::nullopt)
+                    : std::optional<std::shared_ptr<std::string>>(std::make_shared<std::string>(state.string_value())));
+        break;
+      }
+      default: {
+        std::string error_message = fmt::format("unsupported partial state type: {}", static_cast<int>(type));
+        DINGO_LOG(ERROR) << error_message;
+        return butil::Status(pb::error::ENOT_SUPPORT, error_message);
+      }
+    }
+
+    if (!is_null && state.value_case() != expect_value_case) {
+      std::string error_message = fmt::format("partial state index : {} value case : {} mismatch type : {}", i,
+                                              static_cast<int>(state.value_case()), BaseSchema::GetTypeString(type));
+      DINGO_LOG(ERROR) << error_message;
+      return butil::Status(pb::error::EILLEGAL_PARAMTETERS, error_message);
+    }
+  }
+
+  std::shared_ptr<Aggregation> aggregation;
+  butil::Status status = GetAggregation(group_by_key, &aggregation);
   if (!status.ok()) {
-    DINGO_LOG(ERROR) << fmt::format("Aggregation::Execute failed");
+    return status;
+  }
+
+  status = aggregation->Execute(merge_functions_, partial_record);
+  if (!status.ok()) {
+    DINGO_LOG(ERROR) << fmt::format("Aggregation::Execute merge failed");
     return status;
   }
 
@@ -363,6 +572,7 @@ void AggregationManager::Close() {
   }
 
   aggregation_functions_.clear();
+  merge_functions_.clear();
 
   if (aggregations_) {
     aggregations_.reset();
@@ -378,18 +588,19 @@ std::shared_ptr<AggregationIterator> AggregationManager::CreateIterator() {
   return std::make_shared<AggregationIterator>(aggregations_);
 }
 
-butil::Status AggregationManager::AddSumFunction(BaseSchema::Type serial_schema_type,
-                                                 BaseSchema::Type result_schema_type) {
+butil::Status AggregationManager::AddSumFunction(
+    BaseSchema::Type serial_schema_type, BaseSchema::Type result_schema_type,
+    std::vector<std::function<bool(const std::any&, std::any*)>>* functions) {
   if (serial_schema_type == BaseSchema::kBool && result_schema_type == BaseSchema::kBool) {
-    aggregation_functions_.emplace_back(SUM<bool, bool>());
+    functions->emplace_back(SUM<bool, bool>());
   } else if (serial_schema_type == BaseSchema::kInteger && result_schema_type == BaseSchema::kInteger) {
-    aggregation_functions_.emplace_back(SUM<int32_t, int32_t>());
+    functions->emplace_back(SUM<int32_t, int32_t>());
   } else if (serial_schema_type == BaseSchema::kFloat && result_schema_type == BaseSchema::kFloat) {
-    aggregation_functions_.emplace_back(SUM<float, float>());
+    functions->emplace_back(SUM<float, float>());
   } else if (serial_schema_type == BaseSchema::kLong && result_schema_type == BaseSchema::kLong) {
-    aggregation_functions_.emplace_back(SUM<int64_t, int64_t>());
+    functions->emplace_back(SUM<int64_t, int64_t>());
   } else if (serial_schema_type == BaseSchema::kDouble && result_schema_type == BaseSchema::kDouble) {
-    aggregation_functions_.emplace_back(SUM<double, double>());
+    functions->emplace_back(SUM<double, double>());
   } else {
     std::string error_message =
         fmt::format("SUM<{},{}>  not support yet", BaseSchema::GetTypeString(serial_schema_type),
@@ -447,20 +658,21 @@ butil::Status AggregationManager::AddCountWithNullFunction(BaseSchema::Type seri
   }
   return butil::Status();
 }
-butil::Status AggregationManager::AddMaxFunction(BaseSchema::Type serial_schema_type,
-                                                 BaseSchema::Type result_schema_type) {
+butil::Status AggregationManager::AddMaxFunction(
+    BaseSchema::Type serial_schema_type, BaseSchema::Type result_schema_type,
+    std::vector<std::function<bool(const std::any&, std::any*)>>* functions) {
   if (serial_schema_type == BaseSchema::kBool && result_schema_type == BaseSchema::kBool) {
-    aggregation_functions_.emplace_back(MAX<bool, bool>());
+    functions->emplace_back(MAX<bool, bool>());
   } else if (serial_schema_type == BaseSchema::kInteger && result_schema_type == BaseSchema::kInteger) {
-    aggregation_functions_.emplace_back(MAX<int32_t, int32_t>());
+    functions->emplace_back(MAX<int32_t, int32_t>());
   } else if (serial_schema_type == BaseSchema::kFloat && result_schema_type == BaseSchema::kFloat) {
-    aggregation_functions_.emplace_back(MAX<float, float>());
+    functions->emplace_back(MAX<float, float>());
   } else if (serial_schema_type == BaseSchema::kLong && result_schema_type == BaseSchema::kLong) {
-    aggregation_functions_.emplace_back(MAX<int64_t, int64_t>());
+    functions->emplace_back(MAX<int64_t, int64_t>());
   } else if (serial_schema_type == BaseSchema::kDouble && result_schema_type == BaseSchema::kDouble) {
-    aggregation_functions_.emplace_back(MAX<double, double>());
+    functions->emplace_back(MAX<double, double>());
   } else if (serial_schema_type == BaseSchema::kString && result_schema_type == BaseSchema::kString) {
-    aggregation_functions_.emplace_back(MAX<std::shared_ptr<std::string>, std::shared_ptr<std::string>>());
+    functions->emplace_back(MAX<std::shared_ptr<std::string>, std::shared_ptr<std::string>>());
   } else {
     std::string error_message =
         fmt::format("COUNTWITHNULL<{},{}>  not support yet", BaseSchema::GetTypeString(serial_schema_type),
@@ -470,20 +682,21 @@ butil::Status AggregationManager::AddMaxFunction(BaseSchema::Type serial_schema_
   }
   return butil::Status();
 }
-butil::Status AggregationManager::AddMinFunction(BaseSchema::Type serial_schema_type,
-                                                 BaseSchema::Type result_schema_type) {
+butil::Status AggregationManager::AddMinFunction(
+    BaseSchema::Type serial_schema_type, BaseSchema::Type result_schema_type,
+    std::vector<std::function<bool(const std::any&, std::any*)>>* functions) {
   if (serial_schema_type == BaseSchema::kBool && result_schema_type == BaseSchema::kBool) {
-    aggregation_functions_.emplace_back(MIN<bool, bool>());
+    functions->emplace_back(MIN<bool, bool>());
   } else if (serial_schema_type == BaseSchema::kInteger && result_schema_type == BaseSchema::kInteger) {
-    aggregation_functions_.emplace_back(MIN<int32_t, int32_t>());
+    functions->emplace_back(MIN<int32_t, int32_t>());
   } else if (serial_schema_type == BaseSchema::kFloat && result_schema_type == BaseSchema::kFloat) {
-    aggregation_functions_.emplace_back(MIN<float, float>());
+    functions->emplace_back(MIN<float, float>());
   } else if (serial_schema_type == BaseSchema::kLong && result_schema_type == BaseSchema::kLong) {
-    aggregation_functions_.emplace_back(MIN<int64_t, int64_t>());
+    functions->emplace_back(MIN<int64_t, int64_t>());
   } else if (serial_schema_type == BaseSchema::kDouble && result_schema_type == BaseSchema::kDouble) {
-    aggregation_functions_.emplace_back(MIN<double, double>());
+    functions->emplace_back(MIN<double, double>());
   } else if (serial_schema_type == BaseSchema::kString && result_schema_type == BaseSchema::kString) {
-    aggregation_functions_.emplace_back(MIN<std::shared_ptr<std::string>, std::shared_ptr<std::string>>());
+    functions->emplace_back(MIN<std::shared_ptr<std::string>, std::shared_ptr<std::string>>());
   } else {
     std::string error_message =
         fmt::format("COUNTWITHNULL<{},{}>  not support yet", BaseSchema::GetTypeString(serial_schema_type),
@@ -494,4 +707,27 @@ butil::Status AggregationManager::AddMinFunction(BaseSchema::Type serial_schema_
   return butil::Status();
 }
 
+butil::Status AggregationManager::AddMergeFunction(pb::store::AggregationType oper,
+                                                   BaseSchema::Type result_schema_type) {
+  switch (oper) {
+    case pb::store::AggregationType::SUM0:
+      [[fallthrough]];
+    case pb::store::AggregationType::SUM:
+      [[fallthrough]];
+    case pb::store::AggregationType::COUNT:
+      [[fallthrough]];
+    case pb::store::AggregationType::COUNTWITHNULL:
+      return AddSumFunction(result_schema_type, result_schema_type, &merge_functions_);
+    case pb::store::AggregationType::MAX:
+      return AddMaxFunction(result_schema_type, result_schema_type, &merge_functions_);
+    case pb::store::AggregationType::MIN:
+      return AddMinFunction(result_schema_type, result_schema_type, &merge_functions_);
+    default: {
+      std::string error_message = fmt::format("merge oper: {} not support yet", static_cast<int>(oper));
+      DINGO_LOG(ERROR) << error_message;
+      return butil::Status(pb::error::ENOT_SUPPORT, error_message);
+    }
+  }
+}
+
 }  // namespace dingodb
@@ -65,21 +65,39 @@ class AggregationManager {
 
   butil::Status Execute(const std::string& group_by_key, const std::vector<std::any>& group_by_operator_record);
 
+  // Merge partial aggregations of other, which aggregate the same coprocessor on other rows.
+  // Aggregations of other are taken over, other can not be used anymore.
+  butil::Status Merge(const std::shared_ptr<AggregationManager>& other);
+
+  // Serialize partial aggregation result of one group to pb::store::AggregationPartialStates.
+  butil::Status SerializePartialStates(const std::vector<std::any>& result_record, std::string* output);
+  // Merge serialized partial states of group_by_key, which are output by other coprocessor.
+  butil::Status MergePartialStates(const std::string& group_by_key, const std::string& input);
+
   std::shared_ptr<AggregationIterator> CreateIterator();
 
   void Close();
 
  private:
-  butil::Status AddSumFunction(BaseSchema::Type serial_schema_type, BaseSchema::Type result_schema_type);
+  // Get aggregation of group_by_key, open a new one if not exist.
+  butil::Status GetAggregation(const std::string& group_by_key, std::shared_ptr<Aggregation>* aggregation);
+
+  butil::Status AddSumFunction(BaseSchema::Type serial_schema_type, BaseSchema::Type result_schema_type,
+                               std::vector<std::function<bool(const std::any&, std::any*)>>* functions);
   butil::Status AddCountFunction(BaseSchema::Type serial_schema_type, BaseSchema::Type result_schema_type);
   butil::Status AddCountWithNullFunction(BaseSchema::Type serial_schema_type, BaseSchema::Type result_schema_type);
-  butil::Status AddMaxFunction(BaseSchema::Type serial_schema_type, BaseSchema::Type result_schema_type);
-  butil::Status AddMinFunction(BaseSchema::Type serial_schema_type, BaseSchema::Type result_schema_type);
+  butil::Status AddMaxFunction(BaseSchema::Type serial_schema_type, BaseSchema::Type result_schema_type,
+                               std::vector<std::function<bool(const std::any&, std::any*)>>* functions);
+  butil::Status AddMinFunction(BaseSchema::Type serial_schema_type, BaseSchema::Type result_schema_type,
+                               std::vector<std::function<bool(const std::any&, std::any*)>>* functions);
+  // Merge partial result into result, e.g. COUNT partial results are merged by SUM.
+  butil::Status AddMergeFunction(pb::store::AggregationType oper, BaseSchema::Type result_schema_type);
 
   std::shared_ptr<std::vector<std::shared_ptr<BaseSchema>>> group_by_operator_serial_schemas_;
   ::google::protobuf::RepeatedPtrField<pb::store::AggregationOperator> aggregation_operators_;
   std::shared_ptr<std::vector<std::shared_ptr<BaseSchema>>> result_serial_schemas_;
   std::vector<std::function<bool(const std::any&, std::any*)>> aggregation_functions_;
+  std::vector<std::function<bool(const std::any&, std::any*)>> merge_functions_;
   std::shared_ptr<std::map<std::string, std::shared_ptr<Aggregation>>> aggregations_;
 };
 
@@ -23,6 +23,8 @@
 #include <utility>
 #include <vector>
 
+#include "bthread/bthread.h"
+#include "bthread/countdown_event.h"
 #include "common/logging.h"
 #include "coprocessor/utils.h"
 #include "fmt/core.h"
@@ -36,7 +38,7 @@
 
 namespace dingodb {
 
-Coprocessor::Coprocessor() : enable_expression_(true), end_of_group_by_(true) {}
+Coprocessor::Coprocessor() : enable_expression_(true), end_of_group_by_(true), is_aggregated_(false) {}
 Coprocessor::~Coprocessor() { Close(); }
 
 butil::Status Coprocessor::Open(const pb::store::Coprocessor& coprocessor) {
@@ -160,7 +162,7 @@ butil::Status Coprocessor::Execute(const std::shared_ptr<EngineIterator>& iter,
   DINGO_LOG(DEBUG) << fmt::format("Coprocessor::Execute Enter");
   ScanFilter scan_filter = ScanFilter(key_only, max_fetch_cnt, max_bytes_rpc);
   butil::Status status;
-  while (iter->HasNext()) {
+  while (!is_aggregated_ && iter->HasNext()) {
     pb::common::KeyValue key_value;
     iter->GetKV(*key_value.mutable_key(), *key_value.mutable_value());
     bool has_result_kv = false;
@@ -196,6 +198,136 @@ butil::Status Coprocessor::Execute(const std::shared_ptr<EngineIterator>& iter,
 
   return status;
 }
+
+butil::Status Coprocessor::ExecuteParallel(const std::shared_ptr<RawEngine::Reader>& reader,
+                                           const std::shared_ptr<Snapshot>& snapshot,
+                                           const std::vector<pb::common::Range>& ranges) {
+  struct SubTask {
+    std::shared_ptr<Coprocessor> coprocessor;
+    std::shared_ptr<EngineIterator> iter;
+    butil::Status status;
+    bthread::CountdownEvent* event;
+  };
+
+  bthread::CountdownEvent event(static_cast<int>(ranges.size()));
+  std::vector<SubTask> tasks(ranges.size());
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    auto& task = tasks[i];
+    task.coprocessor = std::make_shared<Coprocessor>();
+    butil::Status status = task.coprocessor->Open(coprocessor_);
+    if (!status.ok()) {
+      DINGO_LOG(ERROR) << fmt::format("Coprocessor::Open sub coprocessor failed");
+      return status;
+    }
+    task.iter = reader->NewIterator(snapshot, ranges[i].start_key(), ranges[i].end_key());
+    if (!task.iter) {
+      DINGO_LOG(ERROR) << fmt::format("RawEngine::Reader::NewIterator failed");
+      return butil::Status(pb::error::EINTERNAL, "Internal error : create iter failed");
+    }
+    task.event = &event;
+  }
+
+  auto run_task = [](void* arg) -> void* {
+    auto* task = static_cast<SubTask*>(arg);
+    task->status = task->coprocessor->Aggregate(task->iter);
+    task->event->signal();
+    return nullptr;
+  };
+  for (auto& task : tasks) {
+    bthread_t tid;
+    if (bthread_start_background(&tid, nullptr, run_task, &task) != 0) {
+      run_task(&task);
+    }
+  }
+  event.wait();
+
+  for (auto& task : tasks) {
+    if (!task.status.ok()) {
+      return task.status;
+    }
+    butil::Status status = Merge(task.coprocessor);
+    if (!status.ok()) {
+      return status;
+    }
+  }
+  is_aggregated_ = true;
+
+  return butil::Status();
+}
+
+butil::Status Coprocessor::MergePartialAggregation(const std::vector<pb::common::KeyValue>& partial_kvs) {
+  if (!end_of_group_by_) {
+    return butil::Status(pb::error::EILLEGAL_PARAMTETERS, "Not aggregation coprocessor");
+  }
+
+  butil::Status status = InitAggregationManager();
+  if (!status.ok()) {
+    return status;
+  }
+
+  for (const auto& kv : partial_kvs) {
+    status = aggregation_manager_->MergePartialStates(kv.key(), kv.value());
+    if (!status.ok()) {
+      DINGO_LOG(ERROR) << fmt::format("AggregationManager::MergePartialStates failed");
+      return status;
+    }
+  }
+
+  return butil::Status();
+}
+
+butil::Status Coprocessor::Aggregate(const std::shared_ptr<EngineIterator>& iter) {
+  iter->Start();
+  while (iter->HasNext()) {
+    pb::common::KeyValue key_value;
+    iter->GetKV(*key_value.mutable_key(), *key_value.mutable_value());
+    bool has_result_kv = false;
+    pb::common::KeyValue result_key_value;
+    butil::Status status = DoExecute(key_value, &has_result_kv, &result_key_value);
+    if (!status.ok()) {
+      DINGO_LOG(ERROR) << fmt::format("Coprocessor::Aggregate failed");
+      return status;
+    }
+    iter->Next();
+  }
+
+  return butil::Status();
+}
+
+butil::Status Coprocessor::Merge(const std::shared_ptr<Coprocessor>& other) {
+  if (!other->aggregation_manager_) {
+    return butil::Status();
+  }
+
+  butil::Status status = InitAggregationManager();
+  if (!status.ok()) {
+    return status;
+  }
+
+  status = aggregation_manager_->Merge(other->aggregation_manager_);
+  if (!status.ok()) {
+    DINGO_LOG(ERROR) << fmt::format("AggregationManager::Merge failed");
+    return status;
+  }
+
+  return butil::Status();
+}
+
+butil::Status Coprocessor::InitAggregationManager() {
+  if (aggregation_manager_) {
+    return butil::Status();
+  }
+
+  aggregation_manager_ = std::make_shared<AggregationManager>();
+  butil::Status status = aggregation_manager_->Open(
+      group_by_operator_serial_schemas_, coprocessor_.aggregation_operators(), result_serial_schemas_sorted_);
+  if (!status.ok()) {
+    DINGO_LOG(ERROR) << fmt::format("AggregationManager::Open failed");
+    return status;
+  }
+
+  return butil::Status();
+}
 butil::Status Coprocessor::DoExecute(const pb::common::KeyValue& kv, bool* has_result_kv,
                                      pb::common::KeyValue* result_kv) {
   butil::Status status;
@@ -362,14 +494,9 @@ butil::Status Coprocessor::DoExecuteForAggregation(const std::vector<std::any>&
 
   Utils::DebugGroupByKey(group_by_key, "group_by_key");
 
-  if (!aggregation_manager_) {
-    aggregation_manager_ = std::make_shared<AggregationManager>();
-    status = aggregation_manager_->Open(group_by_operator_serial_schemas_, coprocessor_.aggregation_operators(),
-                                        result_serial_schemas_sorted_);
-    if (!status.ok()) {
-      DINGO_LOG(ERROR) << fmt::format("AggregationManager::Open failed");
-      return status;
-    }
+  status = InitAggregationManager();
+  if (!status.ok()) {
+    return status;
   }
 
   status = aggregation_manager_->Execute(group_by_key, group_by_operator_record);
@@ -425,6 +552,26 @@ butil::Status Coprocessor::GetKeyValueFromAggregation(bool key_only, size_t max_
       const std::string& key = aggregation_iterator_->GetKey();
       const std::shared_ptr<std::vector<std::any>>& value = aggregation_iterator_->GetValue();
 
+      if (coprocessor_.partial_aggregation()) {
+        pb::common::KeyValue partial_key_value;
+        partial_key_value.set_key(key);
+        if (!key_only) {
+          status = aggregation_manager_->SerializePartialStates(*value, partial_key_value.mutable_value());
+          if (!status.ok()) {
+            DINGO_LOG(ERROR) << fmt::format("AggregationManager::SerializePartialStates failed");
+            return status;
+          }
+        }
+
+        kvs->emplace_back(partial_key_value);
+
+        aggregation_iterator_->Next();
+        if (scan_filter.UptoLimit(partial_key_value)) {
+          return butil::Status();
+        }
+        continue;
+      }
+
       std::vector<std::any> result_key_record;
       int ret = 0;
       if (group_by_key_serial_schemas_ && !group_by_key_serial_schemas_->empty()) {
@@ -540,6 +687,7 @@ void Coprocessor::Close() {
 
   enable_expression_ = false;
   end_of_group_by_ = false;
+  is_aggregated_ = false;
 
   if (aggregation_manager_) {
     aggregation_manager_.reset();
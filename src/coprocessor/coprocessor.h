@@ -44,6 +44,22 @@ class Coprocessor {
 
   butil::Status Execute(const std::shared_ptr<EngineIterator>& iter, bool key_only, size_t max_fetch_cnt,
                         uint64_t max_bytes_rpc, std::vector<pb::common::KeyValue>* kvs);
+
+  bool HasAggregation() const { return end_of_group_by_; }
+
+  // Aggregate sub ranges of snapshot in parallel bthreads, each sub range with its own coprocessor, then merge the
+  // partial aggregations. After that Execute only output aggregation result, iter is not consumed.
+  butil::Status ExecuteParallel(const std::shared_ptr<RawEngine::Reader>& reader,
+                                const std::shared_ptr<Snapshot>& snapshot,
+                                const std::vector<pb::common::Range>& ranges);
+
+  // Merge partial aggregation kvs output by coprocessors with partial_aggregation, e.g. of other regions.
+  butil::Status MergePartialAggregation(const std::vector<pb::common::KeyValue>& partial_kvs);
+
+  // Output aggregation result, partial states if partial_aggregation, continue from last output.
+  butil::Status GetKeyValueFromAggregation(bool key_only, size_t max_fetch_cnt, uint64_t max_bytes_rpc,
+                                           std::vector<pb::common::KeyValue>* kvs);
+
   void Close();
 
  private:
@@ -51,10 +67,13 @@ class Coprocessor {
 
   butil::Status DoExecuteForAggregation(const std::vector<std::any>& selection_record);
 
+  // Aggregate all kvs of iter, without output.
+  butil::Status Aggregate(const std::shared_ptr<EngineIterator>& iter);
+  butil::Status Merge(const std::shared_ptr<Coprocessor>& other);
+  butil::Status InitAggregationManager();
+
   butil::Status DoExecuteForSelection(const std::vector<std::any>& selection_record, bool* has_result_kv,
                                       pb::common::KeyValue* result_kv);
-  butil::Status GetKeyValueFromAggregation(bool key_only, size_t max_fetch_cnt, uint64_t max_bytes_rpc,
-                                           std::vector<pb::common::KeyValue>* kvs);
 
   butil::Status CompareSerialSchema(const pb::store::Coprocessor& coprocessor);
 
@@ -74,6 +93,8 @@ class Coprocessor {
   std::shared_ptr<std::vector<std::shared_ptr<BaseSchema>>> result_serial_schemas_;
   bool enable_expression_;
   bool end_of_group_by_;
+  // All kvs are aggregated by ExecuteParallel.
+  bool is_aggregated_;
   std::shared_ptr<AggregationManager> aggregation_manager_;
   std::shared_ptr<AggregationIterator> aggregation_iterator_;
   std::vector<int> original_column_indexes_;
@@ -936,6 +936,8 @@ void Utils::DebugCoprocessor(const pb::store::Coprocessor& coprocessor) {
 
   Utils::DebugGroupByOperators(coprocessor.aggregation_operators(), "aggregation_operators");
 
+  COPROCESSOR_LOG << "partial_aggregation : " << coprocessor.partial_aggregation();
+
   COPROCESSOR_LOG
       << "***************************DebugCoprocessor End*****************************************************";
 }
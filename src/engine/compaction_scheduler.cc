@@ -0,0 +1,147 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "engine/compaction_scheduler.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bthread/bthread.h"
+#include "butil/memory/singleton.h"
+#include "butil/time.h"
+#include "bvar/latency_recorder.h"
+#include "bvar/reducer.h"
+#include "common/helper.h"
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "gflags/gflags.h"
+
+namespace dingodb {
+
+DEFINE_bool(enable_range_compaction, true, "Compact range after big range delete and region drop");
+DEFINE_int32(range_compaction_interval_ms, 1000, "Interval of checking pending range compactions");
+DEFINE_int64(range_compaction_bytes_per_second, 64 * 1024 * 1024,
+             "Pace of range compaction by approximate bytes of compacted range, 0 is unlimited");
+DEFINE_uint32(range_compaction_max_pending, 1024, "Max pending range compactions");
+DEFINE_uint64(range_compaction_min_delete_keys, 10000, "Compact range when range delete remove keys more than it");
+DEFINE_uint64(range_compaction_min_tombstones, 100000, "Compact region when its tombstones more than it");
+DEFINE_double(range_compaction_tombstone_ratio, 0.5, "Compact region when its tombstone ratio exceed it");
+
+static bvar::Adder<int64_t> g_range_compaction_count("dingo_range_compaction_count");
+static bvar::Adder<int64_t> g_range_compaction_drop_count("dingo_range_compaction_drop_count");
+static bvar::LatencyRecorder g_range_compaction_latency("dingo_range_compaction");
+
+CompactionScheduler* CompactionScheduler::GetInstance() { return Singleton<CompactionScheduler>::get(); }
+
+bool CompactionScheduler::NeedCompact(const RawEngine::TombstoneStats& stats) {
+  if (stats.entry_count == 0 || stats.tombstone_count < FLAGS_range_compaction_min_tombstones) {
+    return false;
+  }
+
+  return static_cast<double>(stats.tombstone_count) / stats.entry_count >= FLAGS_range_compaction_tombstone_ratio;
+}
+
+bool CompactionScheduler::Schedule(std::shared_ptr<RawEngine> engine, const std::string& cf_name,
+                                   const pb::common::Range& range, const std::string& reason) {
+  if (!FLAGS_enable_range_compaction || engine == nullptr) {
+    return false;
+  }
+
+  {
+    BAIDU_SCOPED_LOCK(mutex_);
+    for (const auto& task : tasks_) {
+      // Already covered by pending task.
+      if (task.engine == engine && task.cf_name == cf_name && task.range.start_key() <= range.start_key() &&
+          range.end_key() <= task.range.end_key()) {
+        return false;
+      }
+    }
+    if (tasks_.size() >= FLAGS_range_compaction_max_pending) {
+      g_range_compaction_drop_count << 1;
+      DINGO_LOG(WARNING) << fmt::format("[compaction] too many pending range compactions, drop range[{}-{}]",
+                                        Helper::StringToHex(range.start_key()), Helper::StringToHex(range.end_key()));
+      return false;
+    }
+
+    tasks_.push_back({engine, cf_name, range, reason});
+  }
+
+  return true;
+}
+
+size_t CompactionScheduler::PendingSize() {
+  BAIDU_SCOPED_LOCK(mutex_);
+  return tasks_.size();
+}
+
+void CompactionScheduler::TriggerCompaction(void*) {
+  auto* scheduler = GetInstance();
+  // Skip this round if last round not finished.
+  if (scheduler->running_.exchange(true)) {
+    return;
+  }
+
+  bthread_t tid;
+  const bthread_attr_t attr = BTHREAD_ATTR_NORMAL;
+  int ret = bthread_start_background(
+      &tid, &attr,
+      [](void* arg) -> void* {
+        auto* scheduler = static_cast<CompactionScheduler*>(arg);
+        scheduler->Run();
+        scheduler->running_.store(false);
+        return nullptr;
+      },
+      scheduler);
+  if (ret != 0) {
+    scheduler->running_.store(false);
+  }
+}
+
+void CompactionScheduler::Run() {
+  while (butil::gettimeofday_us() >= next_time_us_) {
+    Task task;
+    {
+      BAIDU_SCOPED_LOCK(mutex_);
+      if (tasks_.empty()) {
+        break;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+
+    std::vector<pb::common::Range> ranges = {task.range};
+    uint64_t size = task.engine->GetApproximateSizes(task.cf_name, ranges)[0];
+
+    int64_t start_time = butil::gettimeofday_us();
+    auto status = task.engine->CompactRange(task.cf_name, task.range);
+    int64_t elapsed_us = butil::gettimeofday_us() - start_time;
+    g_range_compaction_count << 1;
+    g_range_compaction_latency << elapsed_us;
+    DINGO_LOG(INFO) << fmt::format("[compaction] compact cf {} range[{}-{}] size {} reason {} elapsed {}ms status {}",
+                                   task.cf_name, Helper::StringToHex(task.range.start_key()),
+                                   Helper::StringToHex(task.range.end_key()), size, task.reason, elapsed_us / 1000,
+                                   status.error_str());
+
+    // Pace next compaction by size of this one.
+    if (FLAGS_range_compaction_bytes_per_second > 0) {
+      int64_t expect_us = size * 1000000 / FLAGS_range_compaction_bytes_per_second;
+      next_time_us_ = start_time + expect_us;
+    }
+  }
+}
+
+}  // namespace dingodb
@@ -0,0 +1,80 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_ENGINE_COMPACTION_SCHEDULER_H_
+#define DINGODB_ENGINE_COMPACTION_SCHEDULER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+
+#include "bthread/mutex.h"
+#include "engine/raw_engine.h"
+#include "proto/common.pb.h"
+
+template <typename T>
+struct DefaultSingletonTraits;
+
+namespace dingodb {
+
+// Compact ranges after big range deletes or region drop, range tombstones slow down reads and scans until
+// compaction drop them. Compactions run one by one in a bthread triggered by crontab, pace by bytes of compacted
+// range, so they don't compete with foreground writes.
+class CompactionScheduler {
+ public:
+  static CompactionScheduler* GetInstance();
+
+  CompactionScheduler(const CompactionScheduler&) = delete;
+  const CompactionScheduler& operator=(const CompactionScheduler&) = delete;
+
+  // Return false if queue is full or range already pending.
+  bool Schedule(std::shared_ptr<RawEngine> engine, const std::string& cf_name, const pb::common::Range& range,
+                const std::string& reason);
+
+  // Whether tombstones are dense enough to compact.
+  static bool NeedCompact(const RawEngine::TombstoneStats& stats);
+
+  size_t PendingSize();
+
+  // Crontab function, run pending compactions in background bthread.
+  static void TriggerCompaction(void*);
+
+ private:
+  CompactionScheduler() : running_(false), next_time_us_(0) {}
+  ~CompactionScheduler() = default;
+
+  friend struct DefaultSingletonTraits<CompactionScheduler>;
+
+  struct Task {
+    std::shared_ptr<RawEngine> engine;
+    std::string cf_name;
+    pb::common::Range range;
+    std::string reason;
+  };
+
+  // Run pending compactions until queue is empty or paced.
+  void Run();
+
+  bthread::Mutex mutex_;
+  std::deque<Task> tasks_;
+  std::atomic<bool> running_;
+  // Next compaction is not earlier than it, pace by size of the last one.
+  int64_t next_time_us_;
+};
+
+}  // namespace dingodb
+
+#endif  // DINGODB_ENGINE_COMPACTION_SCHEDULER_H_
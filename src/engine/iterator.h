@@ -15,6 +15,8 @@
 #ifndef DINGODB_ENGINE_ITERATOR_H_
 #define DINGODB_ENGINE_ITERATOR_H_
 
+#include <cstddef>
+#include <string>
 #include <string_view>
 
 #include "common/logging.h"
@@ -31,8 +33,15 @@ enum class IteratorType {
 };
 
 struct IteratorOptions {
+  // Range [lower_bound, upper_bound), empty means unbounded, engine stop reading at the bound.
   std::string lower_bound;
   std::string upper_bound;
+  // Readahead bytes for sequential scan, 0 is engine default.
+  size_t readahead_size = 0;
+  // Bulk scan(e.g. snapshot, build index) should set false, avoid polluting block cache.
+  bool fill_cache = true;
+  // Only iterate keys with the same prefix as the seek key, instead of total order seek.
+  bool prefix_same_as_start = false;
 };
 
 class Iterator {
@@ -14,11 +14,15 @@
 
 #include "engine/raft_store_engine.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 
 #include "braft/raft.h"
+#include "bthread/bthread.h"
 #include "butil/endpoint.h"
+#include "bvar/latency_recorder.h"
+#include "bvar/reducer.h"
 #include "common/helper.h"
 #include "common/logging.h"
 #include "common/synchronization.h"
@@ -26,6 +30,7 @@
 #include "engine/write_data.h"
 #include "event/store_state_machine_event.h"
 #include "fmt/core.h"
+#include "gflags/gflags.h"
 #include "proto/common.pb.h"
 #include "proto/coordinator_internal.pb.h"
 #include "proto/error.pb.h"
@@ -44,17 +49,30 @@ RaftStoreEngine::~RaftStoreEngine() = default;
 
 bool RaftStoreEngine::Init(std::shared_ptr<Config> /*config*/) { return true; }
 
+DEFINE_int32(raft_node_recover_concurrency, 8, "Max number of raft node recovered concurrently at bootstrap");
+
+// Bootstrap progress metrics
+static bvar::Adder<int64_t> g_recover_raft_node_total("dingo_recover_raft_node_total");
+static bvar::Adder<int64_t> g_recover_raft_node_finished("dingo_recover_raft_node_finished");
+static bvar::Adder<int64_t> g_recover_raft_node_failed("dingo_recover_raft_node_failed");
+static bvar::LatencyRecorder g_recover_raft_node_latency("dingo_recover_raft_node");
+
 // Recover raft node from region meta data.
 // Invoke when server starting.
+// Raft nodes are started concurrently, bounded by raft_node_recover_concurrency,
+// in priority order, so the regions led by this store before restart are served first.
 bool RaftStoreEngine::Recover() {
   auto store_region_meta = Server::GetInstance()->GetStoreMetaManager()->GetStoreRegionMeta();
   auto store_raft_meta = Server::GetInstance()->GetStoreMetaManager()->GetStoreRaftMeta();
   auto store_region_metrics = Server::GetInstance()->GetStoreMetricsManager()->GetStoreRegionMetrics();
   auto regions = store_region_meta->GetAllRegion();
+  Server::GetInstance()->SortRegionByRecoverPriority(regions);
 
   int count = 0;
+  uint64_t start_time = Helper::TimestampMs();
   auto ctx = std::make_shared<Context>();
   auto listener_factory = std::make_shared<StoreSmEventListenerFactory>();
+  BthreadCond cond;
   for (auto& region : regions) {
     if (region->State() == pb::common::StoreRegionState::NORMAL ||
         region->State() == pb::common::StoreRegionState::STANDBY ||
@@ -70,12 +88,27 @@ bool RaftStoreEngine::Recover() {
         DINGO_LOG(WARNING) << "Recover region metrics not found: " << region->Id();
       }
 
-      AddNode(ctx, region, raft_meta, region_metrics, listener_factory->Build(), true);
+      g_recover_raft_node_total << 1;
+      cond.IncreaseWait(std::max(FLAGS_raft_node_recover_concurrency, 1));
+      Bthread bth(&BTHREAD_ATTR_NORMAL);
+      bth.Run([this, ctx, region, raft_meta, region_metrics, listeners = listener_factory->Build(), &cond]() {
+        uint64_t start_time = Helper::TimestampMs();
+        auto status = AddNode(ctx, region, raft_meta, region_metrics, listeners, true);
+        if (!status.ok()) {
+          DINGO_LOG(ERROR) << fmt::format("Recover raft node {} failed, error: {}", region->Id(), status.error_str());
+          g_recover_raft_node_failed << 1;
+        }
+        g_recover_raft_node_latency << (Helper::TimestampMs() - start_time);
+        g_recover_raft_node_finished << 1;
+        cond.DecreaseSignal();
+      });
       ++count;
     }
   }
+  cond.Wait();
 
-  DINGO_LOG(INFO) << "Recover Raft node num: " << count;
+  DINGO_LOG(INFO) << fmt::format("Recover Raft node num: {} failed: {} elapsed time: {}ms", count,
+                                 g_recover_raft_node_failed.get_value(), Helper::TimestampMs() - start_time);
 
   return true;
 }
@@ -101,7 +134,7 @@ butil::Status RaftStoreEngine::AddNode(std::shared_ptr<Context> /*ctx*/, store::
       region->Id(), region->Name(), braft::PeerId(Server::GetInstance()->RaftEndpoint()), state_machine);
 
   if (node->Init(Helper::FormatPeers(Helper::ExtractLocations(region->Peers())),
-                 ConfigManager::GetInstance()->GetConfig(Server::GetInstance()->GetRole())) != 0) {
+                 ConfigManager::GetInstance()->GetConfig(Server::GetInstance()->GetRole()), true) != 0) {
     node->Destroy();
     return butil::Status(pb::error::ERAFT_INIT, "Raft init failed");
   }
@@ -121,8 +154,9 @@ butil::Status RaftStoreEngine::AddNode(std::shared_ptr<pb::common::RegionDefinit
   std::shared_ptr<RaftNode> const node = std::make_shared<RaftNode>(
       region->id(), meta_raft_name, braft::PeerId(Server::GetInstance()->RaftEndpoint()), state_machine);
 
+  // Coordinator meta raft keep braft snapshot timer.
   if (node->Init(Helper::FormatPeers(Helper::ExtractLocations(region->peers())),
-                 ConfigManager::GetInstance()->GetConfig(Server::GetInstance()->GetRole())) != 0) {
+                 ConfigManager::GetInstance()->GetConfig(Server::GetInstance()->GetRole()), false) != 0) {
     node->Destroy();
     return butil::Status(pb::error::ERAFT_INIT, "Raft init failed");
   }
@@ -178,6 +212,8 @@ std::shared_ptr<RaftNode> RaftStoreEngine::GetNode(uint64_t region_id) {
   return raft_node_manager_->GetNode(region_id);
 }
 
+std::vector<std::shared_ptr<RaftNode>> RaftStoreEngine::GetAllNode() { return raft_node_manager_->GetAllNode(); }
+
 butil::Status RaftStoreEngine::DoSnapshot(std::shared_ptr<Context> ctx, uint64_t region_id) {
   auto node = raft_node_manager_->GetNode(region_id);
   if (node == nullptr) {
@@ -308,7 +344,14 @@ butil::Status RaftStoreEngine::VectorReader::SearchVector(uint64_t region_id, co
     return butil::Status(pb::error::EVECTOR_NOT_FOUND, fmt::format("Not found vector index {}", region_id));
   }
 
-  vector_index->Search(vector, parameter.top_n(), vectors);
+  // Quantized index recall more results, then reorder them by original vectors.
+  uint32_t top_n = parameter.top_n();
+  bool need_reorder = vector_index->IsQuantized() && parameter.hnsw().recall_num() > 0 &&
+                      static_cast<uint32_t>(parameter.hnsw().recall_num()) > top_n;
+  auto status = vector_index->Search(vector, need_reorder ? parameter.hnsw().recall_num() : top_n, vectors);
+  if (!status.ok()) {
+    return status;
+  }
 
   // if vector index does not support restruct vector ,we restruct it using RocksDB
   for (auto& vector_with_distance : vectors) {
@@ -316,10 +359,27 @@ butil::Status RaftStoreEngine::VectorReader::SearchVector(uint64_t region_id, co
       continue;
     }
 
+    float distance = vector_with_distance.distance();
     auto status = QueryVectorWithId(region_id, vector_with_distance.vector_with_id().id(), vector_with_distance);
     if (!status.ok()) {
       return status;
     }
+    vector_with_distance.set_distance(distance);
+  }
+
+  if (need_reorder) {
+    for (auto& vector_with_distance : vectors) {
+      vector_with_distance.set_distance(
+          vector_index->CalcDistance(vector.vector(), vector_with_distance.vector_with_id().vector()));
+    }
+
+    std::sort(vectors.begin(), vectors.end(),
+              [](const pb::common::VectorWithDistance& lhs, const pb::common::VectorWithDistance& rhs) {
+                return lhs.distance() < rhs.distance();
+              });
+    if (vectors.size() > top_n) {
+      vectors.resize(top_n);
+    }
   }
 
   return butil::Status();
@@ -77,6 +77,7 @@ class RaftStoreEngine : public Engine, public RaftControlAble {
   butil::Status StopNode(std::shared_ptr<Context> ctx, uint64_t region_id) override;
   butil::Status DestroyNode(std::shared_ptr<Context> ctx, uint64_t region_id) override;
   std::shared_ptr<RaftNode> GetNode(uint64_t region_id) override;
+  std::vector<std::shared_ptr<RaftNode>> GetAllNode();
 
   butil::Status TransferLeader(uint64_t region_id, const pb::common::Peer& peer) override;
 
@@ -85,6 +85,8 @@ class RawEngine {
                                   const std::string& end_key, uint64_t& count) = 0;
 
     virtual std::shared_ptr<EngineIterator> NewIterator(const std::string& start_key, const std::string& end_key) = 0;
+    virtual std::shared_ptr<EngineIterator> NewIterator(std::shared_ptr<dingodb::Snapshot> snapshot,
+                                                        const std::string& start_key, const std::string& end_key) = 0;
   };
 
   class Writer {
@@ -135,10 +137,30 @@ class RawEngine {
   virtual std::shared_ptr<Reader> NewReader(const std::string& cf_name) = 0;
   virtual std::shared_ptr<RawEngine::Writer> NewWriter(const std::string& cf_name) = 0;
   virtual std::shared_ptr<Iterator> NewIterator(const std::string& cf_name, IteratorOptions options) = 0;
+  virtual std::shared_ptr<Iterator> NewIterator(const std::string& cf_name, std::shared_ptr<Snapshot> snapshot,
+                                                IteratorOptions options) = 0;
 
   virtual std::vector<uint64_t> GetApproximateSizes(const std::string& cf_name,
                                                     std::vector<pb::common::Range>& ranges) = 0;
 
+  // Compact range, drop deleted keys and range tombstones.
+  virtual butil::Status CompactRange(const std::string& cf_name, const pb::common::Range& range) = 0;
+  // Delete files which are completely in range, not visible to snapshot anymore.
+  virtual butil::Status DeleteFilesInRange(const std::string& cf_name, const pb::common::Range& range) = 0;
+
+  // Entries and tombstones of files in each range, approximate. File partially in range is counted by the share of
+  // its size in range, so file shared by adjacent ranges is not counted repeatedly. Ranges must not overlap.
+  struct TombstoneStats {
+    uint64_t entry_count{0};
+    uint64_t tombstone_count{0};
+  };
+  virtual std::vector<TombstoneStats> GetTombstoneStats(const std::string& cf_name,
+                                                        const std::vector<pb::common::Range>& ranges) = 0;
+
+  // Split range into at most count sub ranges of approximate equal size, split keys are sst file boundaries.
+  virtual std::vector<pb::common::Range> SplitRange(const std::string& cf_name, const pb::common::Range& range,
+                                                    uint32_t count) = 0;
+
  protected:
   RawEngine() = default;
 };
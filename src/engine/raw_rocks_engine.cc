@@ -41,6 +41,7 @@
 #include "common/helper.h"
 #include "common/logging.h"
 #include "engine/raw_engine.h"
+#include "engine/rocks_resource.h"
 #include "fmt/core.h"
 #include "proto/common.pb.h"
 #include "proto/error.pb.h"
@@ -62,6 +63,11 @@ class RocksIterator : public EngineIterator {
       : snapshot_(snapshot), db_(db), column_family_(column_family), start_key_(start_key), end_key_(end_key) {
     rocksdb::ReadOptions read_option;
     read_option.auto_prefix_mode = true;
+    // end_key_ is owned by iterator, so it can be the rocksdb bound.
+    end_key_slice_ = rocksdb::Slice(end_key_);
+    if (!end_key_.empty()) {
+      read_option.iterate_upper_bound = &end_key_slice_;
+    }
     read_option.snapshot = static_cast<const rocksdb::Snapshot*>(
         std::dynamic_pointer_cast<RawRocksEngine::RocksSnapshot>(snapshot)->Inner());
 
@@ -188,6 +194,7 @@ class RocksIterator : public EngineIterator {
   uint32_t id_ = static_cast<uint32_t>(EnumEngineIterator::kRocks);
   std::string start_key_;
   std::string end_key_;
+  rocksdb::Slice end_key_slice_;
   bool with_start_{true};
   bool with_end_{false};
   bool has_valid_kv_{false};
@@ -222,6 +229,11 @@ bool RawRocksEngine::Init(std::shared_ptr<Config> config) {
 
   SetDefaultIfNotExist(column_families);
 
+  if (!RocksResourceManager::GetInstance()->Init(config)) {
+    DINGO_LOG(ERROR) << "Init rocksdb resource failed";
+    return false;
+  }
+
   InitCfConfig(column_families);
 
   SetColumnFamilyFromConfig(config, column_families);
@@ -272,22 +284,23 @@ butil::Status RawRocksEngine::MergeCheckpointFile(const std::string& path, const
 
   // Create iterator
   IteratorOptions iter_options;
+  iter_options.lower_bound = range.start_key();
   iter_options.upper_bound = range.end_key();
+  iter_options.readahead_size = Constant::kRocksdbBulkScanReadaheadSize;
+  iter_options.fill_cache = false;
 
-  rocksdb::ReadOptions read_options;
-  read_options.auto_prefix_mode = true;
-
-  auto iter =
-      std::make_shared<RawRocksEngine::Iterator>(iter_options, snapshot_db->NewIterator(read_options, handles[0]));
+  auto iter = std::make_shared<RawRocksEngine::Iterator>(iter_options, snapshot_db, handles[0], nullptr);
   iter->Seek(range.start_key());
 
   // Create sst writer
   return NewSstFileWriter()->SaveFile(iter, merge_sst_path);
 }
 
-butil::Status RawRocksEngine::IngestExternalFile(const std::string& cf_name, const std::vector<std::string>& files) {
+butil::Status RawRocksEngine::IngestExternalFile(const std::string& cf_name, const std::vector<std::string>& files,
+                                                 bool move_files) {
   rocksdb::IngestExternalFileOptions options;
   options.write_global_seqno = false;
+  options.move_files = move_files;
   auto status = db_->IngestExternalFile(GetColumnFamily(cf_name)->GetHandle(), files, options);
   if (!status.ok()) {
     DINGO_LOG(ERROR) << "IngestExternalFile failed " << status.ToString();
@@ -338,22 +351,14 @@ std::shared_ptr<dingodb::Iterator> RawRocksEngine::NewIterator(const std::string
     return nullptr;
   }
 
-  // Correct free iterate_upper_bound
-  // auto slice = std::make_unique<rocksdb::Slice>(options.upper_bound);
-  rocksdb::ReadOptions read_options;
-  if (snapshot != nullptr) {
-    read_options.snapshot = static_cast<const rocksdb::Snapshot*>(snapshot->Inner());
-  }
-  read_options.auto_prefix_mode = true;
-  // if (!options.upper_bound.empty()) {
-  //   read_options.iterate_upper_bound = slice.get();
-  // }
-  return std::make_shared<RawRocksEngine::Iterator>(options, db_->NewIterator(read_options, column_family->GetHandle()),
+  return std::make_shared<RawRocksEngine::Iterator>(std::move(options), db_.get(), column_family->GetHandle(),
                                                     snapshot);
 }
 
 std::shared_ptr<RawRocksEngine::SstFileWriter> RawRocksEngine::NewSstFileWriter() {
-  return std::make_shared<RawRocksEngine::SstFileWriter>(rocksdb::Options());
+  rocksdb::Options options;
+  options.rate_limiter = RocksResourceManager::GetInstance()->GetRateLimiter();
+  return std::make_shared<RawRocksEngine::SstFileWriter>(options);
 }
 
 std::shared_ptr<RawRocksEngine::Checkpoint> RawRocksEngine::NewCheckpoint() {
@@ -402,6 +407,193 @@ std::vector<uint64_t> RawRocksEngine::GetApproximateSizes(const std::string& cf_
   return result;
 }
 
+butil::Status RawRocksEngine::CompactRange(const std::string& cf_name, const pb::common::Range& range) {
+  auto column_family = GetColumnFamily(cf_name);
+  if (column_family == nullptr) {
+    return butil::Status(pb::error::EINTERNAL, fmt::format("Not found column family {}", cf_name));
+  }
+
+  rocksdb::CompactRangeOptions options;
+  // Not block automatic compaction.
+  options.exclusive_manual_compaction = false;
+  // Bottommost files hold the deleted keys, skip files just generated by this compaction.
+  options.bottommost_level_compaction = rocksdb::BottommostLevelCompaction::kForceOptimized;
+  rocksdb::Slice start_key(range.start_key());
+  rocksdb::Slice end_key(range.end_key());
+  auto status = db_->CompactRange(options, column_family->GetHandle(), &start_key, &end_key);
+  if (!status.ok()) {
+    DINGO_LOG(ERROR) << fmt::format("rocksdb::DB::CompactRange failed : {}", status.ToString());
+    return butil::Status(pb::error::EINTERNAL, "Internal compact range error");
+  }
+
+  return butil::Status();
+}
+
+butil::Status RawRocksEngine::DeleteFilesInRange(const std::string& cf_name, const pb::common::Range& range) {
+  auto column_family = GetColumnFamily(cf_name);
+  if (column_family == nullptr) {
+    return butil::Status(pb::error::EINTERNAL, fmt::format("Not found column family {}", cf_name));
+  }
+
+  rocksdb::Slice start_key(range.start_key());
+  rocksdb::Slice end_key(range.end_key());
+  // Not include end, end_key belong to next range.
+  rocksdb::RangePtr ranges(&start_key, &end_key);
+  auto status = rocksdb::DeleteFilesInRanges(db_.get(), column_family->GetHandle(), &ranges, 1, false);
+  if (!status.ok()) {
+    DINGO_LOG(ERROR) << fmt::format("rocksdb::DeleteFilesInRanges failed : {}", status.ToString());
+    return butil::Status(pb::error::EINTERNAL, "Internal delete files in range error");
+  }
+
+  return butil::Status();
+}
+
+std::vector<RawEngine::TombstoneStats> RawRocksEngine::GetTombstoneStats(const std::string& cf_name,
+                                                                        const std::vector<pb::common::Range>& ranges) {
+  std::vector<TombstoneStats> stats(ranges.size());
+  auto column_family = GetColumnFamily(cf_name);
+  if (column_family == nullptr || ranges.empty()) {
+    return stats;
+  }
+
+  // File meta data is in memory, not read table properties of every file.
+  rocksdb::ColumnFamilyMetaData meta_data;
+  db_->GetColumnFamilyMetaData(column_family->GetHandle(), &meta_data);
+
+  std::vector<size_t> sorted_indexes(ranges.size());
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    sorted_indexes[i] = i;
+  }
+  std::sort(sorted_indexes.begin(), sorted_indexes.end(),
+            [&ranges](size_t a, size_t b) { return ranges[a].end_key() < ranges[b].end_key(); });
+
+  // File partially in range, with its part in range and its whole span for size share.
+  struct PartialFile {
+    size_t range_index;
+    uint64_t entry_count;
+    uint64_t tombstone_count;
+  };
+  std::vector<PartialFile> partial_files;
+  std::vector<pb::common::Range> size_ranges;
+  for (const auto& level : meta_data.levels) {
+    for (const auto& file : level.files) {
+      // First range end after file smallest key.
+      auto it = std::upper_bound(sorted_indexes.begin(), sorted_indexes.end(), file.smallestkey,
+                                 [&ranges](const std::string& key, size_t i) { return key < ranges[i].end_key(); });
+      for (; it != sorted_indexes.end() && ranges[*it].start_key() <= file.largestkey; ++it) {
+        const auto& range = ranges[*it];
+        // Largest key of range tombstone is the exclusive end of it.
+        if (file.smallestkey >= range.start_key() && file.largestkey <= range.end_key()) {
+          stats[*it].entry_count += file.num_entries;
+          stats[*it].tombstone_count += file.num_deletions;
+          continue;
+        }
+
+        partial_files.push_back({*it, file.num_entries, file.num_deletions});
+        pb::common::Range part;
+        part.set_start_key(std::max(file.smallestkey, range.start_key()));
+        part.set_end_key(std::min(file.largestkey, range.end_key()));
+        size_ranges.push_back(std::move(part));
+        pb::common::Range span;
+        span.set_start_key(file.smallestkey);
+        span.set_end_key(file.largestkey);
+        size_ranges.push_back(std::move(span));
+      }
+    }
+  }
+  if (partial_files.empty()) {
+    return stats;
+  }
+
+  auto sizes = GetApproximateSizes(cf_name, size_ranges);
+  for (size_t i = 0; i < partial_files.size(); ++i) {
+    uint64_t part_size = sizes[i * 2];
+    uint64_t span_size = sizes[i * 2 + 1];
+    if (span_size == 0) {
+      continue;
+    }
+    double share = std::min(static_cast<double>(part_size) / span_size, 1.0);
+    auto& partial_file = partial_files[i];
+    stats[partial_file.range_index].entry_count += static_cast<uint64_t>(partial_file.entry_count * share);
+    stats[partial_file.range_index].tombstone_count += static_cast<uint64_t>(partial_file.tombstone_count * share);
+  }
+
+  return stats;
+}
+
+std::vector<pb::common::Range> RawRocksEngine::SplitRange(const std::string& cf_name, const pb::common::Range& range,
+                                                          uint32_t count) {
+  std::vector<pb::common::Range> sub_ranges;
+  auto column_family = GetColumnFamily(cf_name);
+  if (column_family == nullptr || count <= 1) {
+    sub_ranges.push_back(range);
+    return sub_ranges;
+  }
+
+  rocksdb::ColumnFamilyMetaData meta_data;
+  db_->GetColumnFamilyMetaData(column_family->GetHandle(), &meta_data);
+
+  std::vector<std::string> boundary_keys;
+  for (const auto& level : meta_data.levels) {
+    for (const auto& file : level.files) {
+      for (const auto* key : {&file.smallestkey, &file.largestkey}) {
+        if (*key > range.start_key() && *key < range.end_key()) {
+          boundary_keys.push_back(*key);
+        }
+      }
+    }
+  }
+  std::sort(boundary_keys.begin(), boundary_keys.end());
+  boundary_keys.erase(std::unique(boundary_keys.begin(), boundary_keys.end()), boundary_keys.end());
+  if (boundary_keys.empty()) {
+    sub_ranges.push_back(range);
+    return sub_ranges;
+  }
+
+  // Pieces between adjacent boundary keys, merge them into sub ranges by size.
+  std::vector<pb::common::Range> pieces;
+  std::string start_key = range.start_key();
+  for (auto& key : boundary_keys) {
+    pb::common::Range piece;
+    piece.set_start_key(start_key);
+    piece.set_end_key(key);
+    pieces.push_back(std::move(piece));
+    start_key = key;
+  }
+  pb::common::Range last_piece;
+  last_piece.set_start_key(start_key);
+  last_piece.set_end_key(range.end_key());
+  pieces.push_back(std::move(last_piece));
+
+  auto sizes = GetApproximateSizes(cf_name, pieces);
+  uint64_t total_size = 0;
+  for (auto size : sizes) {
+    total_size += size;
+  }
+  uint64_t sub_range_size = total_size / count;
+  if (sub_range_size == 0) {
+    sub_ranges.push_back(range);
+    return sub_ranges;
+  }
+
+  pb::common::Range sub_range;
+  sub_range.set_start_key(range.start_key());
+  uint64_t size = 0;
+  for (size_t i = 0; i + 1 < pieces.size(); ++i) {
+    size += sizes[i];
+    if (size >= sub_range_size && sub_ranges.size() < count - 1) {
+      sub_range.set_end_key(pieces[i].end_key());
+      sub_ranges.push_back(sub_range);
+      sub_range.set_start_key(pieces[i].end_key());
+      size = 0;
+    }
+  }
+  sub_range.set_end_key(range.end_key());
+  sub_ranges.push_back(std::move(sub_range));
+
+  return sub_ranges;
+}
+
 template <typename T>
 void SetCfConfigurationElement(const std::map<std::string, std::string>& cf_configuration, const char* name,
                                const T& default_value, T& value) {  // NOLINT
@@ -501,7 +693,11 @@ bool RawRocksEngine::SetCfConfiguration(const CfDefaultConf& default_conf,
 
     SetCfConfigurationElementWrapper(default_conf, cf_configuration, Constant::kBlockCache.c_str(), value);
 
-    auto cache = rocksdb::NewLRUCache(value);  // LRUcache
+    // Prefer store level shared cache, the per column family size is ignored.
+    auto cache = RocksResourceManager::GetInstance()->GetBlockCache();
+    if (cache == nullptr) {
+      cache = rocksdb::NewLRUCache(value);  // LRUcache
+    }
     table_options.block_cache = cache;
   }
 
@@ -635,6 +831,8 @@ bool RawRocksEngine::RocksdbInit(std::shared_ptr<Config> config, const std::stri
   db_options.max_background_jobs = GetBackgroundThreadNum(config);
   db_options.max_subcompactions = db_options.max_background_jobs / 4 * 3;
   db_options.stats_dump_period_sec = GetStatsDumpPeriodSec(config);
+  db_options.write_buffer_manager = RocksResourceManager::GetInstance()->GetWriteBufferManager();
+  db_options.rate_limiter = RocksResourceManager::GetInstance()->GetRateLimiter();
 
   rocksdb::DB* db;
   rocksdb::Status s = rocksdb::DB::Open(db_options, db_path, column_families, &family_handles, &db);
@@ -781,10 +979,11 @@ butil::Status RawRocksEngine::Reader::KvScan(std::shared_ptr<dingodb::Snapshot>
   rocksdb::ReadOptions read_option;
   read_option.auto_prefix_mode = true;
   read_option.snapshot = static_cast<const rocksdb::Snapshot*>(snapshot->Inner());
+  rocksdb::Slice upper_bound(end_key);
+  read_option.iterate_upper_bound = &upper_bound;
 
-  std::string_view end_key_view(end_key);
   rocksdb::Iterator* it = db_->NewIterator(read_option, column_family_->GetHandle());
-  for (it->Seek(start_key); it->Valid() && it->key().ToStringView() < end_key_view; it->Next()) {
+  for (it->Seek(start_key); it->Valid(); it->Next()) {
     pb::common::KeyValue kv;
     kv.set_key(it->key().data(), it->key().size());
     kv.set_value(it->value().data(), it->value().size());
@@ -817,10 +1016,13 @@ butil::Status RawRocksEngine::Reader::KvCount(std::shared_ptr<dingodb::Snapshot>
   rocksdb::ReadOptions read_options;
   read_options.auto_prefix_mode = true;
   read_options.snapshot = static_cast<const rocksdb::Snapshot*>(snapshot->Inner());
+  // Count only touch keys, need not cache the blocks.
+  read_options.fill_cache = false;
+  rocksdb::Slice upper_bound(end_key);
+  read_options.iterate_upper_bound = &upper_bound;
 
-  std::string_view end_key_view(end_key.data(), end_key.size());
   rocksdb::Iterator* it = db_->NewIterator(read_options, column_family_->GetHandle());
-  for (it->Seek(start_key), count = 0; it->Valid() && it->key().ToStringView() < end_key_view; it->Next()) {
+  for (it->Seek(start_key), count = 0; it->Valid(); it->Next()) {
     ++count;
   }
   delete it;
@@ -1153,7 +1355,7 @@ butil::Status RawRocksEngine::Writer::KvBatchDeleteRange(const std::vector<pb::c
 
   rocksdb::WriteBatch batch;
   for (const auto& range : ranges) {
-    rocksdb::Status s = batch.DeleteRange(column_family_->GetHandle(), range.start_key(), range.start_key());
+    rocksdb::Status s = batch.DeleteRange(column_family_->GetHandle(), range.start_key(), range.end_key());
     if (!s.ok()) {
       DINGO_LOG(ERROR) << fmt::format("rocksdb::WriteBatch::DeleteRange failed : {}", s.ToString());
       return butil::Status(pb::error::EINTERNAL, "Internal delete range error");
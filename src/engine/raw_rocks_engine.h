@@ -111,29 +111,20 @@ class RawRocksEngine : public RawEngine {
 
   class Iterator : public dingodb::Iterator {
    public:
-    explicit Iterator(IteratorOptions options, rocksdb::Iterator* iter)
-        : options_(options), iter_(iter), snapshot_(nullptr) {}
-    explicit Iterator(IteratorOptions options, rocksdb::Iterator* iter, std::shared_ptr<Snapshot> snapshot)
-        : options_(options), iter_(iter), snapshot_(snapshot) {}
+    // The bounds are owned by the iterator, rocksdb read options point to them until the iterator destroyed.
+    explicit Iterator(IteratorOptions options, rocksdb::DB* db, rocksdb::ColumnFamilyHandle* handle,
+                      std::shared_ptr<Snapshot> snapshot)
+        : options_(std::move(options)), snapshot_(snapshot) {
+      lower_bound_ = rocksdb::Slice(options_.lower_bound);
+      upper_bound_ = rocksdb::Slice(options_.upper_bound);
+      iter_.reset(db->NewIterator(GenReadOptions(), handle));
+    }
     ~Iterator() override = default;
 
     std::string GetName() override { return "RawRocks"; }
     IteratorType GetID() override { return IteratorType::kRawRocksEngine; }
 
-    bool Valid() const override {
-      if (!iter_->Valid()) {
-        return false;
-      }
-
-      if (!options_.upper_bound.empty()) {
-        auto upper_bound = rocksdb::Slice(options_.upper_bound);
-        if (upper_bound.compare(iter_->key()) <= 0) {
-          return false;
-        }
-      }
-
-      return true;
-    }
+    bool Valid() const override { return iter_->Valid(); }
 
     void SeekToFirst() override { iter_->SeekToFirst(); }
     void SeekToLast() override { iter_->SeekToLast(); }
@@ -150,9 +141,34 @@ class RawRocksEngine : public RawEngine {
     std::string_view Value() const override { return std::string_view(iter_->value().data(), iter_->value().size()); }
 
    private:
+    rocksdb::ReadOptions GenReadOptions() {
+      rocksdb::ReadOptions read_options;
+      if (snapshot_ != nullptr) {
+        read_options.snapshot = static_cast<const rocksdb::Snapshot*>(snapshot_->Inner());
+      }
+      if (!options_.lower_bound.empty()) {
+        read_options.iterate_lower_bound = &lower_bound_;
+      }
+      if (!options_.upper_bound.empty()) {
+        read_options.iterate_upper_bound = &upper_bound_;
+      }
+      read_options.readahead_size = options_.readahead_size;
+      read_options.fill_cache = options_.fill_cache;
+      if (options_.prefix_same_as_start) {
+        read_options.prefix_same_as_start = true;
+      } else {
+        read_options.auto_prefix_mode = true;
+      }
+
+      return read_options;
+    }
+
+    // Declaration order matters, iter_ must be destroyed before the bounds and snapshot.
     IteratorOptions options_;
-    std::unique_ptr<rocksdb::Iterator> iter_;
+    rocksdb::Slice lower_bound_;
+    rocksdb::Slice upper_bound_;
     std::shared_ptr<Snapshot> snapshot_;
+    std::unique_ptr<rocksdb::Iterator> iter_;
   };
 
   class Reader : public RawEngine::Reader {
@@ -174,10 +190,10 @@ class RawRocksEngine : public RawEngine {
                           const std::string& end_key, uint64_t& count) override;
 
     std::shared_ptr<EngineIterator> NewIterator(const std::string& start_key, const std::string& end_key) override;
+    std::shared_ptr<EngineIterator> NewIterator(std::shared_ptr<dingodb::Snapshot> snapshot,
+                                                const std::string& start_key, const std::string& end_key) override;
 
    private:
-    std::shared_ptr<EngineIterator> NewIterator(std::shared_ptr<dingodb::Snapshot> snapshot,
-                                                const std::string& start_key, const std::string& end_key);
     std::shared_ptr<rocksdb::DB> db_;
     std::shared_ptr<ColumnFamily> column_family_;
   };
@@ -230,7 +246,8 @@ class RawRocksEngine : public RawEngine {
    public:
     SstFileWriter(const rocksdb::Options& options)
         : options_(options),
-          sst_writer_(std::make_unique<rocksdb::SstFileWriter>(rocksdb::EnvOptions(), options_, nullptr, true)) {}
+          sst_writer_(std::make_unique<rocksdb::SstFileWriter>(rocksdb::EnvOptions(), options_, nullptr, true,
+                                                               rocksdb::Env::IOPriority::IO_LOW)) {}
     ~SstFileWriter() = default;
 
     SstFileWriter(SstFileWriter&& rhs) = delete;
@@ -274,7 +291,9 @@ class RawRocksEngine : public RawEngine {
 
   static butil::Status MergeCheckpointFile(const std::string& path, const pb::common::Range& range,
                                            std::string& merge_sst_path);
-  butil::Status IngestExternalFile(const std::string& cf_name, const std::vector<std::string>& files);
+  // move_files: hard link files into db instead of copy, files are removed after ingest.
+  butil::Status IngestExternalFile(const std::string& cf_name, const std::vector<std::string>& files,
+                                   bool move_files = false);
 
   void Flush(const std::string& cf_name) override;
   void Close();
@@ -285,7 +304,7 @@ class RawRocksEngine : public RawEngine {
   std::shared_ptr<RawEngine::Writer> NewWriter(const std::string& cf_name) override;
   std::shared_ptr<dingodb::Iterator> NewIterator(const std::string& cf_name, IteratorOptions options) override;
   std::shared_ptr<dingodb::Iterator> NewIterator(const std::string& cf_name, std::shared_ptr<Snapshot> snapshot,
-                                                 IteratorOptions options);
+                                                 IteratorOptions options) override;
   static std::shared_ptr<SstFileWriter> NewSstFileWriter();
   std::shared_ptr<Checkpoint> NewCheckpoint();
 
@@ -294,6 +313,13 @@ class RawRocksEngine : public RawEngine {
   std::vector<uint64_t> GetApproximateSizes(const std::string& cf_name,
                                             std::vector<pb::common::Range>& ranges) override;
 
+  butil::Status CompactRange(const std::string& cf_name, const pb::common::Range& range) override;
+  butil::Status DeleteFilesInRange(const std::string& cf_name, const pb::common::Range& range) override;
+  std::vector<TombstoneStats> GetTombstoneStats(const std::string& cf_name,
+                                                const std::vector<pb::common::Range>& ranges) override;
+  std::vector<pb::common::Range> SplitRange(const std::string& cf_name, const pb::common::Range& range,
+                                            uint32_t count) override;
+
  private:
   bool InitCfConfig(const std::vector<std::string>& column_families);
 
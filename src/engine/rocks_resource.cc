@@ -0,0 +1,160 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "engine/rocks_resource.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "butil/memory/singleton.h"
+#include "common/constant.h"
+#include "common/logging.h"
+#include "fmt/core.h"
+
+namespace dingodb {
+
+static const std::string kMetricsPrefix = "dingo_rocksdb_resource";
+// Default estimated entry charge of hyper clock cache, same as the default block size.
+static const size_t kHyperClockEstimatedEntryCharge = 131072;
+
+static int64_t ParseInt64(const std::map<std::string, std::string>& conf, const std::string& key,
+                          int64_t default_value) {
+  auto iter = conf.find(key);
+  if (iter == conf.end() || iter->second.empty()) {
+    return default_value;
+  }
+
+  try {
+    return std::stoll(iter->second);
+  } catch (const std::exception& e) {
+    DINGO_LOG(ERROR) << fmt::format("Parse rocksdb resource config {} failed, value {}", key, iter->second);
+    return default_value;
+  }
+}
+
+RocksResourceManager* RocksResourceManager::GetInstance() { return Singleton<RocksResourceManager>::get(); }
+
+RocksResourceManager::RocksResourceManager()
+    : block_cache_capacity_(GetBlockCacheCapacity, this),
+      block_cache_usage_(GetBlockCacheUsage, this),
+      block_cache_pinned_usage_(GetBlockCachePinnedUsage, this),
+      write_buffer_limit_(GetWriteBufferLimit, this),
+      write_buffer_usage_(GetWriteBufferUsage, this),
+      rate_limit_bytes_per_sec_(GetRateLimitBytesPerSec, this),
+      rate_limit_total_bytes_(GetRateLimitTotalBytes, this) {}
+
+bool RocksResourceManager::Init(std::shared_ptr<Config> config) {
+  std::map<std::string, std::string> conf = config->GetStringMap(Constant::kStoreResource);
+
+  // Init again(e.g. engine reopen) take the latest config.
+  block_cache_.reset();
+  write_buffer_manager_.reset();
+  rate_limiter_.reset();
+
+  // Shared block cache
+  int64_t block_cache_size = ParseInt64(conf, Constant::kResourceBlockCacheSize, 0);
+  if (block_cache_size < 0) {
+    DINGO_LOG(ERROR) << "store.resource.block_cache_size illegal";
+    return false;
+  }
+  if (block_cache_size > 0) {
+    auto iter = conf.find(Constant::kResourceBlockCacheType);
+    std::string cache_type = iter != conf.end() ? iter->second : "lru";
+    if (cache_type == "hyper_clock") {
+      rocksdb::HyperClockCacheOptions cache_options(block_cache_size, kHyperClockEstimatedEntryCharge);
+      block_cache_ = cache_options.MakeSharedCache();
+    } else if (cache_type == "lru") {
+      block_cache_ = rocksdb::NewLRUCache(block_cache_size);
+    } else {
+      DINGO_LOG(ERROR) << fmt::format("store.resource.block_cache_type {} not support", cache_type);
+      return false;
+    }
+  }
+
+  // Bound memtable memory of all column families, optional charge memtable to block cache,
+  // then block cache capacity is the total memory budget.
+  int64_t write_buffer_size = ParseInt64(conf, Constant::kResourceWriteBufferManagerSize, 0);
+  if (write_buffer_size < 0) {
+    DINGO_LOG(ERROR) << "store.resource.write_buffer_manager_size illegal";
+    return false;
+  }
+  if (write_buffer_size > 0) {
+    bool charge_cache = ParseInt64(conf, Constant::kResourceWriteBufferChargeCache, 0) != 0;
+    write_buffer_manager_ = std::make_shared<rocksdb::WriteBufferManager>(
+        write_buffer_size, charge_cache ? block_cache_ : nullptr, false);
+  }
+
+  // Limit background flush/compaction and sst file generation write rate.
+  int64_t rate_limit = ParseInt64(conf, Constant::kResourceRateLimitBytesPerSec, 0);
+  if (rate_limit < 0) {
+    DINGO_LOG(ERROR) << "store.resource.rate_limit_bytes_per_sec illegal";
+    return false;
+  }
+  if (rate_limit > 0) {
+    rate_limiter_.reset(rocksdb::NewGenericRateLimiter(rate_limit));
+  }
+
+  block_cache_capacity_.expose_as(kMetricsPrefix, "block_cache_capacity");
+  block_cache_usage_.expose_as(kMetricsPrefix, "block_cache_usage");
+  block_cache_pinned_usage_.expose_as(kMetricsPrefix, "block_cache_pinned_usage");
+  write_buffer_limit_.expose_as(kMetricsPrefix, "write_buffer_limit");
+  write_buffer_usage_.expose_as(kMetricsPrefix, "write_buffer_usage");
+  rate_limit_bytes_per_sec_.expose_as(kMetricsPrefix, "rate_limit_bytes_per_sec");
+  rate_limit_total_bytes_.expose_as(kMetricsPrefix, "rate_limit_total_bytes");
+
+  DINGO_LOG(INFO) << fmt::format(
+      "Rocksdb resource block_cache_size {} write_buffer_manager_size {} rate_limit_bytes_per_sec {}",
+      block_cache_size, write_buffer_size, rate_limit);
+
+  return true;
+}
+
+int64_t RocksResourceManager::GetBlockCacheCapacity(void* arg) {
+  auto* self = static_cast<RocksResourceManager*>(arg);
+  return self->block_cache_ != nullptr ? self->block_cache_->GetCapacity() : 0;
+}
+
+int64_t RocksResourceManager::GetBlockCacheUsage(void* arg) {
+  auto* self = static_cast<RocksResourceManager*>(arg);
+  return self->block_cache_ != nullptr ? self->block_cache_->GetUsage() : 0;
+}
+
+int64_t RocksResourceManager::GetBlockCachePinnedUsage(void* arg) {
+  auto* self = static_cast<RocksResourceManager*>(arg);
+  return self->block_cache_ != nullptr ? self->block_cache_->GetPinnedUsage() : 0;
+}
+
+int64_t RocksResourceManager::GetWriteBufferLimit(void* arg) {
+  auto* self = static_cast<RocksResourceManager*>(arg);
+  return self->write_buffer_manager_ != nullptr ? self->write_buffer_manager_->buffer_size() : 0;
+}
+
+int64_t RocksResourceManager::GetWriteBufferUsage(void* arg) {
+  auto* self = static_cast<RocksResourceManager*>(arg);
+  return self->write_buffer_manager_ != nullptr ? self->write_buffer_manager_->memory_usage() : 0;
+}
+
+int64_t RocksResourceManager::GetRateLimitBytesPerSec(void* arg) {
+  auto* self = static_cast<RocksResourceManager*>(arg);
+  return self->rate_limiter_ != nullptr ? self->rate_limiter_->GetBytesPerSecond() : 0;
+}
+
+int64_t RocksResourceManager::GetRateLimitTotalBytes(void* arg) {
+  auto* self = static_cast<RocksResourceManager*>(arg);
+  return self->rate_limiter_ != nullptr ? self->rate_limiter_->GetTotalBytesThrough() : 0;
+}
+
+}  // namespace dingodb
@@ -0,0 +1,79 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_ENGINE_ROCKS_RESOURCE_H_
+#define DINGODB_ENGINE_ROCKS_RESOURCE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "bvar/passive_status.h"
+#include "config/config.h"
+#include "rocksdb/cache.h"
+#include "rocksdb/rate_limiter.h"
+#include "rocksdb/write_buffer_manager.h"
+
+template <typename T>
+struct DefaultSingletonTraits;
+
+namespace dingodb {
+
+// Store level rocksdb resource, shared by all column families,
+// so the memory and io of store is bounded by one budget instead of the sum of per column family budgets.
+class RocksResourceManager {
+ public:
+  static RocksResourceManager* GetInstance();
+
+  RocksResourceManager(const RocksResourceManager&) = delete;
+  const RocksResourceManager& operator=(const RocksResourceManager&) = delete;
+
+  bool Init(std::shared_ptr<Config> config);
+
+  // Return nullptr when not configured, column family use its own block cache.
+  std::shared_ptr<rocksdb::Cache> GetBlockCache() { return block_cache_; }
+  std::shared_ptr<rocksdb::WriteBufferManager> GetWriteBufferManager() { return write_buffer_manager_; }
+  std::shared_ptr<rocksdb::RateLimiter> GetRateLimiter() { return rate_limiter_; }
+
+ private:
+  RocksResourceManager();
+  ~RocksResourceManager() = default;
+
+  friend struct DefaultSingletonTraits<RocksResourceManager>;
+
+  static int64_t GetBlockCacheCapacity(void* arg);
+  static int64_t GetBlockCacheUsage(void* arg);
+  static int64_t GetBlockCachePinnedUsage(void* arg);
+  static int64_t GetWriteBufferLimit(void* arg);
+  static int64_t GetWriteBufferUsage(void* arg);
+  static int64_t GetRateLimitBytesPerSec(void* arg);
+  static int64_t GetRateLimitTotalBytes(void* arg);
+
+  std::shared_ptr<rocksdb::Cache> block_cache_;
+  std::shared_ptr<rocksdb::WriteBufferManager> write_buffer_manager_;
+  std::shared_ptr<rocksdb::RateLimiter> rate_limiter_;
+
+  // Metrics
+  bvar::PassiveStatus<int64_t> block_cache_capacity_;
+  bvar::PassiveStatus<int64_t> block_cache_usage_;
+  bvar::PassiveStatus<int64_t> block_cache_pinned_usage_;
+  bvar::PassiveStatus<int64_t> write_buffer_limit_;
+  bvar::PassiveStatus<int64_t> write_buffer_usage_;
+  bvar::PassiveStatus<int64_t> rate_limit_bytes_per_sec_;
+  bvar::PassiveStatus<int64_t> rate_limit_total_bytes_;
+};
+
+}  // namespace dingodb
+
+#endif  // DINGODB_ENGINE_ROCKS_RESOURCE_H_
@@ -26,12 +26,18 @@
 #include "proto/error.pb.h"
 #include "scan/scan.h"
 #include "scan/scan_manager.h"
+#include "store/bulk_load_manager.h"
 namespace dingodb {
 
-Storage::Storage(std::shared_ptr<Engine> engine) : engine_(engine) {}
+Storage::Storage(std::shared_ptr<Engine> engine)
+    : engine_(engine), write_batcher_(std::make_shared<WriteBatcher>(engine)) {}
 
 Storage::~Storage() = default;
 
+bool Storage::Init(std::shared_ptr<Config> config) { return write_batcher_->Init(config); }
+
+void Storage::DeleteRegion(uint64_t region_id) { write_batcher_->DeleteRegion(region_id); }
+
 Snapshot* Storage::GetSnapshot() { return nullptr; }
 
 void Storage::ReleaseSnapshot() {}
@@ -80,8 +86,15 @@ butil::Status Storage::KvGet(std::shared_ptr<Context> ctx, const std::vector<std
 }
 
 butil::Status Storage::KvPut(std::shared_ptr<Context> ctx, const std::vector<pb::common::KeyValue>& kvs) {
-  return engine_->AsyncWrite(
-      ctx, WriteDataBuilder::BuildWrite(ctx->CfName(), kvs), [](std::shared_ptr<Context> ctx, butil::Status status) {
+  // Fail fast before the write wait in merge window, so the caller can redirect to leader.
+  auto status = ValidateLeader(ctx->RegionId());
+  if (!status.ok()) {
+    return status;
+  }
+
+  return write_batcher_->AsyncWrite(
+      ctx, WriteDataBuilder::BuildWrite(ctx->CfName(), kvs), WriteBatcher::CalculateBytes(kvs),
+      [](std::shared_ptr<Context> ctx, butil::Status status) {
         if (!status.ok()) {
           Helper::SetPbMessageError(status, ctx->Response());
           if (ctx->Request() != nullptr && ctx->Response() != nullptr) {
@@ -129,22 +142,36 @@ butil::Status Storage::VectorSearch(std::shared_ptr<Context> ctx, const pb::comm
 
 butil::Status Storage::KvPutIfAbsent(std::shared_ptr<Context> ctx, const std::vector<pb::common::KeyValue>& kvs,
                                      bool is_atomic) {
-  return engine_->AsyncWrite(ctx, WriteDataBuilder::BuildWrite(ctx->CfName(), kvs, is_atomic),
-                             [](std::shared_ptr<Context> ctx, butil::Status status) {
-                               if (!status.ok()) {
-                                 Helper::SetPbMessageError(status, ctx->Response());
-                                 if (ctx->Request() != nullptr && ctx->Response() != nullptr) {
-                                   LOG(ERROR) << fmt::format("KvPutIfAbsent request: {} response: {}",
-                                                             ctx->Request()->ShortDebugString(),
-                                                             ctx->Response()->ShortDebugString());
-                                 }
-                               }
-                             });
+  // Fail fast before the write wait in merge window, so the caller can redirect to leader.
+  auto status = ValidateLeader(ctx->RegionId());
+  if (!status.ok()) {
+    return status;
+  }
+
+  return write_batcher_->AsyncWrite(ctx, WriteDataBuilder::BuildWrite(ctx->CfName(), kvs, is_atomic),
+                                    WriteBatcher::CalculateBytes(kvs),
+                                    [](std::shared_ptr<Context> ctx, butil::Status status) {
+                                      if (!status.ok()) {
+                                        Helper::SetPbMessageError(status, ctx->Response());
+                                        if (ctx->Request() != nullptr && ctx->Response() != nullptr) {
+                                          LOG(ERROR) << fmt::format("KvPutIfAbsent request: {} response: {}",
+                                                                    ctx->Request()->ShortDebugString(),
+                                                                    ctx->Response()->ShortDebugString());
+                                        }
+                                      }
+                                    });
 }
 
 butil::Status Storage::KvDelete(std::shared_ptr<Context> ctx, const std::vector<std::string>& keys) {
-  return engine_->AsyncWrite(
-      ctx, WriteDataBuilder::BuildWrite(ctx->CfName(), keys), [](std::shared_ptr<Context> ctx, butil::Status status) {
+  // Fail fast before the write wait in merge window, so the caller can redirect to leader.
+  auto status = ValidateLeader(ctx->RegionId());
+  if (!status.ok()) {
+    return status;
+  }
+
+  return write_batcher_->AsyncWrite(
+      ctx, WriteDataBuilder::BuildWrite(ctx->CfName(), keys), WriteBatcher::CalculateBytes(keys),
+      [](std::shared_ptr<Context> ctx, butil::Status status) {
         if (!status.ok()) {
           Helper::SetPbMessageError(status, ctx->Response());
           if (ctx->Request() != nullptr && ctx->Response() != nullptr) {
@@ -183,6 +210,47 @@ butil::Status Storage::KvCompareAndSet(std::shared_ptr<Context> ctx, const std::
                              });
 }
 
+butil::Status Storage::KvBulkLoadUpload(std::shared_ptr<Context> ctx, uint64_t load_id, const std::string& file_name,
+                                        uint64_t offset, const std::string& data, uint64_t& file_size) {
+  // Files are staged on leader, then ingest by leader.
+  auto status = ValidateLeader(ctx->RegionId());
+  if (!status.ok()) {
+    return status;
+  }
+
+  return BulkLoadManager::GetInstance()->Upload(ctx->RegionId(), load_id, file_name, offset, data, file_size);
+}
+
+butil::Status Storage::KvBulkLoadIngest(std::shared_ptr<Context> ctx, store::RegionPtr region, uint64_t load_id,
+                                        const std::vector<std::string>& file_names) {
+  auto status = ValidateLeader(ctx->RegionId());
+  if (!status.ok()) {
+    return status;
+  }
+
+  pb::raft::IngestSstRequest request;
+  status = BulkLoadManager::GetInstance()->PrepareIngest(region, ctx->CfName(), load_id, file_names, request);
+  if (!status.ok()) {
+    return status;
+  }
+  // Followers must have the files before the raft log is committed, apply never copy.
+  status = BulkLoadManager::GetInstance()->PrepareFollowers(region, request);
+  if (!status.ok()) {
+    return status;
+  }
+
+  return engine_->AsyncWrite(ctx, WriteDataBuilder::BuildWrite(request), [](std::shared_ptr<Context> ctx,
+                                                                              butil::Status status) {
+    if (!status.ok()) {
+      Helper::SetPbMessageError(status, ctx->Response());
+      if (ctx->Request() != nullptr && ctx->Response() != nullptr) {
+        LOG(ERROR) << fmt::format("KvBulkLoadIngest request: {} response: {}", ctx->Request()->ShortDebugString(),
+                                  ctx->Response()->ShortDebugString());
+      }
+    }
+  });
+}
+
 butil::Status Storage::KvScanBegin(std::shared_ptr<Context> ctx, const std::string& cf_name, uint64_t region_id,
                                    const pb::common::Range& range, uint64_t max_fetch_cnt, bool key_only,
                                    bool disable_auto_release, bool disable_coprocessor,
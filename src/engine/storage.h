@@ -20,8 +20,10 @@
 #include <vector>
 
 #include "common/context.h"
+#include "config/config.h"
 #include "engine/engine.h"
 #include "engine/raft_store_engine.h"
+#include "engine/write_batcher.h"
 #include "memory"
 #include "proto/common.pb.h"
 #include "proto/error.pb.h"
@@ -33,6 +35,8 @@ class Storage {
   Storage(std::shared_ptr<Engine> engine);
   ~Storage();
 
+  bool Init(std::shared_ptr<Config> config);
+
   static Snapshot* GetSnapshot();
   void ReleaseSnapshot();
 
@@ -62,6 +66,12 @@ class Storage {
 
   static butil::Status KvScanRelease(std::shared_ptr<Context> ctx, const std::string& scan_id);
 
+  // bulk load
+  butil::Status KvBulkLoadUpload(std::shared_ptr<Context> ctx, uint64_t load_id, const std::string& file_name,
+                                 uint64_t offset, const std::string& data, uint64_t& file_size);
+  butil::Status KvBulkLoadIngest(std::shared_ptr<Context> ctx, store::RegionPtr region, uint64_t load_id,
+                                 const std::vector<std::string>& file_names);
+
   // vector index
   butil::Status VectorAdd(std::shared_ptr<Context> ctx, const std::vector<pb::common::VectorWithId>& vectors);
   butil::Status VectorSearch(std::shared_ptr<Context> ctx, const pb::common::VectorWithId& vector,
@@ -69,10 +79,14 @@ class Storage {
                              std::vector<pb::common::VectorWithDistance>& results);
   butil::Status VectorDelete(std::shared_ptr<Context> ctx, const std::vector<uint64_t>& ids);
 
+  void DeleteRegion(uint64_t region_id);
+
  private:
   butil::Status ValidateLeader(uint64_t region_id);
 
   std::shared_ptr<Engine> engine_;
+  // Merge small writes into one raft log entry.
+  std::shared_ptr<WriteBatcher> write_batcher_;
 };
 
 }  // namespace dingodb
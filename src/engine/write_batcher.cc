@@ -0,0 +1,241 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "engine/write_batcher.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "brpc/closure_guard.h"
+#include "bthread/bthread.h"
+#include "common/constant.h"
+#include "common/logging.h"
+#include "common/synchronization.h"
+#include "fmt/core.h"
+#include "proto/error.pb.h"
+#include "server/service_helper.h"
+
+namespace dingodb {
+
+// Default write batch config
+static const uint32_t kWriteBatchMaxCountDefault = 128;
+static const uint64_t kWriteBatchMaxBytesDefault = 1 * 1024 * 1024;   // 1MB
+static const uint64_t kWriteBatchMaxRequestBytesDefault = 16 * 1024;  // 16KB
+
+RegionWriteBatcher::RegionWriteBatcher(uint64_t region_id, std::shared_ptr<Engine> engine, int64_t window_us,
+                                       uint32_t max_count, uint64_t max_bytes)
+    : region_id_(region_id),
+      engine_(engine),
+      window_us_(window_us),
+      max_count_(max_count),
+      max_bytes_(max_bytes),
+      pending_bytes_(0),
+      batch_seq_(0) {
+  bthread_mutex_init(&mutex_, nullptr);
+}
+
+RegionWriteBatcher::~RegionWriteBatcher() { bthread_mutex_destroy(&mutex_); }
+
+void RegionWriteBatcher::Submit(WriteBatchEntry entry, uint64_t write_bytes) {
+  std::vector<WriteBatchEntry> flush_entries;
+  bool is_first = false;
+  uint64_t batch_seq = 0;
+  {
+    BAIDU_SCOPED_LOCK(mutex_);
+    is_first = pending_entries_.empty();
+    pending_entries_.push_back(std::move(entry));
+    pending_bytes_ += write_bytes;
+    batch_seq = batch_seq_;
+
+    // Batch is full, flush right now.
+    if (pending_entries_.size() >= max_count_ || pending_bytes_ >= max_bytes_) {
+      flush_entries.swap(pending_entries_);
+      pending_bytes_ = 0;
+      ++batch_seq_;
+    }
+  }
+
+  if (!flush_entries.empty()) {
+    Flush(flush_entries);
+    return;
+  }
+
+  // The first write of batch open the merge window.
+  if (is_first) {
+    auto self = shared_from_this();
+    Bthread bth(&BTHREAD_ATTR_SMALL);
+    bth.Run([self, batch_seq]() {
+      bthread_usleep(self->window_us_);
+      self->FlushIfCurrent(batch_seq);
+    });
+  }
+}
+
+void RegionWriteBatcher::FlushIfCurrent(uint64_t batch_seq) {
+  std::vector<WriteBatchEntry> flush_entries;
+  {
+    BAIDU_SCOPED_LOCK(mutex_);
+    if (batch_seq != batch_seq_ || pending_entries_.empty()) {
+      return;
+    }
+
+    flush_entries.swap(pending_entries_);
+    pending_bytes_ = 0;
+    ++batch_seq_;
+  }
+
+  Flush(flush_entries);
+}
+
+void RegionWriteBatcher::Flush(std::vector<WriteBatchEntry>& entries) {
+  DINGO_LOG(DEBUG) << fmt::format("Flush write batch region {} count {}", region_id_, entries.size());
+
+  butil::Status status;
+  if (entries.size() == 1) {
+    auto& entry = entries[0];
+    status = engine_->AsyncWrite(entry.ctx, entry.write_data, entry.cb);
+  } else {
+    // All merged writes share one raft log entry, the raft request at index i belongs to the batch ctx at index i.
+    auto batch_ctx = std::make_shared<Context>();
+    batch_ctx->SetRegionId(region_id_);
+    auto write_data = std::make_shared<WriteData>();
+    for (auto& entry : entries) {
+      entry.ctx->SetWriteCb(entry.cb);
+      batch_ctx->AddBatchCtx(entry.ctx);
+      for (auto& datum : entry.write_data->Datums()) {
+        write_data->AddDatums(datum);
+      }
+    }
+
+    status = engine_->AsyncWrite(batch_ctx, write_data);
+  }
+
+  // Propose failed, the writes were accepted, so here must response them.
+  if (!status.ok()) {
+    DINGO_LOG(ERROR) << fmt::format("Flush write batch region {} failed, error: {} {}", region_id_,
+                                    status.error_code(), status.error_str());
+    for (auto& entry : entries) {
+      brpc::ClosureGuard const done_guard(entry.ctx->Done());
+      if (entry.cb) {
+        entry.cb(entry.ctx, status);
+      }
+      // Same as direct write, let client redirect to leader.
+      if (status.error_code() == pb::error::ERAFT_NOTLEADER && entry.ctx->Response() != nullptr) {
+        Helper::SetPbMessageError(butil::Status(pb::error::ERAFT_NOTLEADER, "Not leader, please redirect leader."),
+                                  entry.ctx->Response());
+        ServiceHelper::RedirectLeader(status.error_str(), entry.ctx->Response());
+      }
+    }
+  }
+}
+
+WriteBatcher::WriteBatcher(std::shared_ptr<Engine> engine)
+    : engine_(engine),
+      window_us_(0),
+      max_count_(kWriteBatchMaxCountDefault),
+      max_bytes_(kWriteBatchMaxBytesDefault),
+      max_request_bytes_(kWriteBatchMaxRequestBytesDefault) {
+  bthread_mutex_init(&mutex_, nullptr);
+}
+
+WriteBatcher::~WriteBatcher() { bthread_mutex_destroy(&mutex_); }
+
+bool WriteBatcher::Init(std::shared_ptr<Config> config) {
+  std::map<std::string, int> conf = config->GetIntMap(Constant::kStoreWriteBatch);
+
+  auto iter = conf.find(Constant::kWriteBatchWindowUs);
+  if (iter != conf.end()) {
+    if (iter->second < 0) {
+      DINGO_LOG(ERROR) << "store.write_batch.window_us illegal";
+      return false;
+    }
+    window_us_ = iter->second;
+  }
+
+  iter = conf.find(Constant::kWriteBatchMaxCount);
+  if (iter != conf.end() && iter->second > 0) {
+    max_count_ = iter->second;
+  }
+
+  iter = conf.find(Constant::kWriteBatchMaxBytes);
+  if (iter != conf.end() && iter->second > 0) {
+    max_bytes_ = iter->second;
+  }
+
+  iter = conf.find(Constant::kWriteBatchMaxRequestBytes);
+  if (iter != conf.end() && iter->second > 0) {
+    max_request_bytes_ = iter->second;
+  }
+
+  DINGO_LOG(INFO) << fmt::format("Write batch window_us {} max_count {} max_bytes {} max_request_bytes {}", window_us_,
+                                 max_count_, max_bytes_, max_request_bytes_);
+
+  return true;
+}
+
+std::shared_ptr<RegionWriteBatcher> WriteBatcher::GetOrCreateRegionBatcher(uint64_t region_id) {
+  BAIDU_SCOPED_LOCK(mutex_);
+  auto it = region_batchers_.find(region_id);
+  if (it != region_batchers_.end()) {
+    return it->second;
+  }
+
+  auto region_batcher = std::make_shared<RegionWriteBatcher>(region_id, engine_, window_us_, max_count_, max_bytes_);
+  region_batchers_.insert(std::make_pair(region_id, region_batcher));
+
+  return region_batcher;
+}
+
+void WriteBatcher::DeleteRegion(uint64_t region_id) {
+  BAIDU_SCOPED_LOCK(mutex_);
+  region_batchers_.erase(region_id);
+}
+
+butil::Status WriteBatcher::AsyncWrite(std::shared_ptr<Context> ctx, std::shared_ptr<WriteData> write_data,
+                                       uint64_t write_bytes, WriteCbFunc cb) {
+  if (!IsEnable() || engine_->GetID() != pb::common::ENG_RAFT_STORE || ctx->IsSyncMode() ||
+      write_data->Datums().size() != 1 || write_bytes > max_request_bytes_) {
+    return engine_->AsyncWrite(ctx, write_data, cb);
+  }
+
+  WriteBatchEntry entry;
+  entry.ctx = ctx;
+  entry.write_data = write_data;
+  entry.cb = cb;
+  GetOrCreateRegionBatcher(ctx->RegionId())->Submit(std::move(entry), write_bytes);
+
+  return butil::Status();
+}
+
+uint64_t WriteBatcher::CalculateBytes(const std::vector<pb::common::KeyValue>& kvs) {
+  uint64_t bytes = 0;
+  for (const auto& kv : kvs) {
+    bytes += kv.key().size() + kv.value().size();
+  }
+
+  return bytes;
+}
+
+uint64_t WriteBatcher::CalculateBytes(const std::vector<std::string>& keys) {
+  uint64_t bytes = 0;
+  for (const auto& key : keys) {
+    bytes += key.size();
+  }
+
+  return bytes;
+}
+
+}  // namespace dingodb
@@ -0,0 +1,115 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_ENGINE_WRITE_BATCHER_H_
+#define DINGODB_ENGINE_WRITE_BATCHER_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bthread/types.h"
+#include "butil/status.h"
+#include "common/context.h"
+#include "config/config.h"
+#include "engine/engine.h"
+#include "engine/write_data.h"
+#include "proto/common.pb.h"
+
+namespace dingodb {
+
+// Pending write waiting to be merged.
+struct WriteBatchEntry {
+  std::shared_ptr<Context> ctx;
+  std::shared_ptr<WriteData> write_data;
+  WriteCbFunc cb;
+};
+
+// Merge small writes of one region arriving within a short window into one raft log entry.
+// Every merged write keep its own context, the result fan out to it when raft log committed.
+class RegionWriteBatcher : public std::enable_shared_from_this<RegionWriteBatcher> {
+ public:
+  RegionWriteBatcher(uint64_t region_id, std::shared_ptr<Engine> engine, int64_t window_us, uint32_t max_count,
+                     uint64_t max_bytes);
+  ~RegionWriteBatcher();
+
+  RegionWriteBatcher(const RegionWriteBatcher&) = delete;
+  const RegionWriteBatcher& operator=(const RegionWriteBatcher&) = delete;
+
+  void Submit(WriteBatchEntry entry, uint64_t write_bytes);
+
+ private:
+  // Flush pending writes, skip when the pending batch already flushed.
+  void FlushIfCurrent(uint64_t batch_seq);
+  void Flush(std::vector<WriteBatchEntry>& entries);
+
+  uint64_t region_id_;
+  std::shared_ptr<Engine> engine_;
+
+  int64_t window_us_;
+  uint32_t max_count_;
+  uint64_t max_bytes_;
+
+  bthread_mutex_t mutex_;
+  std::vector<WriteBatchEntry> pending_entries_;
+  uint64_t pending_bytes_;
+  // Increase when pending writes flushed, be used to discard stale window timer.
+  uint64_t batch_seq_;
+};
+
+class WriteBatcher {
+ public:
+  WriteBatcher(std::shared_ptr<Engine> engine);
+  ~WriteBatcher();
+
+  WriteBatcher(const WriteBatcher&) = delete;
+  const WriteBatcher& operator=(const WriteBatcher&) = delete;
+
+  bool Init(std::shared_ptr<Config> config);
+
+  bool IsEnable() const { return window_us_ > 0; }
+
+  // Write data must be single datum, small write would be merged with other writes of the same region,
+  // otherwise write directly.
+  butil::Status AsyncWrite(std::shared_ptr<Context> ctx, std::shared_ptr<WriteData> write_data, uint64_t write_bytes,
+                           WriteCbFunc cb);
+
+  void DeleteRegion(uint64_t region_id);
+
+  static uint64_t CalculateBytes(const std::vector<pb::common::KeyValue>& kvs);
+  static uint64_t CalculateBytes(const std::vector<std::string>& keys);
+
+ private:
+  std::shared_ptr<RegionWriteBatcher> GetOrCreateRegionBatcher(uint64_t region_id);
+
+  std::shared_ptr<Engine> engine_;
+
+  // Merge window, 0 is disable write batch.
+  int64_t window_us_;
+  // Max merged write count of one batch.
+  uint32_t max_count_;
+  // Max merged bytes of one batch.
+  uint64_t max_bytes_;
+  // Write which bigger than it will not be merged.
+  uint64_t max_request_bytes_;
+
+  bthread_mutex_t mutex_;
+  std::map<uint64_t, std::shared_ptr<RegionWriteBatcher>> region_batchers_;
+};
+
+}  // namespace dingodb
+
+#endif  // DINGODB_ENGINE_WRITE_BATCHER_H_
@@ -37,6 +37,7 @@ enum class DatumType {
   kSplit = 5,
   kCompareAndSet = 6,
   kMetaPut = 7,
+  kIngestSst = 8,
 };
 
 class DatumAble {
@@ -266,6 +267,24 @@ struct SplitDatum : public DatumAble {
   std::string split_key;
 };
 
+struct IngestSstDatum : public DatumAble {
+  ~IngestSstDatum() override = default;
+  DatumType GetType() override { return DatumType::kIngestSst; }
+
+  pb::raft::Request* TransformToRaft() override {
+    auto* request = new pb::raft::Request();
+
+    request->set_cmd_type(pb::raft::CmdType::INGESTSST);
+    request->mutable_ingest_sst()->Swap(&ingest_sst_request);
+
+    return request;
+  }
+
+  void TransformFromRaft(pb::raft::Response& resonse) override {}
+
+  pb::raft::IngestSstRequest ingest_sst_request;
+};
+
 class WriteData {
  public:
   std::vector<std::shared_ptr<DatumAble>> Datums() const { return datums_; }
@@ -394,6 +413,17 @@ class WriteDataBuilder {
 
     return write_data;
   }
+
+  // IngestSstDatum
+  static std::shared_ptr<WriteData> BuildWrite(pb::raft::IngestSstRequest& ingest_sst_request) {
+    auto datum = std::make_shared<IngestSstDatum>();
+    datum->ingest_sst_request.Swap(&ingest_sst_request);
+
+    auto write_data = std::make_shared<WriteData>();
+    write_data->AddDatums(std::static_pointer_cast<DatumAble>(datum));
+
+    return write_data;
+  }
 };
 
 }  // namespace dingodb
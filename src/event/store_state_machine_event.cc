@@ -36,11 +36,15 @@ void SmApplyEventListener::OnEvent(std::shared_ptr<Event> event) {
   // Dispatch
   auto* done = dynamic_cast<StoreClosure*>(the_event->done);
   auto ctx = done ? done->GetCtx() : nullptr;
-  for (const auto& req : the_event->raft_cmd->requests()) {
+  const auto& requests = the_event->raft_cmd->requests();
+  for (int i = 0; i < requests.size(); ++i) {
+    const auto& req = requests.Get(i);
+    // Merged by write batcher, every request has its own context.
+    auto req_ctx = (ctx != nullptr && ctx->IsBatch()) ? ctx->BatchCtxs().at(i) : ctx;
     auto handler = handler_collection_->GetHandler(static_cast<HandlerType>(req.cmd_type()));
     if (handler) {
-      handler->Handle(ctx, the_event->region, the_event->engine, req, the_event->region_metrics, the_event->term_id,
-                      the_event->log_id);
+      handler->Handle(req_ctx, the_event->region, the_event->engine, req, the_event->region_metrics,
+                      the_event->term_id, the_event->log_id);
     } else {
       DINGO_LOG(ERROR) << "Unknown raft cmd type " << req.cmd_type();
     }
@@ -36,6 +36,7 @@ enum class HandlerType {
   kSplit = pb::raft::SPLIT,
   kMetaWrite = pb::raft::META_WRITE,
   kCompareAndSet = pb::raft::COMPAREANDSET,
+  kIngestSst = pb::raft::INGESTSST,
 
   // vector
   kVectorAdd = pb::raft::VECTOR_ADD,
@@ -21,15 +21,22 @@
 
 #include "common/helper.h"
 #include "common/logging.h"
+#include "engine/compaction_scheduler.h"
+#include "engine/raft_store_engine.h"
 #include "engine/raw_engine.h"
 #include "fmt/core.h"
+#include "gflags/gflags.h"
 #include "proto/common.pb.h"
 #include "proto/error.pb.h"
+#include "raft/store_state_machine.h"
 #include "server/server.h"
+#include "store/bulk_load_manager.h"
 #include "vector/codec.h"
 
 namespace dingodb {
 
+DECLARE_uint64(range_compaction_min_delete_keys);
+
 void PutHandler::Handle(std::shared_ptr<Context> ctx, store::RegionPtr region, std::shared_ptr<RawEngine> engine,
                         const pb::raft::Request &req, store::RegionMetricsPtr region_metrics, uint64_t /*term_id*/,
                         uint64_t /*log_id*/) {
@@ -253,12 +260,68 @@ void DeleteRangeHandler::Handle(std::shared_ptr<Context> ctx, store::RegionPtr r
     }
   }
 
+  // Drop range tombstones of big delete, or reads over the range stay slow until compaction.
+  if (status.ok() && delete_count >= FLAGS_range_compaction_min_delete_keys) {
+    for (const auto &range : request.ranges()) {
+      CompactionScheduler::GetInstance()->Schedule(engine, request.cf_name(), range,
+                                                   fmt::format("region {} delete range", region->Id()));
+    }
+  }
+
   // Update region metrics min/max key policy
   if (region_metrics != nullptr) {
     region_metrics->UpdateMaxAndMinKeyPolicy(request.ranges());
   }
 }
 
+// Stop applying and turn raft node to error state.
+static void SetApplyError(uint64_t region_id, const butil::Status &status) {
+  auto engine = std::dynamic_pointer_cast<RaftStoreEngine>(Server::GetInstance()->GetEngine());
+  auto node = engine != nullptr ? engine->GetNode(region_id) : nullptr;
+  auto *state_machine = node != nullptr ? dynamic_cast<StoreStateMachine *>(node->GetStateMachine()) : nullptr;
+  if (state_machine == nullptr) {
+    DINGO_LOG(FATAL) << fmt::format("[bulk_load][region({})] not found state machine", region_id);
+    return;
+  }
+  state_machine->SetApplyError(status);
+}
+
+void IngestSstHandler::Handle(std::shared_ptr<Context> ctx, store::RegionPtr region, std::shared_ptr<RawEngine> engine,
+                              const pb::raft::Request &req, store::RegionMetricsPtr region_metrics,
+                              uint64_t /*term_id*/, uint64_t /*log_id*/) {
+  uint64_t kv_count = 0;
+  auto status = BulkLoadManager::GetInstance()->Ingest(engine, region, req.ingest_sst(), kv_count);
+  if (!status.ok()) {
+    DINGO_LOG(ERROR) << fmt::format("[bulk_load][region({})] ingest sst failed, error: {} {}", region->Id(),
+                                    pb::error::Errno_Name(status.error_code()), status.error_str());
+    // Range check is the same on every replica, others are local failure, replica would diverge if go on.
+    if (status.error_code() != pb::error::EKEY_OUT_OF_RANGE) {
+      SetApplyError(region->Id(), status);
+      return;
+    }
+  }
+
+  if (ctx && ctx->Response()) {
+    auto *response = dynamic_cast<pb::store::KvBulkLoadIngestResponse *>(ctx->Response());
+    if (response) {
+      ctx->SetStatus(status);
+      response->set_kv_count(kv_count);
+    }
+  }
+
+  if (!status.ok()) {
+    return;
+  }
+
+  // Snapshot right now, staging files are needed by replay raft log after restart until the snapshot saved.
+  BulkLoadManager::SnapshotAndRemoveStaging(region->Id(), req.ingest_sst().load_id());
+
+  // Update region metrics min/max key policy
+  if (region_metrics != nullptr) {
+    region_metrics->UpdateMaxAndMinKeyPolicy();
+  }
+}
+
 void DeleteBatchHandler::Handle(std::shared_ptr<Context> ctx, store::RegionPtr region,
                                 std::shared_ptr<RawEngine> engine, const pb::raft::Request &req,
                                 store::RegionMetricsPtr region_metrics, uint64_t /*term_id*/, uint64_t /*log_id*/) {
@@ -540,6 +603,7 @@ std::shared_ptr<HandlerCollection> RaftApplyHandlerFactory::Build() {
   handler_collection->Register(std::make_shared<DeleteBatchHandler>());
   handler_collection->Register(std::make_shared<SplitHandler>());
   handler_collection->Register(std::make_shared<CompareAndSetHandler>());
+  handler_collection->Register(std::make_shared<IngestSstHandler>());
   handler_collection->Register(std::make_shared<VectorAddHandler>());
   handler_collection->Register(std::make_shared<VectorDeleteHandler>());
 
@@ -68,6 +68,15 @@ class DeleteBatchHandler : public BaseHandler {
               uint64_t log_id) override;
 };
 
+// IngestSstRequest
+class IngestSstHandler : public BaseHandler {
+ public:
+  HandlerType GetType() override { return HandlerType::kIngestSst; }
+  void Handle(std::shared_ptr<Context> ctx, store::RegionPtr region, std::shared_ptr<RawEngine> engine,
+              const pb::raft::Request &req, store::RegionMetricsPtr region_metrics, uint64_t term_id,
+              uint64_t log_id) override;
+};
+
 // SplitHandler
 class SplitHandler : public BaseHandler {
  public:
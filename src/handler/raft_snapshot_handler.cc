@@ -49,7 +49,10 @@ butil::Status RaftSnapshot::GenSnapshotFileByScan(const std::string& checkpoint_
   auto range = region->Range();
   // Build Iterator
   IteratorOptions options;
+  options.lower_bound = range.start_key();
   options.upper_bound = range.end_key();
+  options.readahead_size = Constant::kRocksdbBulkScanReadaheadSize;
+  options.fill_cache = false;
 
   auto iter = raw_engine->NewIterator(Constant::kStoreDataCF, engine_snapshot_, options);
   iter->Seek(range.start_key());
@@ -234,11 +237,8 @@ bool RaftSnapshot::LoadSnapshot(braft::SnapshotReader* reader, store::RegionPtr
       DINGO_LOG(ERROR) << "Load index failed, region_id: " << region->Id() << ", error: " << status.error_str();
       return false;
     }
-    status = Server::GetInstance()->GetVectorIndexManager()->SaveVectorIndex(region);
-    if (!status.ok()) {
-      DINGO_LOG(ERROR) << "Save index failed, region_id: " << region->Id() << ", error: " << status.error_str();
-      return false;
-    }
+    // Save at background, not block raft apply.
+    Server::GetInstance()->GetVectorIndexManager()->AsyncSaveVectorIndex(region->Id());
   }
 
   return status.ok();
@@ -0,0 +1,329 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "log/segment_log_io.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#ifdef WITH_IO_URING
+#include <liburing.h>
+#endif
+
+#include "braft/fsync.h"
+#include "braft/util.h"
+#include "bthread/countdown_event.h"
+#include "butil/memory/singleton.h"
+#include "butil/time.h"
+#include "bvar/latency_recorder.h"
+#include "bvar/reducer.h"
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "gflags/gflags.h"
+
+namespace dingodb {
+
+DEFINE_bool(segment_log_use_io_uring, false,
+            "Use io_uring for segment log io when built with io_uring, take effect at startup");
+DEFINE_uint32(segment_log_io_uring_depth, 256, "Submission queue depth of segment log io_uring");
+
+static bvar::Adder<int64_t> g_segment_log_io_uring_inflight("segment_log_io_uring_inflight");
+static bvar::LatencyRecorder g_segment_log_io_uring_latency("segment_log_io_uring");
+
+struct SegmentLogIo::Request {
+  enum Op { kWritev, kRead, kFsync };
+
+  Op op;
+  int fd = -1;
+  const struct iovec* iov = nullptr;
+  int iovcnt = 0;
+  void* buf = nullptr;
+  size_t size = 0;
+  off_t offset = 0;
+  // cqe result, negative errno on failure.
+  int result = 0;
+  bthread::CountdownEvent event{1};
+};
+
+SegmentLogIo* SegmentLogIo::GetInstance() { return Singleton<SegmentLogIo>::get(); }
+
+#ifdef WITH_IO_URING
+
+SegmentLogIo::SegmentLogIo() : ring_(nullptr), max_inflight_(0) {
+  if (!FLAGS_segment_log_use_io_uring) {
+    return;
+  }
+
+  auto* ring = new struct io_uring;
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  int ret = io_uring_queue_init_params(FLAGS_segment_log_io_uring_depth, ring, &params);
+  if (ret < 0) {
+    DINGO_LOG(WARNING) << fmt::format("[segment_log_io] init io_uring failed, error: {}, fall back to blocking io",
+                                      strerror(-ret));
+    delete ring;
+    return;
+  }
+
+  ring_ = ring;
+  // Kernel round up the depth, completion queue is at least as large as submission queue.
+  max_inflight_ = static_cast<int>(std::min(params.sq_entries, params.cq_entries));
+  reap_thread_ = std::thread([this]() { ReapCompletions(); });
+  DINGO_LOG(INFO) << fmt::format("[segment_log_io] use io_uring, depth: {}, max inflight: {}",
+                                 FLAGS_segment_log_io_uring_depth, max_inflight_);
+}
+
+static struct io_uring_sqe* GetSqe(struct io_uring* ring) {
+  auto* sqe = io_uring_get_sqe(ring);
+  while (sqe == nullptr) {
+    // Submission queue is full, flush it to kernel.
+    io_uring_submit(ring);
+    sqe = io_uring_get_sqe(ring);
+  }
+  return sqe;
+}
+
+SegmentLogIo::~SegmentLogIo() {
+  if (ring_ == nullptr) {
+    return;
+  }
+
+  {
+    // Nop without data tell reap thread to stop.
+    inflight_cond_.IncreaseWait(max_inflight_);
+    BAIDU_SCOPED_LOCK(submit_mutex_);
+    auto* sqe = GetSqe(ring_);
+    io_uring_prep_nop(sqe);
+    io_uring_sqe_set_data(sqe, nullptr);
+    io_uring_submit(ring_);
+  }
+  reap_thread_.join();
+
+  io_uring_queue_exit(ring_);
+  delete ring_;
+  ring_ = nullptr;
+}
+
+int SegmentLogIo::Submit(Request* request) {
+  int64_t start_time = butil::gettimeofday_us();
+  // Wait until a completion slot is free.
+  inflight_cond_.IncreaseWait(max_inflight_);
+  g_segment_log_io_uring_inflight << 1;
+  {
+    BAIDU_SCOPED_LOCK(submit_mutex_);
+    auto* sqe = GetSqe(ring_);
+    switch (request->op) {
+      case Request::kWritev:
+        io_uring_prep_writev(sqe, request->fd, request->iov, request->iovcnt, request->offset);
+        break;
+      case Request::kRead:
+        io_uring_prep_read(sqe, request->fd, request->buf, request->size, request->offset);
+        break;
+      case Request::kFsync:
+        io_uring_prep_fsync(sqe, request->fd,
+                            braft::FLAGS_raft_use_fsync_rather_than_fdatasync ? 0 : IORING_FSYNC_DATASYNC);
+        break;
+    }
+    io_uring_sqe_set_data(sqe, request);
+
+    int ret = 0;
+    do {
+      ret = io_uring_submit(ring_);
+    } while (ret == -EINTR || ret == -EAGAIN || ret == -EBUSY);
+    if (ret < 0) {
+      // The sqe is still in ring and point to request, can not return safely.
+      DINGO_LOG(FATAL) << fmt::format("[segment_log_io] submit io_uring failed, error: {}", strerror(-ret));
+    }
+  }
+
+  // Suspend bthread only, the worker thread go on running other bthreads.
+  request->event.wait();
+  g_segment_log_io_uring_inflight << -1;
+  inflight_cond_.DecreaseSignal();
+  g_segment_log_io_uring_latency << butil::gettimeofday_us() - start_time;
+
+  return request->result;
+}
+
+void SegmentLogIo::ReapCompletions() {
+  for (;;) {
+    struct io_uring_cqe* cqe = nullptr;
+    int ret = io_uring_wait_cqe(ring_, &cqe);
+    if (ret < 0) {
+      if (ret == -EINTR || ret == -EAGAIN) {
+        continue;
+      }
+      DINGO_LOG(FATAL) << fmt::format("[segment_log_io] wait io_uring completion failed, error: {}", strerror(-ret));
+    }
+
+    auto* request = static_cast<Request*>(io_uring_cqe_get_data(cqe));
+    int result = cqe->res;
+    io_uring_cqe_seen(ring_, cqe);
+    if (request == nullptr) {
+      break;
+    }
+
+    request->result = result;
+    request->event.signal();
+  }
+}
+
+#else
+
+SegmentLogIo::SegmentLogIo() : ring_(nullptr), max_inflight_(0) {
+  if (FLAGS_segment_log_use_io_uring) {
+    DINGO_LOG(WARNING) << "[segment_log_io] not built with io_uring, fall back to blocking io";
+  }
+}
+
+SegmentLogIo::~SegmentLogIo() = default;
+
+int SegmentLogIo::Submit(Request* /*request*/) { return -ENOTSUP; }
+
+void SegmentLogIo::ReapCompletions() {}
+
+#endif  // WITH_IO_URING
+
+ssize_t SegmentLogIo::Write(int fd, butil::IOBuf* pieces[], size_t count, off_t offset) {
+  size_t to_write = 0;
+  for (size_t i = 0; i < count; ++i) {
+    to_write += pieces[i]->length();
+  }
+
+  ssize_t written = 0;
+  if (!IsAsync()) {
+    size_t start = 0;
+    while (written < static_cast<ssize_t>(to_write)) {
+      const ssize_t n =
+          butil::IOBuf::cut_multiple_into_file_descriptor(fd, pieces + start, count - start, offset + written);
+      if (n < 0) {
+        return -1;
+      }
+      written += n;
+      for (; start < count && pieces[start]->empty(); ++start) {
+      }
+    }
+    return written;
+  }
+
+  // Refer blocks of pieces directly, pieces are kept until write completed.
+  std::vector<struct iovec> iovs;
+  for (size_t i = 0; i < count; ++i) {
+    for (size_t j = 0; j < pieces[i]->backing_block_num(); ++j) {
+      auto block = pieces[i]->backing_block(j);
+      iovs.push_back({const_cast<char*>(block.data()), block.size()});
+    }
+  }
+
+  size_t start = 0;
+  while (start < iovs.size()) {
+    Request request;
+    request.op = Request::kWritev;
+    request.fd = fd;
+    request.iov = &iovs[start];
+    request.iovcnt = static_cast<int>(std::min(iovs.size() - start, static_cast<size_t>(IOV_MAX)));
+    request.offset = offset + written;
+    int ret = Submit(&request);
+    if (ret <= 0) {
+      errno = ret < 0 ? -ret : EIO;
+      return -1;
+    }
+    written += ret;
+
+    // Skip written iovs, short write continue from the middle of iov.
+    size_t n = ret;
+    while (n > 0 && start < iovs.size()) {
+      if (n >= iovs[start].iov_len) {
+        n -= iovs[start].iov_len;
+        ++start;
+      } else {
+        iovs[start].iov_base = static_cast<char*>(iovs[start].iov_base) + n;
+        iovs[start].iov_len -= n;
+        n = 0;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    pieces[i]->clear();
+  }
+  return written;
+}
+
+ssize_t SegmentLogIo::Read(int fd, butil::IOPortal* portal, off_t offset, size_t size) {
+  if (!IsAsync()) {
+    return braft::file_pread(portal, fd, offset, size);
+  }
+  if (size == 0) {
+    return 0;
+  }
+
+  void* buf = malloc(size);
+  if (buf == nullptr) {
+    errno = ENOMEM;
+    return -1;
+  }
+
+  size_t read_bytes = 0;
+  while (read_bytes < size) {
+    Request request;
+    request.op = Request::kRead;
+    request.fd = fd;
+    request.buf = static_cast<char*>(buf) + read_bytes;
+    request.size = size - read_bytes;
+    request.offset = offset + read_bytes;
+    int ret = Submit(&request);
+    if (ret < 0) {
+      free(buf);
+      errno = -ret;
+      return -1;
+    }
+    // End of file
+    if (ret == 0) {
+      break;
+    }
+    read_bytes += ret;
+  }
+
+  if (read_bytes == 0) {
+    free(buf);
+    return 0;
+  }
+  // Hand over buf to portal without copy.
+  portal->append_user_data(buf, read_bytes, free);
+  return read_bytes;
+}
+
+int SegmentLogIo::Fsync(int fd) {
+  if (!IsAsync()) {
+    return braft::raft_fsync(fd);
+  }
+
+  Request request;
+  request.op = Request::kFsync;
+  request.fd = fd;
+  int ret = Submit(&request);
+  if (ret < 0) {
+    errno = -ret;
+    return -1;
+  }
+  return 0;
+}
+
+}  // namespace dingodb
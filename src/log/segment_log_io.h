@@ -0,0 +1,78 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_LOG_SEGMENT_LOG_IO_H_
+#define DINGODB_LOG_SEGMENT_LOG_IO_H_
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <cstddef>
+#include <thread>
+
+#include "bthread/mutex.h"
+#include "butil/iobuf.h"
+#include "common/synchronization.h"
+
+template <typename T>
+struct DefaultSingletonTraits;
+
+struct io_uring;
+
+namespace dingodb {
+
+// Disk io of segment log.
+// With io_uring(build WITH_IO_URING and enable segment_log_use_io_uring), io is submitted to a ring and
+// completions are reaped by a dedicated thread, the calling bthread is suspended instead of blocking its worker.
+// Otherwise fall back to blocking syscall on the calling thread.
+class SegmentLogIo {
+ public:
+  static SegmentLogIo* GetInstance();
+
+  SegmentLogIo(const SegmentLogIo&) = delete;
+  const SegmentLogIo& operator=(const SegmentLogIo&) = delete;
+
+  bool IsAsync() const { return ring_ != nullptr; }
+
+  // Write all pieces at offset, pieces are consumed, return written bytes or -1.
+  ssize_t Write(int fd, butil::IOBuf* pieces[], size_t count, off_t offset);
+  // Read size bytes at offset and append to portal, return read bytes(less than size at end of file) or -1.
+  ssize_t Read(int fd, butil::IOPortal* portal, off_t offset, size_t size);
+  // Same as braft::raft_fsync.
+  int Fsync(int fd);
+
+ private:
+  SegmentLogIo();
+  ~SegmentLogIo();
+
+  friend struct DefaultSingletonTraits<SegmentLogIo>;
+
+  struct Request;
+
+  // Submit request to ring and wait its completion, return cqe result.
+  int Submit(Request* request);
+  void ReapCompletions();
+
+  struct io_uring* ring_;
+  // io_uring_get_sqe/io_uring_submit are not thread safe.
+  bthread::Mutex submit_mutex_;
+  // In flight requests are bounded by ring size, so the completion queue never overflow.
+  BthreadCond inflight_cond_;
+  int max_inflight_;
+  std::thread reap_thread_;
+};
+
+}  // namespace dingodb
+
+#endif  // DINGODB_LOG_SEGMENT_LOG_IO_H_
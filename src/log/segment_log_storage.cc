@@ -14,7 +14,12 @@
 
 #include "log/segment_log_storage.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <set>
+#include <utility>
+#include <vector>
 
 #include "braft/fsync.h"
 #include "braft/local_storage.pb.h"
@@ -28,10 +33,14 @@
 #include "butil/raw_pack.h"                // butil::RawPacker
 #include "butil/string_printf.h"           // butil::string_appendf
 #include "butil/time.h"
+#include "bvar/passive_status.h"
+#include "bvar/reducer.h"
 #include "common/constant.h"
 #include "common/failpoint.h"
 #include "common/logging.h"
+#include "common/synchronization.h"
 #include "gflags/gflags.h"
+#include "log/segment_log_io.h"
 
 #define SEGMENT_OPEN_PATTERN "log_inprogress_%020" PRId64
 #define SEGMENT_CLOSED_PATTERN "log_%020" PRId64 "_%020" PRId64
@@ -48,6 +57,25 @@ static bvar::LatencyRecorder g_segment_log_open_segment_latency("segment_log_ope
 static bvar::LatencyRecorder g_segment_log_append_entry_latency("segment_log_append_entry");
 static bvar::LatencyRecorder g_segment_log_sync_segment_latency("segment_log_sync_segment");
 
+DEFINE_int64(segment_log_entry_cache_bytes, 4 * 1024 * 1024,
+             "Max bytes of recently appended log entries cached by one log storage, 0 is disable");
+DEFINE_int64(segment_log_entry_cache_total_bytes, 1024 * 1024 * 1024,
+             "Max bytes of log entries cached by all log storages");
+DEFINE_int32(segment_log_readahead_entries, 64, "Max number of log entries read by one sequential read");
+DEFINE_int64(segment_log_readahead_bytes, 1024 * 1024, "Max bytes of log entries read by one sequential read");
+DEFINE_int32(segment_log_readahead_windows, 4,
+             "Number of sequential read windows kept by one log storage, one for each follower catching up");
+
+static butil::atomic<int64_t> g_segment_log_entry_cache_bytes(0);
+static int64_t GetSegmentLogEntryCacheBytes(void*) {
+  return g_segment_log_entry_cache_bytes.load(butil::memory_order_relaxed);
+}
+static bvar::PassiveStatus<int64_t> g_segment_log_entry_cache_bytes_metric("segment_log_entry_cache_bytes",
+                                                                            GetSegmentLogEntryCacheBytes, nullptr);
+static bvar::Adder<int64_t> g_segment_log_entry_cache_hit("segment_log_entry_cache_hit");
+static bvar::Adder<int64_t> g_segment_log_entry_cache_miss("segment_log_entry_cache_miss");
+static bvar::LatencyRecorder g_segment_log_readahead_latency("segment_log_readahead");
+
 int FtruncateUninterrupted(int fd, off_t length) {
   int rc = 0;
   do {
@@ -159,40 +187,24 @@ int Segment::Create() {
 int Segment::LoadEntry(off_t offset, EntryHeader* head, butil::IOBuf* data, size_t size_hint) const {
   butil::IOPortal buf;
   size_t to_read = std::max(size_hint, kEntryHeaderSize);
-  const ssize_t n = braft::file_pread(&buf, fd_, offset, to_read);
+  const ssize_t n = SegmentLogIo::GetInstance()->Read(fd_, &buf, offset, to_read);
   if (n != (ssize_t)to_read) {
     return n < 0 ? -1 : 1;
   }
   char header_buf[kEntryHeaderSize];
   const char* p = (const char*)buf.fetch(header_buf, kEntryHeaderSize);
-  int64_t term = 0;
-  uint32_t meta_field;
-  uint32_t data_len = 0;
-  uint32_t data_checksum = 0;
-  uint32_t header_checksum = 0;
-  RawUnpacker(p)
-      .unpack64((uint64_t&)term)
-      .unpack32(meta_field)
-      .unpack32(data_len)
-      .unpack32(data_checksum)
-      .unpack32(header_checksum);
   EntryHeader tmp;
-  tmp.term = term;
-  tmp.type = meta_field >> 24;
-  tmp.checksum_type = (meta_field << 8) >> 24;
-  tmp.data_len = data_len;
-  tmp.data_checksum = data_checksum;
-  if (!VerifyChecksum(tmp.checksum_type, p, kEntryHeaderSize - 4, header_checksum)) {
-    DINGO_LOG(ERROR) << "Found corrupted header at offset=" << offset << ", header=" << tmp << ", path: " << path_;
+  if (!DecodeHeader(offset, p, &tmp)) {
     return -1;
   }
+  uint32_t data_len = tmp.data_len;
   if (head != nullptr) {
     *head = tmp;
   }
   if (data != nullptr) {
     if (buf.length() < kEntryHeaderSize + data_len) {
       const size_t to_read = kEntryHeaderSize + data_len - buf.length();
-      const ssize_t n = braft::file_pread(&buf, fd_, offset + buf.length(), to_read);
+      const ssize_t n = SegmentLogIo::GetInstance()->Read(fd_, &buf, offset + buf.length(), to_read);
       if (n != (ssize_t)to_read) {
         return n < 0 ? -1 : 1;
       }
@@ -212,6 +224,30 @@ int Segment::LoadEntry(off_t offset, EntryHeader* head, butil::IOBuf* data, size
   return 0;
 }
 
+bool Segment::DecodeHeader(off_t offset, const char* buf, EntryHeader* head) const {
+  int64_t term = 0;
+  uint32_t meta_field;
+  uint32_t data_len = 0;
+  uint32_t data_checksum = 0;
+  uint32_t header_checksum = 0;
+  RawUnpacker(buf)
+      .unpack64((uint64_t&)term)
+      .unpack32(meta_field)
+      .unpack32(data_len)
+      .unpack32(data_checksum)
+      .unpack32(header_checksum);
+  head->term = term;
+  head->type = meta_field >> 24;
+  head->checksum_type = (meta_field << 8) >> 24;
+  head->data_len = data_len;
+  head->data_checksum = data_checksum;
+  if (!VerifyChecksum(head->checksum_type, buf, kEntryHeaderSize - 4, header_checksum)) {
+    DINGO_LOG(ERROR) << "Found corrupted header at offset=" << offset << ", header=" << *head << ", path: " << path_;
+    return false;
+  }
+  return true;
+}
+
 int Segment::GetMeta(int64_t index, LogMeta* meta) const {
   BAIDU_SCOPED_LOCK(mutex_);
   if (index > last_index_.load(butil::memory_order_relaxed) || index < first_index_) {
@@ -385,17 +421,10 @@ int Segment::Append(const braft::LogEntry* entry) {
   header.append(header_buf, kEntryHeaderSize);
   const size_t to_write = header.length() + data.length();
   butil::IOBuf* pieces[2] = {&header, &data};
-  size_t start = 0;
-  ssize_t written = 0;
-  while (written < (ssize_t)to_write) {
-    const ssize_t n = butil::IOBuf::cut_multiple_into_file_descriptor(fd_, pieces + start, ARRAY_SIZE(pieces) - start);
-    if (n < 0) {
-      DINGO_LOG(ERROR) << "Fail to write to fd=" << fd_ << ", path: " << path_ << berror();
-      return -1;
-    }
-    written += n;
-    for (; start < ARRAY_SIZE(pieces) && pieces[start]->empty(); ++start) {
-    }
+  const ssize_t written = SegmentLogIo::GetInstance()->Write(fd_, pieces, ARRAY_SIZE(pieces), bytes_);
+  if (written != (ssize_t)to_write) {
+    DINGO_LOG(ERROR) << "Fail to write to fd=" << fd_ << ", path: " << path_ << berror();
+    return -1;
   }
   BAIDU_SCOPED_LOCK(mutex_);
   offset_and_term_.push_back(std::make_pair(bytes_, entry->id.term));
@@ -416,63 +445,118 @@ int Segment::Sync(bool will_sync) {
       return 0;
     }
     unsynced_bytes_ = 0;
-    return braft::raft_fsync(fd_);
+    return SegmentLogIo::GetInstance()->Fsync(fd_);
   }
   return 0;
 }
 
+braft::LogEntry* Segment::BuildEntry(int64_t index, const EntryHeader& header, butil::IOBuf& data) const {
+  auto* entry = new braft::LogEntry();
+  entry->AddRef();
+  switch (header.type) {
+    case braft::ENTRY_TYPE_DATA:
+      entry->data.swap(data);
+      break;
+    case braft::ENTRY_TYPE_NO_OP:
+      CHECK(data.empty()) << "Data of NO_OP must be empty";
+      break;
+    case braft::ENTRY_TYPE_CONFIGURATION: {
+      butil::Status status = parse_configuration_meta(data, entry);
+      if (!status.ok()) {
+        DINGO_LOG(WARNING) << "Fail to parse ConfigurationPBMeta, path: " << path_;
+        entry->Release();
+        return nullptr;
+      }
+    } break;
+    default:
+      CHECK(false) << "Unknown entry type, path: " << path_;
+      break;
+  }
+
+  entry->id.index = index;
+  entry->id.term = header.term;
+  entry->type = (braft::EntryType)header.type;
+  return entry;
+}
+
 braft::LogEntry* Segment::Get(int64_t index) const {
   LogMeta meta;
   if (GetMeta(index, &meta) != 0) {
     return nullptr;
   }
 
-  bool ok = true;
-  braft::LogEntry* entry = nullptr;
-  do {
-    braft::ConfigurationPBMeta configuration_meta;
+  EntryHeader header;
+  butil::IOBuf data;
+  if (LoadEntry(meta.offset, &header, &data, meta.length) != 0) {
+    return nullptr;
+  }
+  CHECK_EQ(meta.term, header.term);
+
+  return BuildEntry(index, header, data);
+}
+
+int Segment::GetRange(int64_t start_index, size_t max_count, size_t max_bytes,
+                      std::vector<braft::LogEntry*>& entries) const {
+  std::vector<LogMeta> metas;
+  size_t total_bytes = 0;
+  for (int64_t index = start_index; metas.size() < std::max(max_count, static_cast<size_t>(1)); ++index) {
+    LogMeta meta;
+    if (GetMeta(index, &meta) != 0) {
+      break;
+    }
+    // at least one entry
+    if (!metas.empty() && total_bytes + meta.length > max_bytes) {
+      break;
+    }
+    total_bytes += meta.length;
+    metas.push_back(meta);
+  }
+  if (metas.empty()) {
+    return -1;
+  }
+
+  // entries are continuous in file, read them by one pread
+  butil::IOPortal buf;
+  const ssize_t n = SegmentLogIo::GetInstance()->Read(fd_, &buf, metas.front().offset, total_bytes);
+  if (n != static_cast<ssize_t>(total_bytes)) {
+    DINGO_LOG(ERROR) << "Fail to read log entries at offset=" << metas.front().offset << " size=" << total_bytes
+                     << ", path: " << path_;
+    return -1;
+  }
+
+  entries.reserve(entries.size() + metas.size());
+  for (size_t i = 0; i < metas.size(); ++i) {
+    const auto& meta = metas[i];
+    butil::IOBuf piece;
+    buf.cutn(&piece, meta.length);
+
+    char header_buf[kEntryHeaderSize];
+    const char* p = (const char*)piece.fetch(header_buf, kEntryHeaderSize);
     EntryHeader header;
-    butil::IOBuf data;
-    if (LoadEntry(meta.offset, &header, &data, meta.length) != 0) {
-      ok = false;
+    if (p == nullptr || !DecodeHeader(meta.offset, p, &header)) {
       break;
     }
     CHECK_EQ(meta.term, header.term);
-    entry = new braft::LogEntry();
-    entry->AddRef();
-    switch (header.type) {
-      case braft::ENTRY_TYPE_DATA:
-        entry->data.swap(data);
-        break;
-      case braft::ENTRY_TYPE_NO_OP:
-        CHECK(data.empty()) << "Data of NO_OP must be empty";
-        break;
-      case braft::ENTRY_TYPE_CONFIGURATION: {
-        butil::Status status = parse_configuration_meta(data, entry);
-        if (!status.ok()) {
-          DINGO_LOG(WARNING) << "Fail to parse ConfigurationPBMeta, path: " << path_;
-          ok = false;
-          break;
-        }
-      } break;
-      default:
-        CHECK(false) << "Unknown entry type, path: " << path_;
-        break;
+    if (piece.length() != kEntryHeaderSize + header.data_len) {
+      DINGO_LOG(ERROR) << "Found mismatch entry length at offset=" << meta.offset << " header=" << header
+                       << " path: " << path_;
+      break;
     }
-
-    if (!ok) {
+    piece.pop_front(kEntryHeaderSize);
+    if (!VerifyChecksum(header.checksum_type, piece, header.data_checksum)) {
+      DINGO_LOG(ERROR) << "Found corrupted data at offset=" << meta.offset + kEntryHeaderSize << " header=" << header
+                       << " path: " << path_;
       break;
     }
-    entry->id.index = index;
-    entry->id.term = header.term;
-    entry->type = (braft::EntryType)header.type;
-  } while (false);
 
-  if (!ok && entry != nullptr) {
-    entry->Release();
-    entry = nullptr;
+    auto* entry = BuildEntry(start_index + i, header, piece);
+    if (entry == nullptr) {
+      break;
+    }
+    entries.push_back(entry);
   }
-  return entry;
+
+  return 0;
 }
 
 int64_t Segment::GetTerm(int64_t index) const {
@@ -498,7 +582,7 @@ int Segment::Close(bool will_sync) {
   int ret = 0;
   if (last_index_ > first_index_) {
     if (Constant::kSegmentLogSync && will_sync) {
-      ret = braft::raft_fsync(fd_);
+      ret = SegmentLogIo::GetInstance()->Fsync(fd_);
     }
   }
   if (ret == 0) {
@@ -616,6 +700,210 @@ int Segment::Truncate(int64_t last_index_kept) {
   return ret;
 }
 
+// Non-empty caches ordered by indexed append seq, for global eviction.
+static bthread::Mutex g_log_entry_caches_mutex;
+static std::set<std::pair<int64_t, LogEntryCache*>> g_log_entry_caches;
+static butil::atomic<int64_t> g_log_entry_cache_append_seq(0);
+
+LogEntryCache::LogEntryCache(int64_t max_bytes)
+    : max_bytes_(max_bytes), bytes_(0), first_index_(0), append_seq_(0), indexed_seq_(0), indexed_(false) {}
+
+LogEntryCache::~LogEntryCache() {
+  {
+    BAIDU_SCOPED_LOCK(g_log_entry_caches_mutex);
+    if (indexed_.load(std::memory_order_relaxed)) {
+      g_log_entry_caches.erase({indexed_seq_, this});
+    }
+  }
+  Clear();
+}
+
+int64_t LogEntryCache::EntryBytes(const braft::LogEntry* entry) {
+  return sizeof(braft::LogEntry) + entry->data.size();
+}
+
+int64_t LogEntryCache::TotalBytes() { return g_segment_log_entry_cache_bytes.load(butil::memory_order_relaxed); }
+
+void LogEntryCache::EvictGlobal(int64_t incoming_bytes) {
+  if (TotalBytes() + incoming_bytes <= FLAGS_segment_log_entry_cache_total_bytes) {
+    return;
+  }
+
+  // Lock order is global mutex then cache mutex.
+  BAIDU_SCOPED_LOCK(g_log_entry_caches_mutex);
+  auto it = g_log_entry_caches.begin();
+  while (it != g_log_entry_caches.end() && TotalBytes() + incoming_bytes > FLAGS_segment_log_entry_cache_total_bytes) {
+    auto* cache = it->second;
+    // Appended since indexed, move behind by the latest seq, visited again later.
+    int64_t append_seq = cache->append_seq_.load(std::memory_order_relaxed);
+    if (append_seq != it->first) {
+      it = g_log_entry_caches.erase(it);
+      cache->indexed_seq_ = append_seq;
+      g_log_entry_caches.emplace(append_seq, cache);
+      continue;
+    }
+
+    BAIDU_SCOPED_LOCK(cache->mutex_);
+    while (!cache->entries_.empty() && TotalBytes() + incoming_bytes > FLAGS_segment_log_entry_cache_total_bytes) {
+      cache->PopFront();
+    }
+    // Empty caches are added back by Append.
+    if (cache->entries_.empty()) {
+      cache->indexed_.store(false, std::memory_order_release);
+      it = g_log_entry_caches.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void LogEntryCache::IndexGlobal() {
+  if (indexed_.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  BAIDU_SCOPED_LOCK(g_log_entry_caches_mutex);
+  BAIDU_SCOPED_LOCK(mutex_);
+  if (indexed_.load(std::memory_order_relaxed) || entries_.empty()) {
+    return;
+  }
+  indexed_seq_ = append_seq_.load(std::memory_order_relaxed);
+  g_log_entry_caches.emplace(indexed_seq_, this);
+  indexed_.store(true, std::memory_order_release);
+}
+
+void LogEntryCache::Append(braft::LogEntry* entry) {
+  int64_t entry_bytes = EntryBytes(entry);
+  if (max_bytes_ <= 0 || entry_bytes > FLAGS_segment_log_entry_cache_total_bytes) {
+    return;
+  }
+
+  // self is the most recent, evicted at last
+  append_seq_.store(g_log_entry_cache_append_seq.fetch_add(1, butil::memory_order_relaxed),
+                    std::memory_order_relaxed);
+  EvictGlobal(entry_bytes);
+
+  {
+    BAIDU_SCOPED_LOCK(mutex_);
+    if (!entries_.empty() && first_index_ + static_cast<int64_t>(entries_.size()) != entry->id.index) {
+      while (!entries_.empty()) {
+        PopFront();
+      }
+    }
+
+    // evict oldest entries of self, when exceed self bytes limit
+    while (!entries_.empty() && bytes_ + entry_bytes > max_bytes_) {
+      PopFront();
+    }
+    if (bytes_ + entry_bytes > max_bytes_) {
+      return;
+    }
+
+    if (entries_.empty()) {
+      first_index_ = entry->id.index;
+    }
+    entry->AddRef();
+    entries_.push_back(entry);
+    bytes_ += entry_bytes;
+    g_segment_log_entry_cache_bytes.fetch_add(entry_bytes, butil::memory_order_relaxed);
+  }
+
+  IndexGlobal();
+}
+
+braft::LogEntry* LogEntryCache::Get(int64_t index) {
+  BAIDU_SCOPED_LOCK(mutex_);
+  if (entries_.empty() || index < first_index_ || index >= first_index_ + static_cast<int64_t>(entries_.size())) {
+    return nullptr;
+  }
+
+  auto* entry = entries_[index - first_index_];
+  entry->AddRef();
+  return entry;
+}
+
+int64_t LogEntryCache::GetTerm(int64_t index) {
+  BAIDU_SCOPED_LOCK(mutex_);
+  if (entries_.empty() || index < first_index_ || index >= first_index_ + static_cast<int64_t>(entries_.size())) {
+    return 0;
+  }
+
+  return entries_[index - first_index_]->id.term;
+}
+
+void LogEntryCache::TruncatePrefix(int64_t first_index_kept) {
+  BAIDU_SCOPED_LOCK(mutex_);
+  while (!entries_.empty() && first_index_ < first_index_kept) {
+    PopFront();
+  }
+}
+
+void LogEntryCache::TruncateSuffix(int64_t last_index_kept) {
+  BAIDU_SCOPED_LOCK(mutex_);
+  while (!entries_.empty() && first_index_ + static_cast<int64_t>(entries_.size()) - 1 > last_index_kept) {
+    PopBack();
+  }
+}
+
+void LogEntryCache::Clear() {
+  BAIDU_SCOPED_LOCK(mutex_);
+  while (!entries_.empty()) {
+    PopFront();
+  }
+}
+
+int64_t LogEntryCache::Bytes() {
+  BAIDU_SCOPED_LOCK(mutex_);
+  return bytes_;
+}
+
+size_t LogEntryCache::Size() {
+  BAIDU_SCOPED_LOCK(mutex_);
+  return entries_.size();
+}
+
+void LogEntryCache::PopFront() {
+  auto* entry = entries_.front();
+  int64_t entry_bytes = EntryBytes(entry);
+  bytes_ -= entry_bytes;
+  g_segment_log_entry_cache_bytes.fetch_sub(entry_bytes, butil::memory_order_relaxed);
+  entry->Release();
+  entries_.pop_front();
+  ++first_index_;
+}
+
+void LogEntryCache::PopBack() {
+  auto* entry = entries_.back();
+  int64_t entry_bytes = EntryBytes(entry);
+  bytes_ -= entry_bytes;
+  g_segment_log_entry_cache_bytes.fetch_sub(entry_bytes, butil::memory_order_relaxed);
+  entry->Release();
+  entries_.pop_back();
+}
+
+SegmentLogStorage::SegmentLogStorage(const std::string& path, bool enable_sync)
+    : path_(path),
+      first_log_index_(1),
+      last_log_index_(0),
+      checksum_type_(0),
+      enable_sync_(enable_sync),
+      append_cache_(FLAGS_segment_log_entry_cache_bytes),
+      next_readahead_cache_(0),
+      truncate_epoch_(0) {
+  InitReadaheadCaches();
+}
+
+SegmentLogStorage::SegmentLogStorage()
+    : first_log_index_(1),
+      last_log_index_(0),
+      checksum_type_(0),
+      enable_sync_(true),
+      append_cache_(FLAGS_segment_log_entry_cache_bytes),
+      next_readahead_cache_(0),
+      truncate_epoch_(0) {
+  InitReadaheadCaches();
+}
+
 int SegmentLogStorage::init(braft::ConfigurationManager* configuration_manager) {
   if (Constant::kSegmentLogMaxSegmentSize < 0) {
     DINGO_LOG(FATAL) << "Constant::kSegmentLogMaxSegmentSize " << Constant::kSegmentLogMaxSegmentSize
@@ -704,6 +992,7 @@ int SegmentLogStorage::append_entries(const std::vector<braft::LogEntry*>& entri
       g_segment_log_append_entry_latency << delta_time_us;
     }
     last_log_index_.fetch_add(1, butil::memory_order_release);
+    append_cache_.Append(entry);
     last_segment = segment;
   }
   now = butil::cpuwide_time_us();
@@ -713,9 +1002,33 @@ int SegmentLogStorage::append_entries(const std::vector<braft::LogEntry*>& entri
     metric->sync_segment_time_us += delta_time_us;
     g_segment_log_sync_segment_latency << delta_time_us;
   }
+  RecordAppendTime(entries.front()->id.index, entries.back()->id.index, butil::gettimeofday_us());
   return entries.size();
 }
 
+void SegmentLogStorage::RecordAppendTime(int64_t first_index, int64_t last_index, int64_t time_us) {
+  first_index = std::max(first_index, last_index - static_cast<int64_t>(kAppendTimeSlotNum) + 1);
+  for (int64_t index = first_index; index <= last_index; ++index) {
+    auto& slot = append_time_slots_[index % kAppendTimeSlotNum];
+    // Invalidate slot first, reader check index before and after read time.
+    slot.index.store(0, std::memory_order_relaxed);
+    slot.time_us.store(time_us, std::memory_order_release);
+    slot.index.store(index, std::memory_order_release);
+  }
+}
+
+int64_t SegmentLogStorage::GetAppendTimeUs(int64_t index) {
+  if (index <= 0) {
+    return 0;
+  }
+  auto& slot = append_time_slots_[index % kAppendTimeSlotNum];
+  if (slot.index.load(std::memory_order_acquire) != index) {
+    return 0;
+  }
+  int64_t time_us = slot.time_us.load(std::memory_order_acquire);
+  return slot.index.load(std::memory_order_acquire) == index ? time_us : 0;
+}
+
 int SegmentLogStorage::append_entry(const braft::LogEntry* entry) {
   auto segment = OpenSegment();
   if (nullptr == segment) {
@@ -729,19 +1042,92 @@ int SegmentLogStorage::append_entry(const braft::LogEntry* entry) {
     return EINVAL;
   }
   last_log_index_.fetch_add(1, butil::memory_order_release);
+  append_cache_.Append(const_cast<braft::LogEntry*>(entry));
 
   return segment->Sync(enable_sync_);
 }
 
+void SegmentLogStorage::InitReadaheadCaches() {
+  // Bytes of GetRange count data only, leave room for the LogEntry struct, or the front is evicted at once.
+  int64_t max_bytes = FLAGS_segment_log_readahead_bytes +
+                      FLAGS_segment_log_readahead_entries * static_cast<int64_t>(sizeof(braft::LogEntry));
+  for (int i = 0; i < std::max(FLAGS_segment_log_readahead_windows, 1); ++i) {
+    readahead_caches_.push_back(std::make_unique<LogEntryCache>(max_bytes));
+  }
+}
+
+void SegmentLogStorage::TruncateReadaheadCaches(int64_t first_index_kept, int64_t last_index_kept) {
+  BAIDU_SCOPED_LOCK(readahead_mutex_);
+  ++truncate_epoch_;
+  for (auto& readahead_cache : readahead_caches_) {
+    readahead_cache->TruncatePrefix(first_index_kept);
+    readahead_cache->TruncateSuffix(last_index_kept);
+  }
+}
+
 braft::LogEntry* SegmentLogStorage::get_entry(const int64_t index) {
+  auto* entry = append_cache_.Get(index);
+  for (size_t i = 0; entry == nullptr && i < readahead_caches_.size(); ++i) {
+    entry = readahead_caches_[i]->Get(index);
+  }
+  if (entry != nullptr) {
+    g_segment_log_entry_cache_hit << 1;
+    return entry;
+  }
+  g_segment_log_entry_cache_miss << 1;
+
   std::shared_ptr<Segment> segment = GetSegment(index);
   if (segment == nullptr) {
     return nullptr;
   }
-  return segment->Get(index);
+
+  // Lagging follower fetch entries one by one, read the following entries by one sequential read.
+  if (FLAGS_segment_log_readahead_entries <= 1) {
+    return segment->Get(index);
+  }
+  int64_t truncate_epoch = 0;
+  {
+    BAIDU_SCOPED_LOCK(readahead_mutex_);
+    truncate_epoch = truncate_epoch_;
+  }
+  int64_t start_time = butil::cpuwide_time_us();
+  std::vector<braft::LogEntry*> entries;
+  if (segment->GetRange(index, FLAGS_segment_log_readahead_entries, FLAGS_segment_log_readahead_bytes, entries) != 0 ||
+      entries.empty()) {
+    return segment->Get(index);
+  }
+  g_segment_log_readahead_latency << (butil::cpuwide_time_us() - start_time);
+
+  {
+    // Truncated during the read, entries may be replaced by new term, not cache them.
+    BAIDU_SCOPED_LOCK(readahead_mutex_);
+    const auto* last_entry = entries.back();
+    if (truncate_epoch == truncate_epoch_ &&
+        last_entry->id.index <= last_log_index_.load(butil::memory_order_acquire) &&
+        get_term(last_entry->id.index) == last_entry->id.term) {
+      // Replace the oldest filled window, other followers' windows are kept.
+      auto& readahead_cache =
+          readahead_caches_[next_readahead_cache_.fetch_add(1, std::memory_order_relaxed) % readahead_caches_.size()];
+      readahead_cache->Clear();
+      for (auto* readahead_entry : entries) {
+        readahead_cache->Append(readahead_entry);
+      }
+    }
+  }
+  entry = entries.front();
+  for (size_t i = 1; i < entries.size(); ++i) {
+    entries[i]->Release();
+  }
+
+  return entry;
 }
 
 int64_t SegmentLogStorage::get_term(const int64_t index) {
+  int64_t term = append_cache_.GetTerm(index);
+  if (term != 0) {
+    return term;
+  }
+
   std::shared_ptr<Segment> segment = GetSegment(index);
   return (segment == nullptr) ? 0 : segment->GetTerm(index);
 }
@@ -793,8 +1179,11 @@ int SegmentLogStorage::truncate_prefix(const int64_t first_index_kept) {
     return -1;
   }
 
+  append_cache_.TruncatePrefix(first_index_kept);
+
   std::vector<std::shared_ptr<Segment>> poppeds;
   PopSegments(first_index_kept, poppeds);
+  TruncateReadaheadCaches(first_index_kept, INT64_MAX);
   for (auto& popped : poppeds) {
     popped->Unlink();
     popped = nullptr;
@@ -842,6 +1231,11 @@ std::shared_ptr<Segment> SegmentLogStorage::PopSegmentsFromBack(int64_t last_ind
 }
 
 int SegmentLogStorage::truncate_suffix(const int64_t last_index_kept) {
+  append_cache_.TruncateSuffix(last_index_kept);
+  TruncateReadaheadCaches(0, last_index_kept);
+  // Readahead may fill entries read before segments truncated.
+  ScopeGuard readahead_guard([this, last_index_kept]() { TruncateReadaheadCaches(0, last_index_kept); });
+
   // segment files
   std::vector<std::shared_ptr<Segment>> poppeds;
   std::shared_ptr<Segment> last_segment = PopSegmentsFromBack(last_index_kept, poppeds);
@@ -891,6 +1285,11 @@ int SegmentLogStorage::reset(const int64_t next_log_index) {
     DINGO_LOG(ERROR) << "Invalid next_log_index=" << next_log_index << " path: " << path_;
     return EINVAL;
   }
+  append_cache_.Clear();
+  TruncateReadaheadCaches(next_log_index, next_log_index - 1);
+  ScopeGuard readahead_guard(
+      [this, next_log_index]() { TruncateReadaheadCaches(next_log_index, next_log_index - 1); });
+
   std::vector<std::shared_ptr<Segment>> poppeds;
   std::unique_lock<bthread::Mutex> lck(mutex_);
   poppeds.reserve(segments_.size());
@@ -1175,6 +1574,18 @@ void SegmentLogStorage::list_files(std::vector<std::string>* seg_files) {
   }
 }
 
+int64_t SegmentLogStorage::GetLogBytes() {
+  BAIDU_SCOPED_LOCK(mutex_);
+  int64_t bytes = 0;
+  for (auto& [_, segment] : segments_) {
+    bytes += segment->Bytes();
+  }
+  if (open_segment_) {
+    bytes += open_segment_->Bytes();
+  }
+  return bytes;
+}
+
 void SegmentLogStorage::sync() {
   std::vector<std::shared_ptr<Segment>> segments;
   {
@@ -15,6 +15,9 @@
 #ifndef DINGODB_SEGMENT_LOG_STORAGE_H_
 #define DINGODB_SEGMENT_LOG_STORAGE_H_
 
+#include <array>
+#include <atomic>
+#include <deque>
 #include <map>
 #include <memory>
 #include <vector>
@@ -70,6 +73,9 @@ class BAIDU_CACHELINE_ALIGNMENT Segment {
   // get entry by index
   braft::LogEntry* Get(int64_t index) const;
 
+  // get continuous entries from start_index by one sequential read, bounded by max_count and max_bytes
+  int GetRange(int64_t start_index, size_t max_count, size_t max_bytes, std::vector<braft::LogEntry*>& entries) const;
+
   // get entry's term by index
   int64_t GetTerm(int64_t index) const;
 
@@ -103,6 +109,8 @@ class BAIDU_CACHELINE_ALIGNMENT Segment {
   };
 
   int LoadEntry(off_t offset, EntryHeader* head, butil::IOBuf* body, size_t size_hint) const;
+  bool DecodeHeader(off_t offset, const char* buf, EntryHeader* head) const;
+  braft::LogEntry* BuildEntry(int64_t index, const EntryHeader& header, butil::IOBuf& data) const;
   int GetMeta(int64_t index, LogMeta* meta) const;
   int TruncateMetaAndGetLast(int64_t last);
 
@@ -119,6 +127,64 @@ class BAIDU_CACHELINE_ALIGNMENT Segment {
   std::vector<std::pair<int64_t /*offset*/, int64_t /*term*/>> offset_and_term_;
 };
 
+// Cache of continuous log entries [first_index, last_index], evict from the front when exceed bytes.
+// The bytes of all caches is bounded by segment_log_entry_cache_total_bytes too, when exceed it,
+// evict from the front of the least recently appended caches, of this or other log storages.
+class LogEntryCache {
+ public:
+  explicit LogEntryCache(int64_t max_bytes);
+  ~LogEntryCache();
+
+  LogEntryCache(const LogEntryCache&) = delete;
+  const LogEntryCache& operator=(const LogEntryCache&) = delete;
+
+  // append entry after the last one, cache is reset when not continuous
+  void Append(braft::LogEntry* entry);
+
+  // get entry by index, return entry with ref added, nullptr when miss
+  braft::LogEntry* Get(int64_t index);
+
+  // get entry's term by index, 0 when miss
+  int64_t GetTerm(int64_t index);
+
+  // discard entries [first_index, first_index_kept)
+  void TruncatePrefix(int64_t first_index_kept);
+
+  // discard entries (last_index_kept, last_index]
+  void TruncateSuffix(int64_t last_index_kept);
+
+  void Clear();
+
+  int64_t Bytes();
+  size_t Size();
+  // bytes of all caches
+  static int64_t TotalBytes();
+
+  // memory of entry counted by cache
+  static int64_t EntryBytes(const braft::LogEntry* entry);
+
+ private:
+  // Evict until total bytes with incoming_bytes not exceed limit, called without holding any cache mutex.
+  static void EvictGlobal(int64_t incoming_bytes);
+  // Add to global eviction order after append, if it was removed when empty.
+  void IndexGlobal();
+  void PopFront();
+  void PopBack();
+
+  bthread::Mutex mutex_;
+  const int64_t max_bytes_;
+  int64_t bytes_;
+  int64_t first_index_;
+  std::deque<braft::LogEntry*> entries_;
+  // order of the last append among all caches, for global eviction
+  std::atomic<int64_t> append_seq_;
+  // key in global eviction order, caches appended after indexed are re-keyed lazily by eviction,
+  // guarded by global mutex
+  int64_t indexed_seq_;
+  // whether in global eviction order, written with both global mutex and mutex_ held
+  std::atomic<bool> indexed_;
+};
+
 // LogStorage use segmented append-only file, all data in disk, all index in memory.
 // append one log entry, only cause one disk write, every disk write will call fsync().
 //
@@ -130,10 +196,9 @@ class SegmentLogStorage : public braft::LogStorage {
  public:
   using SegmentMap = std::map<int64_t, std::shared_ptr<Segment>>;
 
-  explicit SegmentLogStorage(const std::string& path, bool enable_sync = true)
-      : path_(path), first_log_index_(1), last_log_index_(0), checksum_type_(0), enable_sync_(enable_sync) {}
+  explicit SegmentLogStorage(const std::string& path, bool enable_sync = true);
 
-  SegmentLogStorage() : first_log_index_(1), last_log_index_(0), checksum_type_(0), enable_sync_(true) {}
+  SegmentLogStorage();
 
   ~SegmentLogStorage() override = default;
 
@@ -177,6 +242,12 @@ class SegmentLogStorage : public braft::LogStorage {
 
   void list_files(std::vector<std::string>* seg_files);
 
+  // Total bytes of all segments.
+  int64_t GetLogBytes();
+
+  // Time(us) the log entry was persisted, only recent entries are kept, return 0 if unknown.
+  int64_t GetAppendTimeUs(int64_t index);
+
   void sync();
 
  private:
@@ -188,6 +259,10 @@ class SegmentLogStorage : public braft::LogStorage {
   std::shared_ptr<Segment> GetSegment(int64_t log_index);
   void PopSegments(int64_t first_index_kept, std::vector<std::shared_ptr<Segment>>& poppeds);
   std::shared_ptr<Segment> PopSegmentsFromBack(int64_t last_index_kept, std::vector<std::shared_ptr<Segment>>& poppeds);
+  void RecordAppendTime(int64_t first_index, int64_t last_index, int64_t time_us);
+  void InitReadaheadCaches();
+  // Drop readahead entries out of [first_index_kept, last_index_kept], and fills in progress.
+  void TruncateReadaheadCaches(int64_t first_index_kept, int64_t last_index_kept);
 
   std::string path_;
   butil::atomic<int64_t> first_log_index_;
@@ -200,6 +275,24 @@ class SegmentLogStorage : public braft::LogStorage {
 
   int checksum_type_;
   bool enable_sync_;
+
+  // recently appended entries, serve replication to lagging follower without disk read
+  LogEntryCache append_cache_;
+  // entries of recent sequential reads, serve the following get_entry of catch-up,
+  // followers catching up concurrently use different windows, the oldest filled one is replaced.
+  std::vector<std::unique_ptr<LogEntryCache>> readahead_caches_;
+  std::atomic<size_t> next_readahead_cache_;
+  // readahead fill is dropped if truncated or reset during the disk read, or stale entries are cached
+  bthread::Mutex readahead_mutex_;
+  int64_t truncate_epoch_;
+
+  // persisted time of recent entries, slot is index % kAppendTimeSlotNum, for write latency trace
+  struct AppendTimeSlot {
+    std::atomic<int64_t> index{0};
+    std::atomic<int64_t> time_us{0};
+  };
+  static constexpr size_t kAppendTimeSlotNum = 256;
+  std::array<AppendTimeSlot, kAppendTimeSlotNum> append_time_slots_;
 };
 
 }  //  namespace dingodb
@@ -15,6 +15,7 @@
 #include "meta/meta_reader.h"
 
 #include <cstddef>
+#include <utility>
 
 #include "butil/status.h"
 #include "common/constant.h"
@@ -75,4 +76,35 @@ bool MetaReader::Scan(std::shared_ptr<Snapshot> snapshot, const std::string& pre
   return true;
 }
 
+bool MetaReader::Scan(std::shared_ptr<Snapshot> snapshot, const std::string& prefix, size_t batch_size,
+                      const std::function<bool(std::vector<pb::common::KeyValue>&)>& handler) {
+  IteratorOptions options;
+  options.lower_bound = prefix;
+  options.upper_bound = Helper::PrefixNext(prefix);
+  options.fill_cache = false;
+  auto iter = engine_->NewIterator(Constant::kStoreMetaCF, snapshot, options);
+  if (iter == nullptr) {
+    DINGO_LOG(ERROR) << "Meta scan failed, new iterator failed";
+    return false;
+  }
+
+  std::vector<pb::common::KeyValue> kvs;
+  kvs.reserve(batch_size);
+  for (iter->Seek(prefix); iter->Valid(); iter->Next()) {
+    pb::common::KeyValue kv;
+    kv.set_key(iter->Key().data(), iter->Key().size());
+    kv.set_value(iter->Value().data(), iter->Value().size());
+    kvs.push_back(std::move(kv));
+
+    if (kvs.size() >= batch_size) {
+      if (!handler(kvs)) {
+        return false;
+      }
+      kvs.clear();
+    }
+  }
+
+  return kvs.empty() || handler(kvs);
+}
+
 }  // namespace dingodb
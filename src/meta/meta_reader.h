@@ -15,6 +15,8 @@
 #ifndef DINGODB_META_META_READER_H_
 #define DINGODB_META_META_READER_H_
 
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -37,6 +39,10 @@ class MetaReader {
   // with Snapshot
   std::shared_ptr<pb::common::KeyValue> Get(std::shared_ptr<Snapshot> snapshot, const std::string& key);
   bool Scan(std::shared_ptr<Snapshot>, const std::string& prefix, std::vector<pb::common::KeyValue>& kvs);
+  // Scan by iterator, hand over kvs batch by batch, so the whole prefix need not be in memory.
+  // Stop when handler return false.
+  bool Scan(std::shared_ptr<Snapshot> snapshot, const std::string& prefix, size_t batch_size,
+            const std::function<bool(std::vector<pb::common::KeyValue>&)>& handler);
 
  private:
   std::shared_ptr<RawEngine> engine_;
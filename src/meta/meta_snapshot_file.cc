@@ -0,0 +1,220 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "meta/meta_snapshot_file.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "butil/crc32c.h"
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "gflags/gflags.h"
+#include "proto/error.pb.h"
+
+namespace dingodb {
+
+DEFINE_uint32(meta_snapshot_chunk_kv_count, 4096, "Max kv count of one meta snapshot chunk");
+DEFINE_uint64(meta_snapshot_chunk_bytes, 4 * 1024 * 1024, "Max bytes of one meta snapshot chunk");
+DEFINE_bool(meta_snapshot_stream_format, false,
+            "Save meta snapshot in streaming chunk format, enable it after all coordinators are upgraded");
+
+static const uint32_t kMetaSnapshotFileMagic = 0x444d5346;  // DMSF
+static const uint32_t kMetaSnapshotFileVersion = 1;
+static const size_t kMetaSnapshotHeaderSize = 8;
+// Guard against corrupt length, a chunk is far smaller.
+static const uint32_t kMetaSnapshotMaxChunkSize = 1024 * 1024 * 1024;
+
+static void EncodeFixed32(char* buf, uint32_t value) {
+  buf[0] = static_cast<char>(value & 0xff);
+  buf[1] = static_cast<char>((value >> 8) & 0xff);
+  buf[2] = static_cast<char>((value >> 16) & 0xff);
+  buf[3] = static_cast<char>((value >> 24) & 0xff);
+}
+
+static uint32_t DecodeFixed32(const char* buf) {
+  const auto* data = reinterpret_cast<const uint8_t*>(buf);
+  return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+         (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+MetaSnapshotFileWriter::MetaSnapshotFileWriter(const std::string& path)
+    : path_(path), fd_(-1), chunk_bytes_(0), kv_count_(0) {}
+
+MetaSnapshotFileWriter::~MetaSnapshotFileWriter() {
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+static butil::Status WriteAll(int fd, const std::string& path, const char* data, size_t size) {
+  size_t offset = 0;
+  while (offset < size) {
+    ssize_t written = write(fd, data + offset, size - offset);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return butil::Status(pb::error::Errno::EINTERNAL, "Write file %s failed, errno %d", path.c_str(), errno);
+    }
+    offset += written;
+  }
+
+  return butil::Status::OK();
+}
+
+butil::Status MetaSnapshotFileWriter::Open() {
+  fd_ = open(path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd_ < 0) {
+    return butil::Status(pb::error::Errno::EINTERNAL, "Open file %s failed, errno %d", path_.c_str(), errno);
+  }
+
+  char header[kMetaSnapshotHeaderSize];
+  EncodeFixed32(header, kMetaSnapshotFileMagic);
+  EncodeFixed32(header + 4, kMetaSnapshotFileVersion);
+  return WriteAll(fd_, path_, header, sizeof(header));
+}
+
+butil::Status MetaSnapshotFileWriter::Append(const std::string& prefix, pb::common::KeyValue&& kv) {
+  if (chunk_.kvs_size() > 0 && chunk_.prefix() != prefix) {
+    auto status = Flush();
+    if (!status.ok()) {
+      return status;
+    }
+  }
+
+  chunk_.set_prefix(prefix);
+  chunk_bytes_ += kv.key().size() + kv.value().size();
+  *chunk_.add_kvs() = std::move(kv);
+  ++kv_count_;
+
+  if (chunk_.kvs_size() >= FLAGS_meta_snapshot_chunk_kv_count || chunk_bytes_ >= FLAGS_meta_snapshot_chunk_bytes) {
+    return Flush();
+  }
+
+  return butil::Status::OK();
+}
+
+butil::Status MetaSnapshotFileWriter::Flush() {
+  if (chunk_.kvs_size() == 0) {
+    return butil::Status::OK();
+  }
+
+  auto status = WriteChunk(chunk_);
+  chunk_.Clear();
+  chunk_bytes_ = 0;
+  return status;
+}
+
+butil::Status MetaSnapshotFileWriter::WriteChunk(const pb::coordinator_internal::MetaSnapshotChunk& chunk) {
+  std::string data;
+  data.resize(8);
+  if (!chunk.AppendToString(&data)) {
+    return butil::Status(pb::error::Errno::EINTERNAL, "Serialize meta snapshot chunk failed");
+  }
+
+  uint32_t length = data.size() - 8;
+  EncodeFixed32(data.data(), length);
+  EncodeFixed32(data.data() + 4, butil::crc32c::Value(data.data() + 8, length));
+
+  return WriteAll(fd_, path_, data.data(), data.size());
+}
+
+butil::Status MetaSnapshotFileWriter::Finish() {
+  auto status = Flush();
+  if (!status.ok()) {
+    return status;
+  }
+
+  pb::coordinator_internal::MetaSnapshotChunk last_chunk;
+  last_chunk.set_is_last(true);
+  last_chunk.set_total_kv_count(kv_count_);
+  status = WriteChunk(last_chunk);
+  if (!status.ok()) {
+    return status;
+  }
+
+  if (fsync(fd_) != 0) {
+    return butil::Status(pb::error::Errno::EINTERNAL, "Sync file %s failed, errno %d", path_.c_str(), errno);
+  }
+  close(fd_);
+  fd_ = -1;
+
+  return butil::Status::OK();
+}
+
+MetaSnapshotFileReader::MetaSnapshotFileReader(const std::string& path) : path_(path), kv_count_(0) {}
+
+butil::Status MetaSnapshotFileReader::Open() {
+  file_.open(path_, std::ios::binary);
+  if (!file_.is_open()) {
+    return butil::Status(pb::error::Errno::EINTERNAL, "Open file %s failed", path_.c_str());
+  }
+
+  char header[kMetaSnapshotHeaderSize];
+  if (!file_.read(header, sizeof(header))) {
+    return butil::Status(pb::error::Errno::EINTERNAL, "Read file %s header failed", path_.c_str());
+  }
+  if (DecodeFixed32(header) != kMetaSnapshotFileMagic) {
+    return butil::Status(pb::error::Errno::EINTERNAL, "File %s is not meta snapshot file", path_.c_str());
+  }
+  if (DecodeFixed32(header + 4) != kMetaSnapshotFileVersion) {
+    return butil::Status(pb::error::Errno::EINTERNAL, "File %s version %u not support", path_.c_str(),
+                         DecodeFixed32(header + 4));
+  }
+
+  return butil::Status::OK();
+}
+
+butil::Status MetaSnapshotFileReader::Read(pb::coordinator_internal::MetaSnapshotChunk& chunk) {
+  char chunk_header[8];
+  if (!file_.read(chunk_header, sizeof(chunk_header))) {
+    return butil::Status(pb::error::Errno::EINTERNAL, "File %s is truncated, missing last chunk", path_.c_str());
+  }
+
+  uint32_t length = DecodeFixed32(chunk_header);
+  uint32_t crc = DecodeFixed32(chunk_header + 4);
+  if (length > kMetaSnapshotMaxChunkSize) {
+    return butil::Status(pb::error::Errno::EINTERNAL, "File %s chunk length %u illegal", path_.c_str(), length);
+  }
+
+  buffer_.resize(length);
+  if (!file_.read(buffer_.data(), length)) {
+    return butil::Status(pb::error::Errno::EINTERNAL, "File %s is truncated", path_.c_str());
+  }
+  if (butil::crc32c::Value(buffer_.data(), length) != crc) {
+    return butil::Status(pb::error::Errno::EINTERNAL, "File %s chunk checksum mismatch", path_.c_str());
+  }
+
+  chunk.Clear();
+  if (!chunk.ParseFromArray(buffer_.data(), length)) {
+    return butil::Status(pb::error::Errno::EINTERNAL, "File %s parse chunk failed", path_.c_str());
+  }
+
+  kv_count_ += chunk.kvs_size();
+  if (chunk.is_last() && chunk.total_kv_count() != kv_count_) {
+    return butil::Status(pb::error::Errno::EINTERNAL, "File %s kv count mismatch, expect %lu actual %lu",
+                         path_.c_str(), chunk.total_kv_count(), kv_count_);
+  }
+
+  return butil::Status::OK();
+}
+
+}  // namespace dingodb
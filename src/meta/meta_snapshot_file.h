@@ -0,0 +1,81 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_META_META_SNAPSHOT_FILE_H_
+#define DINGODB_META_META_SNAPSHOT_FILE_H_
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "butil/status.h"
+#include "proto/common.pb.h"
+#include "proto/coordinator_internal.pb.h"
+
+namespace dingodb {
+
+// Streaming meta snapshot file, so the snapshot need not be hold in memory as one protobuf.
+// Layout: | magic(4) | version(4) | chunk | chunk | ... | last chunk |
+// chunk:  | length(4) | crc32c(4) | MetaSnapshotChunk(length) |, integers are little endian.
+class MetaSnapshotFileWriter {
+ public:
+  explicit MetaSnapshotFileWriter(const std::string& path);
+  ~MetaSnapshotFileWriter();
+
+  MetaSnapshotFileWriter(const MetaSnapshotFileWriter&) = delete;
+  const MetaSnapshotFileWriter& operator=(const MetaSnapshotFileWriter&) = delete;
+
+  butil::Status Open();
+  // Buffer kv, flush a chunk when it is full or prefix changed.
+  butil::Status Append(const std::string& prefix, pb::common::KeyValue&& kv);
+  // Flush buffered kvs and write the last chunk, then sync file.
+  butil::Status Finish();
+
+  uint64_t KvCount() const { return kv_count_; }
+
+ private:
+  butil::Status Flush();
+  butil::Status WriteChunk(const pb::coordinator_internal::MetaSnapshotChunk& chunk);
+
+  std::string path_;
+  int fd_;
+  pb::coordinator_internal::MetaSnapshotChunk chunk_;
+  uint64_t chunk_bytes_;
+  uint64_t kv_count_;
+};
+
+class MetaSnapshotFileReader {
+ public:
+  explicit MetaSnapshotFileReader(const std::string& path);
+  ~MetaSnapshotFileReader() = default;
+
+  MetaSnapshotFileReader(const MetaSnapshotFileReader&) = delete;
+  const MetaSnapshotFileReader& operator=(const MetaSnapshotFileReader&) = delete;
+
+  butil::Status Open();
+  // Read next chunk and verify checksum, after the last chunk it is the end of file.
+  butil::Status Read(pb::coordinator_internal::MetaSnapshotChunk& chunk);
+
+  uint64_t KvCount() const { return kv_count_; }
+
+ private:
+  std::string path_;
+  std::ifstream file_;
+  std::string buffer_;
+  uint64_t kv_count_;
+};
+
+}  // namespace dingodb
+
+#endif  // DINGODB_META_META_SNAPSHOT_FILE_H_
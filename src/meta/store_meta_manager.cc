@@ -300,7 +300,15 @@ void StoreRegionMeta::UpdateState(uint64_t region_id, pb::common::StoreRegionSta
 void StoreRegionMeta::UpdateLeaderId(store::RegionPtr region, uint64_t leader_id) {
   assert(region != nullptr);
 
+  if (region->LeaderId() == leader_id) {
+    return;
+  }
   region->SetLeaderId(leader_id);
+
+  // Persist for bootstrap recover priority, regions led by this node recover first.
+  if (meta_writer_ != nullptr) {
+    meta_writer_->Put(TransformToKv(region));
+  }
 }
 
 void StoreRegionMeta::UpdateLeaderId(uint64_t region_id, uint64_t leader_id) {
@@ -132,7 +132,7 @@ class StoreRegionMeta : public TransformKvAble {
   void UpdateState(store::RegionPtr region, pb::common::StoreRegionState new_state);
   void UpdateState(uint64_t region_id, pb::common::StoreRegionState new_state);
 
-  static void UpdateLeaderId(store::RegionPtr region, uint64_t leader_id);
+  void UpdateLeaderId(store::RegionPtr region, uint64_t leader_id);
   void UpdateLeaderId(uint64_t region_id, uint64_t leader_id);
 
   void UpdatePeers(store::RegionPtr region, std::vector<pb::common::Peer>& peers);
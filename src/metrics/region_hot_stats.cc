@@ -0,0 +1,130 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "metrics/region_hot_stats.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "butil/fast_rand.h"
+#include "common/helper.h"
+#include "gflags/gflags.h"
+
+namespace dingodb {
+
+DEFINE_int32(region_hot_stats_sample_rate, 16, "Sample one of every n requests for region hot statistics");
+DEFINE_int32(region_hot_key_sketch_capacity, 64, "Max keys tracked by region hot key sketch");
+DEFINE_int32(region_hot_key_report_num, 10, "Max hot keys of region reported by heartbeat");
+DEFINE_int32(region_hot_key_max_per_request, 16, "Max keys of one request counted by hot key sketch");
+
+void SpaceSavingSketch::Add(std::string_view key, uint64_t weight) {
+  if (capacity_ == 0) {
+    return;
+  }
+
+  std::string str_key(key);
+  auto it = counters_.find(str_key);
+  if (it != counters_.end()) {
+    order_.erase({it->second.first, str_key});
+    it->second.first += weight;
+    order_.insert({it->second.first, str_key});
+    return;
+  }
+
+  uint64_t error = 0;
+  if (counters_.size() >= capacity_) {
+    // Replace the key with min count.
+    auto min_it = order_.begin();
+    error = min_it->first;
+    counters_.erase(min_it->second);
+    order_.erase(min_it);
+  }
+  counters_.insert({str_key, {error + weight, error}});
+  order_.insert({error + weight, std::move(str_key)});
+}
+
+std::vector<SpaceSavingSketch::Counter> SpaceSavingSketch::TopN(size_t n) const {
+  std::vector<Counter> result;
+  result.reserve(std::min(n, order_.size()));
+  for (auto it = order_.rbegin(); it != order_.rend() && result.size() < n; ++it) {
+    result.push_back({it->second, it->first, counters_.at(it->second).second});
+  }
+
+  return result;
+}
+
+void SpaceSavingSketch::Clear() {
+  counters_.clear();
+  order_.clear();
+}
+
+RegionHotStats::RegionHotStats()
+    : window_start_ms_(Helper::TimestampMs()),
+      read_count_(0),
+      write_count_(0),
+      read_bytes_(0),
+      write_bytes_(0),
+      sketch_(FLAGS_region_hot_key_sketch_capacity) {}
+
+bool RegionHotStats::Sample() {
+  return FLAGS_region_hot_stats_sample_rate > 0 &&
+         butil::fast_rand_less_than(FLAGS_region_hot_stats_sample_rate) == 0;
+}
+
+void RegionHotStats::Record(bool is_write, const std::vector<std::string_view>& keys, int64_t bytes) {
+  uint64_t weight = std::max(FLAGS_region_hot_stats_sample_rate, 1);
+
+  BAIDU_SCOPED_LOCK(mutex_);
+  if (is_write) {
+    write_count_ += weight;
+    write_bytes_ += bytes * weight;
+  } else {
+    read_count_ += weight;
+    read_bytes_ += bytes * weight;
+  }
+
+  size_t key_num = std::min(keys.size(), static_cast<size_t>(std::max(FLAGS_region_hot_key_max_per_request, 0)));
+  for (size_t i = 0; i < key_num; ++i) {
+    sketch_.Add(keys[i], weight);
+  }
+}
+
+void RegionHotStats::Collect(pb::common::RegionHotStats* stats) {
+  int64_t now_ms = Helper::TimestampMs();
+
+  BAIDU_SCOPED_LOCK(mutex_);
+  // At least one second, avoid amplify rate of a short window.
+  double elapsed_s = std::max(now_ms - window_start_ms_, static_cast<int64_t>(1000)) / 1000.0;
+  stats->set_read_qps(static_cast<uint64_t>(read_count_ / elapsed_s));
+  stats->set_write_qps(static_cast<uint64_t>(write_count_ / elapsed_s));
+  stats->set_read_bytes_per_second(static_cast<uint64_t>(read_bytes_ / elapsed_s));
+  stats->set_write_bytes_per_second(static_cast<uint64_t>(write_bytes_ / elapsed_s));
+  for (auto& counter : sketch_.TopN(FLAGS_region_hot_key_report_num)) {
+    auto* hot_key = stats->add_hot_keys();
+    hot_key->set_key(counter.key);
+    hot_key->set_count(counter.count);
+    hot_key->set_error(counter.error);
+  }
+
+  window_start_ms_ = now_ms;
+  read_count_ = 0;
+  write_count_ = 0;
+  read_bytes_ = 0;
+  write_bytes_ = 0;
+  sketch_.Clear();
+}
+
+}  // namespace dingodb
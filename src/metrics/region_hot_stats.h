@@ -0,0 +1,89 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_METRICS_REGION_HOT_STATS_H_
+#define DINGODB_METRICS_REGION_HOT_STATS_H_
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "bthread/mutex.h"
+#include "proto/common.pb.h"
+
+namespace dingodb {
+
+// Space-saving top-k sketch, keep at most capacity keys. When it is full, the key with min count is replaced,
+// the new key count is min count + weight and error is min count, so count overestimates at most error.
+class SpaceSavingSketch {
+ public:
+  struct Counter {
+    std::string key;
+    uint64_t count;
+    uint64_t error;
+  };
+
+  explicit SpaceSavingSketch(size_t capacity) : capacity_(capacity) {}
+  ~SpaceSavingSketch() = default;
+
+  void Add(std::string_view key, uint64_t weight);
+  // Top n keys order by count desc.
+  std::vector<Counter> TopN(size_t n) const;
+  void Clear();
+
+  size_t Size() const { return counters_.size(); }
+
+ private:
+  size_t capacity_;
+  // key: {count, error}
+  std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> counters_;
+  // {count, key}, for find min count key
+  std::set<std::pair<uint64_t, std::string>> order_;
+};
+
+// Sampled read/write statistics of region for hot region and hot key detection.
+class RegionHotStats {
+ public:
+  RegionHotStats();
+  ~RegionHotStats() = default;
+
+  RegionHotStats(const RegionHotStats&) = delete;
+  const RegionHotStats& operator=(const RegionHotStats&) = delete;
+
+  // Sample 1/region_hot_stats_sample_rate requests, call Record only when sampled.
+  static bool Sample();
+
+  // Record sampled request, counters are scaled by sample rate.
+  void Record(bool is_write, const std::vector<std::string_view>& keys, int64_t bytes);
+
+  // Fill rates since last collect and hot keys, then start a new window.
+  void Collect(pb::common::RegionHotStats* stats);
+
+ private:
+  bthread::Mutex mutex_;
+  int64_t window_start_ms_;
+  uint64_t read_count_;
+  uint64_t write_count_;
+  uint64_t read_bytes_;
+  uint64_t write_bytes_;
+  SpaceSavingSketch sketch_;
+};
+
+}  // namespace dingodb
+
+#endif  // DINGODB_METRICS_REGION_HOT_STATS_H_
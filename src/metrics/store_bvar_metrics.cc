@@ -12,11 +12,98 @@
 
 #include "metrics/store_bvar_metrics.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "butil/fast_rand.h"
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "gflags/gflags.h"
+
 namespace dingodb {
 
+DEFINE_int64(store_write_slow_threshold_ms, 1000, "Write request slower than it is dumped with stage latency");
+DEFINE_int32(store_write_slow_sample_percent, 10, "Percent of slow write requests dumped");
+DEFINE_bool(store_write_stage_latency_per_region, false,
+            "Record latency of every write stage per region, costs a latency recorder per region and stage");
+
+static const char* kWriteStageNames[] = {"total",  "validate",    "propose",   "log_append",
+                                         "commit", "apply_start", "apply_end", "response"};
+static_assert(sizeof(kWriteStageNames) / sizeof(kWriteStageNames[0]) == static_cast<int>(WriteStage::kStageNum));
+
 StoreBvarMetrics& StoreBvarMetrics::GetInstance() {
   static StoreBvarMetrics store_bvar_metrics;
   return store_bvar_metrics;
 }
 
+void StoreBvarMetrics::InitWriteStageLatency() {
+  for (const auto* name : kWriteStageNames) {
+    write_stage_latency_.push_back(std::make_unique<bvar::LatencyRecorder>("dingo_metrics_store_write_stage", name));
+  }
+}
+
+void StoreBvarMetrics::DeleteWriteStageLatency(const std::string& region_id) {
+  if (region_write_latency_.has_stats({region_id})) {
+    region_write_latency_.delete_stats({region_id});
+  }
+  for (const auto* name : kWriteStageNames) {
+    if (region_write_stage_latency_.has_stats({region_id, name})) {
+      region_write_stage_latency_.delete_stats({region_id, name});
+    }
+  }
+}
+
+void StoreBvarMetrics::ObserveWriteStage(std::shared_ptr<Context> ctx) {
+  int64_t receive_time_us = ctx->StageTimeUs(WriteStage::kReceive);
+  int64_t response_time_us = ctx->StageTimeUs(WriteStage::kResponse);
+  // Not a traced request, e.g. internal write.
+  if (receive_time_us == 0 || response_time_us == 0) {
+    return;
+  }
+
+  std::string region_id = std::to_string(ctx->RegionId());
+  int64_t latencies[static_cast<int>(WriteStage::kStageNum)] = {0};
+  latencies[0] = response_time_us - receive_time_us;
+
+  // Stage latency is from the previous recorded stage, missing stage is merged into the next.
+  int64_t prev_time_us = receive_time_us;
+  for (int i = 1; i < static_cast<int>(WriteStage::kStageNum); ++i) {
+    int64_t time_us = ctx->StageTimeUs(static_cast<WriteStage>(i));
+    if (time_us == 0) {
+      continue;
+    }
+    latencies[i] = std::max(time_us - prev_time_us, static_cast<int64_t>(0));
+    prev_time_us = time_us;
+
+    *write_stage_latency_[i] << latencies[i];
+    if (FLAGS_store_write_stage_latency_per_region) {
+      auto* region_stat = region_write_stage_latency_.get_stats({region_id, kWriteStageNames[i]});
+      if (region_stat != nullptr) {
+        *region_stat << latencies[i];
+      }
+    }
+  }
+  *write_stage_latency_[0] << latencies[0];
+  auto* region_stat = region_write_latency_.get_stats({region_id});
+  if (region_stat != nullptr) {
+    *region_stat << latencies[0];
+  }
+
+  if (latencies[0] < FLAGS_store_write_slow_threshold_ms * 1000 ||
+      butil::fast_rand_less_than(100) >= static_cast<uint64_t>(FLAGS_store_write_slow_sample_percent)) {
+    return;
+  }
+
+  std::string stages;
+  for (int i = 1; i < static_cast<int>(WriteStage::kStageNum); ++i) {
+    stages += fmt::format(" {}({})", kWriteStageNames[i], latencies[i]);
+  }
+  const auto* request = ctx->Request();
+  DINGO_LOG(WARNING) << fmt::format("[write.slow][region({})] {} total({}us) stage(us):{}", region_id,
+                                    request != nullptr ? request->GetDescriptor()->name() : "unknown", latencies[0],
+                                    stages);
+}
+
 }  // namespace dingodb
\ No newline at end of file
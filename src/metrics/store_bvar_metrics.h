@@ -15,13 +15,17 @@
 #ifndef DINGODB_STORE_BVAR_METRICS_H_
 #define DINGODB_STORE_BVAR_METRICS_H_
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "bvar/bvar.h"
+#include "bvar/latency_recorder.h"
 #include "bvar/multi_dimension.h"
 #include "bvar/reducer.h"
 #include "bvar/status.h"
 #include "bvar/variable.h"
+#include "common/context.h"
 #include "common/helper.h"
 
 namespace dingodb {
@@ -32,7 +36,12 @@ class StoreBvarMetrics {
       : leader_switch_time_("dingo_metrics_store_raft_leader_switch_time", {"region"}),
         leader_switch_count_("dingo_metrics_store_raft_leader_switch_count", {"region"}),
         commit_count_per_second_("dingo_metrics_store_raft_commit_count_per_second", {"region"}),
-        apply_count_per_second_("dingo_metrics_store_raft_apply_count_per_second", {"region"}) {}
+        apply_count_per_second_("dingo_metrics_store_raft_apply_count_per_second", {"region"}),
+        region_write_latency_("dingo_metrics_store_write_latency", {"region"}),
+        region_write_stage_latency_("dingo_metrics_store_write_stage_latency", {"region", "stage"}),
+        tombstone_ratio_("dingo_metrics_store_region_tombstone_ratio", {"region"}) {
+    InitWriteStageLatency();
+  }
   ~StoreBvarMetrics() = default;
 
   StoreBvarMetrics(const StoreBvarMetrics&) = delete;
@@ -68,6 +77,13 @@ class StoreBvarMetrics {
     }
   }
 
+  void UpdateTombstoneRatio(std::string region_id, double value) {
+    auto* region_stat = tombstone_ratio_.get_stats({region_id});
+    if (region_stat != nullptr) {
+      region_stat->set_value(value);
+    }
+  }
+
   void DeleteMetrics(std::string region_id) {
     if (leader_switch_time_.has_stats({region_id})) {
       leader_switch_time_.delete_stats({region_id});
@@ -81,13 +97,31 @@ class StoreBvarMetrics {
     if (apply_count_per_second_.has_stats({region_id})) {
       apply_count_per_second_.delete_stats({region_id});
     }
+    if (tombstone_ratio_.has_stats({region_id})) {
+      tombstone_ratio_.delete_stats({region_id});
+    }
+    DeleteWriteStageLatency(region_id);
   }
 
+  // Aggregate latency of every write stage into region and store histograms, dump sampled slow request.
+  void ObserveWriteStage(std::shared_ptr<Context> ctx);
+
  private:
+  void InitWriteStageLatency();
+  void DeleteWriteStageLatency(const std::string& region_id);
+
   bvar::MultiDimension<bvar::Status<uint64_t>> leader_switch_time_;
   bvar::MultiDimension<bvar::Status<uint64_t>> leader_switch_count_;
   bvar::MultiDimension<bvar::PerSecondEx<bvar::Adder<uint64_t>>> commit_count_per_second_;
   bvar::MultiDimension<bvar::PerSecondEx<bvar::Adder<uint64_t>>> apply_count_per_second_;
+  // Latency from the previous recorded stage, index is WriteStage, kReceive is used for total latency.
+  std::vector<std::unique_ptr<bvar::LatencyRecorder>> write_stage_latency_;
+  // Total write latency of region.
+  bvar::MultiDimension<bvar::LatencyRecorder> region_write_latency_;
+  // Stage latency of region, only when store_write_stage_latency_per_region is enabled.
+  bvar::MultiDimension<bvar::LatencyRecorder> region_write_stage_latency_;
+  // Tombstones / entries of sst files overlap with region.
+  bvar::MultiDimension<bvar::Status<double>> tombstone_ratio_;
 };
 
 }  // namespace dingodb
@@ -24,7 +24,9 @@
 #include "common/helper.h"
 #include "common/logging.h"
 #include "config/config_manager.h"
+#include "engine/compaction_scheduler.h"
 #include "fmt/core.h"
+#include "metrics/store_bvar_metrics.h"
 #include "proto/common.pb.h"
 #include "server/server.h"
 
@@ -224,6 +226,36 @@ bool StoreRegionMetrics::CollectMetrics() {
 
   DINGO_LOG(DEBUG) << fmt::format("Get region approximate size elapsed[{} ms]", Helper::TimestampMs() - start_time);
 
+  // Get tombstone density, compact region full of tombstones.
+  start_time = Helper::TimestampMs();
+  std::vector<pb::common::Range> ranges;
+  ranges.reserve(need_collect_regions.size());
+  for (const auto& region : need_collect_regions) {
+    ranges.push_back(region->Range());
+  }
+  auto tombstone_stats = raw_engine_->GetTombstoneStats(Constant::kStoreDataCF, ranges);
+  for (size_t i = 0; i < need_collect_regions.size(); ++i) {
+    const auto& region = need_collect_regions[i];
+    auto region_metrics = GetMetrics(region->Id());
+    if (region_metrics == nullptr) {
+      continue;
+    }
+
+    const auto& stats = tombstone_stats[i];
+    double ratio = stats.entry_count > 0 ? static_cast<double>(stats.tombstone_count) / stats.entry_count : 0;
+    region_metrics->SetTombstoneCount(stats.tombstone_count);
+    region_metrics->SetTombstoneRatio(ratio);
+    StoreBvarMetrics::GetInstance().UpdateTombstoneRatio(std::to_string(region->Id()), ratio);
+
+    if (CompactionScheduler::NeedCompact(stats)) {
+      CompactionScheduler::GetInstance()->Schedule(
+          raw_engine_, Constant::kStoreDataCF, region->Range(),
+          fmt::format("region {} tombstones {} ratio {:.2f}", region->Id(), stats.tombstone_count, ratio));
+    }
+  }
+
+  DINGO_LOG(DEBUG) << fmt::format("Get region tombstone stats elapsed[{} ms]", Helper::TimestampMs() - start_time);
+
   return true;
 }
 
@@ -29,6 +29,7 @@
 #include "meta/meta_writer.h"
 #include "meta/store_meta_manager.h"
 #include "meta/transform_kv_able.h"
+#include "metrics/region_hot_stats.h"
 #include "proto/common.pb.h"
 
 namespace dingodb {
@@ -37,7 +38,11 @@ namespace store {
 
 class RegionMetrics {
  public:
-  RegionMetrics() : last_log_index_(0), need_update_min_key_(true), need_update_max_key_(true) {}
+  RegionMetrics()
+      : last_log_index_(0),
+        need_update_min_key_(true),
+        need_update_max_key_(true),
+        hot_stats_(std::make_shared<RegionHotStats>()) {}
   ~RegionMetrics() = default;
 
   std::string Serialize();
@@ -67,8 +72,16 @@ class RegionMetrics {
   uint64_t KeyCount() const { return inner_region_metrics_.row_count(); }
   void SetKeyCount(uint64_t key_count) { inner_region_metrics_.set_row_count(key_count); }
 
+  uint64_t TombstoneCount() const { return inner_region_metrics_.tombstone_count(); }
+  void SetTombstoneCount(uint64_t tombstone_count) { inner_region_metrics_.set_tombstone_count(tombstone_count); }
+
+  double TombstoneRatio() const { return inner_region_metrics_.tombstone_ratio(); }
+  void SetTombstoneRatio(double tombstone_ratio) { inner_region_metrics_.set_tombstone_ratio(tombstone_ratio); }
+
   const pb::common::RegionMetrics& InnerRegionMetrics() { return inner_region_metrics_; }
 
+  std::shared_ptr<RegionHotStats> HotStats() { return hot_stats_; }
+
   using PbKeyValues = google::protobuf::RepeatedPtrField<pb::common::KeyValue>;
   using PbKeys = google::protobuf::RepeatedPtrField<std::string>;
   using PbRanges = google::protobuf::RepeatedPtrField<pb::common::Range>;
@@ -87,6 +100,9 @@ class RegionMetrics {
   bool need_update_max_key_;
 
   pb::common::RegionMetrics inner_region_metrics_;
+
+  // In memory only, not serialized.
+  std::shared_ptr<RegionHotStats> hot_stats_;
 };
 
 using RegionMetricsPtr = std::shared_ptr<RegionMetrics>;
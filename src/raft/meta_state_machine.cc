@@ -20,6 +20,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 
 #include "common/helper.h"
 #include "common/logging.h"
@@ -27,11 +28,15 @@
 #include "coordinator/coordinator_control.h"
 #include "engine/snapshot.h"
 #include "fmt/core.h"
+#include "gflags/gflags.h"
+#include "meta/meta_snapshot_file.h"
 #include "proto/coordinator_internal.pb.h"
 #include "proto/error.pb.h"
 
 namespace dingodb {
 
+DECLARE_bool(meta_snapshot_stream_format);
+
 MetaStateMachine::MetaStateMachine(std::shared_ptr<MetaControl> meta_control, bool is_volatile)
     : meta_control_(meta_control), is_volatile_state_machine_(is_volatile) {}
 
@@ -98,29 +103,71 @@ struct SnapshotArg {
   braft::Closure* done;
 };
 
-static void* SaveSnapshot(void* arg) {
-  SnapshotArg* sa = (SnapshotArg*)arg;
-  std::unique_ptr<SnapshotArg> arg_guard(sa);
-  // Serialize StateMachine to the snapshot
-  brpc::ClosureGuard done_guard(sa->done);
-  std::string snapshot_path = sa->writer->get_path() + "/data";
+static const std::string kMetaSnapshotFileName = "meta_snapshot";
+static const std::string kLegacyMetaSnapshotFileName = "data";
+
+// Old format, whole meta in one protobuf file, it is readable by coordinators of old version.
+static bool SaveLegacySnapshot(SnapshotArg* sa) {
+  std::string snapshot_path = sa->writer->get_path() + "/" + kLegacyMetaSnapshotFileName;
   DINGO_LOG(INFO) << "Saving snapshot to " << snapshot_path;
   // Use protobuf to store the snapshot for backward compatibility.
   pb::coordinator_internal::MetaSnapshotFile s;
   bool ret = sa->control->LoadMetaToSnapshotFile(sa->snapshot, s);
   if (!ret) {
     sa->done->status().set_error(EIO, "Fail to add file to writer, LoadMetaToSnapshotFile return false");
-    return nullptr;
+    return false;
   }
 
   braft::ProtoBufFile pb_file(snapshot_path);
   if (pb_file.save(&s, true) != 0) {
     sa->done->status().set_error(EIO, "Fail to save pb_file");
+    return false;
+  }
+  return true;
+}
+
+static bool SaveStreamSnapshot(SnapshotArg* sa) {
+  std::string snapshot_path = sa->writer->get_path() + "/" + kMetaSnapshotFileName;
+  DINGO_LOG(INFO) << "Saving snapshot to " << snapshot_path;
+  // Stream meta from iterator to chunked file, the snapshot is never materialized in memory.
+  MetaSnapshotFileWriter file_writer(snapshot_path);
+  auto status = file_writer.Open();
+  if (!status.ok()) {
+    sa->done->status().set_error(EIO, "Fail to open snapshot file, %s", status.error_cstr());
+    return false;
+  }
+
+  bool ret = sa->control->SaveMetaToSnapshotFile(sa->snapshot, file_writer);
+  if (!ret) {
+    sa->done->status().set_error(EIO, "Fail to add file to writer, SaveMetaToSnapshotFile return false");
+    return false;
+  }
+
+  status = file_writer.Finish();
+  if (!status.ok()) {
+    sa->done->status().set_error(EIO, "Fail to finish snapshot file, %s", status.error_cstr());
+    return false;
+  }
+  DINGO_LOG(INFO) << "Saved snapshot to " << snapshot_path << " kv_count: " << file_writer.KvCount();
+  return true;
+}
+
+static void* SaveSnapshot(void* arg) {
+  SnapshotArg* sa = (SnapshotArg*)arg;
+  std::unique_ptr<SnapshotArg> arg_guard(sa);
+  // Serialize StateMachine to the snapshot
+  brpc::ClosureGuard done_guard(sa->done);
+  // Followers of old version only read the old format, so keep it until all coordinators are upgraded.
+  bool stream_format = FLAGS_meta_snapshot_stream_format;
+  bool ret = stream_format ? SaveStreamSnapshot(sa) : SaveLegacySnapshot(sa);
+  if (!ret) {
     return nullptr;
   }
+
   // Snapshot is a set of files in raft. Add the only file into the
   // writer here.
-  if (sa->writer->add_file("data") != 0) {
+  const auto& file_name = stream_format ? kMetaSnapshotFileName : kLegacyMetaSnapshotFileName;
+  if (sa->writer->add_file(file_name) != 0) {
     sa->done->status().set_error(EIO, "Fail to add file to writer");
     return nullptr;
   }
@@ -148,8 +195,9 @@ int MetaStateMachine::on_snapshot_load(braft::SnapshotReader* reader) {
   if (!is_volatile_state_machine_) {
     CHECK(!this->meta_control_->IsLeader()) << "Leader is not supposed to load snapshot";
   }
-  if (reader->get_file_meta("data", nullptr) != 0) {
-    DINGO_LOG(ERROR) << "Fail to find `data' on " << reader->get_path();
+  bool is_stream_file = reader->get_file_meta(kMetaSnapshotFileName, nullptr) == 0;
+  if (!is_stream_file && reader->get_file_meta(kLegacyMetaSnapshotFileName, nullptr) != 0) {
+    DINGO_LOG(ERROR) << "Fail to find snapshot file on " << reader->get_path();
     return -1;
   }
 
@@ -185,7 +233,24 @@ int MetaStateMachine::on_snapshot_load(braft::SnapshotReader* reader) {
     return 0;
   }
 
-  std::string snapshot_path = reader->get_path() + "/data";
+  if (is_stream_file) {
+    std::string snapshot_path = reader->get_path() + "/" + kMetaSnapshotFileName;
+    MetaSnapshotFileReader file_reader(snapshot_path);
+    auto status = file_reader.Open();
+    if (!status.ok()) {
+      DINGO_LOG(ERROR) << "Fail to open snapshot file " << snapshot_path << ", " << status.error_str();
+      return -1;
+    }
+
+    if (!this->meta_control_->LoadMetaFromSnapshotFile(file_reader)) {
+      DINGO_LOG(ERROR) << "Fail to load snapshot from " << snapshot_path << " LoadMetaFromSnapshotFile return false";
+      return -1;
+    }
+    return 0;
+  }
+
+  // Snapshot of old format, whole meta in one protobuf file.
+  std::string snapshot_path = reader->get_path() + "/" + kLegacyMetaSnapshotFileName;
   braft::ProtoBufFile pb_file(snapshot_path);
   pb::coordinator_internal::MetaSnapshotFile s;
   if (pb_file.load(&s) != 0) {
@@ -19,12 +19,14 @@
 #include <string>
 #include <utility>
 
+#include "braft/storage.h"
 #include "bthread/bthread.h"
 #include "common/failpoint.h"
 #include "common/helper.h"
 #include "common/logging.h"
 #include "config/config_manager.h"
 #include "fmt/core.h"
+#include "gflags/gflags.h"
 #include "log/segment_log_storage.h"
 #include "metrics/store_bvar_metrics.h"
 #include "proto/common.pb.h"
@@ -33,13 +35,22 @@
 
 namespace dingodb {
 
+DEFINE_bool(raft_enable_adaptive_snapshot, true,
+            "Snapshot by log size and apply lag instead of fixed interval, take effect at raft node init");
+
 RaftNode::RaftNode(uint64_t node_id, const std::string& raft_group_name, braft::PeerId peer_id,
                    braft::StateMachine* fsm)
     : node_id_(node_id),
       str_node_id_(std::to_string(node_id)),
       raft_group_name_(raft_group_name),
       node_(new braft::Node(raft_group_name, peer_id)),
-      fsm_(fsm) {}
+      fsm_(fsm),
+      log_storage_(nullptr),
+      is_adaptive_snapshot_(false),
+      snapshot_interval_s_(0),
+      last_snapshot_index_(0),
+      last_snapshot_time_s_(0),
+      is_snapshotting_(false) {}
 
 RaftNode::~RaftNode() {
   if (fsm_) {
@@ -48,8 +59,26 @@ RaftNode::~RaftNode() {
   }
 }
 
+// local: one meta file per raft node, every term/vote change sync its own file.
+// merged: term/vote of all raft nodes on server are kept in one kv store, writes are batched and synced together.
+// mixed: write both and read the newer one, for upgrading from local to merged without losing vote.
+// Missing or unknown config fall back to local, which is the layout of existing deployments.
+static std::string GenRaftMetaUri(const std::string& meta_storage, const std::string& raft_path,
+                                  const std::string& node_path) {
+  if (meta_storage == "merged") {
+    return fmt::format("local-merged://{}/merged_raft_meta", raft_path);
+  } else if (meta_storage == "mixed") {
+    return fmt::format("local-mixed://merged_path={}/merged_raft_meta&&single_path={}/raft_meta", raft_path,
+                       node_path);
+  } else if (meta_storage != "local") {
+    DINGO_LOG(WARNING) << fmt::format("Unknown raft meta storage '{}', use local", meta_storage);
+  }
+
+  return fmt::format("local://{}/raft_meta", node_path);
+}
+
 // init_conf: 127.0.0.1:8201:0,127.0.0.1:8202:0,127.0.0.1:8203:0
-int RaftNode::Init(const std::string& init_conf, std::shared_ptr<Config> config) {
+int RaftNode::Init(const std::string& init_conf, std::shared_ptr<Config> config, bool adaptive_snapshot) {
   DINGO_LOG(INFO) << "raft init node_id: " << node_id_ << " init_conf: " << init_conf;
   braft::NodeOptions node_options;
   if (node_options.initial_conf.parse_from(init_conf) != 0) {
@@ -60,13 +89,19 @@ int RaftNode::Init(const std::string& init_conf, std::shared_ptr<Config> config)
   node_options.election_timeout_ms = config->GetInt("raft.election_timeout");
   node_options.fsm = fsm_;
   node_options.node_owns_fsm = false;
-  node_options.snapshot_interval_s = config->GetInt("raft.snapshot_interval");
+  snapshot_interval_s_ = config->GetInt("raft.snapshot_interval");
+  // Adaptive snapshot is driven by RaftSnapshotScheduler, disable braft snapshot timer.
+  is_adaptive_snapshot_ = adaptive_snapshot && FLAGS_raft_enable_adaptive_snapshot;
+  node_options.snapshot_interval_s = is_adaptive_snapshot_ ? 0 : snapshot_interval_s_;
 
   path_ = fmt::format("{}/{}", config->GetString("raft.path"), node_id_);
-  node_options.raft_meta_uri = "local://" + path_ + "/raft_meta";
+  std::string meta_storage = config->GetString("raft.meta_storage");
+  raft_meta_uri_ = GenRaftMetaUri(meta_storage, config->GetString("raft.path"), path_);
+  node_options.raft_meta_uri = raft_meta_uri_;
   node_options.snapshot_uri = "local://" + path_ + "/snapshot";
   node_options.disable_cli = false;
-  node_options.log_storage = new SegmentLogStorage(path_ + "/log");
+  log_storage_ = new SegmentLogStorage(path_ + "/log");
+  node_options.log_storage = log_storage_;
   node_options.node_owns_log_storage = true;
 
   if (node_->init(node_options) != 0) {
@@ -74,6 +109,12 @@ int RaftNode::Init(const std::string& init_conf, std::shared_ptr<Config> config)
     return -1;
   }
 
+  // Right after init applied index is the index of loaded snapshot.
+  braft::NodeStatus status;
+  node_->get_status(&status);
+  last_snapshot_index_.store(status.known_applied_index);
+  last_snapshot_time_s_.store(Helper::Timestamp());
+
   return 0;
 }
 
@@ -90,6 +131,16 @@ void RaftNode::Destroy() {
   node_->join();
   DINGO_LOG(DEBUG) << fmt::format("Delete region {} finish raft node shutdown", node_id_);
 
+  // Delete term/vote record, merged raft meta storage is not under node directory.
+  if (!raft_meta_uri_.empty()) {
+    std::string v_group_id = fmt::format("{}_{}", raft_group_name_, GetPeerId().idx);
+    auto status = braft::RaftMetaStorage::destroy(raft_meta_uri_, v_group_id);
+    if (!status.ok()) {
+      DINGO_LOG(WARNING) << fmt::format("Delete region {} raft meta failed, error: {}", node_id_,
+                                        status.error_cstr());
+    }
+  }
+
   // Delete file directory
   Helper::RemoveAllFileOrDirectory(path_);
   DINGO_LOG(DEBUG) << fmt::format("Delete region {} delete file directory", node_id_);
@@ -106,6 +157,8 @@ butil::Status RaftNode::Commit(std::shared_ptr<Context> ctx, std::shared_ptr<pb:
 
   FAIL_POINT("before_raft_commit");
 
+  ctx->RecordStage(WriteStage::kPropose);
+
   braft::Task task;
   task.data = &data;
   task.done = new StoreClosure(ctx, raft_cmd);
@@ -149,7 +202,57 @@ butil::Status RaftNode::ResetPeers(const braft::Configuration& new_peers) { retu
 
 int RaftNode::TransferLeadershipTo(const braft::PeerId& peer) { return node_->transfer_leadership_to(peer); }
 
-void RaftNode::Snapshot(braft::Closure* done) { node_->snapshot(done); }
+// Record snapshot progress, then run user done.
+// Only the call which set is_snapshotting_ finish it, a call rejected with EBUSY must not end the running snapshot.
+class SnapshotDoneClosure : public braft::Closure {
+ public:
+  SnapshotDoneClosure(RaftNode* node, int64_t snapshot_index, bool is_owner, braft::Closure* done)
+      : node_(node), snapshot_index_(snapshot_index), is_owner_(is_owner), done_(done) {}
+  ~SnapshotDoneClosure() override = default;
+
+  void Run() override {
+    std::unique_ptr<SnapshotDoneClosure> self_guard(this);
+    if (is_owner_) {
+      node_->FinishSnapshot(status().ok(), snapshot_index_);
+    }
+    if (done_ != nullptr) {
+      done_->status() = status();
+      done_->Run();
+    }
+  }
+
+ private:
+  RaftNode* node_;
+  int64_t snapshot_index_;
+  bool is_owner_;
+  braft::Closure* done_;
+};
+
+void RaftNode::Snapshot(braft::Closure* done) {
+  braft::NodeStatus status;
+  node_->get_status(&status);
+  bool expected = false;
+  bool is_owner = is_snapshotting_.compare_exchange_strong(expected, true);
+  node_->snapshot(new SnapshotDoneClosure(this, status.known_applied_index, is_owner, done));
+}
+
+void RaftNode::FinishSnapshot(bool success, int64_t snapshot_index) {
+  if (success) {
+    if (snapshot_index > last_snapshot_index_.load()) {
+      last_snapshot_index_.store(snapshot_index);
+    }
+    last_snapshot_time_s_.store(Helper::Timestamp());
+  }
+  is_snapshotting_.store(false);
+}
+
+int64_t RaftNode::LogBytes() { return log_storage_ != nullptr ? log_storage_->GetLogBytes() : 0; }
+
+int64_t RaftNode::LogAppendTimeUs(int64_t index) {
+  return log_storage_ != nullptr ? log_storage_->GetAppendTimeUs(index) : 0;
+}
+
+void RaftNode::GetStatus(braft::NodeStatus& status) { node_->get_status(&status); }
 
 std::shared_ptr<pb::common::BRaftStatus> RaftNode::GetStatus() {
   braft::NodeStatus status;
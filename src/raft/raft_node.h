@@ -18,11 +18,13 @@
 #include <braft/raft.h>
 #include <braft/util.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 
 #include "common/context.h"
 #include "config/config.h"
+#include "log/segment_log_storage.h"
 #include "proto/common.pb.h"
 #include "proto/error.pb.h"
 #include "proto/raft.pb.h"
@@ -35,7 +37,9 @@ class RaftNode {
   RaftNode(uint64_t node_id, const std::string& raft_group_name, braft::PeerId peer_id, braft::StateMachine* fsm);
   ~RaftNode();
 
-  int Init(const std::string& init_conf, std::shared_ptr<Config> config);
+  // adaptive_snapshot: snapshot is scheduled by RaftSnapshotScheduler instead of braft timer,
+  // take effect only when raft_enable_adaptive_snapshot is on.
+  int Init(const std::string& init_conf, std::shared_ptr<Config> config, bool adaptive_snapshot);
   void Stop();
   void Destroy();
 
@@ -62,17 +66,41 @@ class RaftNode {
   int TransferLeadershipTo(const braft::PeerId& peer);
 
   void Snapshot(braft::Closure* done);
+  void FinishSnapshot(bool success, int64_t snapshot_index);
+
+  // For snapshot scheduling.
+  int64_t LogBytes();
+  // Persisted time(us) of recent log entry, 0 if unknown.
+  int64_t LogAppendTimeUs(int64_t index);
+  bool IsAdaptiveSnapshot() const { return is_adaptive_snapshot_; }
+  int64_t SnapshotIntervalS() const { return snapshot_interval_s_; }
+  int64_t LastSnapshotIndex() const { return last_snapshot_index_.load(); }
+  int64_t LastSnapshotTimeS() const { return last_snapshot_time_s_.load(); }
+  bool IsSnapshotting() const { return is_snapshotting_.load(); }
+  void GetStatus(braft::NodeStatus& status);
 
   std::shared_ptr<pb::common::BRaftStatus> GetStatus();
 
+  braft::StateMachine* GetStateMachine() { return fsm_; }
+
  private:
   std::string path_;
+  std::string raft_meta_uri_;
   uint64_t node_id_;
   std::string str_node_id_;
   std::string raft_group_name_;
 
   std::unique_ptr<braft::Node> node_;
   braft::StateMachine* fsm_;
+  // Owned by node_.
+  SegmentLogStorage* log_storage_;
+
+  bool is_adaptive_snapshot_;
+  int64_t snapshot_interval_s_;
+  // Applied index of the last snapshot, used to count entries since the last snapshot.
+  std::atomic<int64_t> last_snapshot_index_;
+  std::atomic<int64_t> last_snapshot_time_s_;
+  std::atomic<bool> is_snapshotting_;
 };
 
 }  // namespace dingodb
@@ -54,4 +54,15 @@ void RaftNodeManager::DeleteNode(uint64_t node_id) {
   nodes_.erase(node_id);
 }
 
+std::vector<std::shared_ptr<RaftNode>> RaftNodeManager::GetAllNode() {
+  BAIDU_SCOPED_LOCK(mutex_);
+  std::vector<std::shared_ptr<RaftNode>> nodes;
+  nodes.reserve(nodes_.size());
+  for (auto& [_, node] : nodes_) {
+    nodes.push_back(node);
+  }
+
+  return nodes;
+}
+
 }  // namespace dingodb
\ No newline at end of file
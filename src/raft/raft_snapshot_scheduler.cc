@@ -0,0 +1,190 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "raft/raft_snapshot_scheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "bthread/bthread.h"
+#include "bvar/reducer.h"
+#include "common/helper.h"
+#include "common/logging.h"
+#include "engine/raft_store_engine.h"
+#include "fmt/core.h"
+#include "gflags/gflags.h"
+#include "server/server.h"
+
+namespace dingodb {
+
+DECLARE_bool(raft_enable_adaptive_snapshot);
+
+DEFINE_int64(raft_snapshot_log_bytes, 256 * 1024 * 1024, "Do snapshot when raft log bytes exceed it");
+DEFINE_int64(raft_snapshot_log_entries, 200000, "Do snapshot when raft log entries since the last snapshot exceed it");
+DEFINE_int64(raft_snapshot_follower_lag_entries, 10000,
+             "Delay snapshot while leader's slowest follower lag more than it, avoid install snapshot");
+DEFINE_int64(raft_snapshot_log_bytes_hard_limit, 1024 * 1024 * 1024,
+             "Do snapshot when raft log bytes exceed it even if follower lag");
+DEFINE_int32(raft_snapshot_max_concurrency, 4, "Max concurrent snapshots scheduled on server");
+DEFINE_int32(raft_snapshot_schedule_interval_ms, 10000, "Interval of raft snapshot schedule");
+
+static std::atomic<bool> g_scheduling{false};
+static std::atomic<int32_t> g_snapshot_inflight{0};
+
+static bvar::Adder<int64_t> g_raft_snapshot_schedule_count("dingo_raft_snapshot_schedule_count");
+static bvar::Adder<int64_t> g_raft_snapshot_schedule_defer_count("dingo_raft_snapshot_schedule_defer_count");
+
+class ScheduledSnapshotClosure : public braft::Closure {
+ public:
+  explicit ScheduledSnapshotClosure(uint64_t node_id) : node_id_(node_id) {}
+  ~ScheduledSnapshotClosure() override = default;
+
+  void Run() override {
+    std::unique_ptr<ScheduledSnapshotClosure> self_guard(this);
+    g_snapshot_inflight.fetch_sub(1);
+    if (!status().ok()) {
+      DINGO_LOG(WARNING) << fmt::format("[raft.snapshot][node_id({})] scheduled snapshot failed, error: {}", node_id_,
+                                        status().error_cstr());
+    }
+  }
+
+ private:
+  uint64_t node_id_;
+};
+
+bool RaftSnapshotScheduler::NeedSnapshot(const RaftSnapshotHint& hint) {
+  // Idle raft node, nothing to snapshot.
+  int64_t log_entries = hint.applied_index - hint.last_snapshot_index;
+  if (log_entries <= 0) {
+    return false;
+  }
+
+  bool need = hint.log_bytes >= FLAGS_raft_snapshot_log_bytes || log_entries >= FLAGS_raft_snapshot_log_entries ||
+              (hint.interval_s > 0 && hint.elapsed_s >= hint.interval_s);
+  if (!need) {
+    return false;
+  }
+
+  // Truncate log which slowest follower still need, it have to install snapshot.
+  if (hint.is_leader && hint.slowest_match_index >= 0 &&
+      hint.applied_index - hint.slowest_match_index > FLAGS_raft_snapshot_follower_lag_entries &&
+      hint.log_bytes < FLAGS_raft_snapshot_log_bytes_hard_limit) {
+    g_raft_snapshot_schedule_defer_count << 1;
+    return false;
+  }
+
+  return true;
+}
+
+static RaftSnapshotHint GenSnapshotHint(std::shared_ptr<RaftNode> node) {
+  braft::NodeStatus status;
+  node->GetStatus(status);
+
+  RaftSnapshotHint hint;
+  hint.applied_index = status.known_applied_index;
+  hint.last_snapshot_index = node->LastSnapshotIndex();
+  hint.log_bytes = node->LogBytes();
+  hint.elapsed_s = Helper::Timestamp() - node->LastSnapshotTimeS();
+  hint.interval_s = node->SnapshotIntervalS();
+  hint.is_leader = status.state == braft::STATE_LEADER;
+  if (hint.is_leader) {
+    for (const auto& [_, peer_status] : status.stable_followers) {
+      // Unhealthy follower need install snapshot anyway, not wait for it.
+      if (!peer_status.valid || peer_status.installing_snapshot || peer_status.consecutive_error_times > 0) {
+        continue;
+      }
+      int64_t match_index = peer_status.next_index - 1;
+      if (hint.slowest_match_index < 0 || match_index < hint.slowest_match_index) {
+        hint.slowest_match_index = match_index;
+      }
+    }
+  }
+
+  return hint;
+}
+
+void RaftSnapshotScheduler::Schedule(const std::vector<std::shared_ptr<RaftNode>>& nodes) {
+  struct Candidate {
+    std::shared_ptr<RaftNode> node;
+    RaftSnapshotHint hint;
+  };
+
+  std::vector<Candidate> candidates;
+  for (const auto& node : nodes) {
+    if (!node->IsAdaptiveSnapshot() || node->IsSnapshotting()) {
+      continue;
+    }
+    auto hint = GenSnapshotHint(node);
+    if (NeedSnapshot(hint)) {
+      candidates.push_back({node, hint});
+    }
+  }
+  if (candidates.empty()) {
+    return;
+  }
+
+  // Largest log first, it is the most likely to fill disk.
+  std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+    if (a.hint.log_bytes != b.hint.log_bytes) {
+      return a.hint.log_bytes > b.hint.log_bytes;
+    }
+    return a.hint.applied_index - a.hint.last_snapshot_index > b.hint.applied_index - b.hint.last_snapshot_index;
+  });
+
+  for (auto& candidate : candidates) {
+    if (g_snapshot_inflight.load() >= FLAGS_raft_snapshot_max_concurrency) {
+      break;
+    }
+
+    const auto& hint = candidate.hint;
+    DINGO_LOG(INFO) << fmt::format(
+        "[raft.snapshot][node_id({})] schedule snapshot, log_bytes: {} log_entries: {} elapsed_s: {}",
+        candidate.node->GetNodeId(), hint.log_bytes, hint.applied_index - hint.last_snapshot_index, hint.elapsed_s);
+    g_snapshot_inflight.fetch_add(1);
+    g_raft_snapshot_schedule_count << 1;
+    candidate.node->Snapshot(new ScheduledSnapshotClosure(candidate.node->GetNodeId()));
+  }
+}
+
+void RaftSnapshotScheduler::TriggerSchedule(void*) {
+  if (!FLAGS_raft_enable_adaptive_snapshot) {
+    return;
+  }
+  // Skip this round if last round not finished.
+  if (g_scheduling.exchange(true)) {
+    return;
+  }
+
+  bthread_t tid;
+  const bthread_attr_t attr = BTHREAD_ATTR_NORMAL;
+  int ret = bthread_start_background(
+      &tid, &attr,
+      [](void*) -> void* {
+        auto engine = std::dynamic_pointer_cast<RaftStoreEngine>(Server::GetInstance()->GetEngine());
+        if (engine != nullptr) {
+          Schedule(engine->GetAllNode());
+        }
+        g_scheduling.store(false);
+        return nullptr;
+      },
+      nullptr);
+  if (ret != 0) {
+    g_scheduling.store(false);
+  }
+}
+
+}  // namespace dingodb
@@ -0,0 +1,53 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_RAFT_RAFT_SNAPSHOT_SCHEDULER_H_
+#define DINGODB_RAFT_RAFT_SNAPSHOT_SCHEDULER_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "raft/raft_node.h"
+
+namespace dingodb {
+
+// Raft node state used to decide whether to do snapshot.
+struct RaftSnapshotHint {
+  int64_t applied_index{0};
+  int64_t last_snapshot_index{0};
+  int64_t log_bytes{0};
+  int64_t elapsed_s{0};
+  int64_t interval_s{0};
+  bool is_leader{false};
+  // Min match index of healthy followers, only for leader, -1 means no follower.
+  int64_t slowest_match_index{-1};
+};
+
+// Snapshot raft nodes by log bytes and entries since the last snapshot instead of a fixed interval,
+// braft truncate log after snapshot. Busy raft nodes snapshot first, and concurrent snapshots are bounded,
+// the rest wait for next round.
+class RaftSnapshotScheduler {
+ public:
+  // Crontab function, schedule in background bthread.
+  static void TriggerSchedule(void*);
+
+  static void Schedule(const std::vector<std::shared_ptr<RaftNode>>& nodes);
+
+  static bool NeedSnapshot(const RaftSnapshotHint& hint);
+};
+
+}  // namespace dingodb
+
+#endif  // DINGODB_RAFT_RAFT_SNAPSHOT_SCHEDULER_H_
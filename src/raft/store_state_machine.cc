@@ -18,9 +18,11 @@
 #include <string>
 
 #include "braft/util.h"
+#include "butil/time.h"
 #include "butil/status.h"
 #include "common/helper.h"
 #include "common/logging.h"
+#include "engine/raft_store_engine.h"
 #include "event/store_state_machine_event.h"
 #include "fmt/core.h"
 #include "meta/meta_writer.h"
@@ -44,7 +46,24 @@ void StoreClosure::Run() {
 
     ctx_->SetStatus(butil::Status(pb::error::ERAFT_COMMITLOG, status().error_str()));
   }
+  ctx_->RecordStage(WriteStage::kResponse);
+
+  // Merged by write batcher, fan out to every request.
+  if (ctx_->IsBatch()) {
+    for (const auto& batch_ctx : ctx_->BatchCtxs()) {
+      StoreBvarMetrics::GetInstance().ObserveWriteStage(batch_ctx);
+      brpc::ClosureGuard const batch_done_guard(batch_ctx->Done());
+      if (!status().ok()) {
+        batch_ctx->SetStatus(butil::Status(pb::error::ERAFT_COMMITLOG, status().error_str()));
+      }
+      if (batch_ctx->WriteCb()) {
+        batch_ctx->WriteCb()(batch_ctx, batch_ctx->Status());
+      }
+    }
+    return;
+  }
 
+  StoreBvarMetrics::GetInstance().ObserveWriteStage(ctx_);
   if (ctx_->IsSyncMode()) {
     ctx_->Cond()->DecreaseSignal();
   } else {
@@ -78,7 +97,15 @@ void StoreStateMachine::DispatchEvent(dingodb::EventType event_type, std::shared
   }
 }
 
+static std::shared_ptr<RaftNode> GetRaftNode(uint64_t region_id) {
+  auto engine = std::dynamic_pointer_cast<RaftStoreEngine>(Server::GetInstance()->GetEngine());
+  return engine != nullptr ? engine->GetNode(region_id) : nullptr;
+}
+
 void StoreStateMachine::on_apply(braft::Iterator& iter) {
+  // Committed entries are handed to state machine.
+  int64_t commit_time_us = butil::gettimeofday_us();
+  std::shared_ptr<RaftNode> raft_node;
   for (; iter.valid(); iter.next()) {
     braft::AsyncClosureGuard done_guard(iter.done());
     if (iter.index() <= applied_index_) {
@@ -86,9 +113,11 @@ void StoreStateMachine::on_apply(braft::Iterator& iter) {
     }
 
     auto raft_cmd = std::make_shared<pb::raft::RaftCmdRequest>();
+    std::shared_ptr<Context> ctx;
     if (iter.done()) {
       StoreClosure* store_closure = dynamic_cast<StoreClosure*>(iter.done());
       raft_cmd = store_closure->GetRequest();
+      ctx = store_closure->GetCtx();
     } else {
       butil::IOBufAsZeroCopyInputStream wrapper(iter.data());
       CHECK(raft_cmd->ParseFromZeroCopyStream(&wrapper));
@@ -107,7 +136,31 @@ void StoreStateMachine::on_apply(braft::Iterator& iter) {
     event->term_id = iter.term();
     event->log_id = iter.index();
 
+    // Only leader has request context.
+    if (ctx != nullptr) {
+      if (raft_node == nullptr) {
+        raft_node = GetRaftNode(region_->Id());
+      }
+      if (raft_node != nullptr) {
+        ctx->RecordStage(WriteStage::kLogAppend, raft_node->LogAppendTimeUs(iter.index()));
+      }
+      ctx->RecordStage(WriteStage::kCommit, commit_time_us);
+      ctx->RecordStage(WriteStage::kApplyStart);
+    }
+
     DispatchEvent(EventType::kSmApply, event);
+    if (ctx != nullptr) {
+      ctx->RecordStage(WriteStage::kApplyEnd);
+    }
+    if (!apply_error_.ok()) {
+      DINGO_LOG(ERROR) << fmt::format("raft apply log on region[{}-term:{}-index:{}] failed, set node error, {} {}",
+                                      region_->Id(), iter.term(), iter.index(), apply_error_.error_code(),
+                                      apply_error_.error_str());
+      // Rollback closure is run by braft with error.
+      done_guard.release();
+      iter.set_error_and_rollback(1, &apply_error_);
+      break;
+    }
     applied_term_ = iter.term();
     applied_index_ = iter.index();
 
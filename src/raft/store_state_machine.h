@@ -72,6 +72,10 @@ class StoreStateMachine : public braft::StateMachine {
   void on_start_following(const braft::LeaderChangeContext& ctx) override;
   void on_stop_following(const braft::LeaderChangeContext& ctx) override;
 
+  // Called by handler in on_apply, the log entry is not applied and node turn to error state,
+  // use for failure can't be retried and replica must not diverge.
+  void SetApplyError(const butil::Status& status) { apply_error_ = status; }
+
  private:
   void DispatchEvent(dingodb::EventType, std::shared_ptr<dingodb::Event> event);
 
@@ -87,6 +91,9 @@ class StoreStateMachine : public braft::StateMachine {
   store::RegionMetricsPtr region_metrics_;
 
   std::atomic<bool> is_restart_for_load_snapshot_;
+
+  // Only accessed in on_apply.
+  butil::Status apply_error_;
 };
 
 }  // namespace dingodb
@@ -14,6 +14,7 @@
 
 #include "scan/scan.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -24,17 +25,26 @@
 #include "bthread/mutex.h"
 #include "butil/compiler_specific.h"
 #include "butil/macros.h"     // IWYU pragma: keep
+#include "bvar/reducer.h"
 #include "common/constant.h"  // IWYU pragma: keep
 #include "common/helper.h"    // IWYU pragma: keep
 #include "common/logging.h"
 #include "coprocessor/utils.h"
 #include "engine/write_data.h"  // IWYU pragma: keep
 #include "fmt/core.h"
+#include "gflags/gflags.h"
 #include "proto/common.pb.h"
 #include "proto/error.pb.h"
 
 namespace dingodb {
 
+DEFINE_uint32(scan_parallel_aggregate_concurrency, 8,
+              "Max sub ranges of aggregation scan in parallel within one region, 1 means not parallel");
+DEFINE_uint64(scan_parallel_aggregate_min_bytes, 256 * 1024 * 1024,
+              "Min approximate bytes of sub range of parallel aggregation scan");
+
+static bvar::Adder<int64_t> g_scan_parallel_aggregate_count("dingo_scan_parallel_aggregate_count");
+
 // timeout millisecond to destroy
 uint64_t ScanContext::timeout_ms_ = 0;
 
@@ -59,7 +69,8 @@ ScanContext::ScanContext()
       seek_state_(SeekState::kUninit)
 
       ,
-      disable_coprocessor_(true) {
+      disable_coprocessor_(true),
+      is_already_call_parallel_aggregate_(false) {
   bthread_mutex_init(&mutex_, nullptr);
 }
 ScanContext::~ScanContext() { Close(); }
@@ -115,6 +126,7 @@ void ScanContext::Close() {
   is_already_call_start_ = false;
   last_time_ms_.zero();
   coprocessor_.reset();
+  is_already_call_parallel_aggregate_ = false;
   bthread_mutex_destroy(&mutex_);
 }
 
@@ -134,6 +146,15 @@ butil::Status ScanContext::GetKeyValue(std::vector<pb::common::KeyValue>& kvs) {
 
   if (!disable_coprocessor_) {
     butil::Status status;
+    if (!is_already_call_parallel_aggregate_) {
+      is_already_call_parallel_aggregate_ = true;
+      status = ParallelAggregate();
+      if (!status.ok()) {
+        DINGO_LOG(ERROR) << fmt::format("ScanContext::ParallelAggregate failed");
+        return status;
+      }
+    }
+
     status = coprocessor_->Execute(iter_, key_only_, std::min(max_fetch_cnt_, max_fetch_cnt_by_server_), max_bytes_rpc_,
                                    &kvs);
     if (!status.ok()) {
@@ -173,6 +194,30 @@ butil::Status ScanContext::GetKeyValue(std::vector<pb::common::KeyValue>& kvs) {
   return butil::Status();
 }
 
+butil::Status ScanContext::ParallelAggregate() {
+  if (FLAGS_scan_parallel_aggregate_concurrency <= 1 || !coprocessor_->HasAggregation()) {
+    return butil::Status();
+  }
+
+  std::vector<pb::common::Range> ranges = {range_};
+  uint64_t size = engine_->GetApproximateSizes(cf_name_, ranges)[0];
+  uint64_t count = std::min(static_cast<uint64_t>(FLAGS_scan_parallel_aggregate_concurrency),
+                            size / std::max(FLAGS_scan_parallel_aggregate_min_bytes, static_cast<uint64_t>(1)));
+  if (count <= 1) {
+    return butil::Status();
+  }
+
+  auto sub_ranges = engine_->SplitRange(cf_name_, range_, count);
+  if (sub_ranges.size() <= 1) {
+    return butil::Status();
+  }
+
+  DINGO_LOG(INFO) << fmt::format("[scan][region({})] parallel aggregate {} sub ranges, approximate size: {}",
+                                 region_id_, sub_ranges.size(), size);
+  g_scan_parallel_aggregate_count << 1;
+  return coprocessor_->ExecuteParallel(engine_->NewReader(cf_name_), engine_->GetSnapshot(), sub_ranges);
+}
+
 butil::Status ScanContext::AsyncWork() {
   auto lambda_call = [this]() {
     BAIDU_SCOPED_LOCK(mutex_);
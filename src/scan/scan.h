@@ -78,6 +78,9 @@ class ScanContext {
   static std::chrono::milliseconds GetCurrentTime();
   butil::Status GetKeyValue(std::vector<pb::common::KeyValue>& kvs);  // NOLINT
 
+  // Aggregate large range by sub ranges in parallel.
+  butil::Status ParallelAggregate();
+
   butil::Status AsyncWork();
   void WaitForReady();
   butil::Status SeekCheck();
@@ -123,6 +126,9 @@ class ScanContext {
   // coprocessor
   std::shared_ptr<Coprocessor> coprocessor_;
 
+  // call ParallelAggregate
+  bool is_already_call_parallel_aggregate_;
+
   // timeout millisecond to destroy
   static uint64_t timeout_ms_;
 
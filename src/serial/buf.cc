@@ -14,10 +14,27 @@
 
 #include "buf.h"
 
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
 #include "serial/utils.h"
 
 namespace dingodb {
 
+// Byte order conversion, each is an involution, so it is used for both write and read.
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+static inline uint64_t ToBE64(uint64_t v) { return __builtin_bswap64(v); }
+static inline uint64_t ToLE64(uint64_t v) { return v; }
+static inline uint32_t ToBE32(uint32_t v) { return __builtin_bswap32(v); }
+static inline uint32_t ToLE32(uint32_t v) { return v; }
+#else
+static inline uint64_t ToBE64(uint64_t v) { return v; }
+static inline uint64_t ToLE64(uint64_t v) { return __builtin_bswap64(v); }
+static inline uint32_t ToBE32(uint32_t v) { return v; }
+static inline uint32_t ToLE32(uint32_t v) { return __builtin_bswap32(v); }
+#endif
+
 Buf::Buf(int size) {
   Init(size);
   this->le_ = IsLE();
@@ -67,108 +84,108 @@ void Buf::Init(const std::string& buf) {
   this->reverse_pos_ = this->buf_.size() - 1;
 }
 
+void Buf::Reset() {
+  this->forward_pos_ = 0;
+  this->reverse_pos_ = this->buf_.size() - 1;
+}
+
 void Buf::SetForwardPos(int fp) { this->forward_pos_ = fp; }
 
 void Buf::SetReversePos(int rp) { this->reverse_pos_ = rp; }
 
 void Buf::Write(uint8_t b) { buf_.at(forward_pos_++) = b; }
 
-void Buf::Write(const std::string& data) {
-  for (auto it : data) {
-    buf_.at(forward_pos_++) = it;
+void Buf::Write(const std::string& data) { Write(data.data(), data.size()); }
+
+void Buf::Write(const char* data, int size) { memcpy(ForwardWrite(size), data, size); }
+
+void Buf::WriteBE64(uint64_t v) {
+  v = ToBE64(v);
+  memcpy(ForwardWrite(8), &v, 8);
+}
+
+void Buf::WriteLE64(uint64_t v) {
+  v = ToLE64(v);
+  memcpy(ForwardWrite(8), &v, 8);
+}
+
+uint64_t Buf::ReadBE64() {
+  uint64_t v;
+  memcpy(&v, ForwardRead(8), 8);
+  return ToBE64(v);
+}
+
+uint64_t Buf::ReadLE64() {
+  uint64_t v;
+  memcpy(&v, ForwardRead(8), 8);
+  return ToLE64(v);
+}
+
+char* Buf::ForwardWrite(int size) {
+  if (size < 0 || forward_pos_ + size > static_cast<int>(buf_.size())) {
+    throw std::out_of_range("Buf forward write out of range");
   }
+  char* data = buf_.data() + forward_pos_;
+  forward_pos_ += size;
+  return data;
 }
 
-void Buf::WriteInt(int32_t i) {
-  uint32_t* ii = (uint32_t*)&i;
-  if (this->le_) {
-    Write(*ii >> 24);
-    Write(*ii >> 16);
-    Write(*ii >> 8);
-    Write(*ii);
-  } else {
-    Write(*ii);
-    Write(*ii >> 8);
-    Write(*ii >> 16);
-    Write(*ii >> 24);
+const char* Buf::ForwardRead(int size) {
+  if (size < 0 || forward_pos_ + size > static_cast<int>(buf_.size())) {
+    throw std::out_of_range("Buf forward read out of range");
   }
+  const char* data = buf_.data() + forward_pos_;
+  forward_pos_ += size;
+  return data;
+}
+
+void Buf::WriteInt(int32_t i) {
+  uint32_t v = this->le_ ? ToBE32(i) : ToLE32(i);
+  memcpy(ForwardWrite(4), &v, 4);
 }
 
 void Buf::WriteLong(int64_t l) {
-  uint64_t* ll = (uint64_t*)&l;
   if (this->le_) {
-    Write(*ll >> 56);
-    Write(*ll >> 48);
-    Write(*ll >> 40);
-    Write(*ll >> 32);
-    Write(*ll >> 24);
-    Write(*ll >> 16);
-    Write(*ll >> 8);
-    Write(*ll);
+    WriteBE64(l);
   } else {
-    Write(*ll);
-    Write(*ll >> 8);
-    Write(*ll >> 16);
-    Write(*ll >> 24);
-    Write(*ll >> 32);
-    Write(*ll >> 40);
-    Write(*ll >> 48);
-    Write(*ll >> 56);
+    WriteLE64(l);
   }
 }
 
 void Buf::ReverseWrite(uint8_t b) { buf_.at(reverse_pos_--) = b; }
 
+// Reverse write the lowest byte first, so the bytes lay in memory as the opposite order of WriteInt.
 void Buf::ReverseWriteInt(int32_t i) {
-  uint32_t* ii = (uint32_t*)&i;
-  if (this->le_) {
-    ReverseWrite(*ii >> 24);
-    ReverseWrite(*ii >> 16);
-    ReverseWrite(*ii >> 8);
-    ReverseWrite(*ii);
-  } else {
-    ReverseWrite(*ii);
-    ReverseWrite(*ii >> 8);
-    ReverseWrite(*ii >> 16);
-    ReverseWrite(*ii >> 24);
+  if (reverse_pos_ < 3 || reverse_pos_ >= static_cast<int>(buf_.size())) {
+    throw std::out_of_range("Buf reverse write out of range");
   }
+  uint32_t v = this->le_ ? ToLE32(i) : ToBE32(i);
+  reverse_pos_ -= 4;
+  memcpy(buf_.data() + reverse_pos_ + 1, &v, 4);
 }
 
 uint8_t Buf::Read() { return buf_.at(forward_pos_++); }
 
+void Buf::Read(char* data, int size) { memcpy(data, ForwardRead(size), size); }
+
 int32_t Buf::ReadInt() {
-  if (this->le_) {
-    return ((Read() & 0xFF) << 24) | ((Read() & 0xFF) << 16) | ((Read() & 0xFF) << 8) | (Read() & 0xFF);
-  } else {
-    return (Read() & 0xFF) | ((Read() & 0xFF) << 8) | ((Read() & 0xFF) << 16) | ((Read() & 0xFF) << 24);
-  }
+  uint32_t v;
+  memcpy(&v, ForwardRead(4), 4);
+  return this->le_ ? ToBE32(v) : ToLE32(v);
 }
 
-int64_t Buf::ReadLong() {
-  uint64_t l = Read() & 0xFF;
-  if (this->le_) {
-    for (int i = 0; i < 7; i++) {
-      l <<= 8;
-      l |= Read() & 0xFF;
-    }
-  } else {
-    for (int i = 1; i < 8; i++) {
-      l |= (((uint64_t)Read() & 0xFF) << (8 * i));
-    }
-  }
-  return l;
-}
+int64_t Buf::ReadLong() { return this->le_ ? ReadBE64() : ReadLE64(); }
 
 uint8_t Buf::ReverseRead() { return buf_.at(reverse_pos_--); }
 
 int32_t Buf::ReverseReadInt() {
-  if (this->le_) {
-    return ((ReverseRead() & 0xFF) << 24) | ((ReverseRead() & 0xFF) << 16) | ((ReverseRead() & 0xFF) << 8) |
-           (ReverseRead() & 0xFF);
-  } else {
-    return (ReverseRead() & 0xFF) | ((ReverseRead() & 0xFF) << 8) | ((ReverseRead() & 0xFF) << 16) |
-           ((ReverseRead() & 0xFF) << 24);
+  if (reverse_pos_ < 3 || reverse_pos_ >= static_cast<int>(buf_.size())) {
+    throw std::out_of_range("Buf reverse read out of range");
   }
+  uint32_t v;
+  reverse_pos_ -= 4;
+  memcpy(&v, buf_.data() + reverse_pos_ + 1, 4);
+  return this->le_ ? ToLE32(v) : ToBE32(v);
 }
 
 void Buf::ReverseSkipInt() { reverse_pos_ -= 4; }
@@ -187,17 +204,13 @@ void Buf::EnsureRemainder(int length) {
     }
     std::string new_buf;
     new_buf.resize(new_size);
-    for (int i = 0; i < forward_pos_; i++) {
-      new_buf.at(i) = buf_.at(i);
-    }
+    memcpy(new_buf.data(), buf_.data(), forward_pos_);
     int reverse_size = buf_.size() - reverse_pos_ - 1;
     int buf_start = reverse_pos_ + 1;
     int new_buf_start = new_size - reverse_size;
-    for (int i = 0; i < reverse_size; i++) {
-      new_buf.at(new_buf_start + i) = buf_.at(buf_start + i);
-    }
+    memcpy(new_buf.data() + new_buf_start, buf_.data() + buf_start, reverse_size);
     reverse_pos_ = new_size - reverse_size - 1;
-    buf_ = new_buf;
+    buf_.swap(new_buf);
   }
 }
 
@@ -222,13 +235,8 @@ int Buf::GetBytes(std::string& s) {
   if (empty_size > 0) {
     int final_size = buf_.size() - empty_size;
     s.resize(final_size);
-    for (int i = 0; i < forward_pos_; i++) {
-      s[i] = buf_.at(i);
-    }
-    int curr = reverse_pos_ + 1;
-    for (int i = forward_pos_; i < final_size; i++) {
-      s[i] = buf_.at(curr++);
-    }
+    memcpy(s.data(), buf_.data(), forward_pos_);
+    memcpy(s.data() + forward_pos_, buf_.data() + reverse_pos_ + 1, final_size - forward_pos_);
     return final_size;
   }
 
@@ -240,6 +248,19 @@ int Buf::GetBytes(std::string& s) {
   return 0;
 }
 
+int Buf::AppendBytes(std::string& s) {
+  int empty_size = reverse_pos_ - forward_pos_ + 1;
+  if (empty_size < 0) {
+    //"Wrong Key Buf"
+    return -1;
+  }
+
+  int reverse_size = buf_.size() - reverse_pos_ - 1;
+  s.append(buf_.data(), forward_pos_);
+  s.append(buf_.data() + reverse_pos_ + 1, reverse_size);
+  return forward_pos_ + reverse_size;
+}
+
 std::string Buf::GetString() {
   std::string s;
   GetBytes(s);
@@ -15,6 +15,7 @@
 #ifndef DINGO_SERIAL_BUF_H_
 #define DINGO_SERIAL_BUF_H_
 
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -40,15 +41,28 @@ class Buf {
   void Init(int size);
   void Init(std::string* buf);
   void Init(const std::string& buf);
+  // Reset positions to reuse the buffer, keep its size.
+  void Reset();
   void SetForwardPos(int fp);
   void SetReversePos(int rp);
   void Write(uint8_t b);
   void Write(const std::string& data);
+  void Write(const char* data, int size);
+  // Word at a time write/read, byte order is explicit and independent of le_.
+  void WriteBE64(uint64_t v);
+  void WriteLE64(uint64_t v);
+  uint64_t ReadBE64();
+  uint64_t ReadLE64();
+  // Return the address of next size bytes and advance forward position,
+  // used to fill or parse a known size block at once, caller must EnsureRemainder before write.
+  char* ForwardWrite(int size);
+  const char* ForwardRead(int size);
   void WriteInt(int32_t i);
   void WriteLong(int64_t l);
   void ReverseWrite(uint8_t b);
   void ReverseWriteInt(int32_t i);
   uint8_t Read();
+  void Read(char* data, int size);
   int32_t ReadInt();
   int64_t ReadLong();
   uint8_t ReverseRead();
@@ -59,6 +73,8 @@ class Buf {
   void EnsureRemainder(int length);
   std::string* GetBytes();
   int GetBytes(std::string& s);
+  // Append the written bytes to s, return appended size.
+  int AppendBytes(std::string& s);
   std::string GetString();
 };
 
@@ -14,8 +14,10 @@
 
 #include "record_encoder.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "proto/common.pb.h"
 #include "serial/keyvalue.h"  // IWYU pragma: keep
@@ -44,6 +46,19 @@ void RecordEncoder::Init(int schema_version, std::shared_ptr<std::vector<std::sh
   this->key_buf_size_ = size[0];
   this->value_buf_size_ = size[1];
   delete[] size;
+
+  key_columns_.clear();
+  value_columns_.clear();
+  for (const auto& bs : *schemas) {
+    if (bs) {
+      Column column{bs->GetType(), bs->GetIndex(), bs.get()};
+      if (bs->IsKey()) {
+        key_columns_.push_back(column);
+      } else {
+        value_columns_.push_back(column);
+      }
+    }
+  }
 }
 
 int RecordEncoder::Encode(const std::vector<std::any>& record, std::string& key, std::string& value) {
@@ -70,133 +85,135 @@ int RecordEncoder::Encode(const std::vector<std::any>& record, pb::common::KeyVa
   return 0;
 }
 
-int RecordEncoder::EncodeKey(const std::vector<std::any>& record, std::string& output) {
-  Buf* key_buf = new Buf(key_buf_size_, this->le_);
-  key_buf->EnsureRemainder(12);
-  key_buf->WriteLong(common_id_);
-  key_buf->ReverseWriteInt(codec_version_);
-  for (const auto& bs : *schemas_) {
-    if (bs) {
-      BaseSchema::Type type = bs->GetType();
-      switch (type) {
-        case BaseSchema::kBool: {
-          auto bos = std::dynamic_pointer_cast<DingoSchema<std::optional<bool>>>(bs);
-          if (bos->IsKey()) {
-            bos->EncodeKey(key_buf, std::any_cast<std::optional<bool>>(record.at(bos->GetIndex())));
-          }
-          break;
-        }
-        case BaseSchema::kInteger: {
-          auto is = std::dynamic_pointer_cast<DingoSchema<std::optional<int32_t>>>(bs);
-          if (is->IsKey()) {
-            is->EncodeKey(key_buf, std::any_cast<std::optional<int32_t>>(record.at(is->GetIndex())));
-          }
-          break;
-        }
-        case BaseSchema::kFloat: {
-          auto fs = std::dynamic_pointer_cast<DingoSchema<std::optional<float>>>(bs);
-          if (fs->IsKey()) {
-            fs->EncodeKey(key_buf, std::any_cast<std::optional<float>>(record.at(fs->GetIndex())));
-          }
-          break;
-        }
-        case BaseSchema::kLong: {
-          auto ls = std::dynamic_pointer_cast<DingoSchema<std::optional<int64_t>>>(bs);
-          if (ls->IsKey()) {
-            ls->EncodeKey(key_buf, std::any_cast<std::optional<int64_t>>(record.at(ls->GetIndex())));
-          }
-          break;
-        }
-        case BaseSchema::kDouble: {
-          auto ds = std::dynamic_pointer_cast<DingoSchema<std::optional<double>>>(bs);
-          if (ds->IsKey()) {
-            ds->EncodeKey(key_buf, std::any_cast<std::optional<double>>(record.at(ds->GetIndex())));
-          }
-          break;
-        }
-        case BaseSchema::kString: {
-          auto ss = std::dynamic_pointer_cast<DingoSchema<std::optional<std::shared_ptr<std::string>>>>(bs);
-          if (ss->IsKey()) {
-            ss->EncodeKey(key_buf,
-                          std::any_cast<std::optional<std::shared_ptr<std::string>>>(record.at(ss->GetIndex())));
-          }
-          break;
-        }
-        default: {
-          break;
-        }
-      }
+template <typename T>
+static void EncodeColumn(BaseSchema* schema, bool is_key, Buf* buf, const std::any& value) {
+  auto* typed_schema = static_cast<DingoSchema<std::optional<T>>*>(schema);
+  if (is_key) {
+    typed_schema->EncodeKey(buf, std::any_cast<std::optional<T>>(value));
+  } else {
+    typed_schema->EncodeValue(buf, std::any_cast<std::optional<T>>(value));
+  }
+}
+
+static void EncodeColumn(BaseSchema::Type type, BaseSchema* schema, bool is_key, Buf* buf, const std::any& value) {
+  switch (type) {
+    case BaseSchema::kBool: {
+      EncodeColumn<bool>(schema, is_key, buf, value);
+      break;
+    }
+    case BaseSchema::kInteger: {
+      EncodeColumn<int32_t>(schema, is_key, buf, value);
+      break;
+    }
+    case BaseSchema::kFloat: {
+      EncodeColumn<float>(schema, is_key, buf, value);
+      break;
+    }
+    case BaseSchema::kLong: {
+      EncodeColumn<int64_t>(schema, is_key, buf, value);
+      break;
+    }
+    case BaseSchema::kDouble: {
+      EncodeColumn<double>(schema, is_key, buf, value);
+      break;
+    }
+    case BaseSchema::kString: {
+      EncodeColumn<std::shared_ptr<std::string>>(schema, is_key, buf, value);
+      break;
     }
+    default: {
+      break;
+    }
+  }
+}
+
+template <typename GetColumn>
+void RecordEncoder::EncodeKeyColumns(Buf* buf, GetColumn get_column) {
+  buf->EnsureRemainder(12);
+  buf->WriteLong(common_id_);
+  buf->ReverseWriteInt(codec_version_);
+  for (const auto& column : key_columns_) {
+    EncodeColumn(column.type, column.schema, true, buf, get_column(column.index));
   }
+}
+
+template <typename GetColumn>
+void RecordEncoder::EncodeValueColumns(Buf* buf, GetColumn get_column) {
+  buf->EnsureRemainder(4);
+  buf->WriteInt(schema_version_);
+  for (const auto& column : value_columns_) {
+    EncodeColumn(column.type, column.schema, false, buf, get_column(column.index));
+  }
+}
 
-  key_buf->GetBytes(output);
-  delete key_buf;
+int RecordEncoder::EncodeKey(const std::vector<std::any>& record, std::string& output) {
+  Buf key_buf(key_buf_size_, this->le_);
+  EncodeKeyColumns(&key_buf, [&record](int index) -> const std::any& { return record.at(index); });
+
+  key_buf.GetBytes(output);
   return 0;
 }
 
 int RecordEncoder::EncodeValue(const std::vector<std::any>& record, std::string& output) {
-  Buf* value_buf = new Buf(value_buf_size_, this->le_);
-  value_buf->EnsureRemainder(4);
-  value_buf->WriteInt(schema_version_);
+  Buf value_buf(value_buf_size_, this->le_);
+  EncodeValueColumns(&value_buf, [&record](int index) -> const std::any& { return record.at(index); });
 
-  for (const auto& bs : *schemas_) {
-    if (bs) {
-      BaseSchema::Type type = bs->GetType();
-      switch (type) {
-        case BaseSchema::kBool: {
-          auto bos = std::dynamic_pointer_cast<DingoSchema<std::optional<bool>>>(bs);
-          if (!bos->IsKey()) {
-            bos->EncodeValue(value_buf, std::any_cast<std::optional<bool>>(record.at(bos->GetIndex())));
-          }
-          break;
-        }
-        case BaseSchema::kInteger: {
-          auto is = std::dynamic_pointer_cast<DingoSchema<std::optional<int32_t>>>(bs);
-          if (!is->IsKey()) {
-            is->EncodeValue(value_buf, std::any_cast<std::optional<int32_t>>(record.at(is->GetIndex())));
-          }
-          break;
-        }
-        case BaseSchema::kFloat: {
-          auto fs = std::dynamic_pointer_cast<DingoSchema<std::optional<float>>>(bs);
-          if (!fs->IsKey()) {
-            fs->EncodeValue(value_buf, std::any_cast<std::optional<float>>(record.at(fs->GetIndex())));
-          }
-          break;
-        }
-        case BaseSchema::kLong: {
-          auto ls = std::dynamic_pointer_cast<DingoSchema<std::optional<int64_t>>>(bs);
-          if (!ls->IsKey()) {
-            ls->EncodeValue(value_buf, std::any_cast<std::optional<int64_t>>(record.at(ls->GetIndex())));
-          }
-          break;
-        }
-        case BaseSchema::kDouble: {
-          auto ds = std::dynamic_pointer_cast<DingoSchema<std::optional<double>>>(bs);
-          if (!ds->IsKey()) {
-            ds->EncodeValue(value_buf, std::any_cast<std::optional<double>>(record.at(ds->GetIndex())));
-          }
-          break;
-        }
-        case BaseSchema::kString: {
-          auto ss = std::dynamic_pointer_cast<DingoSchema<std::optional<std::shared_ptr<std::string>>>>(bs);
-          if (!ss->IsKey()) {
-            ss->EncodeValue(value_buf,
-                            std::any_cast<std::optional<std::shared_ptr<std::string>>>(record.at(ss->GetIndex())));
-          }
-          break;
-        }
-        default: {
-          break;
-        }
-      }
+  return value_buf.GetBytes(output);
+}
+
+template <typename GetColumn>
+int RecordEncoder::InternalEncodeBatch(size_t count, GetColumn get_column, RecordBatch& output) {
+  output.Clear();
+  output.arena.reserve(count * (key_buf_size_ + value_buf_size_));
+  output.offsets.reserve(count * 2 + 1);
+  output.offsets.push_back(0);
+
+  // The buffers grow to the biggest record and are reused.
+  Buf key_buf(key_buf_size_, this->le_);
+  Buf value_buf(value_buf_size_, this->le_);
+  for (size_t i = 0; i < count; ++i) {
+    auto get_record_column = [&get_column, i](int index) -> const std::any& { return get_column(i, index); };
+
+    key_buf.Reset();
+    EncodeKeyColumns(&key_buf, get_record_column);
+    if (key_buf.AppendBytes(output.arena) < 0) {
+      return -1;
+    }
+    output.offsets.push_back(output.arena.size());
+
+    value_buf.Reset();
+    EncodeValueColumns(&value_buf, get_record_column);
+    if (value_buf.AppendBytes(output.arena) < 0) {
+      return -1;
+    }
+    output.offsets.push_back(output.arena.size());
+
+    if (output.arena.size() > UINT32_MAX) {
+      // "Record batch too large"
+      return -1;
     }
   }
 
-  int ret = value_buf->GetBytes(output);
-  delete value_buf;
+  return 0;
+}
 
-  return ret;
+int RecordEncoder::EncodeBatch(const std::vector<std::vector<std::any>>& records, RecordBatch& output) {
+  return InternalEncodeBatch(
+      records.size(), [&records](size_t row, int index) -> const std::any& { return records[row].at(index); },
+      output);
+}
+
+int RecordEncoder::EncodeColumnarBatch(const std::vector<std::vector<std::any>>& columns, RecordBatch& output) {
+  size_t count = columns.empty() ? 0 : columns[0].size();
+  for (const auto& column : columns) {
+    if (column.size() != count) {
+      // "Column row count not equal"
+      return -1;
+    }
+  }
+
+  return InternalEncodeBatch(
+      count, [&columns](size_t row, int index) -> const std::any& { return columns.at(index)[row]; }, output);
 }
 
 int RecordEncoder::EncodeKeyPrefix(const std::vector<std::any>& record, int column_count, std::string& output) {
@@ -15,7 +15,11 @@
 #ifndef DINGO_SERIAL_RECORD_ENCODER_H_
 #define DINGO_SERIAL_RECORD_ENCODER_H_
 
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "any"
 #include "functional"               // IWYU pragma: keep
@@ -31,8 +35,44 @@
 
 namespace dingodb {
 
+// Encoded key values of a batch of records, all keys and values share one arena,
+// key of record i is arena[offsets[2i], offsets[2i+1]), value is arena[offsets[2i+1], offsets[2i+2]).
+struct RecordBatch {
+  std::string arena;
+  std::vector<uint32_t> offsets;
+
+  size_t Size() const { return offsets.empty() ? 0 : (offsets.size() - 1) / 2; }
+  std::string_view Key(size_t i) const {
+    return std::string_view(arena.data() + offsets[2 * i], offsets[2 * i + 1] - offsets[2 * i]);
+  }
+  std::string_view Value(size_t i) const {
+    return std::string_view(arena.data() + offsets[2 * i + 1], offsets[2 * i + 2] - offsets[2 * i + 1]);
+  }
+  void Clear() {
+    arena.clear();
+    offsets.clear();
+  }
+};
+
 class RecordEncoder {
  private:
+  // Column of schema resolved at init, avoid cast and key/value check per record.
+  struct Column {
+    BaseSchema::Type type;
+    int index;
+    BaseSchema* schema;
+  };
+
+  template <typename GetColumn>
+  void EncodeKeyColumns(Buf* buf, GetColumn get_column);
+  template <typename GetColumn>
+  void EncodeValueColumns(Buf* buf, GetColumn get_column);
+  template <typename GetColumn>
+  int InternalEncodeBatch(size_t count, GetColumn get_column, RecordBatch& output);
+
+  std::vector<Column> key_columns_;
+  std::vector<Column> value_columns_;
+
   int codec_version_ = 0;
   int schema_version_;
   std::shared_ptr<std::vector<std::shared_ptr<BaseSchema>>> schemas_;
@@ -53,6 +93,11 @@ class RecordEncoder {
 
   int EncodeKey(const std::vector<std::any>& record, std::string& output);
 
+  // Encode a batch of records into one arena, the buffers are reused between records.
+  int EncodeBatch(const std::vector<std::vector<std::any>>& records, RecordBatch& output);
+  // Columnar input, columns[i] is all values of column whose index is i, every column has the same row count.
+  int EncodeColumnarBatch(const std::vector<std::vector<std::any>>& columns, RecordBatch& output);
+
   int EncodeValue(const std::vector<std::any>& record, std::string& output);
 
   int EncodeKeyPrefix(const std::vector<std::any>& record, int column_count, std::string& output);
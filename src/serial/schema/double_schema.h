@@ -15,6 +15,7 @@
 #ifndef DINGO_SERIAL_DOUBLE_SCHEMA_H_
 #define DINGO_SERIAL_DOUBLE_SCHEMA_H_
 
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <optional>
@@ -30,6 +31,8 @@ class DingoSchema<std::optional<double>> : public BaseSchema {
   bool key_, allow_null_;
   bool le_ = true;
 
+  static constexpr uint64_t kSignMask = 0x8000000000000000;
+
   static int GetDataLength();
   static int GetWithNullTagLength();
   static void InternalEncodeNull(Buf* buf);
@@ -20,64 +20,19 @@ int DingoSchema<std::optional<int64_t>>::GetDataLength() { return 8; }
 
 int DingoSchema<std::optional<int64_t>>::GetWithNullTagLength() { return 9; }
 
-void DingoSchema<std::optional<int64_t>>::InternalEncodeNull(Buf* buf) {
-  buf->Write(0);
-  buf->Write(0);
-  buf->Write(0);
-  buf->Write(0);
-  buf->Write(0);
-  buf->Write(0);
-  buf->Write(0);
-  buf->Write(0);
-}
+void DingoSchema<std::optional<int64_t>>::InternalEncodeNull(Buf* buf) { buf->WriteLE64(0); }
 
 void DingoSchema<std::optional<int64_t>>::LeInternalEncodeKey(Buf* buf, int64_t data) {
-  uint64_t* l = (uint64_t*)&data;
-  buf->Write(*l >> 56 ^ 0x80);
-  buf->Write(*l >> 48);
-  buf->Write(*l >> 40);
-  buf->Write(*l >> 32);
-  buf->Write(*l >> 24);
-  buf->Write(*l >> 16);
-  buf->Write(*l >> 8);
-  buf->Write(*l);
+  buf->WriteBE64(static_cast<uint64_t>(data) ^ kSignMask);
 }
 
 void DingoSchema<std::optional<int64_t>>::BeInternalEncodeKey(Buf* buf, int64_t data) {
-  uint64_t* l = (uint64_t*)&data;
-  buf->Write(*l ^ 0x80);
-  buf->Write(*l >> 8);
-  buf->Write(*l >> 16);
-  buf->Write(*l >> 24);
-  buf->Write(*l >> 32);
-  buf->Write(*l >> 40);
-  buf->Write(*l >> 48);
-  buf->Write(*l >> 56);
+  buf->WriteLE64(static_cast<uint64_t>(data) ^ 0x80);
 }
 
-void DingoSchema<std::optional<int64_t>>::LeInternalEncodeValue(Buf* buf, int64_t data) {
-  uint64_t* l = (uint64_t*)&data;
-  buf->Write(*l >> 56);
-  buf->Write(*l >> 48);
-  buf->Write(*l >> 40);
-  buf->Write(*l >> 32);
-  buf->Write(*l >> 24);
-  buf->Write(*l >> 16);
-  buf->Write(*l >> 8);
-  buf->Write(*l);
-}
+void DingoSchema<std::optional<int64_t>>::LeInternalEncodeValue(Buf* buf, int64_t data) { buf->WriteBE64(data); }
 
-void DingoSchema<std::optional<int64_t>>::BeInternalEncodeValue(Buf* buf, int64_t data) {
-  uint64_t* l = (uint64_t*)&data;
-  buf->Write(*l);
-  buf->Write(*l >> 8);
-  buf->Write(*l >> 16);
-  buf->Write(*l >> 24);
-  buf->Write(*l >> 32);
-  buf->Write(*l >> 40);
-  buf->Write(*l >> 48);
-  buf->Write(*l >> 56);
-}
+void DingoSchema<std::optional<int64_t>>::BeInternalEncodeValue(Buf* buf, int64_t data) { buf->WriteLE64(data); }
 
 BaseSchema::Type DingoSchema<std::optional<int64_t>>::GetType() { return kLong; }
 
@@ -141,18 +96,10 @@ std::optional<int64_t> DingoSchema<std::optional<int64_t>>::DecodeKey(Buf* buf)
       return std::nullopt;
     }
   }
-  uint64_t l = buf->Read() & 0xFF ^ 0x80;
   if (this->le_) {
-    for (int i = 0; i < 7; i++) {
-      l <<= 8;
-      l |= buf->Read() & 0xFF;
-    }
-  } else {
-    for (int i = 1; i < 8; i++) {
-      l |= (((uint64_t)buf->Read() & 0xFF) << (8 * i));
-    }
+    return buf->ReadBE64() ^ kSignMask;
   }
-  return l;
+  return buf->ReadLE64() ^ 0x80;
 }
 
 void DingoSchema<std::optional<int64_t>>::SkipKey(Buf* buf) { buf->Skip(GetLength()); }
@@ -192,18 +139,10 @@ std::optional<int64_t> DingoSchema<std::optional<int64_t>>::DecodeValue(Buf* buf
       return std::nullopt;
     }
   }
-  uint64_t l = buf->Read() & 0xFF;
   if (this->le_) {
-    for (int i = 0; i < 7; i++) {
-      l <<= 8;
-      l |= buf->Read() & 0xFF;
-    }
-  } else {
-    for (int i = 1; i < 8; i++) {
-      l |= (((uint64_t)buf->Read() & 0xFF) << (8 * i));
-    }
+    return buf->ReadBE64();
   }
-  return l;
+  return buf->ReadLE64();
 }
 
 void DingoSchema<std::optional<int64_t>>::SkipValue(Buf* buf) { buf->Skip(GetLength()); }
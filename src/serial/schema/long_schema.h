@@ -15,6 +15,7 @@
 #ifndef DINGO_SERIAL_LONG_SCHEMA_H_
 #define DINGO_SERIAL_LONG_SCHEMA_H_
 
+#include <cstdint>
 #include <iostream>
 #include <optional>
 #include "dingo_schema.h"
@@ -29,6 +30,8 @@ class DingoSchema<std::optional<int64_t>> : public BaseSchema {
   bool key_, allow_null_;
   bool le_=true;
 
+  static constexpr uint64_t kSignMask = 0x8000000000000000;
+
   static int GetDataLength();
   static int GetWithNullTagLength();
   static void InternalEncodeNull(Buf* buf);
@@ -14,6 +14,9 @@
 
 #include "string_schema.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
 
@@ -23,35 +26,28 @@ int DingoSchema<std::optional<std::shared_ptr<std::string>>>::GetDataLength() {
 
 int DingoSchema<std::optional<std::shared_ptr<std::string>>>::GetWithNullTagLength() { return 0; }
 
+// Memcomparable format, every 8 bytes group followed by marker 0xFF, the last group padded with zero,
+// and its marker is 0xFF - padding count. The output size is known, so fill it group by group at once.
 int DingoSchema<std::optional<std::shared_ptr<std::string>>>::InternalEncodeKey(Buf* buf,
                                                                                 std::shared_ptr<std::string> data) {
   int group_num = data->length() / 8;
   int size = (group_num + 1) * 9;
   int remainder_size = data->length() % 8;
-  int remainder_zero;
-  if (remainder_size == 0) {
-    remainder_size = 8;
-    remainder_zero = 8;
-  } else {
-    remainder_zero = 8 - remainder_size;
-  }
+  int remainder_zero = 8 - remainder_size;
   buf->EnsureRemainder(size + 4);
-  int curr = 0;
+
+  const char* src = data->data();
+  char* dst = buf->ForwardWrite(size);
   for (int i = 0; i < group_num; i++) {
-    for (int j = 0; j < 8; j++) {
-      buf->Write(data->at(curr++));
-    }
-    buf->Write((uint8_t)255);
-  }
-  if (remainder_size < 8) {
-    for (int j = 0; j < remainder_size; j++) {
-      buf->Write(data->at(curr++));
-    }
-  }
-  for (int i = 0; i < remainder_zero; i++) {
-    buf->Write((uint8_t)0);
+    memcpy(dst, src, 8);
+    dst[8] = static_cast<char>(kGroupMarker);
+    src += 8;
+    dst += 9;
   }
-  buf->Write((uint8_t)(255 - remainder_zero));
+  memcpy(dst, src, remainder_size);
+  memset(dst + remainder_size, 0, remainder_zero);
+  dst[8] = static_cast<char>(kGroupMarker - remainder_zero);
+
   return size;
 }
 
@@ -140,31 +136,17 @@ std::optional<std::shared_ptr<std::string>> DingoSchema<std::optional<std::share
   }
   int length = buf->ReverseReadInt();
   int group_num = length / 9;
-  buf->Skip(length - 1);
-  int remainder_zero = 255 - buf->Read() & 0xFF;
-  buf->Skip(0 - length);
+  const char* src = buf->ForwardRead(length);
+  int remainder_zero = kGroupMarker - static_cast<uint8_t>(src[length - 1]);
   int ori_length = group_num * 8 - remainder_zero;
   auto data = std::make_shared<std::string>(ori_length, 0);
 
-  if (ori_length != 0) {
-    int curr = 0;
-    group_num--;
-    for (int i = 0; i < group_num; i++) {
-      for (int j = 0; j < 8; j++) {
-        (*data)[curr++] = buf->Read();
-      }
-      buf->Skip(1);
-    }
-    if (remainder_zero != 8) {
-      int non_zero_count = 8 - remainder_zero;
-      for (int j = 0; j < non_zero_count; j++) {
-        (*data)[curr++] = buf->Read();
-      }
-    }
+  char* dst = data->data();
+  for (int copied = 0; copied < ori_length; copied += 8) {
+    memcpy(dst + copied, src, std::min(8, ori_length - copied));
+    src += 9;
   }
 
-  buf->Skip(remainder_zero + 1);
-
   return std::optional<std::shared_ptr<std::string>>(data);
 }
 
@@ -204,10 +186,7 @@ std::optional<std::shared_ptr<std::string>> DingoSchema<std::optional<std::share
   }
   int length = buf->ReadInt();
   auto su8 = std::make_shared<std::string>(length, 0);
-
-  for (int i = 0; i < length; i++) {
-    (*su8)[i] = buf->Read();
-  }
+  buf->Read(su8->data(), length);
 
   return std::optional<std::shared_ptr<std::string>>{su8};
 }
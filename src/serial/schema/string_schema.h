@@ -15,6 +15,7 @@
 #ifndef DINGO_SERIAL_STRING_SCHEMA_H_
 #define DINGO_SERIAL_STRING_SCHEMA_H_
 
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -31,6 +32,8 @@ class DingoSchema<std::optional<std::shared_ptr<std::string>>> : public BaseSche
   int index_;
   bool key_, allow_null_;
 
+  static constexpr uint8_t kGroupMarker = 0xFF;
+
   static int GetDataLength();
   static int GetWithNullTagLength();
   static int InternalEncodeKey(Buf* buf, std::shared_ptr<std::string> data);
@@ -631,6 +631,28 @@ void CoordinatorServiceImpl::DeleteStoreMetrics(google::protobuf::RpcController
   this->coordinator_control_->DeleteStoreMetrics(request->store_id());
 }
 
+void CoordinatorServiceImpl::GetHotRegions(google::protobuf::RpcController * /*controller*/,
+                                           const pb::coordinator::GetHotRegionsRequest *request,
+                                           pb::coordinator::GetHotRegionsResponse *response,
+                                           google::protobuf::Closure *done) {
+  brpc::ClosureGuard done_guard(done);
+  auto is_leader = this->coordinator_control_->IsLeader();
+  DINGO_LOG(DEBUG) << "Receive Get HotRegions Request, IsLeader:" << is_leader
+                   << ", Request:" << request->DebugString();
+
+  if (!is_leader) {
+    return RedirectResponse(response);
+  }
+
+  uint32_t top_n = request->top_n() > 0 ? request->top_n() : 10;
+  std::vector<pb::coordinator::HotRegion> hot_regions;
+  this->coordinator_control_->GetHotRegions(request->order(), top_n, hot_regions);
+
+  for (auto &hot_region : hot_regions) {
+    response->add_hot_regions()->Swap(&hot_region);
+  }
+}
+
 void CoordinatorServiceImpl::GetExecutorMap(google::protobuf::RpcController * /*controller*/,
                                             const pb::coordinator::GetExecutorMapRequest *request,
                                             pb::coordinator::GetExecutorMapResponse *response,
@@ -142,6 +142,8 @@ class CoordinatorServiceImpl : public pb::coordinator::CoordinatorService {
                           const pb::coordinator::DeleteStoreMetricsRequest* request,
                           pb::coordinator::DeleteStoreMetricsResponse* response,
                           google::protobuf::Closure* done) override;
+  void GetHotRegions(google::protobuf::RpcController* controller, const pb::coordinator::GetHotRegionsRequest* request,
+                     pb::coordinator::GetHotRegionsResponse* response, google::protobuf::Closure* done) override;
 
   void CreateStore(google::protobuf::RpcController* controller, const pb::coordinator::CreateStoreRequest* request,
                    pb::coordinator::CreateStoreResponse* response, google::protobuf::Closure* done) override;
@@ -671,6 +671,30 @@ void MetaServiceImpl::GenerateAutoIncrement(google::protobuf::RpcController *con
   DINGO_LOG(INFO) << request->ShortDebugString();
 
   uint64_t table_id = request->table_id().entity_id();
+
+  // Serve from leader cached segment, avoid raft write for each request.
+  if (auto_increment_control_->CanGenerateFromSegment(request->count(), request->auto_increment_increment())) {
+    uint64_t start_id = 0;
+    uint64_t end_id = 0;
+    auto ret = auto_increment_control_->GenerateAutoIncrementFromSegment(
+        table_id, request->count(), request->auto_increment_increment(), request->auto_increment_offset(), start_id,
+        end_id);
+    if (!ret.ok()) {
+      DINGO_LOG(ERROR) << "generate auto increment from segment failed, " << ret << " | " << request->DebugString();
+      response->mutable_error()->set_errcode(static_cast<pb::error::Errno>(ret.error_code()));
+      response->mutable_error()->set_errmsg(ret.error_str());
+
+      if (ret.error_code() == pb::error::Errno::ERAFT_NOTLEADER) {
+        RedirectAutoIncrementResponse(response);
+      }
+      return;
+    }
+
+    response->set_start_id(start_id);
+    response->set_end_id(end_id);
+    return;
+  }
+
   pb::coordinator_internal::MetaIncrement meta_increment;
   auto ret =
       auto_increment_control_->GenerateAutoIncrement(table_id, request->count(), request->auto_increment_increment(),
@@ -24,11 +24,14 @@
 #include "brpc/controller.h"
 #include "butil/endpoint.h"
 #include "common/failpoint.h"
+#include "common/helper.h"
 #include "common/logging.h"
 #include "coordinator/coordinator_closure.h"
+#include "fmt/core.h"
 #include "proto/common.pb.h"
 #include "proto/coordinator_internal.pb.h"
 #include "proto/node.pb.h"
+#include "store/bulk_load_manager.h"
 
 namespace dingodb {
 using pb::error::Errno;
@@ -334,4 +337,26 @@ void NodeServiceImpl::DeleteFailPoints(google::protobuf::RpcController*,
   }
 }
 
+void NodeServiceImpl::PrepareBulkLoad(google::protobuf::RpcController* /*controller*/,
+                                      const pb::node::PrepareBulkLoadRequest* request,
+                                      pb::node::PrepareBulkLoadResponse* response, google::protobuf::Closure* done) {
+  brpc::ClosureGuard done_guard(done);
+
+  auto store_meta_manager = server_->GetStoreMetaManager();
+  auto region = store_meta_manager != nullptr
+                    ? store_meta_manager->GetStoreRegionMeta()->GetRegion(request->region_id())
+                    : nullptr;
+  if (region == nullptr) {
+    auto* error = response->mutable_error();
+    error->set_errcode(Errno::EREGION_NOT_FOUND);
+    error->set_errmsg(fmt::format("Not found region {}", request->region_id()));
+    return;
+  }
+
+  auto status = BulkLoadManager::GetInstance()->Prepare(region->Id(), request->ingest_sst());
+  if (!status.ok()) {
+    Helper::SetPbMessageError(status, response);
+  }
+}
+
 }  // namespace dingodb
@@ -44,6 +44,8 @@ class NodeServiceImpl : public pb::node::NodeService {
                      pb::node::GetFailPointResponse* response, google::protobuf::Closure* done) override;
   void DeleteFailPoints(google::protobuf::RpcController* controller, const pb::node::DeleteFailPointRequest* request,
                         pb::node::DeleteFailPointResponse* response, google::protobuf::Closure* done) override;
+  void PrepareBulkLoad(google::protobuf::RpcController* controller, const pb::node::PrepareBulkLoadRequest* request,
+                       pb::node::PrepareBulkLoadResponse* response, google::protobuf::Closure* done) override;
 
   void SetServer(dingodb::Server* server);
 
@@ -30,6 +30,7 @@
 #include "config/config.h"
 #include "config/config_manager.h"
 #include "coordinator/coordinator_control.h"
+#include "engine/compaction_scheduler.h"
 #include "engine/engine.h"
 #include "engine/mem_engine.h"
 #include "engine/raft_store_engine.h"
@@ -41,7 +42,9 @@
 #include "proto/common.pb.h"
 #include "proto/error.pb.h"
 #include "proto/node.pb.h"
+#include "raft/raft_snapshot_scheduler.h"
 #include "scan/scan_manager.h"
+#include "store/bulk_load_manager.h"
 #include "store/heartbeat.h"
 
 DEFINE_string(coor_url, "",
@@ -50,6 +53,10 @@ DEFINE_string(coor_url, "",
 
 namespace dingodb {
 
+DECLARE_int32(raft_snapshot_schedule_interval_ms);
+DECLARE_int32(bulk_load_clean_interval_ms);
+DECLARE_int32(range_compaction_interval_ms);
+
 void Server::SetRole(pb::common::ClusterRole role) { role_ = role; }
 
 Server* Server::GetInstance() { return Singleton<Server>::get(); }
@@ -126,6 +133,14 @@ bool Server::InitDirectory() {
     }
   }
 
+  bulk_load_path_ = fmt::format("{}/bulk_load", db_path.parent_path().string());
+  if (!std::filesystem::exists(bulk_load_path_)) {
+    if (!std::filesystem::create_directories(bulk_load_path_)) {
+      DINGO_LOG(ERROR) << "Create bulk load directory failed: " << bulk_load_path_;
+      return false;
+    }
+  }
+
   return true;
 }
 
@@ -166,6 +181,7 @@ bool Server::InitEngine() {
     coordinator_control_->SetKvEngine(engine_);
 
     auto_increment_control_ = std::make_shared<AutoIncrementControl>();
+    auto_increment_control_->SetKvEngine(engine_);
     if (!auto_increment_control_->Recover()) {
       DINGO_LOG(ERROR) << "auto_increment_control_->Recover Failed";
       return false;
@@ -235,8 +251,10 @@ bool Server::InitCoordinatorInteractionForAutoIncrement() {
 }
 
 bool Server::InitStorage() {
+  auto config = ConfigManager::GetInstance()->GetConfig(role_);
+
   storage_ = std::make_shared<Storage>(engine_);
-  return true;
+  return storage_->Init(config);
 }
 
 bool Server::InitStoreMetaManager() {
@@ -306,6 +324,33 @@ bool Server::InitCrontabManager() {
       crontab_manager_->AddAndRunCrontab(scan_crontab);
     }
 
+    // Add bulk load clean crontab
+    std::shared_ptr<Crontab> bulk_load_crontab = std::make_shared<Crontab>();
+    bulk_load_crontab->name = "BULK_LOAD_CLEAN";
+    bulk_load_crontab->interval = FLAGS_bulk_load_clean_interval_ms;
+    bulk_load_crontab->func = BulkLoadManager::CleanExpired;
+    bulk_load_crontab->arg = nullptr;
+
+    crontab_manager_->AddAndRunCrontab(bulk_load_crontab);
+
+    // Add range compaction crontab
+    std::shared_ptr<Crontab> compaction_crontab = std::make_shared<Crontab>();
+    compaction_crontab->name = "RANGE_COMPACTION";
+    compaction_crontab->interval = FLAGS_range_compaction_interval_ms;
+    compaction_crontab->func = CompactionScheduler::TriggerCompaction;
+    compaction_crontab->arg = nullptr;
+
+    crontab_manager_->AddAndRunCrontab(compaction_crontab);
+
+    // Add raft snapshot schedule crontab, only region raft nodes, coordinator keep braft snapshot timer.
+    std::shared_ptr<Crontab> snapshot_crontab = std::make_shared<Crontab>();
+    snapshot_crontab->name = "RAFT_SNAPSHOT";
+    snapshot_crontab->interval = FLAGS_raft_snapshot_schedule_interval_ms;
+    snapshot_crontab->func = RaftSnapshotScheduler::TriggerSchedule;
+    snapshot_crontab->arg = nullptr;
+
+    crontab_manager_->AddAndRunCrontab(snapshot_crontab);
+
   } else if (role_ == pb::common::ClusterRole::COORDINATOR) {
     // Add push crontab
     std::shared_ptr<Crontab> push_crontab = std::make_shared<Crontab>();
@@ -397,6 +442,43 @@ bool Server::InitCrontabManager() {
       crontab_manager_->AddAndRunCrontab(metrics_crontab);
     }
 
+    // Add vector index save crontab
+    int vector_index_save_interval =
+        config->GetInt(Constant::kVectorIndexSave + "." + Constant::kVectorIndexSaveIntervalMs);
+    int vector_index_save_log_gap = config->GetInt(Constant::kVectorIndexSave + "." + Constant::kVectorIndexSaveLogGap);
+    if (vector_index_save_interval < 0 || vector_index_save_log_gap < 0) {
+      DINGO_LOG(ERROR) << "config vector.index_save illegal";
+      return false;
+    } else if (vector_index_save_interval > 0) {
+      std::shared_ptr<Crontab> vector_index_save_crontab = std::make_shared<Crontab>();
+      vector_index_save_crontab->name = "VECTOR_INDEX_SAVE";
+      vector_index_save_crontab->interval = vector_index_save_interval;
+      vector_index_save_crontab->func = [vector_index_save_log_gap](void*) {
+        Server::GetInstance()->GetVectorIndexManager()->ScrubVectorIndex(vector_index_save_log_gap);
+      };
+      vector_index_save_crontab->arg = nullptr;
+
+      crontab_manager_->AddAndRunCrontab(vector_index_save_crontab);
+    }
+
+    // Add range compaction crontab
+    std::shared_ptr<Crontab> compaction_crontab = std::make_shared<Crontab>();
+    compaction_crontab->name = "RANGE_COMPACTION";
+    compaction_crontab->interval = FLAGS_range_compaction_interval_ms;
+    compaction_crontab->func = CompactionScheduler::TriggerCompaction;
+    compaction_crontab->arg = nullptr;
+
+    crontab_manager_->AddAndRunCrontab(compaction_crontab);
+
+    // Add raft snapshot schedule crontab
+    std::shared_ptr<Crontab> snapshot_crontab = std::make_shared<Crontab>();
+    snapshot_crontab->name = "RAFT_SNAPSHOT";
+    snapshot_crontab->interval = FLAGS_raft_snapshot_schedule_interval_ms;
+    snapshot_crontab->func = RaftSnapshotScheduler::TriggerSchedule;
+    snapshot_crontab->arg = nullptr;
+
+    crontab_manager_->AddAndRunCrontab(snapshot_crontab);
+
     // // Add scan crontab
     // ScanManager::GetInstance()->Init(config);
     // uint64_t scan_interval = config->GetInt(Constant::kStoreScan + "." + Constant::kStoreScanScanIntervalMs);
@@ -443,7 +525,9 @@ bool Server::InitVectorIndexManager() {
   vector_index_manager_ = std::make_shared<VectorIndexManager>(raw_engine_, std::make_shared<MetaReader>(raw_engine_),
                                                                std::make_shared<MetaWriter>(raw_engine_));
 
-  return vector_index_manager_->Init(store_meta_manager_->GetStoreRegionMeta()->GetAllAliveRegion());
+  auto regions = store_meta_manager_->GetStoreRegionMeta()->GetAllAliveRegion();
+  SortRegionByRecoverPriority(regions);
+  return vector_index_manager_->Init(regions);
 }
 
 bool Server::Recover() {
@@ -474,6 +558,35 @@ bool Server::Recover() {
   return true;
 }
 
+void Server::SortRegionByRecoverPriority(std::vector<store::RegionPtr>& regions) {
+  struct RegionPriority {
+    store::RegionPtr region;
+    bool is_leader;
+    uint64_t region_size;
+  };
+
+  auto store_region_metrics =
+      store_metrics_manager_ != nullptr ? store_metrics_manager_->GetStoreRegionMetrics() : nullptr;
+  std::vector<RegionPriority> priorities;
+  priorities.reserve(regions.size());
+  for (auto& region : regions) {
+    auto region_metrics = store_region_metrics != nullptr ? store_region_metrics->GetMetrics(region->Id()) : nullptr;
+    priorities.push_back({region, region->LeaderId() == id_,
+                          region_metrics != nullptr ? region_metrics->RegionSize() : 0});
+  }
+
+  std::stable_sort(priorities.begin(), priorities.end(), [](const RegionPriority& a, const RegionPriority& b) {
+    if (a.is_leader != b.is_leader) {
+      return a.is_leader;
+    }
+    return a.region_size > b.region_size;
+  });
+
+  for (size_t i = 0; i < priorities.size(); ++i) {
+    regions[i] = priorities[i].region;
+  }
+}
+
 bool Server::InitHeartbeat() { return heartbeat_->Init(); }
 
 void Server::Destroy() {
@@ -481,6 +594,9 @@ void Server::Destroy() {
   heartbeat_->Destroy();
   region_controller_->Destroy();
   store_controller_->Destroy();
+  if (vector_index_manager_ != nullptr) {
+    vector_index_manager_->Destroy();
+  }
 
   google::ShutdownGoogleLogging();
 }
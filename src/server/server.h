@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "brpc/channel.h"
 #include "common/meta_control.h"
@@ -107,6 +108,10 @@ class Server {
   // Recover server state, include store/region/raft.
   bool Recover();
 
+  // Order regions for bootstrap, regions led by this node before restart first, then larger regions,
+  // so leadership and hot data are served as soon as possible.
+  void SortRegionByRecoverPriority(std::vector<store::RegionPtr>& regions);
+
   void Destroy();
 
   uint64_t Id() const { return id_; }
@@ -145,6 +150,8 @@ class Server {
 
   std::string GetIndexPath() { return index_path_; }
 
+  std::string GetBulkLoadPath() { return bulk_load_path_; }
+
   std::shared_ptr<VectorIndexManager> GetVectorIndexManager() { return vector_index_manager_; }
 
   Server(const Server&) = delete;
@@ -213,6 +220,9 @@ class Server {
   // index directory
   std::string index_path_;
 
+  // bulk load staging directory
+  std::string bulk_load_path_;
+
   // vector index manager
   std::shared_ptr<VectorIndexManager> vector_index_manager_;
 };
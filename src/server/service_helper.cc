@@ -140,4 +140,18 @@ butil::Status ServiceHelper::ValidateIndexRegion(uint64_t region_id) {
   return butil::Status();
 }
 
+void ServiceHelper::RecordHotStats(uint64_t region_id, bool is_write, const std::vector<std::string_view>& keys,
+                                   int64_t bytes) {
+  auto metrics_manager = Server::GetInstance()->GetStoreMetricsManager();
+  if (metrics_manager == nullptr) {
+    return;
+  }
+  auto region_metrics = metrics_manager->GetStoreRegionMetrics()->GetMetrics(region_id);
+  if (region_metrics == nullptr) {
+    return;
+  }
+
+  region_metrics->HotStats()->Record(is_write, keys, bytes);
+}
+
 }  // namespace dingodb
\ No newline at end of file
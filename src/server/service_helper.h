@@ -41,6 +41,10 @@ class ServiceHelper {
   static butil::Status ValidateRangeInRange(const pb::common::Range& region_range, const pb::common::Range& req_range);
   static butil::Status ValidateRegion(uint64_t region_id, const std::vector<std::string_view>& keys);
   static butil::Status ValidateIndexRegion(uint64_t region_id);
+
+  // Record request into region hot stats, caller check RegionHotStats::Sample() first.
+  static void RecordHotStats(uint64_t region_id, bool is_write, const std::vector<std::string_view>& keys,
+                             int64_t bytes);
 };
 
 template <typename T>
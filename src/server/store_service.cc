@@ -28,6 +28,7 @@
 #include "common/synchronization.h"
 #include "fmt/core.h"
 #include "meta/store_meta_manager.h"
+#include "metrics/region_hot_stats.h"
 #include "proto/common.pb.h"
 #include "proto/coordinator.pb.h"
 #include "proto/error.pb.h"
@@ -39,6 +40,20 @@ using dingodb::pb::error::Errno;
 
 namespace dingodb {
 
+static std::vector<std::string_view> GetKeys(const google::protobuf::RepeatedPtrField<pb::common::KeyValue>& kvs) {
+  std::vector<std::string_view> keys;
+  keys.reserve(kvs.size());
+  for (const auto& kv : kvs) {
+    keys.push_back(kv.key());
+  }
+  return keys;
+}
+
+template <typename Container>
+static std::vector<std::string_view> GetKeys(const Container& keys) {
+  return std::vector<std::string_view>(keys.begin(), keys.end());
+}
+
 StoreServiceImpl::StoreServiceImpl() = default;
 
 void StoreServiceImpl::AddRegion(google::protobuf::RpcController* controller,
@@ -209,6 +224,9 @@ void StoreServiceImpl::KvGet(google::protobuf::RpcController* controller,
   if (!kvs.empty()) {
     response->set_value(kvs[0].value());
   }
+  if (RegionHotStats::Sample()) {
+    ServiceHelper::RecordHotStats(request->region_id(), false, {keys[0]}, response->ByteSizeLong());
+  }
 
   DINGO_LOG(DEBUG) << fmt::format("KvGet request: {} response: {}", request->ShortDebugString(),
                                   response->ShortDebugString());
@@ -257,7 +275,8 @@ void StoreServiceImpl::KvBatchGet(google::protobuf::RpcController* controller,
 
   std::vector<pb::common::KeyValue> kvs;
   auto* mut_request = const_cast<dingodb::pb::store::KvBatchGetRequest*>(request);
-  status = storage_->KvGet(ctx, Helper::PbRepeatedToVector(mut_request->mutable_keys()), kvs);
+  auto keys = Helper::PbRepeatedToVector(mut_request->mutable_keys());
+  status = storage_->KvGet(ctx, keys, kvs);
   if (!status.ok()) {
     auto* err = response->mutable_error();
     err->set_errcode(static_cast<Errno>(status.error_code()));
@@ -272,6 +291,9 @@ void StoreServiceImpl::KvBatchGet(google::protobuf::RpcController* controller,
   }
 
   Helper::VectorToPbRepeated(kvs, response->mutable_kvs());
+  if (RegionHotStats::Sample()) {
+    ServiceHelper::RecordHotStats(request->region_id(), false, GetKeys(keys), response->ByteSizeLong());
+  }
 
   DINGO_LOG(DEBUG) << fmt::format("KvBatchGet request: {} response: {}", request->ShortDebugString(),
                                   response->ShortDebugString());
@@ -294,6 +316,7 @@ butil::Status ValidateKvPutRequest(const dingodb::pb::store::KvPutRequest* reque
 void StoreServiceImpl::KvPut(google::protobuf::RpcController* controller,
                              const dingodb::pb::store::KvPutRequest* request,
                              dingodb::pb::store::KvPutResponse* response, google::protobuf::Closure* done) {
+  int64_t receive_time_us = butil::gettimeofday_us();
   brpc::Controller* cntl = (brpc::Controller*)controller;
   brpc::ClosureGuard done_guard(done);
 
@@ -309,6 +332,11 @@ void StoreServiceImpl::KvPut(google::protobuf::RpcController* controller,
 
   std::shared_ptr<Context> ctx = std::make_shared<Context>(cntl, done_guard.release(), request, response);
   ctx->SetRegionId(request->region_id()).SetCfName(Constant::kStoreDataCF);
+  ctx->RecordStage(WriteStage::kReceive, receive_time_us);
+  ctx->RecordStage(WriteStage::kValidate);
+  if (RegionHotStats::Sample()) {
+    ServiceHelper::RecordHotStats(request->region_id(), true, {request->kv().key()}, request->ByteSizeLong());
+  }
 
   auto* mut_request = const_cast<dingodb::pb::store::KvPutRequest*>(request);
   std::vector<pb::common::KeyValue> kvs;
@@ -347,6 +375,7 @@ butil::Status ValidateKvBatchPutRequest(const dingodb::pb::store::KvBatchPutRequ
 void StoreServiceImpl::KvBatchPut(google::protobuf::RpcController* controller,
                                   const pb::store::KvBatchPutRequest* request, pb::store::KvBatchPutResponse* response,
                                   google::protobuf::Closure* done) {
+  int64_t receive_time_us = butil::gettimeofday_us();
   brpc::Controller* cntl = (brpc::Controller*)controller;
   brpc::ClosureGuard done_guard(done);
 
@@ -367,6 +396,11 @@ void StoreServiceImpl::KvBatchPut(google::protobuf::RpcController* controller,
 
   std::shared_ptr<Context> ctx = std::make_shared<Context>(cntl, done_guard.release(), request, response);
   ctx->SetRegionId(request->region_id()).SetCfName(Constant::kStoreDataCF);
+  ctx->RecordStage(WriteStage::kReceive, receive_time_us);
+  ctx->RecordStage(WriteStage::kValidate);
+  if (RegionHotStats::Sample()) {
+    ServiceHelper::RecordHotStats(request->region_id(), true, GetKeys(request->kvs()), request->ByteSizeLong());
+  }
   auto* mut_request = const_cast<dingodb::pb::store::KvBatchPutRequest*>(request);
   status = storage_->KvPut(ctx, Helper::PbRepeatedToVector(mut_request->mutable_kvs()));
   if (!status.ok()) {
@@ -400,6 +434,7 @@ butil::Status ValidateKvPutIfAbsentRequest(const dingodb::pb::store::KvPutIfAbse
 void StoreServiceImpl::KvPutIfAbsent(google::protobuf::RpcController* controller,
                                      const pb::store::KvPutIfAbsentRequest* request,
                                      pb::store::KvPutIfAbsentResponse* response, google::protobuf::Closure* done) {
+  int64_t receive_time_us = butil::gettimeofday_us();
   brpc::Controller* cntl = (brpc::Controller*)controller;
   brpc::ClosureGuard done_guard(done);
   DINGO_LOG(DEBUG) << "KvPutIfAbsent request: " << request->ShortDebugString();
@@ -416,6 +451,11 @@ void StoreServiceImpl::KvPutIfAbsent(google::protobuf::RpcController* controller
 
   std::shared_ptr<Context> ctx = std::make_shared<Context>(cntl, done_guard.release(), request, response);
   ctx->SetRegionId(request->region_id()).SetCfName(Constant::kStoreDataCF);
+  ctx->RecordStage(WriteStage::kReceive, receive_time_us);
+  ctx->RecordStage(WriteStage::kValidate);
+  if (RegionHotStats::Sample()) {
+    ServiceHelper::RecordHotStats(request->region_id(), true, {request->kv().key()}, request->ByteSizeLong());
+  }
   auto* mut_request = const_cast<dingodb::pb::store::KvPutIfAbsentRequest*>(request);
   std::vector<pb::common::KeyValue> kvs;
   kvs.emplace_back(std::move(*mut_request->release_kv()));
@@ -456,6 +496,7 @@ void StoreServiceImpl::KvBatchPutIfAbsent(google::protobuf::RpcController* contr
                                           const pb::store::KvBatchPutIfAbsentRequest* request,
                                           pb::store::KvBatchPutIfAbsentResponse* response,
                                           google::protobuf::Closure* done) {
+  int64_t receive_time_us = butil::gettimeofday_us();
   brpc::Controller* cntl = (brpc::Controller*)controller;
   brpc::ClosureGuard done_guard(done);
 
@@ -476,6 +517,11 @@ void StoreServiceImpl::KvBatchPutIfAbsent(google::protobuf::RpcController* contr
 
   std::shared_ptr<Context> const ctx = std::make_shared<Context>(cntl, done_guard.release(), request, response);
   ctx->SetRegionId(request->region_id()).SetCfName(Constant::kStoreDataCF);
+  ctx->RecordStage(WriteStage::kReceive, receive_time_us);
+  ctx->RecordStage(WriteStage::kValidate);
+  if (RegionHotStats::Sample()) {
+    ServiceHelper::RecordHotStats(request->region_id(), true, GetKeys(request->kvs()), request->ByteSizeLong());
+  }
 
   auto* mut_request = const_cast<dingodb::pb::store::KvBatchPutIfAbsentRequest*>(request);
   status = storage_->KvPutIfAbsent(ctx, Helper::PbRepeatedToVector(mut_request->mutable_kvs()), request->is_atomic());
@@ -514,6 +560,7 @@ butil::Status ValidateKvBatchDeleteRequest(const dingodb::pb::store::KvBatchDele
 void StoreServiceImpl::KvBatchDelete(google::protobuf::RpcController* controller,
                                      const pb::store::KvBatchDeleteRequest* request,
                                      pb::store::KvBatchDeleteResponse* response, google::protobuf::Closure* done) {
+  int64_t receive_time_us = butil::gettimeofday_us();
   brpc::Controller* cntl = (brpc::Controller*)controller;
   brpc::ClosureGuard done_guard(done);
 
@@ -534,6 +581,11 @@ void StoreServiceImpl::KvBatchDelete(google::protobuf::RpcController* controller
 
   std::shared_ptr<Context> const ctx = std::make_shared<Context>(cntl, done_guard.release(), request, response);
   ctx->SetRegionId(request->region_id()).SetCfName(Constant::kStoreDataCF);
+  ctx->RecordStage(WriteStage::kReceive, receive_time_us);
+  ctx->RecordStage(WriteStage::kValidate);
+  if (RegionHotStats::Sample()) {
+    ServiceHelper::RecordHotStats(request->region_id(), true, GetKeys(request->keys()), request->ByteSizeLong());
+  }
   auto* mut_request = const_cast<dingodb::pb::store::KvBatchDeleteRequest*>(request);
   status = storage_->KvDelete(ctx, Helper::PbRepeatedToVector(mut_request->mutable_keys()));
   if (!status.ok()) {
@@ -576,6 +628,7 @@ butil::Status ValidateKvDeleteRangeRequest(store::RegionPtr region, const pb::co
 void StoreServiceImpl::KvDeleteRange(google::protobuf::RpcController* controller,
                                      const pb::store::KvDeleteRangeRequest* request,
                                      pb::store::KvDeleteRangeResponse* response, google::protobuf::Closure* done) {
+  int64_t receive_time_us = butil::gettimeofday_us();
   brpc::Controller* cntl = (brpc::Controller*)controller;
   brpc::ClosureGuard done_guard(done);
 
@@ -602,6 +655,11 @@ void StoreServiceImpl::KvDeleteRange(google::protobuf::RpcController* controller
 
   std::shared_ptr<Context> const ctx = std::make_shared<Context>(cntl, done_guard.release(), request, response);
   ctx->SetRegionId(request->region_id()).SetCfName(Constant::kStoreDataCF);
+  ctx->RecordStage(WriteStage::kReceive, receive_time_us);
+  ctx->RecordStage(WriteStage::kValidate);
+  if (RegionHotStats::Sample()) {
+    ServiceHelper::RecordHotStats(request->region_id(), true, {}, request->ByteSizeLong());
+  }
   auto* mut_request = const_cast<dingodb::pb::store::KvDeleteRangeRequest*>(request);
   status = storage_->KvDeleteRange(ctx, correction_range);
   if (!status.ok()) {
@@ -635,6 +693,7 @@ butil::Status ValidateKvCompareAndSetRequest(const dingodb::pb::store::KvCompare
 void StoreServiceImpl::KvCompareAndSet(google::protobuf::RpcController* controller,
                                        const pb::store::KvCompareAndSetRequest* request,
                                        pb::store::KvCompareAndSetResponse* response, google::protobuf::Closure* done) {
+  int64_t receive_time_us = butil::gettimeofday_us();
   brpc::Controller* cntl = (brpc::Controller*)controller;
   brpc::ClosureGuard done_guard(done);
 
@@ -652,6 +711,11 @@ void StoreServiceImpl::KvCompareAndSet(google::protobuf::RpcController* controll
 
   std::shared_ptr<Context> ctx = std::make_shared<Context>(cntl, done_guard.release(), request, response);
   ctx->SetRegionId(request->region_id()).SetCfName(Constant::kStoreDataCF);
+  ctx->RecordStage(WriteStage::kReceive, receive_time_us);
+  ctx->RecordStage(WriteStage::kValidate);
+  if (RegionHotStats::Sample()) {
+    ServiceHelper::RecordHotStats(request->region_id(), true, {request->kv().key()}, request->ByteSizeLong());
+  }
   // auto* mut_request = const_cast<dingodb::pb::store::KvCompareAndSetRequest*>(request);
 
   status = storage_->KvCompareAndSet(ctx, {request->kv()}, {request->expect_value()}, true);
@@ -696,6 +760,7 @@ void StoreServiceImpl::KvBatchCompareAndSet(google::protobuf::RpcController* con
                                             const pb::store::KvBatchCompareAndSetRequest* request,
                                             pb::store::KvBatchCompareAndSetResponse* response,
                                             google::protobuf::Closure* done) {
+  int64_t receive_time_us = butil::gettimeofday_us();
   brpc::Controller* cntl = (brpc::Controller*)controller;
   brpc::ClosureGuard done_guard(done);
 
@@ -717,6 +782,11 @@ void StoreServiceImpl::KvBatchCompareAndSet(google::protobuf::RpcController* con
 
   std::shared_ptr<Context> ctx = std::make_shared<Context>(cntl, done_guard.release(), response);
   ctx->SetRegionId(request->region_id()).SetCfName(Constant::kStoreDataCF);
+  ctx->RecordStage(WriteStage::kReceive, receive_time_us);
+  ctx->RecordStage(WriteStage::kValidate);
+  if (RegionHotStats::Sample()) {
+    ServiceHelper::RecordHotStats(request->region_id(), true, GetKeys(request->kvs()), request->ByteSizeLong());
+  }
   auto* mut_request = const_cast<dingodb::pb::store::KvBatchCompareAndSetRequest*>(request);
 
   status = storage_->KvCompareAndSet(ctx, Helper::PbRepeatedToVector(mut_request->kvs()),
@@ -930,6 +1000,87 @@ void StoreServiceImpl::KvScanRelease(google::protobuf::RpcController* controller
                                   response->ShortDebugString());
 }
 
+void StoreServiceImpl::KvBulkLoadUpload(google::protobuf::RpcController* controller,
+                                        const ::dingodb::pb::store::KvBulkLoadUploadRequest* request,
+                                        ::dingodb::pb::store::KvBulkLoadUploadResponse* response,
+                                        ::google::protobuf::Closure* done) {
+  brpc::Controller* cntl = (brpc::Controller*)controller;
+  brpc::ClosureGuard done_guard(done);
+
+  auto region = Server::GetInstance()->GetStoreMetaManager()->GetStoreRegionMeta()->GetRegion(request->region_id());
+  butil::Status status = ServiceHelper::ValidateRegionState(region);
+  if (!status.ok()) {
+    auto* err = response->mutable_error();
+    err->set_errcode(static_cast<Errno>(status.error_code()));
+    err->set_errmsg(status.error_str());
+    DINGO_LOG(ERROR) << fmt::format("KvBulkLoadUpload region: {} response: {}", request->region_id(),
+                                    response->ShortDebugString());
+    return;
+  }
+
+  std::shared_ptr<Context> const ctx = std::make_shared<Context>(cntl, done);
+  ctx->SetRegionId(request->region_id()).SetCfName(Constant::kStoreDataCF);
+
+  uint64_t file_size = 0;
+  status = storage_->KvBulkLoadUpload(ctx, request->load_id(), request->file_name(), request->offset(),
+                                      request->data(), file_size);
+  response->set_file_size(file_size);
+  if (!status.ok()) {
+    auto* err = response->mutable_error();
+    err->set_errcode(static_cast<Errno>(status.error_code()));
+    err->set_errmsg(status.error_str());
+    if (status.error_code() == pb::error::ERAFT_NOTLEADER) {
+      err->set_errmsg("Not leader, please redirect leader.");
+      ServiceHelper::RedirectLeader(status.error_str(), response);
+    }
+    // Not log data of request.
+    DINGO_LOG(ERROR) << fmt::format("KvBulkLoadUpload region: {} load_id: {} file: {} offset: {} response: {}",
+                                    request->region_id(), request->load_id(), request->file_name(),
+                                    request->offset(), response->ShortDebugString());
+  }
+}
+
+void StoreServiceImpl::KvBulkLoadIngest(google::protobuf::RpcController* controller,
+                                        const ::dingodb::pb::store::KvBulkLoadIngestRequest* request,
+                                        ::dingodb::pb::store::KvBulkLoadIngestResponse* response,
+                                        ::google::protobuf::Closure* done) {
+  brpc::Controller* cntl = (brpc::Controller*)controller;
+  brpc::ClosureGuard done_guard(done);
+
+  DINGO_LOG(INFO) << "KvBulkLoadIngest request: " << request->ShortDebugString();
+
+  auto region = Server::GetInstance()->GetStoreMetaManager()->GetStoreRegionMeta()->GetRegion(request->region_id());
+  butil::Status status = ServiceHelper::ValidateRegionState(region);
+  if (status.ok() && region->State() == pb::common::StoreRegionState::SPLITTING) {
+    status = butil::Status(pb::error::EREGION_SPLITING, "Region is spliting, please try later");
+  }
+  if (!status.ok()) {
+    auto* err = response->mutable_error();
+    err->set_errcode(static_cast<Errno>(status.error_code()));
+    err->set_errmsg(status.error_str());
+    DINGO_LOG(ERROR) << fmt::format("KvBulkLoadIngest request: {} response: {}", request->ShortDebugString(),
+                                    response->ShortDebugString());
+    return;
+  }
+
+  std::shared_ptr<Context> const ctx = std::make_shared<Context>(cntl, done_guard.release(), request, response);
+  ctx->SetRegionId(request->region_id()).SetCfName(Constant::kStoreDataCF);
+  status = storage_->KvBulkLoadIngest(ctx, region, request->load_id(),
+                                      Helper::PbRepeatedToVector(request->file_names()));
+  if (!status.ok()) {
+    auto* err = response->mutable_error();
+    err->set_errcode(static_cast<Errno>(status.error_code()));
+    err->set_errmsg(status.error_str());
+    if (status.error_code() == pb::error::ERAFT_NOTLEADER) {
+      err->set_errmsg("Not leader, please redirect leader.");
+      ServiceHelper::RedirectLeader(status.error_str(), response);
+    }
+    brpc::ClosureGuard const done_guard(done);
+    DINGO_LOG(ERROR) << fmt::format("KvBulkLoadIngest request: {} response: {}", request->ShortDebugString(),
+                                    response->ShortDebugString());
+  }
+}
+
 void StoreServiceImpl::Debug(google::protobuf::RpcController* controller,
                              const ::dingodb::pb::store::DebugRequest* request,
                              ::dingodb::pb::store::DebugResponse* response, ::google::protobuf::Closure* done) {
@@ -86,6 +86,15 @@ class StoreServiceImpl : public pb::store::StoreService {
                      const ::dingodb::pb::store::KvScanReleaseRequest* request,
                      ::dingodb::pb::store::KvScanReleaseResponse* response, ::google::protobuf::Closure* done) override;
 
+  void KvBulkLoadUpload(google::protobuf::RpcController* controller,
+                        const ::dingodb::pb::store::KvBulkLoadUploadRequest* request,
+                        ::dingodb::pb::store::KvBulkLoadUploadResponse* response,
+                        ::google::protobuf::Closure* done) override;
+  void KvBulkLoadIngest(google::protobuf::RpcController* controller,
+                        const ::dingodb::pb::store::KvBulkLoadIngestRequest* request,
+                        ::dingodb::pb::store::KvBulkLoadIngestResponse* response,
+                        ::google::protobuf::Closure* done) override;
+
   void Debug(google::protobuf::RpcController* controller, const ::dingodb::pb::store::DebugRequest* request,
              ::dingodb::pb::store::DebugResponse* response, ::google::protobuf::Closure* done) override;
 
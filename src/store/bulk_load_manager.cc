@@ -0,0 +1,484 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "store/bulk_load_manager.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "braft/file_service.h"
+#include "braft/file_system_adaptor.h"
+#include "braft/raft.h"
+#include "braft/remote_file_copier.h"
+#include "brpc/callback.h"
+#include "brpc/channel.h"
+#include "brpc/controller.h"
+#include "bthread/bthread.h"
+#include "butil/endpoint.h"
+#include "butil/memory/singleton.h"
+#include "bvar/reducer.h"
+#include "common/context.h"
+#include "common/helper.h"
+#include "common/logging.h"
+#include "engine/raw_rocks_engine.h"
+#include "fmt/core.h"
+#include "gflags/gflags.h"
+#include "proto/error.pb.h"
+#include "proto/node.pb.h"
+#include "rocksdb/sst_file_reader.h"
+#include "rocksdb/table_properties.h"
+#include "server/server.h"
+
+namespace dingodb {
+
+DEFINE_int64(bulk_load_staging_keep_s, 3600,
+             "Keep staging sst files on leader for followers to copy, expired staging files are removed");
+DEFINE_int32(bulk_load_copy_retry_times, 3, "Retry times of follower copy sst files from leader");
+DEFINE_int64(bulk_load_prepare_timeout_ms, 1800000, "Timeout of waiting followers copy sst files from leader");
+DEFINE_int32(bulk_load_clean_interval_ms, 60000, "Interval of cleaning expired bulk load staging files");
+DEFINE_int32(bulk_load_snapshot_retry_times, 10, "Retry times of snapshot after ingest, staging files are kept if failed");
+
+static bvar::Adder<int64_t> g_bulk_load_ingest_count("dingo_bulk_load_ingest_count");
+static bvar::Adder<int64_t> g_bulk_load_ingest_fail_count("dingo_bulk_load_ingest_fail_count");
+static bvar::Adder<int64_t> g_bulk_load_ingest_kv_count("dingo_bulk_load_ingest_kv_count");
+
+static const char* kIngestFileSuffix = ".ingest";
+// Mark staging directory uploaded on this node, not a valid upload file name.
+static const char* kSourceMarkFile = ".source";
+
+BulkLoadManager* BulkLoadManager::GetInstance() { return Singleton<BulkLoadManager>::get(); }
+
+std::string BulkLoadManager::StagingPath(uint64_t region_id, uint64_t load_id) {
+  return fmt::format("{}/{}_{}", Server::GetInstance()->GetBulkLoadPath(), region_id, load_id);
+}
+
+bool BulkLoadManager::IsValidFileName(const std::string& file_name) {
+  std::string suffix(kIngestFileSuffix);
+  bool is_ingest_file = file_name.size() >= suffix.size() &&
+                        file_name.compare(file_name.size() - suffix.size(), suffix.size(), suffix) == 0;
+  return !file_name.empty() && file_name.find('/') == std::string::npos && file_name[0] != '.' && !is_ingest_file;
+}
+
+butil::Status BulkLoadManager::Upload(uint64_t region_id, uint64_t load_id, const std::string& file_name,
+                                      uint64_t offset, const std::string& data, uint64_t& file_size) {
+  if (!IsValidFileName(file_name)) {
+    return butil::Status(pb::error::EILLEGAL_PARAMTETERS, fmt::format("File name {} is illegal", file_name));
+  }
+
+  std::string path = StagingPath(region_id, load_id);
+  std::string filepath = fmt::format("{}/{}", path, file_name);
+
+  BAIDU_SCOPED_LOCK(mutex_);
+  std::error_code ec;
+  if (!std::filesystem::exists(path) && !std::filesystem::create_directories(path, ec)) {
+    return butil::Status(pb::error::EINTERNAL, fmt::format("Create directory {} failed, {}", path, ec.message()));
+  }
+
+  file_size = std::filesystem::exists(filepath) ? std::filesystem::file_size(filepath) : 0;
+  // Chunks must be sent in order, client resume from the returned file size.
+  if (offset != file_size) {
+    return butil::Status(pb::error::EILLEGAL_PARAMTETERS,
+                         fmt::format("File {} offset {} mismatch uploaded size {}", file_name, offset, file_size));
+  }
+
+  std::ofstream file(filepath, std::ios::binary | std::ios::app);
+  if (!file.is_open() || !file.write(data.data(), data.size()) || !file.flush()) {
+    return butil::Status(pb::error::EINTERNAL, fmt::format("Write file {} failed", filepath));
+  }
+  file_size += data.size();
+
+  return butil::Status();
+}
+
+// Read key range and kv count of sst file.
+static butil::Status ReadSstFileInfo(const std::string& filepath, pb::raft::IngestSstFile& file_info) {
+  rocksdb::Options options;
+  rocksdb::SstFileReader reader(options);
+  auto status = reader.Open(filepath);
+  if (!status.ok()) {
+    return butil::Status(pb::error::EILLEGAL_PARAMTETERS,
+                         fmt::format("Open sst file {} failed, {}", filepath, status.ToString()));
+  }
+  status = reader.VerifyChecksum();
+  if (!status.ok()) {
+    return butil::Status(pb::error::EILLEGAL_PARAMTETERS,
+                         fmt::format("Sst file {} checksum mismatch, {}", filepath, status.ToString()));
+  }
+
+  rocksdb::ReadOptions read_options;
+  read_options.fill_cache = false;
+  std::unique_ptr<rocksdb::Iterator> iter(reader.NewIterator(read_options));
+  iter->SeekToFirst();
+  if (!iter->Valid()) {
+    return butil::Status(pb::error::ENO_ENTRIES, fmt::format("Sst file {} is empty", filepath));
+  }
+  file_info.set_start_key(iter->key().ToString());
+  iter->SeekToLast();
+  file_info.set_end_key(iter->key().ToString());
+
+  file_info.set_kv_count(reader.GetTableProperties()->num_entries);
+  file_info.set_size(std::filesystem::file_size(filepath));
+
+  return butil::Status();
+}
+
+butil::Status BulkLoadManager::ValidateFileRange(store::RegionPtr region, const pb::raft::IngestSstRequest& request) {
+  const auto& range = region->Range();
+  for (const auto& file : request.files()) {
+    if (file.start_key() < range.start_key() || file.end_key() >= range.end_key()) {
+      return butil::Status(pb::error::EKEY_OUT_OF_RANGE,
+                           fmt::format("Sst file {} range [{}, {}] out of region {} range [{}, {})", file.name(),
+                                       Helper::StringToHex(file.start_key()), Helper::StringToHex(file.end_key()),
+                                       region->Id(), Helper::StringToHex(range.start_key()),
+                                       Helper::StringToHex(range.end_key())));
+    }
+  }
+
+  return butil::Status();
+}
+
+butil::Status BulkLoadManager::AddSource(const std::string& path, std::string& uri) {
+  BAIDU_SCOPED_LOCK(mutex_);
+  auto it = sources_.find(path);
+  if (it == sources_.end()) {
+    std::ofstream mark_file(fmt::format("{}/{}", path, kSourceMarkFile));
+    if (!mark_file.is_open()) {
+      return butil::Status(pb::error::EINTERNAL, fmt::format("Create source mark file in {} failed", path));
+    }
+
+    Source source;
+    source.reader = new braft::LocalDirReader(braft::default_file_system(), path);
+    if (braft::file_service_add(source.reader.get(), &source.reader_id) != 0) {
+      return butil::Status(pb::error::EINTERNAL, fmt::format("Add {} to file service failed", path));
+    }
+    source.create_time_s = Helper::Timestamp();
+    it = sources_.emplace(path, source).first;
+  }
+
+  uri = fmt::format("remote://{}/{}", butil::endpoint2str(Server::GetInstance()->RaftEndpoint()).c_str(),
+                    it->second.reader_id);
+  return butil::Status();
+}
+
+bool BulkLoadManager::IsSource(const std::string& path) {
+  return std::filesystem::exists(fmt::format("{}/{}", path, kSourceMarkFile));
+}
+
+butil::Status BulkLoadManager::PrepareIngest(store::RegionPtr region, const std::string& cf_name, uint64_t load_id,
+                                             const std::vector<std::string>& file_names,
+                                             pb::raft::IngestSstRequest& request) {
+  if (file_names.empty()) {
+    return butil::Status(pb::error::EILLEGAL_PARAMTETERS, "Missing sst files");
+  }
+
+  std::string path = StagingPath(region->Id(), load_id);
+  request.set_cf_name(cf_name);
+  request.set_load_id(load_id);
+  for (const auto& file_name : file_names) {
+    std::string filepath = fmt::format("{}/{}", path, file_name);
+    if (!IsValidFileName(file_name) || !std::filesystem::exists(filepath)) {
+      return butil::Status(pb::error::EILLEGAL_PARAMTETERS, fmt::format("Not found uploaded file {}", file_name));
+    }
+
+    auto* file_info = request.add_files();
+    file_info->set_name(file_name);
+    auto status = ReadSstFileInfo(filepath, *file_info);
+    if (!status.ok()) {
+      return status;
+    }
+  }
+
+  auto status = ValidateFileRange(region, request);
+  if (!status.ok()) {
+    return status;
+  }
+
+  return AddSource(path, *request.mutable_source_uri());
+}
+
+butil::Status BulkLoadManager::CopyFiles(const pb::raft::IngestSstRequest& request, const std::string& path) {
+  std::error_code ec;
+  if (!std::filesystem::exists(path) && !std::filesystem::create_directories(path, ec)) {
+    return butil::Status(pb::error::EINTERNAL, fmt::format("Create directory {} failed, {}", path, ec.message()));
+  }
+
+  braft::RemoteFileCopier copier;
+  if (copier.init(request.source_uri(), braft::default_file_system(), nullptr) != 0) {
+    return butil::Status(pb::error::EINTERNAL, fmt::format("Init file copier {} failed", request.source_uri()));
+  }
+
+  for (const auto& file : request.files()) {
+    std::string filepath = fmt::format("{}/{}", path, file.name());
+    if (std::filesystem::exists(filepath) && std::filesystem::file_size(filepath) == file.size()) {
+      continue;
+    }
+
+    int ret = -1;
+    for (int i = 0; i <= FLAGS_bulk_load_copy_retry_times && ret != 0; ++i) {
+      ret = copier.copy_to_file(file.name(), filepath, nullptr);
+      if (ret != 0) {
+        DINGO_LOG(WARNING) << fmt::format("[bulk_load] copy file {} from {} failed, retry {}", file.name(),
+                                          request.source_uri(), i);
+        bthread_usleep(1000 * 1000L);
+      }
+    }
+    if (ret != 0) {
+      return butil::Status(pb::error::EINTERNAL,
+                           fmt::format("Copy file {} from {} failed", file.name(), request.source_uri()));
+    }
+    if (std::filesystem::file_size(filepath) != file.size()) {
+      return butil::Status(pb::error::EINTERNAL, fmt::format("Copied file {} size mismatch", file.name()));
+    }
+  }
+
+  return butil::Status();
+}
+
+butil::Status BulkLoadManager::Prepare(uint64_t region_id, const pb::raft::IngestSstRequest& request) {
+  std::string path = StagingPath(region_id, request.load_id());
+  if (IsSource(path)) {
+    return butil::Status();
+  }
+
+  auto status = CopyFiles(request, path);
+  if (!status.ok()) {
+    DINGO_LOG(ERROR) << fmt::format("[bulk_load][region({})] prepare files failed, load_id: {}, error: {}", region_id,
+                                    request.load_id(), status.error_str());
+    return status;
+  }
+
+  DINGO_LOG(INFO) << fmt::format("[bulk_load][region({})] prepared {} files, load_id: {}", region_id,
+                                 request.files_size(), request.load_id());
+  return butil::Status();
+}
+
+butil::Status BulkLoadManager::PrepareFollowers(store::RegionPtr region, const pb::raft::IngestSstRequest& request) {
+  struct PrepareCall {
+    std::string addr;
+    brpc::Channel channel;
+    brpc::Controller cntl;
+    pb::node::PrepareBulkLoadResponse response;
+  };
+
+  std::vector<std::unique_ptr<PrepareCall>> calls;
+  for (const auto& peer : region->Peers()) {
+    butil::EndPoint endpoint;
+    butil::str2endpoint(peer.raft_location().host().c_str(), peer.raft_location().port(), &endpoint);
+    if (endpoint == Server::GetInstance()->RaftEndpoint()) {
+      continue;
+    }
+
+    auto call = std::make_unique<PrepareCall>();
+    call->addr = butil::endpoint2str(endpoint).c_str();
+    if (call->channel.Init(endpoint, nullptr) != 0) {
+      return butil::Status(pb::error::EINTERNAL, fmt::format("Init channel to {} failed", call->addr));
+    }
+    calls.push_back(std::move(call));
+  }
+
+  pb::node::PrepareBulkLoadRequest prepare_request;
+  prepare_request.set_region_id(region->Id());
+  *prepare_request.mutable_ingest_sst() = request;
+
+  // Followers copy files concurrently.
+  for (auto& call : calls) {
+    call->cntl.set_timeout_ms(FLAGS_bulk_load_prepare_timeout_ms);
+    pb::node::NodeService_Stub stub(&call->channel);
+    stub.PrepareBulkLoad(&call->cntl, &prepare_request, &call->response, brpc::DoNothing());
+  }
+  for (auto& call : calls) {
+    brpc::Join(call->cntl.call_id());
+  }
+
+  for (auto& call : calls) {
+    if (call->cntl.Failed()) {
+      return butil::Status(pb::error::EINTERNAL,
+                           fmt::format("Prepare bulk load on {} failed, {}", call->addr, call->cntl.ErrorText()));
+    }
+    if (call->response.error().errcode() != pb::error::OK) {
+      return butil::Status(call->response.error().errcode(), fmt::format("Prepare bulk load on {} failed, {}",
+                                                                         call->addr, call->response.error().errmsg()));
+    }
+  }
+
+  return butil::Status();
+}
+
+butil::Status BulkLoadManager::Ingest(std::shared_ptr<RawEngine> engine, store::RegionPtr region,
+                                      const pb::raft::IngestSstRequest& request, uint64_t& kv_count) {
+  // Region range may changed by split after propose, check again at apply, every replica get the same result.
+  auto status = ValidateFileRange(region, request);
+  if (!status.ok()) {
+    return status;
+  }
+
+  // Files are copied before propose, never copy here, copy of big files block apply of the region.
+  std::string path = StagingPath(region->Id(), request.load_id());
+
+  // Ingest hard links, staging files are kept for replay until snapshot saved, see SnapshotAndRemoveStaging.
+  std::vector<std::string> ingest_files;
+  kv_count = 0;
+  for (const auto& file : request.files()) {
+    std::string filepath = fmt::format("{}/{}", path, file.name());
+    std::string ingest_filepath = filepath + kIngestFileSuffix;
+    std::error_code ec;
+    if (!std::filesystem::exists(filepath) || std::filesystem::file_size(filepath, ec) != file.size()) {
+      g_bulk_load_ingest_fail_count << 1;
+      return butil::Status(pb::error::EINTERNAL, fmt::format("File {} is not prepared", filepath));
+    }
+    std::filesystem::remove(ingest_filepath, ec);
+    std::filesystem::create_hard_link(filepath, ingest_filepath, ec);
+    if (ec) {
+      g_bulk_load_ingest_fail_count << 1;
+      return butil::Status(pb::error::EINTERNAL, fmt::format("Link file {} failed, {}", filepath, ec.message()));
+    }
+    ingest_files.push_back(ingest_filepath);
+    kv_count += file.kv_count();
+  }
+
+  auto raw_engine = std::dynamic_pointer_cast<RawRocksEngine>(engine);
+  status = raw_engine->IngestExternalFile(request.cf_name(), ingest_files, true);
+  if (!status.ok()) {
+    g_bulk_load_ingest_fail_count << 1;
+    return status;
+  }
+  g_bulk_load_ingest_count << 1;
+  g_bulk_load_ingest_kv_count << kv_count;
+
+  DINGO_LOG(INFO) << fmt::format("[bulk_load][region({})] ingest {} files {} kvs, load_id: {}", region->Id(),
+                                 request.files_size(), kv_count, request.load_id());
+  return butil::Status();
+}
+
+static void DoIngestSnapshot(uint64_t region_id, braft::Closure* done) {
+  auto ctx = std::make_shared<Context>();
+  ctx->SetDone(done);
+  auto status = Server::GetInstance()->GetEngine()->DoSnapshot(ctx, region_id);
+  if (!status.ok()) {
+    // Raft node is gone, staging files are removed when expired.
+    DINGO_LOG(WARNING) << fmt::format("[bulk_load][region({})] do snapshot failed, error: {}", region_id,
+                                      status.error_str());
+    delete done;
+  }
+}
+
+// Remove staging files of non-source replica after snapshot saved, retry if failed or another snapshot is running.
+class IngestSnapshotClosure : public braft::Closure {
+ public:
+  IngestSnapshotClosure(uint64_t region_id, uint64_t load_id, int retry_times)
+      : region_id_(region_id), load_id_(load_id), retry_times_(retry_times) {}
+  ~IngestSnapshotClosure() override = default;
+
+  void Run() override {
+    std::unique_ptr<IngestSnapshotClosure> self_guard(this);
+    if (status().ok()) {
+      BulkLoadManager::RemoveStaging(region_id_, load_id_);
+      return;
+    }
+
+    if (retry_times_ <= 0) {
+      DINGO_LOG(WARNING) << fmt::format(
+          "[bulk_load][region({})] snapshot after ingest failed, keep staging files until expired, load_id: {}, "
+          "error: {}",
+          region_id_, load_id_, status().error_str());
+      return;
+    }
+
+    // Not block the braft snapshot callback.
+    auto* args = new IngestSnapshotClosure(region_id_, load_id_, retry_times_ - 1);
+    bthread_t tid;
+    const bthread_attr_t attr = BTHREAD_ATTR_NORMAL;
+    bthread_start_background(
+        &tid, &attr,
+        [](void* arg) -> void* {
+          auto* done = static_cast<IngestSnapshotClosure*>(arg);
+          bthread_usleep(1000 * 1000L);
+          DoIngestSnapshot(done->region_id_, done);
+          return nullptr;
+        },
+        args);
+  }
+
+ private:
+  uint64_t region_id_;
+  uint64_t load_id_;
+  int retry_times_;
+};
+
+void BulkLoadManager::SnapshotAndRemoveStaging(uint64_t region_id, uint64_t load_id) {
+  DoIngestSnapshot(region_id, new IngestSnapshotClosure(region_id, load_id, FLAGS_bulk_load_snapshot_retry_times));
+}
+
+void BulkLoadManager::RemoveStaging(uint64_t region_id, uint64_t load_id) {
+  std::string path = StagingPath(region_id, load_id);
+  if (!IsSource(path)) {
+    Helper::RemoveFileOrDirectory(path);
+    DINGO_LOG(INFO) << fmt::format("[bulk_load][region({})] snapshot saved, remove staging directory {}", region_id,
+                                   path);
+  }
+}
+
+void BulkLoadManager::CleanExpiredStaging() {
+  BAIDU_SCOPED_LOCK(mutex_);
+  int64_t now_s = Helper::Timestamp();
+  for (auto it = sources_.begin(); it != sources_.end();) {
+    if (now_s - it->second.create_time_s < FLAGS_bulk_load_staging_keep_s) {
+      ++it;
+      continue;
+    }
+
+    braft::file_service_remove(it->second.reader_id);
+    Helper::RemoveFileOrDirectory(it->first);
+    DINGO_LOG(INFO) << fmt::format("[bulk_load] remove expired staging directory {}", it->first);
+    it = sources_.erase(it);
+  }
+
+  // Uploaded but never ingested, or left by previous process.
+  std::error_code ec;
+  for (const auto& entry : std::filesystem::directory_iterator(Server::GetInstance()->GetBulkLoadPath(), ec)) {
+    const auto path = entry.path().string();
+    if (sources_.find(path) != sources_.end()) {
+      continue;
+    }
+    auto last_write_time = std::filesystem::last_write_time(entry, ec);
+    if (ec) {
+      continue;
+    }
+    auto age = std::filesystem::file_time_type::clock::now() - last_write_time;
+    if (std::chrono::duration_cast<std::chrono::seconds>(age).count() >= FLAGS_bulk_load_staging_keep_s) {
+      Helper::RemoveFileOrDirectory(path);
+      DINGO_LOG(INFO) << fmt::format("[bulk_load] remove expired staging directory {}", path);
+    }
+  }
+}
+
+void BulkLoadManager::CleanExpired(void*) {
+  bthread_t tid;
+  const bthread_attr_t attr = BTHREAD_ATTR_NORMAL;
+  bthread_start_background(
+      &tid, &attr,
+      [](void*) -> void* {
+        BulkLoadManager::GetInstance()->CleanExpiredStaging();
+        return nullptr;
+      },
+      nullptr);
+}
+
+}  // namespace dingodb
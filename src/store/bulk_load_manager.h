@@ -0,0 +1,107 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_STORE_BULK_LOAD_MANAGER_H_
+#define DINGODB_STORE_BULK_LOAD_MANAGER_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "braft/file_reader.h"
+#include "bthread/mutex.h"
+#include "butil/status.h"
+#include "engine/raw_engine.h"
+#include "meta/store_meta_manager.h"
+#include "proto/raft.pb.h"
+
+template <typename T>
+struct DefaultSingletonTraits;
+
+namespace dingodb {
+
+// Bulk load externally built sst files into region.
+// Sst files are uploaded to the region leader's staging directory, followers copy them from the leader by
+// braft file service and acknowledge, then a raft log carry the file list, every replica ingest them into
+// rocksdb atomically, bypass memtable and WAL. Replica failed to ingest turn to error state instead of skip the log.
+// The leader keeps staging files for a while, and every replica do snapshot after ingest, other replicas keep
+// staging files until the snapshot covering the ingest log is saved, replay raft log after restart still find them.
+class BulkLoadManager {
+ public:
+  static BulkLoadManager* GetInstance();
+
+  BulkLoadManager(const BulkLoadManager&) = delete;
+  const BulkLoadManager& operator=(const BulkLoadManager&) = delete;
+
+  // Append data to staging file at offset, offset must equal to uploaded size of file.
+  butil::Status Upload(uint64_t region_id, uint64_t load_id, const std::string& file_name, uint64_t offset,
+                       const std::string& data, uint64_t& file_size);
+
+  // Validate uploaded files on leader and generate ingest raft request.
+  butil::Status PrepareIngest(store::RegionPtr region, const std::string& cf_name, uint64_t load_id,
+                              const std::vector<std::string>& file_names, pb::raft::IngestSstRequest& request);
+
+  // Leader ask all followers to copy files, return ok after all of them acknowledge.
+  butil::Status PrepareFollowers(store::RegionPtr region, const pb::raft::IngestSstRequest& request);
+
+  // Follower copy files from leader to local staging directory.
+  butil::Status Prepare(uint64_t region_id, const pb::raft::IngestSstRequest& request);
+
+  // Apply ingest raft request, files must be prepared.
+  butil::Status Ingest(std::shared_ptr<RawEngine> engine, store::RegionPtr region,
+                       const pb::raft::IngestSstRequest& request, uint64_t& kv_count);
+
+  // Snapshot region after ingest, remove staging files of non-source replica when the snapshot is saved.
+  static void SnapshotAndRemoveStaging(uint64_t region_id, uint64_t load_id);
+
+  static bool IsValidFileName(const std::string& file_name);
+  // All keys of files must be in region range.
+  static butil::Status ValidateFileRange(store::RegionPtr region, const pb::raft::IngestSstRequest& request);
+
+  // Crontab function, clean expired staging directory.
+  static void CleanExpired(void*);
+
+ private:
+  BulkLoadManager() = default;
+  ~BulkLoadManager() = default;
+
+  friend struct DefaultSingletonTraits<BulkLoadManager>;
+  friend class IngestSnapshotClosure;
+
+  struct Source {
+    int64_t reader_id;
+    scoped_refptr<braft::FileReader> reader;
+    int64_t create_time_s;
+  };
+
+  static std::string StagingPath(uint64_t region_id, uint64_t load_id);
+  static butil::Status CopyFiles(const pb::raft::IngestSstRequest& request, const std::string& path);
+
+  // Register staging directory to braft file service, return uri of it.
+  // A marker file is left in the directory, so ingest not remove it even after restart.
+  butil::Status AddSource(const std::string& path, std::string& uri);
+  static bool IsSource(const std::string& path);
+  static void RemoveStaging(uint64_t region_id, uint64_t load_id);
+  void CleanExpiredStaging();
+
+  bthread::Mutex mutex_;
+  // staging path -> file service reader
+  std::map<std::string, Source> sources_;
+};
+
+}  // namespace dingodb
+
+#endif  // DINGODB_STORE_BULK_LOAD_MANAGER_H_
@@ -84,6 +84,7 @@ void HeartbeatTask::SendStoreHeartbeat(std::shared_ptr<CoordinatorInteraction> c
     auto metrics = region_metrics->GetMetrics(region_meta->Id());
     if (metrics != nullptr) {
       tmp_region_metrics.CopyFrom(metrics->InnerRegionMetrics());
+      metrics->HotStats()->Collect(tmp_region_metrics.mutable_hot_stats());
     }
 
     tmp_region_metrics.set_id(region_meta->Id());
@@ -26,6 +26,7 @@
 #include "common/helper.h"
 #include "common/logging.h"
 #include "config/config_manager.h"
+#include "engine/compaction_scheduler.h"
 #include "event/store_state_machine_event.h"
 #include "fmt/core.h"
 #include "glog/logging.h"
@@ -179,8 +180,16 @@ butil::Status DeleteRegionTask::DeleteRegion(std::shared_ptr<Context> ctx, uint6
 
   // Delete data
   DINGO_LOG(DEBUG) << fmt::format("Delete region {} delete data", region_id);
-  auto writer = engine->GetRawEngine()->NewWriter(Constant::kStoreDataCF);
+  auto raw_engine = engine->GetRawEngine();
+  // Drop whole sst files first, only the boundary files left range tombstones.
+  status = raw_engine->DeleteFilesInRange(Constant::kStoreDataCF, region->Range());
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("Delete region {} delete files failed, {}", region_id, status.error_str());
+  }
+  auto writer = raw_engine->NewWriter(Constant::kStoreDataCF);
   writer->KvDeleteRange(region->Range());
+  CompactionScheduler::GetInstance()->Schedule(raw_engine, Constant::kStoreDataCF, region->Range(),
+                                               fmt::format("drop region {}", region_id));
 
   // Raft kv engine
   if (engine->GetID() == pb::common::ENG_RAFT_STORE) {
@@ -202,6 +211,9 @@ butil::Status DeleteRegionTask::DeleteRegion(std::shared_ptr<Context> ctx, uint6
   // Delete raft meta
   store_meta_manager->GetStoreRaftMeta()->DeleteRaftMeta(region_id);
 
+  // Delete write batcher
+  Server::GetInstance()->GetStorage()->DeleteRegion(region_id);
+
   // Index region
   if (Server::GetInstance()->GetRole() == pb::common::ClusterRole::INDEX) {
     // Delete vector index
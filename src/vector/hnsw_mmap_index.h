@@ -0,0 +1,192 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef DINGODB_VECTOR_HNSW_MMAP_INDEX_H_
+#define DINGODB_VECTOR_HNSW_MMAP_INDEX_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "hnswlib/hnswlib.h"
+
+namespace dingodb {
+
+// Hnsw index loaded from file saved by hnswlib saveIndex, same as hnswlib loadIndex except that vector data
+// and level 0 graph are mapped from file instead of read into heap, so load is fast and clean pages can be
+// evicted by kernel. Anonymous memory is reserved up to max_elements and the file is privately mapped over the
+// head of it, the header is mapped too so level 0 memory need not be page aligned in file.
+// Pages touched by add/delete become anonymous memory, call DirtyCount to decide when to remap a saved file.
+class HnswMmapIndex : public hnswlib::HierarchicalNSW<float> {
+ public:
+  // Throw std::runtime_error like hnswlib loadIndex.
+  HnswMmapIndex(hnswlib::SpaceInterface<float>* space, const std::string& path, size_t max_elements)
+      : hnswlib::HierarchicalNSW<float>(space) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("Open file " + path + " failed, errno " + std::to_string(errno));
+    }
+
+    try {
+      Load(fd, path, space, max_elements);
+    } catch (...) {
+      close(fd);
+      Release();
+      throw;
+    }
+    close(fd);
+  }
+
+  ~HnswMmapIndex() override { Release(); }
+
+  // Add/delete count since load, every one may copy some pages of the mapping to anonymous memory.
+  size_t DirtyCount() const { return dirty_count_.load(std::memory_order_relaxed); }
+  void IncDirtyCount() { dirty_count_.fetch_add(1, std::memory_order_relaxed); }
+
+ private:
+  static size_t RoundUp(size_t size, size_t align) { return (size + align - 1) / align * align; }
+
+  void Load(int fd, const std::string& path, hnswlib::SpaceInterface<float>* space, size_t max_elements) {
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+      throw std::runtime_error("Stat file " + path + " failed, errno " + std::to_string(errno));
+    }
+    size_t file_size = file_stat.st_size;
+
+    // header, same order as hnswlib saveIndex
+    std::ifstream input(path, std::ios::binary);
+    size_t file_element_count = 0;
+    ReadPod(input, offsetLevel0_);
+    ReadPod(input, max_elements_);
+    ReadPod(input, file_element_count);
+    ReadPod(input, size_data_per_element_);
+    ReadPod(input, label_offset_);
+    ReadPod(input, offsetData_);
+    ReadPod(input, maxlevel_);
+    ReadPod(input, enterpoint_node_);
+    ReadPod(input, maxM_);
+    ReadPod(input, maxM0_);
+    ReadPod(input, M_);
+    ReadPod(input, mult_);
+    ReadPod(input, ef_construction_);
+    size_t header_size = input.tellg();
+    size_t level0_size = file_element_count * size_data_per_element_;
+    if (!input || header_size + level0_size > file_size) {
+      throw std::runtime_error("Index file " + path + " is corrupted");
+    }
+
+    max_elements_ = std::max(max_elements, file_element_count);
+    data_size_ = space->get_data_size();
+    fstdistfunc_ = space->get_dist_func();
+    dist_func_param_ = space->get_dist_func_param();
+
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    mmap_size_ = RoundUp(header_size + max_elements_ * size_data_per_element_, page_size);
+    size_t file_map_size = RoundUp(header_size + level0_size, page_size);
+    void* mmap_base =
+        mmap(nullptr, mmap_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (mmap_base == MAP_FAILED) {
+      throw std::runtime_error("Mmap " + path + " failed, errno " + std::to_string(errno));
+    }
+    mmap_base_ = static_cast<char*>(mmap_base);
+    if (mmap(mmap_base_, file_map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+      throw std::runtime_error("Mmap " + path + " failed, errno " + std::to_string(errno));
+    }
+    // hnsw visit graph randomly, readahead is useless.
+    madvise(mmap_base_, mmap_size_, MADV_RANDOM);
+    data_level0_memory_ = mmap_base_ + header_size;
+
+    // upper level graph is small, read into heap like hnswlib loadIndex
+    size_links_per_element_ = maxM_ * sizeof(hnswlib::tableint) + sizeof(hnswlib::linklistsizeint);
+    size_links_level0_ = maxM0_ * sizeof(hnswlib::tableint) + sizeof(hnswlib::linklistsizeint);
+    std::vector<std::mutex>(max_elements_).swap(link_list_locks_);
+    std::vector<std::mutex>(MAX_LABEL_OPERATION_LOCKS).swap(label_op_locks_);
+    visited_list_pool_ = new hnswlib::VisitedListPool(1, max_elements_);
+    linkLists_ = static_cast<char**>(malloc(sizeof(void*) * max_elements_));
+    if (linkLists_ == nullptr) {
+      throw std::runtime_error("Not enough memory: allocate linklists failed");
+    }
+    element_levels_ = std::vector<int>(max_elements_);
+    revSize_ = 1.0 / mult_;
+    ef_ = 10;
+    allow_replace_deleted_ = true;
+
+    input.seekg(header_size + level0_size);
+    // cur_element_count is the count of element whose link list is read, base destructor free them.
+    for (size_t i = 0; i < file_element_count; ++i) {
+      label_lookup_[getExternalLabel(i)] = i;
+      unsigned int link_list_size = 0;
+      ReadPod(input, link_list_size);
+      if (!input) {
+        throw std::runtime_error("Index file " + path + " is corrupted");
+      }
+      if (link_list_size == 0) {
+        element_levels_[i] = 0;
+        linkLists_[i] = nullptr;
+      } else {
+        element_levels_[i] = link_list_size / size_links_per_element_;
+        linkLists_[i] = static_cast<char*>(malloc(link_list_size));
+        if (linkLists_[i] == nullptr) {
+          throw std::runtime_error("Not enough memory: allocate linklist failed");
+        }
+        input.read(linkLists_[i], link_list_size);
+      }
+      cur_element_count = i + 1;
+    }
+    if (!input) {
+      throw std::runtime_error("Index file " + path + " is corrupted");
+    }
+
+    for (size_t i = 0; i < cur_element_count; ++i) {
+      if (isMarkedDeleted(i)) {
+        num_deleted_ += 1;
+        deleted_elements.insert(i);
+      }
+    }
+  }
+
+  template <typename T>
+  static void ReadPod(std::ifstream& input, T& pod) {
+    input.read(reinterpret_cast<char*>(&pod), sizeof(T));
+  }
+
+  // The mapping is not malloced, detach it before hnswlib destructor free level 0 memory.
+  void Release() {
+    data_level0_memory_ = nullptr;
+    if (mmap_base_ != nullptr) {
+      munmap(mmap_base_, mmap_size_);
+      mmap_base_ = nullptr;
+    }
+  }
+
+  char* mmap_base_{nullptr};
+  size_t mmap_size_{0};
+  std::atomic<size_t> dirty_count_{0};
+};
+
+}  // namespace dingodb
+
+#endif  // DINGODB_VECTOR_HNSW_MMAP_INDEX_H_
@@ -15,30 +15,45 @@
 #ifndef DINGODB_VECTOR_INDEX_H_
 #define DINGODB_VECTOR_INDEX_H_
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
+#include "bthread/mutex.h"
 #include "butil/status.h"
 #include "common/logging.h"
+#include "common/synchronization.h"
 #include "hnswlib/space_ip.h"
 #include "hnswlib/space_l2.h"
 #include "proto/common.pb.h"
 #include "proto/error.pb.h"
+#include "vector/hnsw_mmap_index.h"
+#include "vector/vector_quantization.h"
 
 namespace dingodb {
 
 class VectorIndex {
  public:
   VectorIndex(uint64_t id, const pb::common::VectorIndexParameter& vector_index_parameter)
-      : id_(id), apply_log_index_(0), snapshot_log_index_(0), vector_index_parameter_(vector_index_parameter) {
+      : id_(id),
+        apply_log_index_(0),
+        snapshot_log_index_(0),
+        write_seq_(0),
+        vector_index_parameter_(vector_index_parameter) {
     vector_index_type_ = vector_index_parameter_.vector_index_type();
 
-    if (vector_index_type_ == pb::common::VectorIndexType::VECTOR_INDEX_TYPE_HNSW) {
+    if (IsHnsw()) {
       const auto& hnsw_parameter = vector_index_parameter_.hnsw_parameter();
       assert(hnsw_parameter.dimension() > 0);
       assert(hnsw_parameter.metric_type() != pb::common::MetricType::METRIC_TYPE_NONE);
@@ -46,7 +61,11 @@ class VectorIndex {
       assert(hnsw_parameter.max_elements() > 0);
       assert(hnsw_parameter.nlinks() > 0);
 
-      if (hnsw_parameter.metric_type() == pb::common::MetricType::METRIC_TYPE_INNER_PRODUCT) {
+      dimension_ = hnsw_parameter.dimension();
+      if (IsQuantized()) {
+        hnsw_space_ = new Sq8Space(hnsw_parameter.dimension(),
+                                   hnsw_parameter.metric_type() == pb::common::MetricType::METRIC_TYPE_INNER_PRODUCT);
+      } else if (hnsw_parameter.metric_type() == pb::common::MetricType::METRIC_TYPE_INNER_PRODUCT) {
         hnsw_space_ = new hnswlib::InnerProductSpace(hnsw_parameter.dimension());
       } else {
         hnsw_space_ = new hnswlib::L2Space(hnsw_parameter.dimension());
@@ -61,7 +80,7 @@ class VectorIndex {
   }
 
   ~VectorIndex() {
-    if (vector_index_type_ == pb::common::VectorIndexType::VECTOR_INDEX_TYPE_HNSW) {
+    if (IsHnsw()) {
       delete hnsw_index_;
       delete hnsw_space_;
     }
@@ -74,7 +93,8 @@ class VectorIndex {
     }
 
     const auto& vector_index_parameter = index_parameter.vector_index_parameter();
-    if (vector_index_parameter.vector_index_type() == pb::common::VectorIndexType::VECTOR_INDEX_TYPE_HNSW) {
+    if (vector_index_parameter.vector_index_type() == pb::common::VectorIndexType::VECTOR_INDEX_TYPE_HNSW ||
+        vector_index_parameter.vector_index_type() == pb::common::VectorIndexType::VECTOR_INDEX_TYPE_HNSW_SQ8) {
       const auto& hnsw_parameter = vector_index_parameter.hnsw_parameter();
 
       if (hnsw_parameter.dimension() == 0) {
@@ -108,6 +128,35 @@ class VectorIndex {
 
   pb::common::VectorIndexType VectorIndexType() { return vector_index_type_; }
 
+  bool IsHnsw() const {
+    return vector_index_type_ == pb::common::VectorIndexType::VECTOR_INDEX_TYPE_HNSW ||
+           vector_index_type_ == pb::common::VectorIndexType::VECTOR_INDEX_TYPE_HNSW_SQ8;
+  }
+
+  // Index store compressed vector, search result not carry vector and distance is approximate.
+  bool IsQuantized() const { return vector_index_type_ == pb::common::VectorIndexType::VECTOR_INDEX_TYPE_HNSW_SQ8; }
+
+  // Exact distance of full precision vectors, same metric as index.
+  float CalcDistance(const pb::common::Vector& vector_a, const pb::common::Vector& vector_b) {
+    if (vector_a.float_values_size() != vector_b.float_values_size()) {
+      return std::numeric_limits<float>::max();
+    }
+
+    bool is_inner_product = vector_index_parameter_.hnsw_parameter().metric_type() ==
+                            pb::common::MetricType::METRIC_TYPE_INNER_PRODUCT;
+    float result = 0;
+    for (int i = 0; i < vector_a.float_values_size(); ++i) {
+      if (is_inner_product) {
+        result += vector_a.float_values(i) * vector_b.float_values(i);
+      } else {
+        float diff = vector_a.float_values(i) - vector_b.float_values(i);
+        result += diff * diff;
+      }
+    }
+
+    return is_inner_product ? 1.0F - result : result;
+  }
+
   butil::Status Add(const std::vector<pb::common::VectorWithId>& vector_with_ids) {
     for (const auto& vector_with_id : vector_with_ids) {
       auto ret = Add(vector_with_id);
@@ -128,8 +177,22 @@ class VectorIndex {
   }
 
   butil::Status Add(uint64_t id, const std::vector<float>& vector) {
-    if (vector_index_type_ == pb::common::VectorIndexType::VECTOR_INDEX_TYPE_HNSW) {
-      hnsw_index_->addPoint(vector.data(), id, true);
+    if (IsHnsw()) {
+      const void* data = vector.data();
+      std::string code;
+      if (IsQuantized()) {
+        if (vector.size() != dimension_) {
+          return butil::Status(pb::error::Errno::EILLEGAL_PARAMTETERS, "vector dimension not match");
+        }
+        code.resize(ScalarQuantizer::CodeSize(dimension_));
+        ScalarQuantizer::Encode(vector.data(), dimension_, code.data());
+        data = code.data();
+      }
+
+      // addPoint is thread safe, so add concurrently.
+      std::shared_lock<BthreadRWLock> lock(rw_lock_);
+      hnsw_index_->addPoint(data, id, true);
+      MarkWrite();
       return butil::Status::OK();
     } else {
       return butil::Status(pb::error::Errno::EINTERNAL, "vector index type is not supported");
@@ -137,9 +200,11 @@ class VectorIndex {
   }
 
   void Delete(uint64_t id) {
-    if (vector_index_type_ == pb::common::VectorIndexType::VECTOR_INDEX_TYPE_HNSW) {
+    if (IsHnsw()) {
+      std::shared_lock<BthreadRWLock> lock(rw_lock_);
       try {
         hnsw_index_->markDelete(id);
+        MarkWrite();
       } catch (std::exception& e) {
         DINGO_LOG(ERROR) << "delete vector failed, id=" << id << ", what=" << e.what();
       }
@@ -147,7 +212,7 @@ class VectorIndex {
   }
 
   butil::Status Save(const std::string& path) {
-    if (vector_index_type_ == pb::common::VectorIndexType::VECTOR_INDEX_TYPE_HNSW) {
+    if (IsHnsw()) {
       hnsw_index_->saveIndex(path);
       return butil::Status::OK();
     } else {
@@ -155,24 +220,190 @@ class VectorIndex {
     }
   }
 
+  using SaveWriter = std::function<butil::Status(const char* data, size_t size)>;
+
+  // Save index in hnswlib saveIndex format by chunks through writer, without a full copy in memory.
+  // Exclusive lock is held only to take element count and header, then elements are copied one by one
+  // under their link list lock, add/delete go on meanwhile. Links to elements added after the start are
+  // dropped to keep the graph closed, writes after the start may partially be in file, they are replayed
+  // from wal after load. apply_log_index is the log index which the file contains at least,
+  // write_seq identify the start for Remap, the file is exact only if there is no write after it.
+  butil::Status SaveToWriter(const SaveWriter& writer, uint64_t& apply_log_index, uint64_t& write_seq) {
+    if (!IsHnsw()) {
+      return butil::Status(pb::error::Errno::EINTERNAL, "vector index type is not supported");
+    }
+
+    std::string buffer;
+    buffer.reserve(kSaveChunkSize);
+    auto write_pod = [&buffer](const auto& pod) {
+      buffer.append(reinterpret_cast<const char*>(&pod), sizeof(pod));
+    };
+
+    // Prevent hnsw index from being replaced while saving.
+    BAIDU_SCOPED_LOCK(replace_mutex_);
+
+    hnswlib::HierarchicalNSW<float>* index = nullptr;
+    size_t cur_element_count = 0;
+    {
+      std::unique_lock<BthreadRWLock> lock(rw_lock_);
+      apply_log_index = ApplyLogIndex();
+      write_seq = write_seq_.load(std::memory_order_relaxed);
+
+      index = hnsw_index_;
+      cur_element_count = index->cur_element_count;
+      write_pod(index->offsetLevel0_);
+      write_pod(index->max_elements_);
+      write_pod(cur_element_count);
+      write_pod(index->size_data_per_element_);
+      write_pod(index->label_offset_);
+      write_pod(index->offsetData_);
+      write_pod(index->maxlevel_);
+      write_pod(index->enterpoint_node_);
+      write_pod(index->maxM_);
+      write_pod(index->maxM0_);
+      write_pod(index->M_);
+      write_pod(index->mult_);
+      write_pod(index->ef_construction_);
+    }
+
+    auto flush = [&buffer, &writer](bool force) -> butil::Status {
+      if (buffer.empty() || (!force && buffer.size() < kSaveChunkSize)) {
+        return butil::Status::OK();
+      }
+      auto status = writer(buffer.data(), buffer.size());
+      buffer.clear();
+      return status;
+    };
+
+    for (size_t i = 0; i < cur_element_count; ++i) {
+      size_t offset = buffer.size();
+      {
+        std::unique_lock<std::mutex> element_lock(index->link_list_locks_[i]);
+        buffer.append(index->data_level0_memory_ + i * index->size_data_per_element_ + index->offsetLevel0_,
+                      index->size_data_per_element_);
+      }
+      DropNewLinks(buffer.data() + offset, cur_element_count);
+
+      auto status = flush(false);
+      if (!status.ok()) {
+        return status;
+      }
+    }
+
+    for (size_t i = 0; i < cur_element_count; ++i) {
+      unsigned int link_list_size =
+          index->element_levels_[i] > 0 ? index->size_links_per_element_ * index->element_levels_[i] : 0;
+      write_pod(link_list_size);
+      if (link_list_size > 0) {
+        size_t offset = buffer.size();
+        {
+          std::unique_lock<std::mutex> element_lock(index->link_list_locks_[i]);
+          buffer.append(index->linkLists_[i], link_list_size);
+        }
+        for (int level = 0; level < index->element_levels_[i]; ++level) {
+          DropNewLinks(buffer.data() + offset + level * index->size_links_per_element_, cur_element_count);
+        }
+      }
+
+      auto status = flush(false);
+      if (!status.ok()) {
+        return status;
+      }
+    }
+
+    return flush(true);
+  }
+
   butil::Status Load(const std::string& path) {
-    // FIXME: need to prevent SEGV when delete old_hnsw_index
-    if (vector_index_type_ == pb::common::VectorIndexType::VECTOR_INDEX_TYPE_HNSW) {
-      auto* old_hnsw_index = hnsw_index_;
-      hnsw_index_ = new hnswlib::HierarchicalNSW<float>(hnsw_space_, path, false,
-                                                        vector_index_parameter_.hnsw_parameter().max_elements(), true);
-      delete old_hnsw_index;
+    if (IsHnsw()) {
+      auto* hnsw_index = new hnswlib::HierarchicalNSW<float>(
+          hnsw_space_, path, false, vector_index_parameter_.hnsw_parameter().max_elements(), true);
+      ReplaceHnswIndex(hnsw_index);
       return butil::Status::OK();
     } else {
       return butil::Status(pb::error::Errno::EINTERNAL, "vector index type is not supported");
     }
   }
 
+  // Load index file which is saved by SaveToWriter/saveIndex, vector data and level 0 graph are mapped
+  // from file instead of read into heap, see HnswMmapIndex.
+  butil::Status LoadMmap(const std::string& path) {
+    if (!IsHnsw()) {
+      return butil::Status(pb::error::Errno::EINTERNAL, "vector index type is not supported");
+    }
+
+    try {
+      auto* hnsw_index =
+          new HnswMmapIndex(hnsw_space_, path, vector_index_parameter_.hnsw_parameter().max_elements());
+      ReplaceHnswIndex(hnsw_index);
+    } catch (std::exception& e) {
+      return butil::Status(pb::error::Errno::EINTERNAL, "Load vector index file %s failed, %s", path.c_str(),
+                           e.what());
+    }
+
+    return butil::Status::OK();
+  }
+
+  // Map the file saved from SaveToWriter again, so pages copied by add/delete since last map are released.
+  // Only replace when the index has no add/delete after the copy, otherwise wait next save.
+  bool Remap(const std::string& path, uint64_t write_seq) {
+    if (!IsMmap()) {
+      return false;
+    }
+
+    hnswlib::HierarchicalNSW<float>* hnsw_index = nullptr;
+    try {
+      hnsw_index = new HnswMmapIndex(hnsw_space_, path, vector_index_parameter_.hnsw_parameter().max_elements());
+    } catch (std::exception& e) {
+      DINGO_LOG(ERROR) << "remap vector index failed, id=" << id_ << ", what=" << e.what();
+      return false;
+    }
+
+    bool is_replaced = false;
+    {
+      BAIDU_SCOPED_LOCK(replace_mutex_);
+      std::unique_lock<BthreadRWLock> lock(rw_lock_);
+      if (write_seq_.load(std::memory_order_relaxed) == write_seq) {
+        std::swap(hnsw_index_, hnsw_index);
+        is_replaced = true;
+      }
+    }
+
+    // old index or the unused new one
+    delete hnsw_index;
+    return is_replaced;
+  }
+
+  bool IsMmap() {
+    std::shared_lock<BthreadRWLock> lock(rw_lock_);
+    return dynamic_cast<HnswMmapIndex*>(hnsw_index_) != nullptr;
+  }
+
+  // Add/delete count since the index file is mapped, 0 if not mmap.
+  size_t MmapDirtyCount() {
+    std::shared_lock<BthreadRWLock> lock(rw_lock_);
+    auto* hnsw_index = dynamic_cast<HnswMmapIndex*>(hnsw_index_);
+    return hnsw_index != nullptr ? hnsw_index->DirtyCount() : 0;
+  }
+
   butil::Status Search(const std::vector<float>& vector, uint32_t topk,
                        std::vector<pb::common::VectorWithDistance>& results) {
-    if (vector_index_type_ == pb::common::VectorIndexType::VECTOR_INDEX_TYPE_HNSW) {
+    if (IsHnsw()) {
+      const void* query = vector.data();
+      std::string code;
+      if (IsQuantized()) {
+        if (vector.size() != dimension_) {
+          return butil::Status(pb::error::Errno::EILLEGAL_PARAMTETERS, "vector dimension not match");
+        }
+        code.resize(ScalarQuantizer::CodeSize(dimension_));
+        ScalarQuantizer::Encode(vector.data(), dimension_, code.data());
+        query = code.data();
+      }
+
+      // Prevent hnsw index from being replaced by load.
+      std::shared_lock<BthreadRWLock> lock(rw_lock_);
       // std::priority_queue<std::pair<float, uint64_t>> result = hnsw_index_->searchKnn(vector.data(), topk);
-      std::priority_queue<std::pair<float, uint64_t>> result = hnsw_index_->searchKnn(vector.data(), topk);
+      std::priority_queue<std::pair<float, uint64_t>> result = hnsw_index_->searchKnn(query, topk);
 
       DINGO_LOG(DEBUG) << "result.size() = " << result.size();
 
@@ -184,6 +415,13 @@ class VectorIndex {
 
         vector_with_id->set_id(result.top().second);
 
+        // Quantized vector is lossy, the caller restruct it from storage.
+        if (IsQuantized()) {
+          results.push_back(vector_with_distance);
+          result.pop();
+          continue;
+        }
+
         try {
           std::vector<float> data = hnsw_index_->getDataByLabel<float>(result.top().second);
           for (auto& value : data) {
@@ -227,12 +465,50 @@ class VectorIndex {
   }
 
  private:
+  // Link list is | count(unsigned short) | flags | neighbor ids |, remove neighbors not less than element_count.
+  static void DropNewLinks(char* link_list, size_t element_count) {
+    unsigned short count = 0;
+    memcpy(&count, link_list, sizeof(count));
+    char* ids = link_list + sizeof(hnswlib::linklistsizeint);
+    unsigned short new_count = 0;
+    for (unsigned short i = 0; i < count; ++i) {
+      hnswlib::tableint id = 0;
+      memcpy(&id, ids + i * sizeof(id), sizeof(id));
+      if (id < element_count) {
+        memcpy(ids + new_count * sizeof(id), &id, sizeof(id));
+        ++new_count;
+      }
+    }
+    memcpy(link_list, &new_count, sizeof(new_count));
+  }
+
+  // Called with lock held.
+  void MarkWrite() {
+    write_seq_.fetch_add(1, std::memory_order_relaxed);
+    auto* hnsw_index = dynamic_cast<HnswMmapIndex*>(hnsw_index_);
+    if (hnsw_index != nullptr) {
+      hnsw_index->IncDirtyCount();
+    }
+  }
+
+  void ReplaceHnswIndex(hnswlib::HierarchicalNSW<float>* hnsw_index) {
+    {
+      BAIDU_SCOPED_LOCK(replace_mutex_);
+      std::unique_lock<BthreadRWLock> lock(rw_lock_);
+      std::swap(hnsw_index_, hnsw_index);
+    }
+
+    delete hnsw_index;
+  }
+
   // region_id
   uint64_t id_;
   // apply max log index
   std::atomic<uint64_t> apply_log_index_;
   // last snapshot log index
   std::atomic<uint64_t> snapshot_log_index_;
+  // increase on every add/delete
+  std::atomic<uint64_t> write_seq_;
 
   pb::common::VectorIndexType vector_index_type_;
 
@@ -242,6 +518,14 @@ class VectorIndex {
 
   uint32_t dimension_;  // Dimension of the elements
   pb::common::VectorIndexParameter vector_index_parameter_;
+
+  // Add/delete/search hold shared lock, starting save or replacing index hold exclusive lock shortly.
+  BthreadRWLock rw_lock_;
+  // Save hold it for the whole dump, so hnsw index is not replaced meanwhile.
+  bthread::Mutex replace_mutex_;
+
+  // Save flush to writer by chunks of this size.
+  static const size_t kSaveChunkSize = 4 * 1024 * 1024;
 };
 
 }  // namespace dingodb
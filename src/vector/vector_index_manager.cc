@@ -14,12 +14,27 @@
 
 #include "vector/vector_index_manager.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
 #include <cstdint>
 #include <filesystem>
+#include <fstream>
 #include <memory>
+#include <set>
 #include <string>
 
+#include "bthread/bthread.h"
+#include "butil/crc32c.h"
+#include "bvar/latency_recorder.h"
+#include "bvar/reducer.h"
+#include "common/constant.h"
+#include "common/helper.h"
 #include "common/logging.h"
+#include "common/synchronization.h"
+#include "gflags/gflags.h"
 #include "fmt/core.h"
 #include "proto/error.pb.h"
 #include "server/server.h"
@@ -27,26 +42,264 @@
 #include "vector/vector_index.h"
 namespace dingodb {
 
+DEFINE_int32(vector_index_load_concurrency, 4, "Max number of vector index loaded concurrently at bootstrap");
+DEFINE_int32(vector_index_build_concurrency, 8, "Number of bthreads add vector to one index when build/replay");
+DEFINE_int32(vector_index_build_batch_size, 1024, "Vector count of one insert bthread each round when build/replay");
+DEFINE_bool(vector_index_use_mmap, true, "Map vector index file into memory instead of reading it into heap");
+DEFINE_uint64(vector_index_mmap_remap_dirty_count, 10000,
+              "Map the saved file again when add/delete count since mapped exceed it, release copied pages");
+DEFINE_bool(vector_index_verify_checksum, false,
+            "Verify vector index file checksum when load, it read the whole file and slow down mmap load, "
+            "file size is always checked");
+
+// Bootstrap progress metrics
+static bvar::Adder<int64_t> g_load_vector_index_total("dingo_load_vector_index_total");
+static bvar::Adder<int64_t> g_load_vector_index_finished("dingo_load_vector_index_finished");
+static bvar::Adder<int64_t> g_load_vector_index_failed("dingo_load_vector_index_failed");
+static bvar::LatencyRecorder g_load_vector_index_latency("dingo_load_vector_index");
+
+// Decode and apply vector to index in parallel by round, the reader decode next round
+// while workers apply the current round. Vector with the same id always fall in the same lane,
+// so operations on it keep the wal order.
+class VectorIndexApplier {
+ public:
+  VectorIndexApplier(std::shared_ptr<VectorIndex> vector_index, uint32_t concurrency, uint32_t batch_size)
+      : vector_index_(vector_index),
+        concurrency_(std::max(concurrency, 1U)),
+        batch_size_(std::max(batch_size, 1U)),
+        count_(0) {
+    lanes_ = std::make_shared<std::vector<std::vector<Operation>>>(concurrency_);
+  }
+  ~VectorIndexApplier() { Finish(); }
+
+  void Add(pb::common::VectorWithId vector) {
+    uint64_t vector_id = vector.id();
+    Push(vector_id, Operation{false, std::move(vector)});
+  }
+
+  void Delete(uint64_t vector_id) {
+    pb::common::VectorWithId vector;
+    vector.set_id(vector_id);
+    Push(vector_id, Operation{true, std::move(vector)});
+  }
+
+  // Apply rest vector and wait all done.
+  void Finish() {
+    Dispatch();
+    cond_.Wait();
+  }
+
+ private:
+  struct Operation {
+    bool is_delete;
+    pb::common::VectorWithId vector;
+  };
+
+  static void Apply(std::shared_ptr<VectorIndex> vector_index, std::vector<Operation>& operations) {
+    for (auto& operation : operations) {
+      if (operation.is_delete) {
+        vector_index->Delete(operation.vector.id());
+      } else {
+        vector_index->Add(operation.vector);
+      }
+    }
+  }
+
+  void Push(uint64_t vector_id, Operation operation) {
+    (*lanes_)[vector_id % concurrency_].push_back(std::move(operation));
+    if (++count_ >= static_cast<size_t>(concurrency_) * batch_size_) {
+      Dispatch();
+    }
+  }
+
+  void Dispatch() {
+    if (count_ == 0) {
+      return;
+    }
+
+    // Wait previous round done.
+    cond_.Wait();
+
+    if (concurrency_ == 1) {
+      Apply(vector_index_, (*lanes_)[0]);
+      (*lanes_)[0].clear();
+    } else {
+      auto lanes = lanes_;
+      for (uint32_t i = 0; i < concurrency_; ++i) {
+        if ((*lanes)[i].empty()) {
+          continue;
+        }
+
+        cond_.Increase();
+        auto vector_index = vector_index_;
+        auto* cond = &cond_;
+        Bthread bth(&BTHREAD_ATTR_SMALL);
+        bth.Run([vector_index, lanes, i, cond]() {
+          Apply(vector_index, (*lanes)[i]);
+          cond->DecreaseSignal();
+        });
+      }
+      lanes_ = std::make_shared<std::vector<std::vector<Operation>>>(concurrency_);
+    }
+
+    count_ = 0;
+  }
+
+  std::shared_ptr<VectorIndex> vector_index_;
+  uint32_t concurrency_;
+  uint32_t batch_size_;
+
+  // Lanes of the round being decoded, the dispatched round is held by workers.
+  std::shared_ptr<std::vector<std::vector<Operation>>> lanes_;
+  size_t count_;
+  // Running worker number of the dispatched round.
+  BthreadCond cond_;
+};
+
+// Write vector index file chunk by chunk.
+static const size_t kVectorIndexWriteChunkSize = 4 * 1024 * 1024;  // 4MB
+
+// Append data to file and calculate crc32c at the same time, sync it on finish.
+class VectorIndexFileWriter {
+ public:
+  explicit VectorIndexFileWriter(const std::string& path) : path_(path), fd_(-1), size_(0), crc_(0) {}
+  ~VectorIndexFileWriter() {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  butil::Status Open() {
+    fd_ = open(path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+      return butil::Status(pb::error::Errno::EINTERNAL, "Open file %s failed, errno %d", path_.c_str(), errno);
+    }
+    return butil::Status::OK();
+  }
+
+  butil::Status Write(const char* data, size_t size) {
+    size_t offset = 0;
+    while (offset < size) {
+      ssize_t written = write(fd_, data + offset, std::min(kVectorIndexWriteChunkSize, size - offset));
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return butil::Status(pb::error::Errno::EINTERNAL, "Write file %s failed, errno %d", path_.c_str(), errno);
+      }
+
+      crc_ = butil::crc32c::Extend(crc_, data + offset, written);
+      offset += written;
+    }
+    size_ += size;
+
+    return butil::Status::OK();
+  }
+
+  butil::Status Finish() {
+    int ret = fsync(fd_);
+    close(fd_);
+    fd_ = -1;
+    if (ret != 0) {
+      return butil::Status(pb::error::Errno::EINTERNAL, "Sync file %s failed, errno %d", path_.c_str(), errno);
+    }
+    return butil::Status::OK();
+  }
+
+  uint64_t Size() const { return size_; }
+  uint32_t Crc() const { return crc_; }
+
+ private:
+  std::string path_;
+  int fd_;
+  uint64_t size_;
+  uint32_t crc_;
+};
+
+// Write buffer to file and sync it, calculate crc32c at the same time.
+static butil::Status WriteVectorIndexFile(const std::string& path, const std::string& buffer, uint32_t& crc) {
+  VectorIndexFileWriter writer(path);
+  auto status = writer.Open();
+  if (status.ok()) {
+    status = writer.Write(buffer.data(), buffer.size());
+  }
+  if (status.ok()) {
+    status = writer.Finish();
+  }
+  crc = writer.Crc();
+  return status;
+}
+
+static butil::Status VerifyVectorIndexFile(const std::string& path, uint64_t expect_size, uint32_t expect_crc) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return butil::Status(pb::error::Errno::EINTERNAL, "Open file failed");
+  }
+
+  std::string chunk(kVectorIndexWriteChunkSize, '\0');
+  uint64_t size = 0;
+  uint32_t crc = 0;
+  while (file) {
+    file.read(chunk.data(), chunk.size());
+    auto count = file.gcount();
+    if (count <= 0) {
+      break;
+    }
+    crc = butil::crc32c::Extend(crc, chunk.data(), count);
+    size += count;
+  }
+
+  if (size != expect_size || crc != expect_crc) {
+    return butil::Status(pb::error::Errno::EINTERNAL, "Size or checksum mismatch");
+  }
+
+  return butil::Status::OK();
+}
+
 bool VectorIndexManager::Init(std::vector<store::RegionPtr> regions) {
+  bthread::ExecutionQueueOptions options;
+  options.bthread_attr = BTHREAD_ATTR_NORMAL;
+  if (bthread::execution_queue_start(&save_queue_id_, &options, SaveVectorIndexRoutine, this) != 0) {
+    DINGO_LOG(ERROR) << "Start save vector index execution queue failed";
+    return false;
+  }
+  is_available_.store(true, std::memory_order_relaxed);
+
+  // Load vector index of regions concurrently, bounded by vector_index_load_concurrency,
+  // regions are in recover priority order.
+  std::vector<uint64_t> vector_index_ids;
+  std::atomic<bool> load_failed = false;
+  BthreadCond cond;
   for (auto& region : regions) {
     // init vector index map
     const auto& definition = region->InnerRegion().definition();
     if (definition.index_parameter().index_type() == pb::common::IndexType::INDEX_TYPE_VECTOR) {
       DINGO_LOG(INFO) << fmt::format("Init load region {} vector index", region->Id());
 
-      auto status = LoadVectorIndex(region);
-      if (!status.ok()) {
-        DINGO_LOG(ERROR) << fmt::format("Load region {} vector index failed, ", region->Id());
-        return false;
-      }
+      g_load_vector_index_total << 1;
+      cond.IncreaseWait(std::max(FLAGS_vector_index_load_concurrency, 1));
+      Bthread bth(&BTHREAD_ATTR_NORMAL);
+      bth.Run([this, region, &load_failed, &cond]() {
+        uint64_t start_time = Helper::TimestampMs();
+        auto status = LoadVectorIndex(region);
+        if (!status.ok()) {
+          DINGO_LOG(ERROR) << fmt::format("Load region {} vector index failed, ", region->Id());
+          load_failed.store(true);
+          g_load_vector_index_failed << 1;
+        }
+        g_load_vector_index_latency << (Helper::TimestampMs() - start_time);
+        g_load_vector_index_finished << 1;
+        cond.DecreaseSignal();
+      });
 
-      status = SaveVectorIndex(region);
-      if (!status.ok()) {
-        DINGO_LOG(ERROR) << fmt::format("Save region {} vector index failed, ", region->Id());
-        return false;
-      }
+      vector_index_ids.push_back(region->Id());
     }
   }
+  cond.Wait();
+
+  if (load_failed.load()) {
+    return false;
+  }
 
   // Set apply log index
   std::vector<pb::common::KeyValue> kvs;
@@ -60,9 +313,27 @@ bool VectorIndexManager::Init(std::vector<store::RegionPtr> regions) {
     TransformFromKv(kvs);
   }
 
+  // Save vector index at background, so not delay bootstrap.
+  for (auto vector_index_id : vector_index_ids) {
+    AsyncSaveVectorIndex(vector_index_id);
+  }
+
   return true;
 }
 
+void VectorIndexManager::Destroy() {
+  is_available_.store(false, std::memory_order_relaxed);
+
+  if (bthread::execution_queue_stop(save_queue_id_) != 0) {
+    DINGO_LOG(ERROR) << "Save vector index execution queue stop failed";
+    return;
+  }
+
+  if (bthread::execution_queue_join(save_queue_id_) != 0) {
+    DINGO_LOG(ERROR) << "Save vector index execution queue join failed";
+  }
+}
+
 bool VectorIndexManager::AddVectorIndex(uint64_t region_id, std::shared_ptr<VectorIndex> vector_index) {
   return vector_indexs_.Put(region_id, vector_index) > 0;
 }
@@ -97,6 +368,12 @@ butil::Status VectorIndexManager::LoadVectorIndex(store::RegionPtr region) {
 
   // try to LoadVectorIndexFromDisk
   vector_index = LoadVectorIndexFromDisk(region);
+  if (vector_index != nullptr && vector_index->ApplyLogIndex() < GetVectorWalTrimLogIndex(region->Id())) {
+    // The wal between index file and now is trimmed, e.g. data was replaced by raft snapshot.
+    DINGO_LOG(WARNING) << fmt::format("Vector index {} file log id {} is older than wal trim point, discard it",
+                                      region->Id(), vector_index->ApplyLogIndex());
+    vector_index = nullptr;
+  }
   if (vector_index) {
     // replay wal
     DINGO_LOG(INFO) << fmt::format("Load vector index from disk, id {} success, will ReplayWal", region->Id());
@@ -137,6 +414,9 @@ std::shared_ptr<VectorIndex> VectorIndexManager::LoadVectorIndexFromDisk(store::
 
   // open vector_index_file_log_id_file_path and read its content to a std::string
   uint64_t vector_index_file_log_id;
+  uint64_t vector_index_file_size = 0;
+  uint32_t vector_index_file_crc = 0;
+  bool has_checksum = false;
   if (!std::filesystem::exists(vector_index_file_log_id_file_path)) {
     DINGO_LOG(WARNING) << fmt::format(
         "Vector index {} log id file {} not exist, can't load, need to build vector_index", region->Id(),
@@ -151,6 +431,9 @@ std::shared_ptr<VectorIndex> VectorIndexManager::LoadVectorIndexFromDisk(store::
     } else {
       // read vector_index_file_log_id_file_path content to vector_index_file_log_id, then close it
       vector_index_file_log_id_file >> vector_index_file_log_id;
+      if (vector_index_file_log_id_file >> vector_index_file_size >> vector_index_file_crc) {
+        has_checksum = true;
+      }
       vector_index_file_log_id_file.close();
     }
   }
@@ -168,6 +451,22 @@ std::shared_ptr<VectorIndex> VectorIndexManager::LoadVectorIndexFromDisk(store::
     return nullptr;
   }
 
+  // verify file size and checksum, the log id file of old version has not them.
+  if (has_checksum && !FLAGS_vector_index_verify_checksum) {
+    if (std::filesystem::file_size(vector_index_file_path) != vector_index_file_size) {
+      DINGO_LOG(ERROR) << fmt::format("Vector index {} file {} size mismatch, need to build vector_index",
+                                      region->Id(), vector_index_file_path);
+      return nullptr;
+    }
+  } else if (has_checksum) {
+    auto status = VerifyVectorIndexFile(vector_index_file_path, vector_index_file_size, vector_index_file_crc);
+    if (!status.ok()) {
+      DINGO_LOG(ERROR) << fmt::format("Vector index {} file {} verify failed, {}, need to build vector_index",
+                                      region->Id(), vector_index_file_path, status.error_str());
+      return nullptr;
+    }
+  }
+
   // create a new vector_index
   auto vector_index = VectorIndex::New(region->Id(), region->InnerRegion().definition().index_parameter());
   if (!vector_index) {
@@ -176,9 +475,10 @@ std::shared_ptr<VectorIndex> VectorIndexManager::LoadVectorIndexFromDisk(store::
   }
 
   // load index from file
-  auto ret = vector_index->Load(vector_index_file_path);
+  auto ret = FLAGS_vector_index_use_mmap ? vector_index->LoadMmap(vector_index_file_path)
+                                         : vector_index->Load(vector_index_file_path);
   if (!ret.ok()) {
-    DINGO_LOG(WARNING) << fmt::format("Load vector index failed, id {}", region->Id());
+    DINGO_LOG(WARNING) << fmt::format("Load vector index failed, id {}, {}", region->Id(), ret.error_str());
     return nullptr;
   }
 
@@ -205,9 +505,12 @@ butil::Status VectorIndexManager::ReplayValToVectorIndex(std::shared_ptr<VectorI
   IteratorOptions options;
   options.lower_bound = start_key;
   options.upper_bound = end_key;
+  options.readahead_size = Constant::kRocksdbBulkScanReadaheadSize;
+  options.fill_cache = false;
   auto iter = raw_engine_->NewIterator(Constant::kStoreDataCF, options);
 
   // replay vector wal data to vector index
+  VectorIndexApplier applier(vector_index, FLAGS_vector_index_build_concurrency, FLAGS_vector_index_build_batch_size);
   uint64_t last_log_id = vector_index->ApplyLogIndex();
   for (iter->Seek(start_key); iter->Valid(); iter->Next()) {
     pb::common::VectorWithId vector;
@@ -238,7 +541,7 @@ butil::Status VectorIndexManager::ReplayValToVectorIndex(std::shared_ptr<VectorI
     if (value.empty() || value.length() == 0) {
       DINGO_LOG(DEBUG) << fmt::format("Replay vector index vector delete, vector id {}, log_id {}", vector.id(),
                                       log_id);
-      vector_index->Delete(vector.id());
+      applier.Delete(vector.id());
       continue;
     }
 
@@ -253,8 +556,9 @@ butil::Status VectorIndexManager::ReplayValToVectorIndex(std::shared_ptr<VectorI
     }
 
     DINGO_LOG(DEBUG) << fmt::format("Replay vector index vector add, vector id {}, log_id {}", vector.id(), log_id);
-    vector_index->Add(vector);
+    applier.Add(std::move(vector));
   }
+  applier.Finish();
 
   vector_index->SetApplyLogIndex(last_log_id);
 
@@ -276,6 +580,8 @@ std::shared_ptr<VectorIndex> VectorIndexManager::BuildVectorIndex(store::RegionP
   IteratorOptions options;
   options.lower_bound = start_key;
   options.upper_bound = end_key;
+  options.readahead_size = Constant::kRocksdbBulkScanReadaheadSize;
+  options.fill_cache = false;
 
   auto vector_index = VectorIndex::New(region->Id(), region->InnerRegion().definition().index_parameter());
   if (!vector_index) {
@@ -294,6 +600,7 @@ std::shared_ptr<VectorIndex> VectorIndexManager::BuildVectorIndex(store::RegionP
                                  snapshot_log_index, apply_log_index);
 
   // load vector data to vector index
+  VectorIndexApplier applier(vector_index, FLAGS_vector_index_build_concurrency, FLAGS_vector_index_build_batch_size);
   auto iter = raw_engine_->NewIterator(Constant::kStoreDataCF, options);
   for (iter->Seek(start_key); iter->Valid(); iter->Next()) {
     pb::common::VectorWithId vector;
@@ -312,8 +619,9 @@ std::shared_ptr<VectorIndex> VectorIndexManager::BuildVectorIndex(store::RegionP
       continue;
     }
 
-    vector_index->Add(vector);
+    applier.Add(std::move(vector));
   }
+  applier.Finish();
 
   return vector_index;
 }
@@ -380,70 +688,109 @@ butil::Status VectorIndexManager::SaveVectorIndex(std::shared_ptr<VectorIndex> v
     return butil::Status(pb::error::Errno::EINTERNAL, "Save vector index failed, vector_index is null");
   }
 
-  // get vector index file path
-  std::string vector_index_file_path = fmt::format("{}/{}_{}.idx", Server::GetInstance()->GetIndexPath(),
-                                                   vector_index->Id(), vector_index->ApplyLogIndex());
-
-  // get vector index tmp file path
-  std::string vector_index_tmp_file_path = fmt::format("{}/{}_{}.tmp", Server::GetInstance()->GetIndexPath(),
-                                                       vector_index->Id(), vector_index->ApplyLogIndex());
-
-  DINGO_LOG(INFO) << fmt::format("Save vector index {} to file {}", vector_index->Id(), vector_index_file_path);
-
-  // save vector index to tmp file
-  auto ret = vector_index->Save(vector_index_tmp_file_path);
+  uint64_t save_seq = save_seq_.fetch_add(1, std::memory_order_relaxed) + 1;
+  {
+    BAIDU_SCOPED_LOCK(save_mutex_);
+    saving_seqs_.insert(save_seq);
+  }
+  ScopeGuard saving_guard([this, save_seq]() {
+    BAIDU_SCOPED_LOCK(save_mutex_);
+    saving_seqs_.erase(save_seq);
+  });
+
+  // Write to file directly, add/delete only wait for taking the start point, apply log index is known after it.
+  std::string vector_index_tmp_file_path =
+      fmt::format("{}/{}_saving_{}.tmp", Server::GetInstance()->GetIndexPath(), vector_index->Id(), save_seq);
+  VectorIndexFileWriter writer(vector_index_tmp_file_path);
+  uint64_t apply_log_index = 0;
+  uint64_t write_seq = 0;
+  auto ret = writer.Open();
+  if (ret.ok()) {
+    ret = vector_index->SaveToWriter(
+        [&writer](const char* data, size_t size) -> butil::Status { return writer.Write(data, size); },
+        apply_log_index, write_seq);
+  }
+  if (ret.ok()) {
+    ret = writer.Finish();
+  }
   if (!ret.ok()) {
     DINGO_LOG(ERROR) << fmt::format("Save vector index {} to tmp file failed, {}", vector_index->Id(), ret.error_str());
     std::filesystem::remove(vector_index_tmp_file_path);
     return ret;
   }
+  uint32_t crc = writer.Crc();
+
+  // Concurrent saves publish one by one.
+  BAIDU_SCOPED_LOCK(save_mutex_);
+
+  // A newer save has been published, its wal may be trimmed, so this one is useless.
+  if (apply_log_index < vector_index->SnapshotLogIndex()) {
+    DINGO_LOG(INFO) << fmt::format("Skip save vector index {}, log index {} is older than snapshot log index {}",
+                                   vector_index->Id(), apply_log_index, vector_index->SnapshotLogIndex());
+    std::filesystem::remove(vector_index_tmp_file_path);
+    return butil::Status::OK();
+  }
+
+  // get vector index file path
+  std::string vector_index_file_path =
+      fmt::format("{}/{}_{}.idx", Server::GetInstance()->GetIndexPath(), vector_index->Id(), apply_log_index);
+
+  DINGO_LOG(INFO) << fmt::format("Save vector index {} to file {}, size {}", vector_index->Id(), vector_index_file_path,
+                                 writer.Size());
 
   // rename tmp file to vector index file
   std::filesystem::rename(vector_index_tmp_file_path, vector_index_file_path);
 
-  // write vector index file log_id
+  // write vector index file log_id, size and checksum, rename make it atomic.
   std::string vector_index_file_log_id_file_path =
       fmt::format("{}/{}.log_id", Server::GetInstance()->GetIndexPath(), vector_index->Id());
+  std::string vector_index_file_log_id_tmp_file_path =
+      fmt::format("{}/{}_saving_{}.log_id.tmp", Server::GetInstance()->GetIndexPath(), vector_index->Id(), save_seq);
 
-  std::ofstream vector_index_file_log_id_file(vector_index_file_log_id_file_path);
-  if (!vector_index_file_log_id_file.is_open()) {
-    DINGO_LOG(ERROR) << fmt::format("Open vector index file log_id file {} failed", vector_index_file_log_id_file_path);
-    return butil::Status(pb::error::Errno::EINTERNAL, "Open vector index file log_id file failed");
+  uint32_t log_id_crc = 0;
+  ret = WriteVectorIndexFile(vector_index_file_log_id_tmp_file_path,
+                             fmt::format("{} {} {}", apply_log_index, writer.Size(), crc), log_id_crc);
+  if (!ret.ok()) {
+    DINGO_LOG(ERROR) << fmt::format("Write vector index file log_id file {} failed, {}",
+                                    vector_index_file_log_id_tmp_file_path, ret.error_str());
+    std::filesystem::remove(vector_index_file_log_id_tmp_file_path);
+    return ret;
   }
+  std::filesystem::rename(vector_index_file_log_id_tmp_file_path, vector_index_file_log_id_file_path);
 
-  vector_index_file_log_id_file << vector_index->ApplyLogIndex();
+  // Private mapping copy pages touched by add/delete, map the new file to give them back.
+  if (vector_index->IsMmap() && vector_index->MmapDirtyCount() >= FLAGS_vector_index_mmap_remap_dirty_count) {
+    bool is_remapped = vector_index->Remap(vector_index_file_path, write_seq);
+    DINGO_LOG(INFO) << fmt::format("Remap vector index {} file {}, {}", vector_index->Id(), vector_index_file_path,
+                                   is_remapped ? "success" : "skip for changed");
+  }
 
-  // delete old vector index file
-  // read dir file list
+  // Delete old files of this vector index, index file {id}_{log_id}.idx which log id is less than current,
+  // and tmp file {id}_saving_{seq}*.tmp which left by finished or crashed save.
   std::vector<std::filesystem::path> file_path_list;
+  std::string id_prefix = fmt::format("{}_", vector_index->Id());
+  std::string saving_prefix = fmt::format("{}_saving_", vector_index->Id());
   std::filesystem::directory_iterator dir_iter(Server::GetInstance()->GetIndexPath());
   for (const auto& iter : dir_iter) {
-    if (iter.is_regular_file()) {
-      // add file with extension .idx/.tmp and file_name != vector_index_file_path
-      if ((iter.path().extension() == ".idx" || iter.path().extension() == ".tmp") &&
-          iter.path().string() != vector_index_file_path) {
-        auto file_name = iter.path().filename().string();
-        auto pos = file_name.find('_');
-        if (pos == std::string::npos) {
-          DINGO_LOG(WARNING) << fmt::format("Find old vector index file failed, file_name {}", file_name);
-          continue;
-        }
+    if (!iter.is_regular_file()) {
+      continue;
+    }
 
-        uint64_t old_vector_index_id = 0;
-        try {
-          old_vector_index_id = std::stoull(file_name.substr(0, pos));
-        } catch (std::exception& e) {
-          DINGO_LOG(WARNING) << fmt::format("Find old vector index file failed, file_name {}", file_name);
-          continue;
+    auto file_name = iter.path().filename().string();
+    try {
+      if (iter.path().extension() == ".tmp" && file_name.rfind(saving_prefix, 0) == 0) {
+        uint64_t seq = std::stoull(file_name.substr(saving_prefix.size()));
+        if (seq < save_seq && saving_seqs_.count(seq) == 0) {
+          file_path_list.emplace_back(iter.path());
         }
-
-        if (old_vector_index_id == vector_index->Id()) {
-          DINGO_LOG(INFO) << fmt::format("Find old vector index file {} -> {}", iter.path().string(),
-                                         vector_index_file_path);
+      } else if (iter.path().extension() == ".idx" && file_name.rfind(id_prefix, 0) == 0) {
+        uint64_t log_id = std::stoull(file_name.substr(id_prefix.size()));
+        if (log_id < apply_log_index) {
           file_path_list.emplace_back(iter.path());
-          continue;
         }
       }
+    } catch (std::exception& e) {
+      DINGO_LOG(WARNING) << fmt::format("Find old vector index file failed, file_name {}", file_name);
     }
   }
 
@@ -453,11 +800,114 @@ butil::Status VectorIndexManager::SaveVectorIndex(std::shared_ptr<VectorIndex> v
     std::filesystem::remove(file_path);
   }
 
-  // TODO: trim wal log here
+  // update snapshot log index
+  vector_index->SetSnapshotLogIndex(apply_log_index);
+  meta_writer_->Put(TransformToKv(vector_index));
+
+  // the wal before snapshot log index is useless
+  ret = TrimVectorWal(vector_index->Id(), apply_log_index);
+  if (!ret.ok()) {
+    DINGO_LOG(WARNING) << fmt::format("Trim vector index {} wal failed, {}", vector_index->Id(), ret.error_str());
+  }
 
   return butil::Status::OK();
 }
 
+bool VectorIndexManager::AsyncSaveVectorIndex(uint64_t region_id) {
+  if (!is_available_.load(std::memory_order_relaxed)) {
+    DINGO_LOG(ERROR) << "Save vector index execution queue is not available.";
+    return false;
+  }
+
+  if (bthread::execution_queue_execute(save_queue_id_, region_id) != 0) {
+    DINGO_LOG(ERROR) << fmt::format("Save vector index {} execution queue execute failed", region_id);
+    return false;
+  }
+
+  return true;
+}
+
+int VectorIndexManager::SaveVectorIndexRoutine(void* meta, bthread::TaskIterator<uint64_t>& iter) {
+  auto* vector_index_manager = static_cast<VectorIndexManager*>(meta);
+
+  // One save cover all pending request of the same vector index.
+  std::set<uint64_t> saved_ids;
+  for (; iter; ++iter) {
+    uint64_t region_id = *iter;
+    if (saved_ids.count(region_id) > 0) {
+      continue;
+    }
+    saved_ids.insert(region_id);
+
+    auto vector_index = vector_index_manager->vector_indexs_.Get(region_id);
+    if (vector_index == nullptr) {
+      continue;
+    }
+
+    auto status = vector_index_manager->SaveVectorIndex(vector_index);
+    if (!status.ok()) {
+      DINGO_LOG(ERROR) << fmt::format("Async save vector index {} failed, {}", region_id, status.error_str());
+    }
+  }
+
+  return 0;
+}
+
+void VectorIndexManager::ScrubVectorIndex(uint64_t log_gap) {
+  std::vector<std::shared_ptr<VectorIndex>> vector_indexs;
+  vector_indexs_.GetAllValues(vector_indexs, [log_gap](std::shared_ptr<VectorIndex> vector_index) -> bool {
+    return vector_index->ApplyLogIndex() >= vector_index->SnapshotLogIndex() + log_gap;
+  });
+
+  for (auto& vector_index : vector_indexs) {
+    DINGO_LOG(INFO) << fmt::format("Scrub vector index {}, apply log index {} snapshot log index {}",
+                                   vector_index->Id(), vector_index->ApplyLogIndex(),
+                                   vector_index->SnapshotLogIndex());
+    AsyncSaveVectorIndex(vector_index->Id());
+  }
+}
+
+butil::Status VectorIndexManager::TrimVectorWal(uint64_t region_id, uint64_t log_id) {
+  if (log_id == 0) {
+    return butil::Status::OK();
+  }
+
+  // Wal key of log id 0 is the trim point.
+  pb::common::KeyValue kv;
+  VectorCodec::EncodeVectorWal(region_id, 0, 0, *kv.mutable_key());
+  kv.set_value(std::to_string(log_id));
+
+  auto writer = raw_engine_->NewWriter(Constant::kStoreDataCF);
+  auto status = writer->KvPut(kv);
+  if (!status.ok()) {
+    return status;
+  }
+
+  pb::common::Range range;
+  VectorCodec::EncodeVectorWal(region_id, 0, 1, *range.mutable_start_key());
+  VectorCodec::EncodeVectorWal(region_id, 0, log_id + 1, *range.mutable_end_key());
+
+  return writer->KvDeleteRange(range);
+}
+
+uint64_t VectorIndexManager::GetVectorWalTrimLogIndex(uint64_t region_id) {
+  std::string key;
+  VectorCodec::EncodeVectorWal(region_id, 0, 0, key);
+
+  std::string value;
+  auto status = raw_engine_->NewReader(Constant::kStoreDataCF)->KvGet(key, value);
+  if (!status.ok() || value.empty()) {
+    return 0;
+  }
+
+  try {
+    return std::stoull(value);
+  } catch (std::exception& e) {
+    DINGO_LOG(ERROR) << fmt::format("Parse vector index {} wal trim log index failed, {}", region_id, value);
+    return 0;
+  }
+}
+
 void VectorIndexManager::UpdateApplyLogIndex(std::shared_ptr<VectorIndex> vector_index, uint64_t apply_log_index) {
   assert(vector_index != nullptr);
 
@@ -15,9 +15,15 @@
 #ifndef DINGODB_VECTOR_INDEX_MANAGER_H_
 #define DINGODB_VECTOR_INDEX_MANAGER_H_
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
+#include <set>
+#include <string>
+#include <vector>
 
+#include "bthread/execution_queue.h"
+#include "bthread/mutex.h"
 #include "butil/status.h"
 #include "common/safe_map.h"
 #include "meta/store_meta_manager.h"
@@ -33,12 +39,16 @@ class VectorIndexManager : public TransformKvAble {
       : TransformKvAble(Constant::kVectorIndexApplyLogPrefix),
         raw_engine_(raw_engine),
         meta_reader_(meta_reader),
-        meta_writer_(meta_writer) {
+        meta_writer_(meta_writer),
+        is_available_(false),
+        save_queue_id_({UINT64_MAX}),
+        save_seq_(0) {
     vector_indexs_.Init(1000);
   }
   ~VectorIndexManager() override = default;
 
   bool Init(std::vector<store::RegionPtr> regions);
+  void Destroy();
 
   bool AddVectorIndex(uint64_t region_id, std::shared_ptr<VectorIndex> vector_index);
   bool AddVectorIndex(uint64_t region_id, const pb::common::IndexParameter& index_parameter);
@@ -49,7 +59,11 @@ class VectorIndexManager : public TransformKvAble {
   static std::shared_ptr<VectorIndex> LoadVectorIndexFromDisk(store::RegionPtr region);
 
   butil::Status SaveVectorIndex(store::RegionPtr region);
-  static butil::Status SaveVectorIndex(std::shared_ptr<VectorIndex> vector_index);
+  butil::Status SaveVectorIndex(std::shared_ptr<VectorIndex> vector_index);
+  // Save vector index at background, not block vector add/delete.
+  bool AsyncSaveVectorIndex(uint64_t region_id);
+  // Save the vector indexs which apply log index exceed snapshot log index more than log_gap.
+  void ScrubVectorIndex(uint64_t log_gap);
   std::shared_ptr<VectorIndex> BuildVectorIndex(store::RegionPtr region);
   butil::Status RebuildVectorIndex(store::RegionPtr region);
   butil::Status ReplayValToVectorIndex(std::shared_ptr<VectorIndex> vector_index, uint64_t start_log_id,
@@ -63,6 +77,13 @@ class VectorIndexManager : public TransformKvAble {
   void TransformFromKv(const std::vector<pb::common::KeyValue>& kvs) override;
   void GetVectorIndexLogIndex(uint64_t region_id, uint64_t& snapshot_log_index, uint64_t& apply_log_index);
 
+  // Delete wal whose log id is not greater than log_id, and remember the trim point.
+  butil::Status TrimVectorWal(uint64_t region_id, uint64_t log_id);
+  // Wal before the trim point is deleted, index file before it can't be replayed.
+  uint64_t GetVectorWalTrimLogIndex(uint64_t region_id);
+
+  static int SaveVectorIndexRoutine(void* meta, bthread::TaskIterator<uint64_t>& iter);
+
   // Read meta data from persistence storage.
   std::shared_ptr<MetaReader> meta_reader_;
   // Write meta data to persistence storage.
@@ -71,6 +92,16 @@ class VectorIndexManager : public TransformKvAble {
   std::shared_ptr<RawEngine> raw_engine_;
   // region_id: vector_index
   DingoSafeMap<uint64_t, std::shared_ptr<VectorIndex>> vector_indexs_;
+
+  // Save vector index queue, element is region_id.
+  std::atomic<bool> is_available_;
+  bthread::ExecutionQueueId<uint64_t> save_queue_id_;
+
+  // Every save write its own tmp file, sync save(e.g. rebuild) may run with background save of the same index.
+  std::atomic<uint64_t> save_seq_;
+  // Protect publishing saved file and the seq of saves in progress, whose tmp files must not be deleted.
+  bthread::Mutex save_mutex_;
+  std::set<uint64_t> saving_seqs_;
 };
 
 }  // namespace dingodb
@@ -0,0 +1,127 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_VECTOR_QUANTIZATION_H_
+#define DINGODB_VECTOR_QUANTIZATION_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "hnswlib/hnswlib.h"
+
+namespace dingodb {
+
+// Scalar quantizer compress float to uint8, each vector has its own min and step,
+// so it need not train, code layout: | min(float) | step(float) | code(uint8 * dimension) |
+class ScalarQuantizer {
+ public:
+  static size_t CodeSize(size_t dimension) { return sizeof(float) * 2 + dimension; }
+
+  static void Encode(const float* vector, size_t dimension, char* code) {
+    float min_value = 0;
+    float max_value = 0;
+    if (dimension > 0) {
+      auto [min_iter, max_iter] = std::minmax_element(vector, vector + dimension);
+      min_value = *min_iter;
+      max_value = *max_iter;
+    }
+    float step = (max_value - min_value) / kMaxCode;
+
+    memcpy(code, &min_value, sizeof(float));
+    memcpy(code + sizeof(float), &step, sizeof(float));
+    auto* codes = reinterpret_cast<uint8_t*>(code + sizeof(float) * 2);
+    for (size_t i = 0; i < dimension; ++i) {
+      codes[i] = step > 0 ? static_cast<uint8_t>(std::lround((vector[i] - min_value) / step)) : 0;
+    }
+  }
+
+  static void Decode(const char* code, size_t dimension, float* vector) {
+    float min_value = 0;
+    float step = 0;
+    memcpy(&min_value, code, sizeof(float));
+    memcpy(&step, code + sizeof(float), sizeof(float));
+    const auto* codes = reinterpret_cast<const uint8_t*>(code + sizeof(float) * 2);
+    for (size_t i = 0; i < dimension; ++i) {
+      vector[i] = min_value + codes[i] * step;
+    }
+  }
+
+ private:
+  static constexpr float kMaxCode = 255.0F;
+};
+
+// hnswlib space of scalar quantized vector, distance is computed on codes directly.
+class Sq8Space : public hnswlib::SpaceInterface<float> {
+ public:
+  Sq8Space(size_t dimension, bool is_inner_product)
+      : dimension_(dimension), data_size_(ScalarQuantizer::CodeSize(dimension)) {
+    dist_func_ = is_inner_product ? InnerProductDistance : L2Distance;
+  }
+
+  size_t get_data_size() override { return data_size_; }
+  hnswlib::DISTFUNC<float> get_dist_func() override { return dist_func_; }
+  void* get_dist_func_param() override { return &dimension_; }
+
+ private:
+  static void DecodeHead(const void* code, float& min_value, float& step, const uint8_t*& codes) {
+    const auto* data = static_cast<const char*>(code);
+    memcpy(&min_value, data, sizeof(float));
+    memcpy(&step, data + sizeof(float), sizeof(float));
+    codes = reinterpret_cast<const uint8_t*>(data + sizeof(float) * 2);
+  }
+
+  // Same as hnswlib L2Sqr.
+  static float L2Distance(const void* code_a, const void* code_b, const void* param) {
+    size_t dimension = *static_cast<const size_t*>(param);
+    float min_a, step_a, min_b, step_b;
+    const uint8_t *codes_a, *codes_b;
+    DecodeHead(code_a, min_a, step_a, codes_a);
+    DecodeHead(code_b, min_b, step_b, codes_b);
+
+    float min_diff = min_a - min_b;
+    float result = 0;
+    for (size_t i = 0; i < dimension; ++i) {
+      float diff = min_diff + codes_a[i] * step_a - codes_b[i] * step_b;
+      result += diff * diff;
+    }
+    return result;
+  }
+
+  // Same as hnswlib InnerProductDistance.
+  static float InnerProductDistance(const void* code_a, const void* code_b, const void* param) {
+    size_t dimension = *static_cast<const size_t*>(param);
+    float min_a, step_a, min_b, step_b;
+    const uint8_t *codes_a, *codes_b;
+    DecodeHead(code_a, min_a, step_a, codes_a);
+    DecodeHead(code_b, min_b, step_b, codes_b);
+
+    float result = 0;
+    for (size_t i = 0; i < dimension; ++i) {
+      result += (min_a + codes_a[i] * step_a) * (min_b + codes_b[i] * step_b);
+    }
+    return 1.0F - result;
+  }
+
+  size_t dimension_;
+  size_t data_size_;
+  hnswlib::DISTFUNC<float> dist_func_;
+};
+
+}  // namespace dingodb
+
+#endif  // DINGODB_VECTOR_QUANTIZATION_H_
@@ -0,0 +1,117 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "bench_common.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "config/config.h"
+#include "config/yaml_config.h"
+#include "fmt/core.h"
+
+namespace dingodb::bench {
+
+static const std::string kBenchYamlConfigContent =
+    "cluster:\n"
+    "  name: dingodb\n"
+    "  instance_id: 12345\n"
+    "  coordinators: 127.0.0.1:19190,127.0.0.1:19191,127.0.0.1:19192\n"
+    "  keyring: TO_BE_CONTINUED\n"
+    "server:\n"
+    "  host: 127.0.0.1\n"
+    "  port: 23000\n"
+    "  heartbeat_interval: 10000 # ms\n"
+    "raft:\n"
+    "  host: 127.0.0.1\n"
+    "  port: 23100\n"
+    "  path: /tmp/dingo-store/bench/raft\n"
+    "  election_timeout: 1000 # ms\n"
+    "  snapshot_interval: 3600 # s\n"
+    "  meta_storage: local\n"
+    "log:\n"
+    "  path: /tmp/dingo-store/bench/log\n"
+    "store:\n"
+    "  path: /tmp/dingo-store/bench/rocks\n"
+    "  base:\n"
+    "    block_size: 131072\n"
+    "    block_cache: 67108864\n"
+    "    arena_block_size: 67108864\n"
+    "    min_write_buffer_number_to_merge: 4\n"
+    "    max_write_buffer_number: 4\n"
+    "    max_compaction_bytes: 134217728\n"
+    "    write_buffer_size: 67108864\n"
+    "    prefix_extractor: 8\n"
+    "    max_bytes_for_level_base: 41943040\n"
+    "    target_file_size_base: 4194304\n"
+    "  default:\n"
+    "  instruction:\n"
+    "    max_write_buffer_number: 3\n"
+    "  column_families:\n"
+    "    - default\n"
+    "    - meta\n"
+    "    - instruction\n";
+
+static const char kAlphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+
+std::string GenRandomString(size_t len) {
+  std::uniform_int_distribution<size_t> distrib(0, sizeof(kAlphabet) - 2);
+  std::string result;
+  result.reserve(len);
+  for (size_t i = 0; i < len; ++i) {
+    result.push_back(kAlphabet[distrib(Rng())]);
+  }
+
+  return result;
+}
+
+std::string GenKey(const std::string& prefix, uint64_t num) { return fmt::format("{}{:016}", prefix, num); }
+
+class EngineHolder {
+ public:
+  EngineHolder() {
+    std::shared_ptr<Config> config = std::make_shared<YamlConfig>();
+    if (config->Load(kBenchYamlConfigContent) != 0) {
+      std::cerr << "Load bench config failed" << '\n';
+      return;
+    }
+
+    auto engine = std::make_shared<RawRocksEngine>();
+    if (!engine->Init(config)) {
+      std::cerr << "RawRocksEngine init failed" << '\n';
+      return;
+    }
+    engine_ = engine;
+  }
+
+  ~EngineHolder() {
+    if (engine_ != nullptr) {
+      engine_->Close();
+      engine_->Destroy();
+    }
+  }
+
+  std::shared_ptr<RawRocksEngine> Engine() { return engine_; }
+
+ private:
+  std::shared_ptr<RawRocksEngine> engine_;
+};
+
+std::shared_ptr<RawRocksEngine> GetEngine() {
+  static EngineHolder holder;
+  return holder.Engine();
+}
+
+}  // namespace dingodb::bench
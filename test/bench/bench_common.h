@@ -0,0 +1,47 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef DINGODB_TEST_BENCH_BENCH_COMMON_H_
+#define DINGODB_TEST_BENCH_BENCH_COMMON_H_
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "engine/raw_rocks_engine.h"
+
+namespace dingodb::bench {
+
+// Fixed seed, every run and every commit generate the same dataset.
+static const uint32_t kBenchSeed = 20231019;
+
+inline std::mt19937& Rng() {
+  static thread_local std::mt19937 rng(kBenchSeed);
+  return rng;
+}
+
+// Restart random sequence, call at the beginning of dataset generation.
+inline void ResetRng() { Rng().seed(kBenchSeed); }
+
+std::string GenRandomString(size_t len);
+
+// Zero padded, keep key order same as number order.
+std::string GenKey(const std::string& prefix, uint64_t num);
+
+// Shared rocksdb engine under /tmp, destroyed at process exit.
+std::shared_ptr<RawRocksEngine> GetEngine();
+
+}  // namespace dingodb::bench
+
+#endif  // DINGODB_TEST_BENCH_BENCH_COMMON_H_
@@ -0,0 +1,250 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <benchmark/benchmark.h>
+
+#include <any>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "butil/status.h"
+#include "common/helper.h"
+#include "coprocessor/aggregation_manager.h"
+#include "coprocessor/coprocessor.h"
+#include "coprocessor/utils.h"
+#include "proto/common.pb.h"
+#include "proto/store.pb.h"
+#include "serial/record_encoder.h"
+#include "serial/schema/base_schema.h"
+
+namespace dingodb::bench {
+
+static const std::string kCoprocessorCf = "default";
+static const int64_t kCoprocessorCommonId = 1001;
+static const int64_t kCoprocessorRowNum = 100000;
+static const int32_t kCoprocessorGroupNum = 64;
+
+static void AddSchema(pb::store::Coprocessor::SchemaWrapper* wrapper, pb::store::Schema::Type type, bool is_key,
+                      int index) {
+  auto* schema = wrapper->add_schema();
+  schema->set_type(type);
+  schema->set_is_key(is_key);
+  schema->set_is_nullable(true);
+  schema->set_index(index);
+}
+
+// Table (id bigint key, grp int, amount bigint, price double, name varchar).
+static void FillOriginalSchema(pb::store::Coprocessor::SchemaWrapper* wrapper) {
+  wrapper->set_common_id(kCoprocessorCommonId);
+  AddSchema(wrapper, pb::store::Schema::LONG, true, 0);
+  AddSchema(wrapper, pb::store::Schema::INTEGER, false, 1);
+  AddSchema(wrapper, pb::store::Schema::LONG, false, 2);
+  AddSchema(wrapper, pb::store::Schema::DOUBLE, false, 3);
+  AddSchema(wrapper, pb::store::Schema::STRING, false, 4);
+}
+
+// Write table rows once, coprocessor benchmarks scan all of them.
+static bool PrepareTable() {
+  static bool prepared = [] {
+    auto engine = GetEngine();
+    if (engine == nullptr) {
+      return false;
+    }
+
+    pb::store::Coprocessor pb_coprocessor;
+    FillOriginalSchema(pb_coprocessor.mutable_original_schema());
+    auto schemas = std::make_shared<std::vector<std::shared_ptr<BaseSchema>>>();
+    if (!Utils::TransToSerialSchema(pb_coprocessor.original_schema().schema(), &schemas).ok()) {
+      return false;
+    }
+
+    ResetRng();
+    RecordEncoder encoder(1, schemas, kCoprocessorCommonId);
+    auto writer = engine->NewWriter(kCoprocessorCf);
+    std::vector<pb::common::KeyValue> kvs;
+    for (int64_t i = 0; i < kCoprocessorRowNum; ++i) {
+      std::vector<std::any> record = {
+          std::optional<int64_t>(i),
+          std::optional<int32_t>(static_cast<int32_t>(Rng()() % kCoprocessorGroupNum)),
+          std::optional<int64_t>(static_cast<int64_t>(Rng()() % 10000)),
+          std::optional<double>(static_cast<double>(Rng()() % 100000) / 100),
+          std::optional<std::shared_ptr<std::string>>(std::make_shared<std::string>(GenRandomString(16)))};
+
+      pb::common::KeyValue kv;
+      encoder.Encode(record, kv);
+      kvs.push_back(std::move(kv));
+      if (kvs.size() >= 1024) {
+        writer->KvBatchPut(kvs);
+        kvs.clear();
+      }
+    }
+    if (!kvs.empty()) {
+      writer->KvBatchPut(kvs);
+    }
+
+    return true;
+  }();
+
+  return prepared;
+}
+
+static void RunCoprocessor(benchmark::State& state, const pb::store::Coprocessor& pb_coprocessor) {
+  if (!PrepareTable()) {
+    state.SkipWithError("prepare table failed");
+    return;
+  }
+
+  auto schemas = std::make_shared<std::vector<std::shared_ptr<BaseSchema>>>();
+  Utils::TransToSerialSchema(pb_coprocessor.original_schema().schema(), &schemas);
+  RecordEncoder encoder(1, schemas, kCoprocessorCommonId);
+  std::string min_key;
+  std::string max_key;
+  encoder.EncodeMinKeyPrefix(min_key);
+  encoder.EncodeMaxKeyPrefix(max_key);
+
+  auto reader = GetEngine()->NewReader(kCoprocessorCf);
+  int64_t rows = 0;
+  for (auto _ : state) {
+    // Open per scan, aggregation state is kept in coprocessor.
+    Coprocessor coprocessor;
+    auto status = coprocessor.Open(pb_coprocessor);
+    if (!status.ok()) {
+      state.SkipWithError(status.error_cstr());
+      return;
+    }
+
+    auto iter = reader->NewIterator(min_key, max_key);
+    iter->Start();
+    std::vector<pb::common::KeyValue> kvs;
+    for (;;) {
+      kvs.clear();
+      coprocessor.Execute(iter, false, 1024, UINT64_MAX, &kvs);
+      if (kvs.empty()) {
+        break;
+      }
+      rows += kvs.size();
+    }
+    coprocessor.Close();
+  }
+
+  state.SetItemsProcessed(state.iterations() * kCoprocessorRowNum);
+  state.counters["result_rows"] = benchmark::Counter(rows, benchmark::Counter::kAvgIterations);
+}
+
+static void BM_CoprocessorSelection(benchmark::State& state) {
+  pb::store::Coprocessor pb_coprocessor;
+  pb_coprocessor.set_schema_version(1);
+  FillOriginalSchema(pb_coprocessor.mutable_original_schema());
+  FillOriginalSchema(pb_coprocessor.mutable_result_schema());
+
+  RunCoprocessor(state, pb_coprocessor);
+}
+BENCHMARK(BM_CoprocessorSelection)->Unit(benchmark::kMillisecond);
+
+// select grp, sum(amount), count(amount), max(price) group by grp
+static void BM_CoprocessorAggregation(benchmark::State& state) {
+  pb::store::Coprocessor pb_coprocessor;
+  pb_coprocessor.set_schema_version(1);
+  FillOriginalSchema(pb_coprocessor.mutable_original_schema());
+  pb_coprocessor.add_group_by_columns(1);
+
+  auto* sum = pb_coprocessor.add_aggregation_operators();
+  sum->set_oper(pb::store::AggregationType::SUM);
+  sum->set_index_of_column(2);
+  auto* count = pb_coprocessor.add_aggregation_operators();
+  count->set_oper(pb::store::AggregationType::COUNT);
+  count->set_index_of_column(2);
+  auto* max = pb_coprocessor.add_aggregation_operators();
+  max->set_oper(pb::store::AggregationType::MAX);
+  max->set_index_of_column(3);
+
+  auto* result_schema = pb_coprocessor.mutable_result_schema();
+  result_schema->set_common_id(kCoprocessorCommonId);
+  AddSchema(result_schema, pb::store::Schema::INTEGER, true, 0);
+  AddSchema(result_schema, pb::store::Schema::LONG, false, 1);
+  AddSchema(result_schema, pb::store::Schema::LONG, false, 2);
+  AddSchema(result_schema, pb::store::Schema::DOUBLE, false, 3);
+
+  RunCoprocessor(state, pb_coprocessor);
+}
+BENCHMARK(BM_CoprocessorAggregation)->Unit(benchmark::kMillisecond);
+
+// Aggregate kAggregationRowNum records into range(0) groups.
+static void BM_AggregationManagerGroupBy(benchmark::State& state) {
+  static const size_t kAggregationRowNum = 100000;
+
+  google::protobuf::RepeatedPtrField<pb::store::Schema> operator_schemas;
+  google::protobuf::RepeatedPtrField<pb::store::Schema> result_schemas;
+  auto add_schema = [](google::protobuf::RepeatedPtrField<pb::store::Schema>* schemas, pb::store::Schema::Type type,
+                       bool is_key) {
+    auto* schema = schemas->Add();
+    schema->set_type(type);
+    schema->set_is_key(is_key);
+    schema->set_is_nullable(true);
+    schema->set_index(schemas->size() - 1);
+  };
+  add_schema(&operator_schemas, pb::store::Schema::LONG, false);
+  add_schema(&operator_schemas, pb::store::Schema::LONG, false);
+  add_schema(&operator_schemas, pb::store::Schema::DOUBLE, false);
+  add_schema(&result_schemas, pb::store::Schema::INTEGER, true);
+  add_schema(&result_schemas, pb::store::Schema::LONG, false);
+  add_schema(&result_schemas, pb::store::Schema::LONG, false);
+  add_schema(&result_schemas, pb::store::Schema::DOUBLE, false);
+
+  auto operator_serial_schemas = std::make_shared<std::vector<std::shared_ptr<BaseSchema>>>();
+  auto result_serial_schemas = std::make_shared<std::vector<std::shared_ptr<BaseSchema>>>();
+  Utils::TransToSerialSchema(operator_schemas, &operator_serial_schemas);
+  Utils::TransToSerialSchema(result_schemas, &result_serial_schemas);
+
+  google::protobuf::RepeatedPtrField<pb::store::AggregationOperator> aggregation_operators;
+  for (auto oper : {pb::store::AggregationType::SUM, pb::store::AggregationType::COUNT,
+                    pb::store::AggregationType::MAX}) {
+    auto* aggregation_operator = aggregation_operators.Add();
+    aggregation_operator->set_oper(oper);
+    aggregation_operator->set_index_of_column(aggregation_operators.size() - 1);
+  }
+
+  ResetRng();
+  std::vector<std::string> group_keys(kAggregationRowNum);
+  std::vector<std::vector<std::any>> records(kAggregationRowNum);
+  for (size_t i = 0; i < kAggregationRowNum; ++i) {
+    group_keys[i] = GenKey("g", Rng()() % state.range(0));
+    auto amount = static_cast<int64_t>(Rng()() % 10000);
+    records[i] = {std::optional<int64_t>(amount), std::optional<int64_t>(amount),
+                  std::optional<double>(static_cast<double>(Rng()() % 100000) / 100)};
+  }
+
+  for (auto _ : state) {
+    AggregationManager aggregation_manager;
+    auto status = aggregation_manager.Open(operator_serial_schemas, aggregation_operators, result_serial_schemas);
+    if (!status.ok()) {
+      state.SkipWithError(status.error_cstr());
+      return;
+    }
+    for (size_t i = 0; i < kAggregationRowNum; ++i) {
+      aggregation_manager.Execute(group_keys[i], records[i]);
+    }
+    benchmark::DoNotOptimize(aggregation_manager.CreateIterator());
+    aggregation_manager.Close();
+  }
+
+  state.SetItemsProcessed(state.iterations() * kAggregationRowNum);
+}
+BENCHMARK(BM_AggregationManagerGroupBy)->Arg(16)->Arg(1024)->Arg(65536)->ArgName("groups")->Unit(
+    benchmark::kMillisecond);
+
+}  // namespace dingodb::bench
@@ -0,0 +1,82 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "codec.h"
+#include "runner.h"
+
+namespace dingodb::bench {
+
+struct ExprCase {
+  const char* name;
+  // Encoded expression in hex, same as test/expr/test_expr.cc.
+  const char* code;
+  expr::Tuple tuple;
+};
+
+static const std::vector<ExprCase>& ExprCases() {
+  static const std::vector<ExprCase> kCases = {
+      {"const_add_int32", "110111018301", {}},
+      {"var_add_int32", "310031018301", {expr::wrap<int32_t>(1), expr::wrap<int32_t>(2)}},
+      {"var_add_int64", "320032018302", {expr::wrap<int64_t>(35), expr::wrap<int64_t>(46)}},
+      {"var_add_double", "350035018305", {expr::wrap<double>(3.5), expr::wrap<double>(4.6)}},
+      {"var_compare_cast", "3501128080808008f0529505", {expr::wrap<double>(3.5), expr::wrap<double>(4.6)}},
+      {"const_logic", "110711088301110E930111061105950152", {}},
+  };
+  return kCases;
+}
+
+static std::vector<expr::byte> DecodeHex(const std::string& hex) {
+  std::vector<expr::byte> code(hex.size() / 2);
+  expr::HexToBytes(code.data(), hex.data(), hex.size());
+  return code;
+}
+
+static void BM_ExprDecode(benchmark::State& state) {
+  const auto& expr_case = ExprCases()[state.range(0)];
+  auto code = DecodeHex(expr_case.code);
+
+  for (auto _ : state) {
+    expr::Runner runner;
+    runner.Decode(code.data(), code.size());
+    benchmark::DoNotOptimize(runner);
+  }
+
+  state.SetLabel(expr_case.name);
+}
+BENCHMARK(BM_ExprDecode)->DenseRange(0, 5)->ArgName("case");
+
+static void BM_ExprRun(benchmark::State& state) {
+  const auto& expr_case = ExprCases()[state.range(0)];
+  auto code = DecodeHex(expr_case.code);
+  expr::Runner runner;
+  runner.Decode(code.data(), code.size());
+
+  const expr::Tuple* tuple = expr_case.tuple.empty() ? nullptr : &expr_case.tuple;
+  for (auto _ : state) {
+    auto result = runner.RunAny(tuple);
+    benchmark::DoNotOptimize(result);
+  }
+
+  state.SetLabel(expr_case.name);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ExprRun)->DenseRange(0, 5)->ArgName("case");
+
+}  // namespace dingodb::bench
@@ -0,0 +1,171 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "proto/common.pb.h"
+
+namespace dingodb::bench {
+
+// Raw engine benchmarks use meta cf, not mix with coprocessor table in default cf.
+static const std::string kRawEngineCf = "meta";
+static const std::string kPreparedKeyPrefix = "bench_kv_";
+static const std::string kPutKeyPrefix = "bench_put_";
+static const uint64_t kPreparedKeyNum = 100000;
+static const size_t kValueSize = 256;
+
+static bool PrepareKvs() {
+  static bool prepared = [] {
+    auto engine = GetEngine();
+    if (engine == nullptr) {
+      return false;
+    }
+
+    ResetRng();
+    auto writer = engine->NewWriter(kRawEngineCf);
+    std::vector<pb::common::KeyValue> kvs;
+    for (uint64_t i = 0; i < kPreparedKeyNum; ++i) {
+      pb::common::KeyValue kv;
+      kv.set_key(GenKey(kPreparedKeyPrefix, i));
+      kv.set_value(GenRandomString(kValueSize));
+      kvs.push_back(std::move(kv));
+      if (kvs.size() >= 1024) {
+        writer->KvBatchPut(kvs);
+        kvs.clear();
+      }
+    }
+    if (!kvs.empty()) {
+      writer->KvBatchPut(kvs);
+    }
+
+    return true;
+  }();
+
+  return prepared;
+}
+
+static void BM_RawEnginePut(benchmark::State& state) {
+  auto engine = GetEngine();
+  if (engine == nullptr) {
+    state.SkipWithError("engine init failed");
+    return;
+  }
+
+  ResetRng();
+  auto writer = engine->NewWriter(kRawEngineCf);
+  std::string value = GenRandomString(kValueSize);
+  uint64_t i = 0;
+  pb::common::KeyValue kv;
+  for (auto _ : state) {
+    kv.set_key(GenKey(kPutKeyPrefix, i++));
+    kv.set_value(value);
+    writer->KvPut(kv);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * kValueSize);
+}
+BENCHMARK(BM_RawEnginePut);
+
+static void BM_RawEngineBatchPut(benchmark::State& state) {
+  auto engine = GetEngine();
+  if (engine == nullptr) {
+    state.SkipWithError("engine init failed");
+    return;
+  }
+
+  ResetRng();
+  auto writer = engine->NewWriter(kRawEngineCf);
+  std::string value = GenRandomString(kValueSize);
+  uint64_t i = 0;
+  std::vector<pb::common::KeyValue> kvs(state.range(0));
+  for (auto _ : state) {
+    for (auto& kv : kvs) {
+      kv.set_key(GenKey(kPutKeyPrefix, i++));
+      kv.set_value(value);
+    }
+    writer->KvBatchPut(kvs);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * state.range(0) * kValueSize);
+}
+BENCHMARK(BM_RawEngineBatchPut)->Arg(16)->Arg(256)->ArgName("batch");
+
+static void BM_RawEngineGet(benchmark::State& state) {
+  if (!PrepareKvs()) {
+    state.SkipWithError("prepare kvs failed");
+    return;
+  }
+
+  auto reader = GetEngine()->NewReader(kRawEngineCf);
+  std::mt19937 rng(kBenchSeed);
+  std::string value;
+  for (auto _ : state) {
+    reader->KvGet(GenKey(kPreparedKeyPrefix, rng() % kPreparedKeyNum), value);
+    benchmark::DoNotOptimize(value);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RawEngineGet);
+
+// Scan range(0) continuous keys from a random start.
+static void BM_RawEngineScan(benchmark::State& state) {
+  if (!PrepareKvs()) {
+    state.SkipWithError("prepare kvs failed");
+    return;
+  }
+
+  auto reader = GetEngine()->NewReader(kRawEngineCf);
+  std::mt19937 rng(kBenchSeed);
+  uint64_t scan_num = state.range(0);
+  std::vector<pb::common::KeyValue> kvs;
+  for (auto _ : state) {
+    uint64_t start = rng() % (kPreparedKeyNum - scan_num);
+    kvs.clear();
+    reader->KvScan(GenKey(kPreparedKeyPrefix, start), GenKey(kPreparedKeyPrefix, start + scan_num), kvs);
+    benchmark::DoNotOptimize(kvs);
+  }
+
+  state.SetItemsProcessed(state.iterations() * scan_num);
+}
+BENCHMARK(BM_RawEngineScan)->Arg(10)->Arg(100)->Arg(1000)->ArgName("keys");
+
+static void BM_RawEngineKvCount(benchmark::State& state) {
+  if (!PrepareKvs()) {
+    state.SkipWithError("prepare kvs failed");
+    return;
+  }
+
+  auto reader = GetEngine()->NewReader(kRawEngineCf);
+  std::mt19937 rng(kBenchSeed);
+  uint64_t count_num = state.range(0);
+  for (auto _ : state) {
+    uint64_t start = rng() % (kPreparedKeyNum - count_num);
+    uint64_t count = 0;
+    reader->KvCount(GenKey(kPreparedKeyPrefix, start), GenKey(kPreparedKeyPrefix, start + count_num), count);
+    benchmark::DoNotOptimize(count);
+  }
+
+  state.SetItemsProcessed(state.iterations() * count_num);
+}
+BENCHMARK(BM_RawEngineKvCount)->Arg(1000)->Arg(50000)->ArgName("keys");
+
+}  // namespace dingodb::bench
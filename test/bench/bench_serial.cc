@@ -0,0 +1,194 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <benchmark/benchmark.h>
+
+#include <any>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "serial/record_decoder.h"
+#include "serial/record_encoder.h"
+#include "serial/schema/base_schema.h"
+
+namespace dingodb::bench {
+
+static const int kSerialColumnNum = 8;
+static const int kSerialKeyColumnNum = 2;
+static const size_t kSerialRecordNum = 1024;
+
+template <typename T>
+static std::shared_ptr<BaseSchema> NewSchema(int index) {
+  auto schema = std::make_shared<DingoSchema<std::optional<T>>>();
+  schema->SetIndex(index);
+  schema->SetAllowNull(true);
+  schema->SetIsKey(index < kSerialKeyColumnNum);
+  return schema;
+}
+
+// All columns are the given type, the first kSerialKeyColumnNum columns are key.
+static std::shared_ptr<std::vector<std::shared_ptr<BaseSchema>>> GenSchemas(BaseSchema::Type type) {
+  auto schemas = std::make_shared<std::vector<std::shared_ptr<BaseSchema>>>();
+  for (int i = 0; i < kSerialColumnNum; ++i) {
+    switch (type) {
+      case BaseSchema::kBool:
+        schemas->push_back(NewSchema<bool>(i));
+        break;
+      case BaseSchema::kInteger:
+        schemas->push_back(NewSchema<int32_t>(i));
+        break;
+      case BaseSchema::kFloat:
+        schemas->push_back(NewSchema<float>(i));
+        break;
+      case BaseSchema::kLong:
+        schemas->push_back(NewSchema<int64_t>(i));
+        break;
+      case BaseSchema::kDouble:
+        schemas->push_back(NewSchema<double>(i));
+        break;
+      case BaseSchema::kString:
+        schemas->push_back(NewSchema<std::shared_ptr<std::string>>(i));
+        break;
+    }
+  }
+
+  return schemas;
+}
+
+static std::any GenValue(BaseSchema::Type type) {
+  auto& rng = Rng();
+  switch (type) {
+    case BaseSchema::kBool:
+      return std::optional<bool>(rng() % 2 == 0);
+    case BaseSchema::kInteger:
+      return std::optional<int32_t>(static_cast<int32_t>(rng()));
+    case BaseSchema::kFloat:
+      return std::optional<float>(std::uniform_real_distribution<float>(-1e6, 1e6)(rng));
+    case BaseSchema::kLong:
+      return std::optional<int64_t>((static_cast<int64_t>(rng()) << 32) | rng());
+    case BaseSchema::kDouble:
+      return std::optional<double>(std::uniform_real_distribution<double>(-1e9, 1e9)(rng));
+    case BaseSchema::kString:
+      return std::optional<std::shared_ptr<std::string>>(std::make_shared<std::string>(GenRandomString(32)));
+  }
+
+  return {};
+}
+
+static std::vector<std::vector<std::any>> GenRecords(BaseSchema::Type type) {
+  ResetRng();
+  std::vector<std::vector<std::any>> records(kSerialRecordNum);
+  for (auto& record : records) {
+    record.reserve(kSerialColumnNum);
+    for (int i = 0; i < kSerialColumnNum; ++i) {
+      record.push_back(GenValue(type));
+    }
+  }
+
+  return records;
+}
+
+static void BM_RecordEncode(benchmark::State& state) {
+  auto type = static_cast<BaseSchema::Type>(state.range(0));
+  auto records = GenRecords(type);
+  RecordEncoder encoder(1, GenSchemas(type), 1);
+
+  size_t i = 0;
+  std::string key;
+  std::string value;
+  for (auto _ : state) {
+    encoder.Encode(records[i++ % records.size()], key, value);
+    benchmark::DoNotOptimize(key);
+    benchmark::DoNotOptimize(value);
+  }
+
+  state.SetLabel(BaseSchema::GetTypeString(type));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RecordEncode)->DenseRange(BaseSchema::kBool, BaseSchema::kString)->ArgName("type");
+
+static void BM_RecordEncodeBatch(benchmark::State& state) {
+  auto type = static_cast<BaseSchema::Type>(state.range(0));
+  auto records = GenRecords(type);
+  RecordEncoder encoder(1, GenSchemas(type), 1);
+
+  RecordBatch batch;
+  for (auto _ : state) {
+    batch.Clear();
+    encoder.EncodeBatch(records, batch);
+    benchmark::DoNotOptimize(batch.arena);
+  }
+
+  state.SetLabel(BaseSchema::GetTypeString(type));
+  state.SetItemsProcessed(state.iterations() * records.size());
+}
+BENCHMARK(BM_RecordEncodeBatch)->DenseRange(BaseSchema::kBool, BaseSchema::kString)->ArgName("type");
+
+static void BM_RecordDecode(benchmark::State& state) {
+  auto type = static_cast<BaseSchema::Type>(state.range(0));
+  auto schemas = GenSchemas(type);
+  auto records = GenRecords(type);
+  RecordEncoder encoder(1, schemas, 1);
+  RecordDecoder decoder(1, schemas, 1);
+
+  std::vector<pb::common::KeyValue> kvs(records.size());
+  for (size_t i = 0; i < records.size(); ++i) {
+    encoder.Encode(records[i], kvs[i]);
+  }
+
+  size_t i = 0;
+  std::vector<std::any> record;
+  for (auto _ : state) {
+    record.clear();
+    decoder.Decode(kvs[i++ % kvs.size()], record);
+    benchmark::DoNotOptimize(record);
+  }
+
+  state.SetLabel(BaseSchema::GetTypeString(type));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RecordDecode)->DenseRange(BaseSchema::kBool, BaseSchema::kString)->ArgName("type");
+
+// Decode only part of columns, the common case of coprocessor selection.
+static void BM_RecordDecodeColumns(benchmark::State& state) {
+  auto type = static_cast<BaseSchema::Type>(state.range(0));
+  auto schemas = GenSchemas(type);
+  auto records = GenRecords(type);
+  RecordEncoder encoder(1, schemas, 1);
+  RecordDecoder decoder(1, schemas, 1);
+
+  std::vector<pb::common::KeyValue> kvs(records.size());
+  for (size_t i = 0; i < records.size(); ++i) {
+    encoder.Encode(records[i], kvs[i]);
+  }
+  std::vector<int> column_indexes = {0, kSerialKeyColumnNum, kSerialColumnNum - 1};
+
+  size_t i = 0;
+  std::vector<std::any> record;
+  for (auto _ : state) {
+    record.clear();
+    decoder.Decode(kvs[i++ % kvs.size()], column_indexes, record);
+    benchmark::DoNotOptimize(record);
+  }
+
+  state.SetLabel(BaseSchema::GetTypeString(type));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RecordDecodeColumns)->DenseRange(BaseSchema::kBool, BaseSchema::kString)->ArgName("type");
+
+}  // namespace dingodb::bench
@@ -0,0 +1,104 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "proto/common.pb.h"
+#include "vector/vector_index.h"
+
+namespace dingodb::bench {
+
+static const uint32_t kVectorNum = 10000;
+static const uint32_t kVectorTopk = 10;
+
+static std::shared_ptr<VectorIndex> NewHnswIndex(uint32_t dimension, pb::common::VectorIndexType type) {
+  pb::common::IndexParameter index_parameter;
+  index_parameter.set_index_type(pb::common::IndexType::INDEX_TYPE_VECTOR);
+  auto* vector_index_parameter = index_parameter.mutable_vector_index_parameter();
+  vector_index_parameter->set_vector_index_type(type);
+  auto* hnsw_parameter = vector_index_parameter->mutable_hnsw_parameter();
+  hnsw_parameter->set_dimension(dimension);
+  hnsw_parameter->set_metric_type(pb::common::MetricType::METRIC_TYPE_L2);
+  hnsw_parameter->set_efconstruction(200);
+  hnsw_parameter->set_max_elements(kVectorNum);
+  hnsw_parameter->set_nlinks(32);
+
+  return VectorIndex::New(1, index_parameter);
+}
+
+static std::vector<std::vector<float>> GenVectors(uint32_t num, uint32_t dimension) {
+  ResetRng();
+  std::uniform_real_distribution<float> distrib(0.0F, 1.0F);
+  std::vector<std::vector<float>> vectors(num);
+  for (auto& vector : vectors) {
+    vector.resize(dimension);
+    for (auto& value : vector) {
+      value = distrib(Rng());
+    }
+  }
+
+  return vectors;
+}
+
+static pb::common::VectorIndexType VectorIndexTypeOf(int64_t arg) {
+  return arg == 0 ? pb::common::VectorIndexType::VECTOR_INDEX_TYPE_HNSW
+                  : pb::common::VectorIndexType::VECTOR_INDEX_TYPE_HNSW_SQ8;
+}
+
+// Build index of kVectorNum vectors, args: dimension, quantized.
+static void BM_VectorIndexAdd(benchmark::State& state) {
+  uint32_t dimension = state.range(0);
+  auto vectors = GenVectors(kVectorNum, dimension);
+
+  for (auto _ : state) {
+    auto index = NewHnswIndex(dimension, VectorIndexTypeOf(state.range(1)));
+    for (uint32_t i = 0; i < kVectorNum; ++i) {
+      index->Add(i + 1, vectors[i]);
+    }
+    benchmark::DoNotOptimize(index);
+  }
+
+  state.SetItemsProcessed(state.iterations() * kVectorNum);
+}
+BENCHMARK(BM_VectorIndexAdd)
+    ->ArgsProduct({{64, 256}, {0, 1}})
+    ->ArgNames({"dimension", "sq8"})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_VectorIndexSearch(benchmark::State& state) {
+  uint32_t dimension = state.range(0);
+  auto vectors = GenVectors(kVectorNum, dimension);
+  auto index = NewHnswIndex(dimension, VectorIndexTypeOf(state.range(1)));
+  for (uint32_t i = 0; i < kVectorNum; ++i) {
+    index->Add(i + 1, vectors[i]);
+  }
+
+  size_t i = 0;
+  std::vector<pb::common::VectorWithDistance> results;
+  for (auto _ : state) {
+    results.clear();
+    index->Search(vectors[i++ % vectors.size()], kVectorTopk, results);
+    benchmark::DoNotOptimize(results);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VectorIndexSearch)->ArgsProduct({{64, 256}, {0, 1}})->ArgNames({"dimension", "sq8"});
+
+}  // namespace dingodb::bench
@@ -0,0 +1,245 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "butil/status.h"
+#include "common/context.h"
+#include "coordinator/auto_increment_control.h"
+#include "engine/engine.h"
+#include "engine/write_data.h"
+#include "gflags/gflags.h"
+#include "proto/coordinator_internal.pb.h"
+
+namespace dingodb {
+DECLARE_uint32(auto_increment_segment_size);
+}  // namespace dingodb
+
+static const std::string kAutoIncrementFile = "./auto_increment_control_test";
+
+static void AddElement(dingodb::pb::coordinator_internal::AutoIncrementStorage* storage, uint64_t table_id,
+                       uint64_t start_id) {
+  auto* element = storage->add_elements();
+  element->set_table_id(table_id);
+  element->set_start_id(start_id);
+}
+
+TEST(AutoIncrementControlTest, LoadMetaFromLegacySnapshotFile) {
+  dingodb::pb::coordinator_internal::MetaSnapshotFile meta_snapshot_file;
+  auto* storage = meta_snapshot_file.mutable_auto_increment_storage();
+  AddElement(storage, 1001, 1);
+  AddElement(storage, 1002, 500);
+  AddElement(storage, 1003, 1001);
+
+  dingodb::AutoIncrementControl control;
+  ASSERT_TRUE(control.LoadMetaFromSnapshotFile(meta_snapshot_file));
+
+  uint64_t start_id = 0;
+  ASSERT_TRUE(control.GetAutoIncrement(1001, start_id).ok());
+  EXPECT_EQ(1, start_id);
+  ASSERT_TRUE(control.GetAutoIncrement(1002, start_id).ok());
+  EXPECT_EQ(500, start_id);
+  ASSERT_TRUE(control.GetAutoIncrement(1003, start_id).ok());
+  EXPECT_EQ(1001, start_id);
+  EXPECT_FALSE(control.GetAutoIncrement(1, start_id).ok());
+
+  // Save the loaded meta to snapshot file again, it should be the same.
+  dingodb::pb::coordinator_internal::MetaSnapshotFile saved_snapshot_file;
+  ASSERT_TRUE(control.LoadMetaToSnapshotFile(control.PrepareRaftSnapshot(), saved_snapshot_file));
+  EXPECT_EQ(3, saved_snapshot_file.auto_increment_storage().elements_size());
+  for (const auto& element : saved_snapshot_file.auto_increment_storage().elements()) {
+    ASSERT_TRUE(control.GetAutoIncrement(element.table_id(), start_id).ok());
+    EXPECT_EQ(start_id, element.start_id());
+  }
+}
+
+TEST(AutoIncrementControlTest, LoadAutoIncrement) {
+  dingodb::pb::coordinator_internal::AutoIncrementStorage storage;
+  AddElement(&storage, 2001, 10);
+  AddElement(&storage, 2002, 3000);
+  {
+    std::ofstream file(kAutoIncrementFile, std::ios::binary | std::ios::trunc);
+    file << storage.SerializeAsString();
+  }
+
+  dingodb::AutoIncrementControl control;
+  ASSERT_EQ(0, control.LoadAutoIncrement(kAutoIncrementFile));
+  std::remove(kAutoIncrementFile.c_str());
+
+  uint64_t start_id = 0;
+  ASSERT_TRUE(control.GetAutoIncrement(2001, start_id).ok());
+  EXPECT_EQ(10, start_id);
+  ASSERT_TRUE(control.GetAutoIncrement(2002, start_id).ok());
+  EXPECT_EQ(3000, start_id);
+}
+
+// Apply the meta increment at once as leader instead of propose it.
+class ApplyEngine : public dingodb::Engine {
+ public:
+  explicit ApplyEngine(dingodb::AutoIncrementControl* control) : control(control) {}
+
+  bool Init(std::shared_ptr<dingodb::Config> /*config*/) override { return true; }
+  std::string GetName() override { return "APPLY_ENGINE"; }
+  dingodb::pb::common::Engine GetID() override { return dingodb::pb::common::ENG_RAFT_STORE; }
+  std::shared_ptr<dingodb::Snapshot> GetSnapshot() override { return nullptr; }
+  butil::Status DoSnapshot(std::shared_ptr<dingodb::Context> /*ctx*/, uint64_t /*region_id*/) override {
+    return butil::Status();
+  }
+  butil::Status Write(std::shared_ptr<dingodb::Context> /*ctx*/,
+                      std::shared_ptr<dingodb::WriteData> write_data) override {
+    ++write_count;
+    for (auto& datum : write_data->Datums()) {
+      auto meta_datum = std::dynamic_pointer_cast<dingodb::MetaPutDatum>(datum);
+      control->ApplyMetaIncrement(meta_datum->meta_increment, true, 1, write_count, nullptr);
+    }
+    return butil::Status();
+  }
+  butil::Status AsyncWrite(std::shared_ptr<dingodb::Context> ctx,
+                           std::shared_ptr<dingodb::WriteData> write_data) override {
+    return Write(ctx, write_data);
+  }
+  butil::Status AsyncWrite(std::shared_ptr<dingodb::Context> ctx, std::shared_ptr<dingodb::WriteData> write_data,
+                           dingodb::WriteCbFunc /*cb*/) override {
+    return Write(ctx, write_data);
+  }
+  std::shared_ptr<dingodb::Reader> NewReader(const std::string& /*cf_name*/) override { return nullptr; }
+
+  dingodb::AutoIncrementControl* control;
+  uint64_t write_count = 0;
+};
+
+class AutoIncrementSegmentTest : public testing::Test {
+ protected:
+  static constexpr uint64_t kTableId = 3001;
+
+  void SetUp() override {
+    dingodb::FLAGS_auto_increment_segment_size = 100;
+    engine = std::make_shared<ApplyEngine>(&control);
+    control.SetKvEngine(engine);
+
+    dingodb::pb::coordinator_internal::MetaIncrement meta_increment;
+    ASSERT_TRUE(control.CreateAutoIncrement(kTableId, 1, meta_increment).ok());
+    control.ApplyMetaIncrement(meta_increment, true, 1, 1, nullptr);
+  }
+
+  void TearDown() override { dingodb::FLAGS_auto_increment_segment_size = 10000; }
+
+  dingodb::AutoIncrementControl control;
+  std::shared_ptr<ApplyEngine> engine;
+};
+
+TEST_F(AutoIncrementSegmentTest, CanGenerateFromSegment) {
+  EXPECT_TRUE(control.CanGenerateFromSegment(10, 1));
+  EXPECT_TRUE(control.CanGenerateFromSegment(49, 2));
+  // Exceed segment size.
+  EXPECT_FALSE(control.CanGenerateFromSegment(100, 1));
+  EXPECT_FALSE(control.CanGenerateFromSegment(50, 2));
+
+  dingodb::FLAGS_auto_increment_segment_size = 0;
+  EXPECT_FALSE(control.CanGenerateFromSegment(10, 1));
+
+  dingodb::AutoIncrementControl no_engine_control;
+  dingodb::FLAGS_auto_increment_segment_size = 100;
+  EXPECT_FALSE(no_engine_control.CanGenerateFromSegment(10, 1));
+}
+
+TEST_F(AutoIncrementSegmentTest, Generate) {
+  uint64_t start_id = 0;
+  uint64_t end_id = 0;
+  ASSERT_TRUE(control.GenerateAutoIncrementFromSegment(kTableId, 10, 1, 1, start_id, end_id).ok());
+  EXPECT_EQ(1, start_id);
+  EXPECT_EQ(11, end_id);
+  EXPECT_EQ(1, engine->write_count);
+
+  // The whole segment is reserved in one write.
+  uint64_t map_start_id = 0;
+  ASSERT_TRUE(control.GetAutoIncrement(kTableId, map_start_id).ok());
+  EXPECT_EQ(101, map_start_id);
+
+  // Served from segment without write.
+  for (uint64_t i = 1; i < 9; ++i) {
+    ASSERT_TRUE(control.GenerateAutoIncrementFromSegment(kTableId, 10, 1, 1, start_id, end_id).ok());
+    EXPECT_EQ(1 + i * 10, start_id);
+    EXPECT_EQ(11 + i * 10, end_id);
+  }
+  EXPECT_EQ(1, engine->write_count);
+
+  // Ids never be generated twice.
+  uint64_t last_end_id = end_id;
+  ASSERT_TRUE(control.GenerateAutoIncrementFromSegment(kTableId, 10, 2, 1, start_id, end_id).ok());
+  EXPECT_GE(start_id, last_end_id);
+  EXPECT_EQ(start_id + 20, end_id);
+}
+
+TEST_F(AutoIncrementSegmentTest, ContinueSegment) {
+  uint64_t start_id = 0;
+  uint64_t end_id = 0;
+  ASSERT_TRUE(control.GenerateAutoIncrementFromSegment(kTableId, 95, 1, 1, start_id, end_id).ok());
+  EXPECT_EQ(1, start_id);
+  EXPECT_EQ(96, end_id);
+
+  // The next segment follow current one, the remainder [96, 101) is kept.
+  ASSERT_TRUE(control.GenerateAutoIncrementFromSegment(kTableId, 10, 1, 1, start_id, end_id).ok());
+  EXPECT_EQ(96, start_id);
+  EXPECT_EQ(106, end_id);
+  EXPECT_EQ(2, engine->write_count);
+}
+
+TEST_F(AutoIncrementSegmentTest, ResetSegment) {
+  uint64_t start_id = 0;
+  uint64_t end_id = 0;
+  ASSERT_TRUE(control.GenerateAutoIncrementFromSegment(kTableId, 10, 1, 1, start_id, end_id).ok());
+  EXPECT_EQ(1, engine->write_count);
+
+  // Generate by raft write take ids after the segment, the segment is still usable.
+  dingodb::pb::coordinator_internal::MetaIncrement meta_increment;
+  ASSERT_TRUE(control.GenerateAutoIncrement(kTableId, 10, 1, 1, meta_increment).ok());
+  control.ApplyMetaIncrement(meta_increment, true, 1, 2, nullptr);
+  ASSERT_TRUE(control.GenerateAutoIncrementFromSegment(kTableId, 10, 1, 1, start_id, end_id).ok());
+  EXPECT_EQ(11, start_id);
+  EXPECT_EQ(1, engine->write_count);
+
+  // The next segment don't follow current one, so the remainder [21, 101) is dropped.
+  ASSERT_TRUE(control.GenerateAutoIncrementFromSegment(kTableId, 85, 1, 1, start_id, end_id).ok());
+  EXPECT_EQ(111, start_id);
+  EXPECT_EQ(196, end_id);
+  EXPECT_EQ(2, engine->write_count);
+
+  // Update start id drop the segment.
+  meta_increment.Clear();
+  ASSERT_TRUE(control.UpdateAutoIncrement(kTableId, 1000, false, meta_increment).ok());
+  control.ApplyMetaIncrement(meta_increment, true, 1, 3, nullptr);
+  ASSERT_TRUE(control.GenerateAutoIncrementFromSegment(kTableId, 10, 1, 1, start_id, end_id).ok());
+  EXPECT_EQ(1000, start_id);
+  EXPECT_EQ(1010, end_id);
+  EXPECT_EQ(3, engine->write_count);
+
+  // New leader reserve again.
+  control.OnLeaderStart(2);
+  ASSERT_TRUE(control.GenerateAutoIncrementFromSegment(kTableId, 10, 1, 1, start_id, end_id).ok());
+  EXPECT_EQ(1100, start_id);
+  EXPECT_EQ(4, engine->write_count);
+
+  // Deleted table can't generate.
+  meta_increment.Clear();
+  ASSERT_TRUE(control.DeleteAutoIncrement(kTableId, meta_increment).ok());
+  control.ApplyMetaIncrement(meta_increment, true, 1, 4, nullptr);
+  EXPECT_FALSE(control.GenerateAutoIncrementFromSegment(kTableId, 10, 1, 1, start_id, end_id).ok());
+  EXPECT_EQ(4, engine->write_count);
+}
@@ -0,0 +1,249 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "butil/status.h"
+#include "common/constant.h"
+#include "common/helper.h"
+#include "config/config_manager.h"
+#include "engine/raw_rocks_engine.h"
+#include "fmt/core.h"
+#include "meta/store_meta_manager.h"
+#include "proto/common.pb.h"
+#include "proto/error.pb.h"
+#include "proto/raft.pb.h"
+#include "rocksdb/options.h"
+#include "rocksdb/sst_file_writer.h"
+#include "server/server.h"
+#include "store/bulk_load_manager.h"
+
+namespace dingodb {
+
+static const std::string &kDefaultCf = Constant::kStoreDataCF;  // NOLINT
+
+class BulkLoadManagerTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    auto *server = Server::GetInstance();
+    server->SetRole(pb::common::ClusterRole::STORE);
+    server->InitConfig(kFileName);
+    server->InitDirectory();
+
+    engine = std::make_shared<RawRocksEngine>();
+    if (!engine->Init(ConfigManager::GetInstance()->GetConfig(pb::common::ClusterRole::STORE))) {
+      std::cout << "RawRocksEngine init failed" << std::endl;
+    }
+  }
+
+  static void TearDownTestSuite() {
+    engine->Close();
+    engine->Destroy();
+    Helper::RemoveFileOrDirectory(Server::GetInstance()->GetBulkLoadPath());
+  }
+
+  static store::RegionPtr BuildRegion(uint64_t region_id, const std::string &start_key, const std::string &end_key) {
+    pb::common::RegionDefinition definition;
+    definition.set_id(region_id);
+    definition.mutable_range()->set_start_key(start_key);
+    definition.mutable_range()->set_end_key(end_key);
+    return store::Region::New(definition);
+  }
+
+  // Build sst file with keys prefix + [0, count).
+  static std::string BuildSstFile(const std::string &name, const std::string &prefix, int count) {
+    std::string filepath = fmt::format("./{}", name);
+    rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), rocksdb::Options());
+    EXPECT_TRUE(writer.Open(filepath).ok());
+    for (int i = 0; i < count; ++i) {
+      EXPECT_TRUE(writer.Put(fmt::format("{}{:04}", prefix, i), fmt::format("value{}", i)).ok());
+    }
+    EXPECT_TRUE(writer.Finish().ok());
+
+    return filepath;
+  }
+
+  inline static const std::string kFileName = "../../conf/store.yaml";
+  inline static std::shared_ptr<RawRocksEngine> engine;  // NOLINT
+};
+
+TEST_F(BulkLoadManagerTest, IsValidFileName) {
+  EXPECT_TRUE(BulkLoadManager::IsValidFileName("000001.sst"));
+  EXPECT_TRUE(BulkLoadManager::IsValidFileName("a.ingest.sst"));
+
+  EXPECT_FALSE(BulkLoadManager::IsValidFileName(""));
+  EXPECT_FALSE(BulkLoadManager::IsValidFileName(".source"));
+  EXPECT_FALSE(BulkLoadManager::IsValidFileName("../000001.sst"));
+  EXPECT_FALSE(BulkLoadManager::IsValidFileName("dir/000001.sst"));
+  EXPECT_FALSE(BulkLoadManager::IsValidFileName("000001.sst.ingest"));
+}
+
+TEST_F(BulkLoadManagerTest, UploadOffset) {
+  auto *manager = BulkLoadManager::GetInstance();
+  uint64_t file_size = 0;
+
+  auto status = manager->Upload(1001, 1, "upload.sst", 0, "hello", file_size);
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ(5, file_size);
+
+  // Resend the same chunk, return uploaded size for resume.
+  status = manager->Upload(1001, 1, "upload.sst", 0, "hello", file_size);
+  EXPECT_EQ(pb::error::EILLEGAL_PARAMTETERS, status.error_code());
+  EXPECT_EQ(5, file_size);
+
+  // Gap is not allowed.
+  status = manager->Upload(1001, 1, "upload.sst", 8, "world", file_size);
+  EXPECT_EQ(pb::error::EILLEGAL_PARAMTETERS, status.error_code());
+
+  status = manager->Upload(1001, 1, "upload.sst", 5, "world", file_size);
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ(10, file_size);
+
+  status = manager->Upload(1001, 1, "../upload.sst", 0, "hello", file_size);
+  EXPECT_EQ(pb::error::EILLEGAL_PARAMTETERS, status.error_code());
+}
+
+TEST_F(BulkLoadManagerTest, ValidateFileRange) {
+  auto region = BuildRegion(1002, "b", "d");
+
+  pb::raft::IngestSstRequest request;
+  auto *file = request.add_files();
+  file->set_name("1.sst");
+  file->set_start_key("b");
+  file->set_end_key("c99");
+  EXPECT_TRUE(BulkLoadManager::ValidateFileRange(region, request).ok());
+
+  // End key of region is exclusive.
+  file->set_end_key("d");
+  EXPECT_EQ(pb::error::EKEY_OUT_OF_RANGE, BulkLoadManager::ValidateFileRange(region, request).error_code());
+
+  file->set_start_key("a");
+  file->set_end_key("c");
+  EXPECT_EQ(pb::error::EKEY_OUT_OF_RANGE, BulkLoadManager::ValidateFileRange(region, request).error_code());
+}
+
+TEST_F(BulkLoadManagerTest, Ingest) {
+  auto *manager = BulkLoadManager::GetInstance();
+  auto region = BuildRegion(1003, "bulk", "bulm");
+
+  std::string filepath = BuildSstFile("bulk_load_test.sst", "bulk", 100);
+  std::ifstream file(filepath, std::ios::binary);
+  std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  ASSERT_FALSE(data.empty());
+  Helper::RemoveFileOrDirectory(filepath);
+
+  uint64_t file_size = 0;
+  auto status = manager->Upload(region->Id(), 1, "1.sst", 0, data, file_size);
+  ASSERT_TRUE(status.ok());
+
+  pb::raft::IngestSstRequest request;
+  status = manager->PrepareIngest(region, kDefaultCf, 1, {"1.sst"}, request);
+  ASSERT_TRUE(status.ok()) << status.error_str();
+  ASSERT_EQ(1, request.files_size());
+  EXPECT_EQ("bulk0000", request.files(0).start_key());
+  EXPECT_EQ("bulk0099", request.files(0).end_key());
+  EXPECT_EQ(100, request.files(0).kv_count());
+  EXPECT_EQ(data.size(), request.files(0).size());
+
+  // Not uploaded file.
+  pb::raft::IngestSstRequest bad_request;
+  status = manager->PrepareIngest(region, kDefaultCf, 1, {"2.sst"}, bad_request);
+  EXPECT_EQ(pb::error::EILLEGAL_PARAMTETERS, status.error_code());
+
+  uint64_t kv_count = 0;
+  status = manager->Ingest(engine, region, request, kv_count);
+  ASSERT_TRUE(status.ok()) << status.error_str();
+  EXPECT_EQ(100, kv_count);
+
+  std::vector<pb::common::KeyValue> kvs;
+  status = engine->NewReader(kDefaultCf)->KvScan("bulk", "bulm", kvs);
+  EXPECT_TRUE(status.ok());
+  ASSERT_EQ(100, kvs.size());
+  EXPECT_EQ("bulk0000", kvs.front().key());
+  EXPECT_EQ("value99", kvs.back().value());
+
+  // Staging of source is kept for followers.
+  EXPECT_TRUE(std::filesystem::exists(fmt::format("{}/{}_1/1.sst", Server::GetInstance()->GetBulkLoadPath(),
+                                                  region->Id())));
+
+  // Region split after propose, every replica reject it.
+  auto split_region = BuildRegion(region->Id(), "bulk", "bulk0050");
+  status = manager->Ingest(engine, split_region, request, kv_count);
+  EXPECT_EQ(pb::error::EKEY_OUT_OF_RANGE, status.error_code());
+}
+
+TEST_F(BulkLoadManagerTest, IngestKeepStaging) {
+  auto *manager = BulkLoadManager::GetInstance();
+  auto region = BuildRegion(1005, "bulk", "bulm");
+
+  std::string filepath = BuildSstFile("bulk_load_keep_test.sst", "bulk", 10);
+  std::ifstream file(filepath, std::ios::binary);
+  std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  ASSERT_FALSE(data.empty());
+  Helper::RemoveFileOrDirectory(filepath);
+
+  // Files copied by follower, no source mark.
+  uint64_t file_size = 0;
+  ASSERT_TRUE(manager->Upload(region->Id(), 1, "1.sst", 0, data, file_size).ok());
+
+  pb::raft::IngestSstRequest request;
+  request.set_cf_name(kDefaultCf);
+  request.set_load_id(1);
+  auto *file_info = request.add_files();
+  file_info->set_name("1.sst");
+  file_info->set_size(data.size());
+  file_info->set_kv_count(10);
+  file_info->set_start_key("bulk0000");
+  file_info->set_end_key("bulk0009");
+
+  uint64_t kv_count = 0;
+  auto status = manager->Ingest(engine, region, request, kv_count);
+  ASSERT_TRUE(status.ok()) << status.error_str();
+  EXPECT_EQ(10, kv_count);
+
+  // Replay after crash before snapshot saved need the files.
+  EXPECT_TRUE(std::filesystem::exists(fmt::format("{}/{}_1/1.sst", Server::GetInstance()->GetBulkLoadPath(),
+                                                  region->Id())));
+  status = manager->Ingest(engine, region, request, kv_count);
+  EXPECT_TRUE(status.ok()) << status.error_str();
+}
+
+TEST_F(BulkLoadManagerTest, IngestNotPrepared) {
+  auto *manager = BulkLoadManager::GetInstance();
+  auto region = BuildRegion(1004, "bulk", "bulm");
+
+  pb::raft::IngestSstRequest request;
+  request.set_cf_name(kDefaultCf);
+  request.set_load_id(1);
+  auto *file = request.add_files();
+  file->set_name("1.sst");
+  file->set_size(1024);
+  file->set_start_key("bulk0000");
+  file->set_end_key("bulk0099");
+
+  // Apply never copy files, follower missed prepare must fail.
+  uint64_t kv_count = 0;
+  auto status = manager->Ingest(engine, region, request, kv_count);
+  EXPECT_EQ(pb::error::EINTERNAL, status.error_code());
+}
+
+}  // namespace dingodb
@@ -0,0 +1,215 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "config/config_manager.h"
+#include "coordinator/coordinator_control.h"
+#include "engine/raw_rocks_engine.h"
+#include "meta/meta_reader.h"
+#include "meta/meta_writer.h"
+#include "proto/common.pb.h"
+#include "proto/coordinator_internal.pb.h"
+#include "server/server.h"
+
+class CoordinatorControlTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    auto *server = dingodb::Server::GetInstance();
+    server->SetRole(dingodb::pb::common::ClusterRole::STORE);
+    server->InitConfig(kFileName);
+
+    engine = std::make_shared<dingodb::RawRocksEngine>();
+    if (!engine->Init(dingodb::ConfigManager::GetInstance()->GetConfig(dingodb::pb::common::ClusterRole::STORE))) {
+      std::cout << "RawRocksEngine init failed" << std::endl;
+    }
+
+    control = std::make_shared<dingodb::CoordinatorControl>(std::make_shared<dingodb::MetaReader>(engine),
+                                                            std::make_shared<dingodb::MetaWriter>(engine), engine);
+    ASSERT_TRUE(control->Recover());
+
+    // Add normal stores through raft apply.
+    dingodb::pb::coordinator_internal::MetaIncrement meta_increment;
+    for (uint64_t store_id = kFirstStoreId; store_id < kFirstStoreId + kStoreNum; ++store_id) {
+      auto *store_increment = meta_increment.add_stores();
+      store_increment->set_id(store_id);
+      store_increment->set_op_type(dingodb::pb::coordinator_internal::MetaIncrementOpType::CREATE);
+      auto *store = store_increment->mutable_store();
+      store->set_id(store_id);
+      store->set_state(dingodb::pb::common::StoreState::STORE_NORMAL);
+      store->set_in_state(dingodb::pb::common::StoreInState::STORE_IN);
+      store->set_store_type(dingodb::pb::common::StoreType::NODE_TYPE_STORE);
+    }
+    control->ApplyMetaIncrement(meta_increment, true, 1, 1, nullptr);
+  }
+
+  static void TearDownTestSuite() {
+    control = nullptr;
+    engine->Close();
+    engine->Destroy();
+  }
+
+  static std::vector<dingodb::pb::common::Range> GenRanges(int count) {
+    std::vector<dingodb::pb::common::Range> ranges;
+    for (int i = 0; i < count; ++i) {
+      dingodb::pb::common::Range range;
+      range.set_start_key(std::string(1, static_cast<char>('a' + i)));
+      range.set_end_key(std::string(1, static_cast<char>('a' + i + 1)));
+      ranges.push_back(range);
+    }
+    return ranges;
+  }
+
+  inline static const std::string kFileName = "../../conf/store.yaml";
+  inline static const uint64_t kFirstStoreId = 1000001;
+  inline static const uint64_t kStoreNum = 4;
+  inline static std::shared_ptr<dingodb::RawRocksEngine> engine = nullptr;
+  inline static std::shared_ptr<dingodb::CoordinatorControl> control = nullptr;
+};
+
+TEST_F(CoordinatorControlTest, GetNextIds) {
+  dingodb::pb::coordinator_internal::MetaIncrement meta_increment;
+  uint64_t first_id = control->GetNextIds(dingodb::pb::coordinator_internal::IdEpochType::ID_NEXT_REGION, 5,
+                                          meta_increment);
+  ASSERT_EQ(1, meta_increment.idepochs_size());
+  EXPECT_EQ(first_id + 4, meta_increment.idepochs(0).idepoch().value());
+
+  // Next range follows the reserved one.
+  uint64_t second_id = control->GetNextIds(dingodb::pb::coordinator_internal::IdEpochType::ID_NEXT_REGION, 3,
+                                           meta_increment);
+  EXPECT_EQ(first_id + 5, second_id);
+  ASSERT_EQ(2, meta_increment.idepochs_size());
+  EXPECT_EQ(second_id + 2, meta_increment.idepochs(1).idepoch().value());
+
+  EXPECT_EQ(0, control->GetNextIds(dingodb::pb::coordinator_internal::IdEpochType::ID_NEXT_REGION, 0,
+                                   meta_increment));
+  EXPECT_EQ(2, meta_increment.idepochs_size());
+}
+
+TEST_F(CoordinatorControlTest, CreateRegions) {
+  const int region_count = 6;
+  const int replica_num = 3;
+  std::vector<std::string> region_names(region_count, "test_region");
+  auto ranges = GenRanges(region_count);
+
+  std::vector<uint64_t> new_region_ids;
+  dingodb::pb::coordinator_internal::MetaIncrement meta_increment;
+  auto status = control->CreateRegions(region_names, dingodb::pb::common::RegionType::STORE_REGION, "", replica_num,
+                                       ranges, 2, 60001, 0, dingodb::pb::common::IndexParameter(), new_region_ids,
+                                       meta_increment);
+  ASSERT_TRUE(status.ok()) << status.error_str();
+
+  // Region ids are continuous.
+  ASSERT_EQ(region_count, new_region_ids.size());
+  for (int i = 1; i < region_count; ++i) {
+    EXPECT_EQ(new_region_ids[0] + i, new_region_ids[i]);
+  }
+
+  // One id epoch increment for region ids and one for region cmd ids.
+  EXPECT_EQ(2, meta_increment.idepochs_size());
+
+  // Replicas of a region are on different stores, and regions spread evenly on stores.
+  ASSERT_EQ(region_count, meta_increment.regions_size());
+  std::map<uint64_t, int> store_region_count;
+  for (int i = 0; i < region_count; ++i) {
+    const auto &region = meta_increment.regions(i).region();
+    EXPECT_EQ(new_region_ids[i], region.id());
+    EXPECT_EQ(ranges[i].start_key(), region.definition().range().start_key());
+    EXPECT_EQ(ranges[i].end_key(), region.definition().range().end_key());
+
+    std::set<uint64_t> store_ids;
+    for (const auto &peer : region.definition().peers()) {
+      store_ids.insert(peer.store_id());
+      ++store_region_count[peer.store_id()];
+    }
+    EXPECT_EQ(replica_num, store_ids.size());
+  }
+  ASSERT_EQ(kStoreNum, store_region_count.size());
+  int min_count = region_count * replica_num;
+  int max_count = 0;
+  for (const auto &[_, count] : store_region_count) {
+    min_count = std::min(min_count, count);
+    max_count = std::max(max_count, count);
+  }
+  EXPECT_LE(max_count - min_count, 1);
+
+  // Region cmds of one store are merged into one store operation, cmd ids are continuous.
+  ASSERT_EQ(kStoreNum, meta_increment.store_operations_size());
+  std::set<uint64_t> region_cmd_ids;
+  for (const auto &store_operation_increment : meta_increment.store_operations()) {
+    const auto &store_operation = store_operation_increment.store_operation();
+    EXPECT_EQ(store_region_count[store_operation.id()], store_operation.region_cmds_size());
+    for (const auto &region_cmd : store_operation.region_cmds()) {
+      EXPECT_EQ(dingodb::pb::coordinator::RegionCmdType::CMD_CREATE, region_cmd.region_cmd_type());
+      region_cmd_ids.insert(region_cmd.id());
+    }
+  }
+  ASSERT_EQ(region_count * replica_num, region_cmd_ids.size());
+  EXPECT_EQ(*region_cmd_ids.begin() + region_count * replica_num - 1, *region_cmd_ids.rbegin());
+}
+
+TEST_F(CoordinatorControlTest, CreateRegionsFailed) {
+  std::vector<uint64_t> new_region_ids;
+  dingodb::pb::coordinator_internal::MetaIncrement meta_increment;
+
+  // Size of names and ranges not match.
+  auto status = control->CreateRegions({"test_region"}, dingodb::pb::common::RegionType::STORE_REGION, "", 3,
+                                       GenRanges(2), 2, 60001, 0, dingodb::pb::common::IndexParameter(),
+                                       new_region_ids, meta_increment);
+  EXPECT_FALSE(status.ok());
+
+  // Not enough stores.
+  status = control->CreateRegions({"test_region"}, dingodb::pb::common::RegionType::STORE_REGION, "", kStoreNum + 1,
+                                  GenRanges(1), 2, 60001, 0, dingodb::pb::common::IndexParameter(), new_region_ids,
+                                  meta_increment);
+  EXPECT_FALSE(status.ok());
+
+  EXPECT_TRUE(new_region_ids.empty());
+  EXPECT_EQ(0, meta_increment.ByteSizeLong());
+}
+
+TEST_F(CoordinatorControlTest, CreateRegionsIdExist) {
+  // Region with the next region id exist.
+  uint64_t exist_region_id = control->GetPresentId(dingodb::pb::coordinator_internal::IdEpochType::ID_NEXT_REGION) + 1;
+  dingodb::pb::coordinator_internal::MetaIncrement region_increment;
+  auto* region = region_increment.add_regions();
+  region->set_id(exist_region_id);
+  region->set_op_type(dingodb::pb::coordinator_internal::MetaIncrementOpType::CREATE);
+  region->mutable_region()->set_id(exist_region_id);
+  control->ApplyMetaIncrement(region_increment, true, 1, 10, nullptr);
+
+  std::vector<uint64_t> new_region_ids;
+  dingodb::pb::coordinator_internal::MetaIncrement meta_increment;
+  auto status = control->CreateRegions({"test_region"}, dingodb::pb::common::RegionType::STORE_REGION, "", 3,
+                                       GenRanges(1), 2, 60001, 0, dingodb::pb::common::IndexParameter(),
+                                       new_region_ids, meta_increment);
+  EXPECT_FALSE(status.ok());
+  EXPECT_TRUE(new_region_ids.empty());
+  EXPECT_EQ(0, meta_increment.ByteSizeLong());
+
+  // The conflict id is skipped.
+  status = control->CreateRegions({"test_region"}, dingodb::pb::common::RegionType::STORE_REGION, "", 3, GenRanges(1),
+                                  2, 60001, 0, dingodb::pb::common::IndexParameter(), new_region_ids, meta_increment);
+  ASSERT_TRUE(status.ok());
+  ASSERT_EQ(1, new_region_ids.size());
+  EXPECT_GT(new_region_ids[0], exist_region_id);
+}
@@ -25,6 +25,7 @@
 #include <filesystem>
 #include <iostream>
 #include <iterator>
+#include <map>
 #include <memory>
 #include <numeric>
 #include <optional>
@@ -3859,4 +3860,121 @@ TEST_F(CoprocessorTest, KvDeleteRangeForDisorder) {
   }
 }
 
+// Parallel aggregation over several flushed sst files must equal the single iterator aggregation.
+TEST_F(CoprocessorTest, ExecuteParallel) {
+  int schema_version = 1;
+  long common_id = 2;  // NOLINT
+  auto schemas = std::make_shared<std::vector<std::shared_ptr<BaseSchema>>>();
+  for (int i = 0; i < 3; ++i) {
+    auto long_schema = std::make_shared<DingoSchema<std::optional<int64_t>>>();
+    long_schema->SetIsKey(i == 0);
+    long_schema->SetAllowNull(true);
+    long_schema->SetIndex(i);
+    schemas->emplace_back(std::move(long_schema));
+  }
+  RecordEncoder record_encoder(schema_version, schemas, common_id);
+
+  // id, group = id % 3, value = id, each batch is flushed to its own sst file
+  std::string min_key;
+  std::string max_key;
+  for (int64_t batch = 0; batch < 8; ++batch) {
+    for (int64_t id = batch * 500; id < (batch + 1) * 500; ++id) {
+      std::vector<std::any> record = {std::optional<int64_t>(id), std::optional<int64_t>(id % 3),
+                                      std::optional<int64_t>(id)};
+      pb::common::KeyValue key_value;
+      EXPECT_EQ(0, record_encoder.Encode(record, key_value));
+      EXPECT_EQ(pb::error::OK, engine->NewWriter(kDefaultCf)->KvPut(key_value).error_code());
+      if (min_key.empty() || key_value.key() < min_key) {
+        min_key = key_value.key();
+      }
+      if (key_value.key() > max_key) {
+        max_key = key_value.key();
+      }
+    }
+    engine->Flush(kDefaultCf);
+  }
+
+  pb::store::Coprocessor pb_coprocessor;
+  pb_coprocessor.set_schema_version(schema_version);
+  auto *original_schema = pb_coprocessor.mutable_original_schema();
+  original_schema->set_common_id(common_id);
+  for (int i = 0; i < 3; ++i) {
+    auto *schema = original_schema->add_schema();
+    schema->set_type(::dingodb::pb::store::Schema_Type::Schema_Type_LONG);
+    schema->set_is_key(i == 0);
+    schema->set_is_nullable(true);
+    schema->set_index(i);
+    pb_coprocessor.add_selection_columns(i);
+  }
+
+  // SELECT group, SUM(value), COUNT(value), MAX(value), MIN(value) GROUP BY group
+  auto *result_schema = pb_coprocessor.mutable_result_schema();
+  result_schema->set_common_id(common_id);
+  pb_coprocessor.add_group_by_columns(1);
+  for (int i = 0; i < 5; ++i) {
+    auto *schema = result_schema->add_schema();
+    schema->set_type(::dingodb::pb::store::Schema_Type::Schema_Type_LONG);
+    schema->set_is_key(i == 0);
+    schema->set_is_nullable(true);
+    schema->set_index(i);
+  }
+  for (auto oper : {pb::store::AggregationType::SUM, pb::store::AggregationType::COUNT,
+                    pb::store::AggregationType::MAX, pb::store::AggregationType::MIN}) {
+    auto *aggregation_operator = pb_coprocessor.add_aggregation_operators();
+    aggregation_operator->set_oper(oper);
+    aggregation_operator->set_index_of_column(2);
+  }
+
+  pb::common::Range range;
+  range.set_start_key(min_key);
+  range.set_end_key(Helper::PrefixNext(max_key));
+
+  auto execute = [&](const std::shared_ptr<Coprocessor> &coprocessor, std::shared_ptr<EngineIterator> iter) {
+    std::map<std::string, std::string> results;
+    std::vector<pb::common::KeyValue> kvs;
+    while (true) {
+      butil::Status ok = coprocessor->Execute(iter, false, 2, 1000000000000000, &kvs);
+      EXPECT_EQ(ok.error_code(), pb::error::OK);
+      if (!ok.ok() || kvs.empty()) {
+        break;
+      }
+      for (const auto &kv : kvs) {
+        results[kv.key()] = kv.value();
+      }
+      kvs.clear();
+    }
+    return results;
+  };
+
+  // single iterator
+  auto single_coprocessor = std::make_shared<Coprocessor>();
+  EXPECT_EQ(pb::error::OK, single_coprocessor->Open(pb_coprocessor).error_code());
+  auto single_iter = engine->NewReader(kDefaultCf)->NewIterator(range.start_key(), range.end_key());
+  single_iter->Start();
+  auto single_results = execute(single_coprocessor, single_iter);
+
+  // parallel sub ranges
+  auto sub_ranges = engine->SplitRange(kDefaultCf, range, 4);
+  EXPECT_GT(sub_ranges.size(), 1);
+  EXPECT_EQ(range.start_key(), sub_ranges.front().start_key());
+  EXPECT_EQ(range.end_key(), sub_ranges.back().end_key());
+  for (size_t i = 1; i < sub_ranges.size(); ++i) {
+    EXPECT_EQ(sub_ranges[i - 1].end_key(), sub_ranges[i].start_key());
+  }
+
+  auto parallel_coprocessor = std::make_shared<Coprocessor>();
+  EXPECT_EQ(pb::error::OK, parallel_coprocessor->Open(pb_coprocessor).error_code());
+  butil::Status ok =
+      parallel_coprocessor->ExecuteParallel(engine->NewReader(kDefaultCf), engine->GetSnapshot(), sub_ranges);
+  EXPECT_EQ(ok.error_code(), pb::error::OK);
+  auto parallel_iter = engine->NewReader(kDefaultCf)->NewIterator(range.start_key(), range.end_key());
+  parallel_iter->Start();
+  auto parallel_results = execute(parallel_coprocessor, parallel_iter);
+
+  EXPECT_EQ(3, single_results.size());
+  EXPECT_EQ(single_results, parallel_results);
+
+  EXPECT_EQ(pb::error::OK, engine->NewWriter(kDefaultCf)->KvDeleteRange(range).error_code());
+}
+
 }  // namespace dingodb
@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -2737,4 +2738,172 @@ TEST_F(CoprocessorAggregationManagerTest, CreateIterator) {
 
 TEST_F(CoprocessorAggregationManagerTest, Close) { aggregation_manager->Close(); }
 
+TEST_F(CoprocessorAggregationManagerTest, Merge) {
+  std::shared_ptr<std::vector<std::shared_ptr<BaseSchema>>> group_by_operator_serial_schemas;
+  ::google::protobuf::RepeatedPtrField<pb::store::AggregationOperator> aggregation_operators;
+  std::shared_ptr<std::vector<std::shared_ptr<BaseSchema>>> result_serial_schemas;
+
+  google::protobuf::RepeatedPtrField<pb::store::Schema> pb_schemas;
+  for (int i = 0; i < 4; i++) {
+    pb::store::Schema schema;
+    schema.set_type(::dingodb::pb::store::Schema_Type::Schema_Type_LONG);
+    schema.set_is_key(false);
+    schema.set_is_nullable(true);
+    schema.set_index(i);
+    pb_schemas.Add(std::move(schema));
+  }
+
+  result_serial_schemas = std::make_shared<std::vector<std::shared_ptr<BaseSchema>>>();
+  butil::Status ok = Utils::TransToSerialSchema(pb_schemas, &result_serial_schemas);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+
+  group_by_operator_serial_schemas = std::make_shared<std::vector<std::shared_ptr<BaseSchema>>>();
+  ok = Utils::TransToSerialSchema(pb_schemas, &group_by_operator_serial_schemas);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+
+  for (auto oper : {pb::store::AggregationType::SUM, pb::store::AggregationType::COUNT,
+                    pb::store::AggregationType::MAX, pb::store::AggregationType::MIN}) {
+    pb::store::AggregationOperator aggregation_operator;
+    aggregation_operator.set_index_of_column(0);
+    aggregation_operator.set_oper(oper);
+    aggregation_operators.Add(std::move(aggregation_operator));
+  }
+
+  // Partial aggregation of value 1 -> 10 and 11 -> 20 of key "a", 100 of key "b"
+  auto aggregation_manager1 = std::make_shared<AggregationManager>();
+  ok = aggregation_manager1->Open(group_by_operator_serial_schemas, aggregation_operators, result_serial_schemas);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+  auto aggregation_manager2 = std::make_shared<AggregationManager>();
+  ok = aggregation_manager2->Open(group_by_operator_serial_schemas, aggregation_operators, result_serial_schemas);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+
+  for (int64_t i = 1; i <= 20; i++) {
+    std::vector<std::any> group_by_operator_record(4, std::optional<int64_t>(i));
+    auto &manager = i <= 10 ? aggregation_manager1 : aggregation_manager2;
+    ok = manager->Execute("a", group_by_operator_record);
+    EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+  }
+  std::vector<std::any> group_by_operator_record(4, std::optional<int64_t>(100));
+  ok = aggregation_manager2->Execute("b", group_by_operator_record);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+
+  ok = aggregation_manager1->Merge(aggregation_manager2);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+
+  std::map<std::string, std::vector<int64_t>> results;
+  std::shared_ptr<AggregationIterator> iter = aggregation_manager1->CreateIterator();
+  while (iter->HasNext()) {
+    for (const auto &column : *iter->GetValue()) {
+      results[iter->GetKey()].push_back(std::any_cast<std::optional<int64_t>>(column).value());
+    }
+    iter->Next();
+  }
+
+  EXPECT_EQ(2, results.size());
+  EXPECT_EQ((std::vector<int64_t>{210, 20, 20, 1}), results["a"]);
+  EXPECT_EQ((std::vector<int64_t>{100, 1, 100, 100}), results["b"]);
+
+  aggregation_manager1->Close();
+  aggregation_manager2->Close();
+}
+
+TEST_F(CoprocessorAggregationManagerTest, PartialStates) {
+  std::shared_ptr<std::vector<std::shared_ptr<BaseSchema>>> group_by_operator_serial_schemas;
+  ::google::protobuf::RepeatedPtrField<pb::store::AggregationOperator> aggregation_operators;
+  std::shared_ptr<std::vector<std::shared_ptr<BaseSchema>>> result_serial_schemas;
+
+  google::protobuf::RepeatedPtrField<pb::store::Schema> pb_schemas;
+  for (auto type : {pb::store::Schema_Type::Schema_Type_LONG, pb::store::Schema_Type::Schema_Type_LONG,
+                    pb::store::Schema_Type::Schema_Type_STRING}) {
+    pb::store::Schema schema;
+    schema.set_type(type);
+    schema.set_is_key(false);
+    schema.set_is_nullable(true);
+    schema.set_index(pb_schemas.size());
+    pb_schemas.Add(std::move(schema));
+  }
+
+  result_serial_schemas = std::make_shared<std::vector<std::shared_ptr<BaseSchema>>>();
+  butil::Status ok = Utils::TransToSerialSchema(pb_schemas, &result_serial_schemas);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+
+  group_by_operator_serial_schemas = std::make_shared<std::vector<std::shared_ptr<BaseSchema>>>();
+  ok = Utils::TransToSerialSchema(pb_schemas, &group_by_operator_serial_schemas);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+
+  for (auto oper : {pb::store::AggregationType::SUM, pb::store::AggregationType::COUNT,
+                    pb::store::AggregationType::MAX}) {
+    pb::store::AggregationOperator aggregation_operator;
+    aggregation_operator.set_index_of_column(aggregation_operators.size());
+    aggregation_operator.set_oper(oper);
+    aggregation_operators.Add(std::move(aggregation_operator));
+  }
+
+  auto partial_aggregation_manager = std::make_shared<AggregationManager>();
+  ok = partial_aggregation_manager->Open(group_by_operator_serial_schemas, aggregation_operators,
+                                         result_serial_schemas);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+  auto final_aggregation_manager = std::make_shared<AggregationManager>();
+  ok = final_aggregation_manager->Open(group_by_operator_serial_schemas, aggregation_operators, result_serial_schemas);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+
+  auto gen_record = [](int64_t i) {
+    std::vector<std::any> record;
+    record.emplace_back(std::optional<int64_t>(i));
+    record.emplace_back(std::optional<int64_t>(i));
+    record.emplace_back(std::optional<std::shared_ptr<std::string>>(std::make_shared<std::string>(std::to_string(i))));
+    return record;
+  };
+  for (int64_t i = 1; i <= 5; i++) {
+    ok = partial_aggregation_manager->Execute("a", gen_record(i));
+    EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+    ok = final_aggregation_manager->Execute("a", gen_record(i + 3));
+    EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+  }
+  // Null only group.
+  std::vector<std::any> null_record;
+  null_record.emplace_back(std::optional<int64_t>(std::nullopt));
+  null_record.emplace_back(std::optional<int64_t>(std::nullopt));
+  null_record.emplace_back(std::optional<std::shared_ptr<std::string>>(std::nullopt));
+  ok = partial_aggregation_manager->Execute("b", null_record);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+
+  std::shared_ptr<AggregationIterator> iter = partial_aggregation_manager->CreateIterator();
+  while (iter->HasNext()) {
+    std::string partial_states;
+    ok = partial_aggregation_manager->SerializePartialStates(*iter->GetValue(), &partial_states);
+    EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+    ok = final_aggregation_manager->MergePartialStates(iter->GetKey(), partial_states);
+    EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+    iter->Next();
+  }
+
+  ok = final_aggregation_manager->MergePartialStates("a", "illegal partial states");
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::EILLEGAL_PARAMTETERS);
+
+  int count = 0;
+  iter = final_aggregation_manager->CreateIterator();
+  while (iter->HasNext()) {
+    const auto &value = *iter->GetValue();
+    auto sum = std::any_cast<std::optional<int64_t>>(value[0]);
+    auto cnt = std::any_cast<std::optional<int64_t>>(value[1]);
+    auto max = std::any_cast<std::optional<std::shared_ptr<std::string>>>(value[2]);
+    if (iter->GetKey() == "a") {
+      EXPECT_EQ(15 + 30, sum.value());
+      EXPECT_EQ(10, cnt.value());
+      EXPECT_EQ("8", *max.value());
+    } else {
+      EXPECT_FALSE(sum.has_value());
+      EXPECT_EQ(0, cnt.value());
+      EXPECT_FALSE(max.has_value());
+    }
+    count++;
+    iter->Next();
+  }
+  EXPECT_EQ(2, count);
+
+  partial_aggregation_manager->Close();
+  final_aggregation_manager->Close();
+}
+
 }  // namespace dingodb
@@ -0,0 +1,178 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+#include "braft/log_entry.h"
+#include "gflags/gflags.h"
+#include "log/segment_log_storage.h"
+
+namespace dingodb {
+DECLARE_int64(segment_log_entry_cache_total_bytes);
+}  // namespace dingodb
+
+static braft::LogEntry* NewEntry(int64_t index, int64_t term, size_t data_size) {
+  auto* entry = new braft::LogEntry();
+  entry->type = braft::ENTRY_TYPE_DATA;
+  entry->id = braft::LogId(index, term);
+  entry->data.append(std::string(data_size, 'x'));
+  return entry;
+}
+
+// Append [first_index, last_index] to cache, cache hold its own reference.
+static void AppendEntries(dingodb::LogEntryCache& cache, int64_t first_index, int64_t last_index, size_t data_size) {
+  for (int64_t index = first_index; index <= last_index; ++index) {
+    auto* entry = NewEntry(index, 1, data_size);
+    cache.Append(entry);
+    entry->Release();
+  }
+}
+
+class LogEntryCacheTest : public testing::Test {
+ protected:
+  void SetUp() override { total_bytes_ = dingodb::FLAGS_segment_log_entry_cache_total_bytes; }
+  void TearDown() override { dingodb::FLAGS_segment_log_entry_cache_total_bytes = total_bytes_; }
+
+  static int64_t EntryBytes(size_t data_size) {
+    auto* entry = NewEntry(1, 1, data_size);
+    int64_t bytes = dingodb::LogEntryCache::EntryBytes(entry);
+    entry->Release();
+    return bytes;
+  }
+
+ private:
+  int64_t total_bytes_;
+};
+
+TEST_F(LogEntryCacheTest, AppendAndGet) {
+  dingodb::LogEntryCache cache(1024 * 1024);
+  AppendEntries(cache, 10, 19, 100);
+  EXPECT_EQ(10, cache.Size());
+  EXPECT_EQ(10 * EntryBytes(100), cache.Bytes());
+
+  auto* entry = cache.Get(15);
+  ASSERT_NE(nullptr, entry);
+  EXPECT_EQ(15, entry->id.index);
+  entry->Release();
+  EXPECT_EQ(1, cache.GetTerm(19));
+
+  EXPECT_EQ(nullptr, cache.Get(9));
+  EXPECT_EQ(nullptr, cache.Get(20));
+  EXPECT_EQ(0, cache.GetTerm(20));
+
+  cache.Clear();
+  EXPECT_EQ(0, cache.Size());
+  EXPECT_EQ(0, cache.Bytes());
+}
+
+TEST_F(LogEntryCacheTest, AppendNotContinuous) {
+  dingodb::LogEntryCache cache(1024 * 1024);
+  AppendEntries(cache, 10, 19, 100);
+  AppendEntries(cache, 30, 31, 100);
+
+  EXPECT_EQ(2, cache.Size());
+  EXPECT_EQ(nullptr, cache.Get(19));
+  auto* entry = cache.Get(30);
+  ASSERT_NE(nullptr, entry);
+  entry->Release();
+}
+
+TEST_F(LogEntryCacheTest, EvictSelf) {
+  dingodb::LogEntryCache cache(5 * EntryBytes(100));
+  AppendEntries(cache, 1, 8, 100);
+
+  // keep the latest entries
+  EXPECT_EQ(5, cache.Size());
+  EXPECT_EQ(nullptr, cache.Get(3));
+  auto* entry = cache.Get(4);
+  ASSERT_NE(nullptr, entry);
+  entry->Release();
+
+  // entry larger than cache is not cached
+  AppendEntries(cache, 9, 9, 10 * 100);
+  EXPECT_EQ(nullptr, cache.Get(9));
+}
+
+TEST_F(LogEntryCacheTest, Truncate) {
+  dingodb::LogEntryCache cache(1024 * 1024);
+  AppendEntries(cache, 1, 10, 100);
+
+  cache.TruncatePrefix(4);
+  EXPECT_EQ(7, cache.Size());
+  EXPECT_EQ(nullptr, cache.Get(3));
+
+  cache.TruncateSuffix(8);
+  EXPECT_EQ(5, cache.Size());
+  EXPECT_EQ(nullptr, cache.Get(9));
+  EXPECT_EQ(5 * EntryBytes(100), cache.Bytes());
+
+  // append after truncated suffix is continuous
+  AppendEntries(cache, 9, 9, 100);
+  EXPECT_EQ(6, cache.Size());
+}
+
+TEST_F(LogEntryCacheTest, EvictGlobal) {
+  int64_t entry_bytes = EntryBytes(100);
+  dingodb::LogEntryCache cache1(1024 * 1024);
+  dingodb::LogEntryCache cache2(1024 * 1024);
+  dingodb::LogEntryCache cache3(1024 * 1024);
+  dingodb::FLAGS_segment_log_entry_cache_total_bytes = dingodb::LogEntryCache::TotalBytes() + 10 * entry_bytes;
+
+  AppendEntries(cache1, 1, 4, 100);
+  AppendEntries(cache2, 1, 4, 100);
+  AppendEntries(cache3, 1, 2, 100);
+  EXPECT_EQ(4, cache1.Size());
+
+  // evict the least recently appended cache1 first, not the caller
+  AppendEntries(cache3, 3, 5, 100);
+  EXPECT_EQ(1, cache1.Size());
+  EXPECT_EQ(4, cache2.Size());
+  EXPECT_EQ(5, cache3.Size());
+
+  // then cache2
+  AppendEntries(cache3, 6, 8, 100);
+  EXPECT_EQ(0, cache1.Size());
+  EXPECT_EQ(2, cache2.Size());
+  EXPECT_EQ(8, cache3.Size());
+  EXPECT_EQ(10 * entry_bytes, cache1.Bytes() + cache2.Bytes() + cache3.Bytes());
+
+  // caller is evicted at last
+  AppendEntries(cache3, 9, 12, 100);
+  EXPECT_EQ(0, cache2.Size());
+  EXPECT_EQ(10, cache3.Size());
+  EXPECT_EQ(nullptr, cache3.Get(2));
+}
+
+TEST_F(LogEntryCacheTest, EvictGlobalAfterEmpty) {
+  int64_t entry_bytes = EntryBytes(100);
+  dingodb::LogEntryCache cache1(1024 * 1024);
+  dingodb::LogEntryCache cache2(1024 * 1024);
+  dingodb::FLAGS_segment_log_entry_cache_total_bytes = dingodb::LogEntryCache::TotalBytes() + 4 * entry_bytes;
+
+  AppendEntries(cache1, 1, 2, 100);
+  AppendEntries(cache2, 1, 4, 100);
+  EXPECT_EQ(0, cache1.Size());
+  EXPECT_EQ(4, cache2.Size());
+
+  // emptied cache1 take part in eviction again after append
+  AppendEntries(cache1, 10, 10, 100);
+  EXPECT_EQ(1, cache1.Size());
+  EXPECT_EQ(3, cache2.Size());
+
+  AppendEntries(cache2, 5, 5, 100);
+  EXPECT_EQ(0, cache1.Size());
+  EXPECT_EQ(4, cache2.Size());
+}
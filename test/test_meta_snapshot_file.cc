@@ -0,0 +1,170 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "fmt/core.h"
+#include "gflags/gflags.h"
+#include "meta/meta_snapshot_file.h"
+#include "proto/common.pb.h"
+#include "proto/coordinator_internal.pb.h"
+
+namespace dingodb {
+DECLARE_uint32(meta_snapshot_chunk_kv_count);
+}  // namespace dingodb
+
+static const std::string kSnapshotPath = "./meta_snapshot_file_test";
+
+static dingodb::pb::common::KeyValue GenKv(const std::string& prefix, int i) {
+  dingodb::pb::common::KeyValue kv;
+  kv.set_key(fmt::format("{}_{:06}", prefix, i));
+  kv.set_value(fmt::format("value_{}", i));
+  return kv;
+}
+
+class MetaSnapshotFileTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    chunk_kv_count_ = dingodb::FLAGS_meta_snapshot_chunk_kv_count;
+    dingodb::FLAGS_meta_snapshot_chunk_kv_count = 10;
+  }
+
+  void TearDown() override {
+    dingodb::FLAGS_meta_snapshot_chunk_kv_count = chunk_kv_count_;
+    std::remove(kSnapshotPath.c_str());
+  }
+
+  // Write kv_counts[i] kvs of prefix_i.
+  static void WriteFile(const std::vector<int>& kv_counts) {
+    dingodb::MetaSnapshotFileWriter writer(kSnapshotPath);
+    ASSERT_TRUE(writer.Open().ok());
+    uint64_t total = 0;
+    for (size_t i = 0; i < kv_counts.size(); ++i) {
+      for (int j = 0; j < kv_counts[i]; ++j) {
+        ASSERT_TRUE(writer.Append(fmt::format("prefix_{}", i), GenKv(fmt::format("prefix_{}", i), j)).ok());
+      }
+      total += kv_counts[i];
+    }
+    ASSERT_TRUE(writer.Finish().ok());
+    EXPECT_EQ(total, writer.KvCount());
+  }
+
+  uint32_t chunk_kv_count_;
+};
+
+TEST_F(MetaSnapshotFileTest, RoundTrip) {
+  std::vector<int> kv_counts = {25, 0, 10, 3};
+  WriteFile(kv_counts);
+
+  dingodb::MetaSnapshotFileReader reader(kSnapshotPath);
+  ASSERT_TRUE(reader.Open().ok());
+
+  std::vector<int> read_counts(kv_counts.size(), 0);
+  dingodb::pb::coordinator_internal::MetaSnapshotChunk chunk;
+  do {
+    ASSERT_TRUE(reader.Read(chunk).ok());
+    EXPECT_LE(chunk.kvs_size(), 10);
+    if (chunk.kvs_size() == 0) {
+      continue;
+    }
+
+    // kvs of a chunk share one prefix, and keep the append order.
+    int index = std::stoi(chunk.prefix().substr(std::string("prefix_").size()));
+    for (const auto& kv : chunk.kvs()) {
+      auto expect_kv = GenKv(chunk.prefix(), read_counts[index]++);
+      EXPECT_EQ(expect_kv.key(), kv.key());
+      EXPECT_EQ(expect_kv.value(), kv.value());
+    }
+  } while (!chunk.is_last());
+
+  EXPECT_EQ(kv_counts, read_counts);
+  EXPECT_EQ(38, reader.KvCount());
+  EXPECT_EQ(38, chunk.total_kv_count());
+}
+
+TEST_F(MetaSnapshotFileTest, Empty) {
+  WriteFile({});
+
+  dingodb::MetaSnapshotFileReader reader(kSnapshotPath);
+  ASSERT_TRUE(reader.Open().ok());
+
+  dingodb::pb::coordinator_internal::MetaSnapshotChunk chunk;
+  ASSERT_TRUE(reader.Read(chunk).ok());
+  EXPECT_TRUE(chunk.is_last());
+  EXPECT_EQ(0, chunk.kvs_size());
+  EXPECT_EQ(0, reader.KvCount());
+}
+
+TEST_F(MetaSnapshotFileTest, ChecksumMismatch) {
+  WriteFile({5});
+
+  // Flip the last byte of the first chunk, which is the value of the last kv.
+  {
+    std::fstream file(kSnapshotPath, std::ios::in | std::ios::out | std::ios::binary);
+    ASSERT_TRUE(file.is_open());
+    char header[4];
+    file.seekg(8);
+    file.read(header, sizeof(header));
+    uint32_t length = static_cast<uint8_t>(header[0]) | (static_cast<uint8_t>(header[1]) << 8) |
+                      (static_cast<uint8_t>(header[2]) << 16) | (static_cast<uint8_t>(header[3]) << 24);
+    file.seekp(8 + 8 + length - 1);
+    file.put('#');
+  }
+
+  dingodb::MetaSnapshotFileReader reader(kSnapshotPath);
+  ASSERT_TRUE(reader.Open().ok());
+
+  dingodb::pb::coordinator_internal::MetaSnapshotChunk chunk;
+  EXPECT_FALSE(reader.Read(chunk).ok());
+}
+
+TEST_F(MetaSnapshotFileTest, Truncated) {
+  WriteFile({5});
+
+  // Cut the last chunk off.
+  std::string data;
+  {
+    std::ifstream file(kSnapshotPath, std::ios::binary);
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream file(kSnapshotPath, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), data.size() - 4);
+  }
+
+  dingodb::MetaSnapshotFileReader reader(kSnapshotPath);
+  ASSERT_TRUE(reader.Open().ok());
+
+  dingodb::pb::coordinator_internal::MetaSnapshotChunk chunk;
+  ASSERT_TRUE(reader.Read(chunk).ok());
+  EXPECT_EQ(5, chunk.kvs_size());
+  EXPECT_FALSE(chunk.is_last());
+  EXPECT_FALSE(reader.Read(chunk).ok());
+}
+
+TEST_F(MetaSnapshotFileTest, NotSnapshotFile) {
+  {
+    std::ofstream file(kSnapshotPath, std::ios::binary | std::ios::trunc);
+    file << "not a meta snapshot file";
+  }
+
+  dingodb::MetaSnapshotFileReader reader(kSnapshotPath);
+  EXPECT_FALSE(reader.Open().ok());
+}
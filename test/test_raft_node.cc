@@ -144,7 +144,7 @@ std::shared_ptr<dingodb::RaftNode> LaunchRaftNode(std::shared_ptr<dingodb::Confi
   auto node = std::make_shared<dingodb::RaftNode>(node_id, region->Name(),
                                                   braft::PeerId(FormatLocation(peer.raft_location())), state_machine);
 
-  if (node->Init(init_conf, config) != 0) {
+  if (node->Init(init_conf, config, true) != 0) {
     node->Destroy();
     return nullptr;
   }
@@ -301,6 +301,18 @@ std::unique_ptr<brpc::Server> RaftNodeTest::raft_server = nullptr;
 //   inner_nodes.clear();
 // }
 
+// Config without raft.meta_storage, as deployed before it was added.
+TEST_F(RaftNodeTest, InitWithoutMetaStorage) {
+  EXPECT_TRUE(config->GetString("raft.meta_storage").empty());
+
+  std::vector<std::string> raft_addrs = {"127.0.0.1:17001:5"};
+  auto region = BuildRegion(2000, "unit_test_meta_storage", raft_addrs);
+  auto node = LaunchRaftNode(config, region, 2001, region->Peers()[0], FormatPeers(region->Peers()));
+  ASSERT_NE(nullptr, node);
+
+  node->Destroy();
+}
+
 TEST_F(RaftNodeTest, DeleteOnePeer) {
   // Add one peer
   std::cout << "====Delete one peer" << std::endl;
@@ -0,0 +1,93 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "gflags/gflags.h"
+#include "raft/raft_snapshot_scheduler.h"
+
+namespace dingodb {
+
+DECLARE_int64(raft_snapshot_log_bytes);
+DECLARE_int64(raft_snapshot_log_entries);
+DECLARE_int64(raft_snapshot_follower_lag_entries);
+DECLARE_int64(raft_snapshot_log_bytes_hard_limit);
+
+class RaftSnapshotSchedulerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    FLAGS_raft_snapshot_log_bytes = 1000;
+    FLAGS_raft_snapshot_log_entries = 100;
+    FLAGS_raft_snapshot_follower_lag_entries = 10;
+    FLAGS_raft_snapshot_log_bytes_hard_limit = 5000;
+  }
+
+  static RaftSnapshotHint GenHint() {
+    RaftSnapshotHint hint;
+    hint.applied_index = 50;
+    hint.last_snapshot_index = 40;
+    hint.log_bytes = 100;
+    hint.elapsed_s = 10;
+    hint.interval_s = 3600;
+    return hint;
+  }
+};
+
+TEST_F(RaftSnapshotSchedulerTest, IdleNode) {
+  auto hint = GenHint();
+  hint.last_snapshot_index = hint.applied_index;
+  hint.log_bytes = 100000;
+  hint.elapsed_s = 100000;
+  EXPECT_FALSE(RaftSnapshotScheduler::NeedSnapshot(hint));
+}
+
+TEST_F(RaftSnapshotSchedulerTest, Threshold) {
+  auto hint = GenHint();
+  EXPECT_FALSE(RaftSnapshotScheduler::NeedSnapshot(hint));
+
+  hint.log_bytes = 1000;
+  EXPECT_TRUE(RaftSnapshotScheduler::NeedSnapshot(hint));
+
+  hint = GenHint();
+  hint.applied_index = hint.last_snapshot_index + 100;
+  EXPECT_TRUE(RaftSnapshotScheduler::NeedSnapshot(hint));
+
+  hint = GenHint();
+  hint.elapsed_s = hint.interval_s;
+  EXPECT_TRUE(RaftSnapshotScheduler::NeedSnapshot(hint));
+}
+
+TEST_F(RaftSnapshotSchedulerTest, LaggingFollower) {
+  auto hint = GenHint();
+  hint.log_bytes = 1000;
+  hint.is_leader = true;
+  hint.slowest_match_index = hint.applied_index - 5;
+  EXPECT_TRUE(RaftSnapshotScheduler::NeedSnapshot(hint));
+
+  hint.slowest_match_index = hint.applied_index - 20;
+  EXPECT_FALSE(RaftSnapshotScheduler::NeedSnapshot(hint));
+
+  // Log too large, not wait for follower.
+  hint.log_bytes = 5000;
+  EXPECT_TRUE(RaftSnapshotScheduler::NeedSnapshot(hint));
+
+  // Follower not wait for others.
+  hint.log_bytes = 1000;
+  hint.is_leader = false;
+  EXPECT_TRUE(RaftSnapshotScheduler::NeedSnapshot(hint));
+}
+
+}  // namespace dingodb
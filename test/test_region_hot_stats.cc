@@ -0,0 +1,113 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "metrics/region_hot_stats.h"
+#include "proto/common.pb.h"
+
+namespace dingodb {
+
+DECLARE_int32(region_hot_stats_sample_rate);
+
+TEST(SpaceSavingSketchTest, TopN) {
+  SpaceSavingSketch sketch(3);
+  sketch.Add("a", 5);
+  sketch.Add("b", 3);
+  sketch.Add("c", 1);
+  sketch.Add("a", 1);
+  EXPECT_EQ(3, sketch.Size());
+
+  auto top = sketch.TopN(2);
+  ASSERT_EQ(2, top.size());
+  EXPECT_EQ("a", top[0].key);
+  EXPECT_EQ(6, top[0].count);
+  EXPECT_EQ(0, top[0].error);
+  EXPECT_EQ("b", top[1].key);
+}
+
+TEST(SpaceSavingSketchTest, Evict) {
+  SpaceSavingSketch sketch(2);
+  sketch.Add("a", 5);
+  sketch.Add("b", 1);
+  // Replace b, inherit its count as error.
+  sketch.Add("c", 2);
+  EXPECT_EQ(2, sketch.Size());
+
+  auto top = sketch.TopN(10);
+  ASSERT_EQ(2, top.size());
+  EXPECT_EQ("a", top[0].key);
+  EXPECT_EQ("c", top[1].key);
+  EXPECT_EQ(3, top[1].count);
+  EXPECT_EQ(1, top[1].error);
+
+  sketch.Clear();
+  EXPECT_EQ(0, sketch.Size());
+}
+
+TEST(RegionHotStatsTest, Collect) {
+  FLAGS_region_hot_stats_sample_rate = 1;
+
+  RegionHotStats hot_stats;
+  std::vector<std::string_view> keys = {"k1", "k2"};
+  hot_stats.Record(true, keys, 100);
+  hot_stats.Record(true, {"k1"}, 50);
+  hot_stats.Record(false, {"k3"}, 10);
+
+  pb::common::RegionHotStats stats;
+  hot_stats.Collect(&stats);
+  EXPECT_EQ(2, stats.write_qps());
+  EXPECT_EQ(1, stats.read_qps());
+  EXPECT_EQ(150, stats.write_bytes_per_second());
+  EXPECT_EQ(10, stats.read_bytes_per_second());
+  ASSERT_EQ(3, stats.hot_keys_size());
+  EXPECT_EQ("k1", stats.hot_keys(0).key());
+  EXPECT_EQ(2, stats.hot_keys(0).count());
+
+  // Window is reset after collect.
+  pb::common::RegionHotStats empty_stats;
+  hot_stats.Collect(&empty_stats);
+  EXPECT_EQ(0, empty_stats.write_qps());
+  EXPECT_EQ(0, empty_stats.hot_keys_size());
+
+  FLAGS_region_hot_stats_sample_rate = 16;
+}
+
+TEST(RegionHotStatsTest, CollectFractionalWindow) {
+  FLAGS_region_hot_stats_sample_rate = 1;
+
+  RegionHotStats hot_stats;
+  for (int i = 0; i < 30; ++i) {
+    hot_stats.Record(true, {"k1"}, 10);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+
+  // 30 writes in about 1.5s, not truncated to 1s.
+  pb::common::RegionHotStats stats;
+  hot_stats.Collect(&stats);
+  EXPECT_LE(stats.write_qps(), 20);
+  EXPECT_GE(stats.write_qps(), 15);
+  EXPECT_LE(stats.write_bytes_per_second(), 200);
+  EXPECT_GE(stats.write_bytes_per_second(), 150);
+
+  FLAGS_region_hot_stats_sample_rate = 16;
+}
+
+}  // namespace dingodb
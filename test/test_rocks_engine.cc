@@ -32,11 +32,13 @@
 #include <vector>
 
 #include "butil/status.h"
+#include "common/constant.h"
 #include "common/context.h"
 #include "common/helper.h"
 #include "config/config.h"
 #include "config/yaml_config.h"
 #include "engine/raw_rocks_engine.h"
+#include "fmt/core.h"
 #include "proto/common.pb.h"
 #include "proto/store_internal.pb.h"
 #include "server/server.h"
@@ -2742,7 +2744,8 @@ TEST_F(RawRocksEngineTest, KvBatchDeleteRange) {
       std::cout << kv.key() << ":" << kv.value() << std::endl;
     }
 
-    EXPECT_EQ(20, kvs.size());
+    // KEY0 -> KEY9 are deleted, KEZ0 -> KEZ9 left.
+    EXPECT_EQ(10, kvs.size());
   }
 
   {
@@ -2759,6 +2762,129 @@ TEST_F(RawRocksEngineTest, KvBatchDeleteRange) {
   }
 }
 
+TEST_F(RawRocksEngineTest, CompactRange) {
+  const std::string &cf_name = kDefaultCf;
+  std::shared_ptr<RawEngine::Writer> writer = RawRocksEngineTest::engine->NewWriter(cf_name);
+
+  pb::common::Range range;
+  range.set_start_key("TOMB");
+  range.set_end_key("TOMC");
+
+  std::vector<pb::common::KeyValue> kvs;
+  for (int i = 0; i < 1000; i++) {
+    pb::common::KeyValue kv;
+    kv.set_key(fmt::format("TOMB{:04}", i));
+    kv.set_value("VALUE" + std::to_string(i));
+    kvs.push_back(kv);
+  }
+  butil::Status ok = writer->KvBatchPut(kvs);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+  RawRocksEngineTest::engine->Flush(cf_name);
+
+  ok = writer->KvDeleteRange(range);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+  RawRocksEngineTest::engine->Flush(cf_name);
+
+  auto stats = RawRocksEngineTest::engine->GetTombstoneStats(cf_name, {range})[0];
+  EXPECT_GT(stats.tombstone_count, 0);
+  EXPECT_GE(stats.entry_count, stats.tombstone_count);
+
+  ok = RawRocksEngineTest::engine->CompactRange(cf_name, range);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+
+  // Range tombstone and deleted keys are dropped.
+  auto compacted_stats = RawRocksEngineTest::engine->GetTombstoneStats(cf_name, {range})[0];
+  EXPECT_LT(compacted_stats.tombstone_count, stats.tombstone_count);
+
+  std::vector<pb::common::KeyValue> scan_kvs;
+  std::shared_ptr<RawEngine::Reader> reader = RawRocksEngineTest::engine->NewReader(cf_name);
+  ok = reader->KvScan(range.start_key(), range.end_key(), scan_kvs);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+  EXPECT_EQ(0, scan_kvs.size());
+}
+
+TEST_F(RawRocksEngineTest, GetTombstoneStats) {
+  const std::string &cf_name = kDefaultCf;
+  std::shared_ptr<RawEngine::Writer> writer = RawRocksEngineTest::engine->NewWriter(cf_name);
+
+  // One file of deletes shared by two adjacent ranges.
+  std::vector<pb::common::KeyValue> kvs;
+  std::vector<std::string> keys;
+  for (int i = 0; i < 1000; i++) {
+    for (const auto *prefix : {"SHRA", "SHRB"}) {
+      pb::common::KeyValue kv;
+      kv.set_key(fmt::format("{}{:04}", prefix, i));
+      kv.set_value(GenRandomString(64));
+      kvs.push_back(kv);
+      keys.push_back(kv.key());
+    }
+  }
+  butil::Status ok = writer->KvBatchPut(kvs);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+  RawRocksEngineTest::engine->Flush(cf_name);
+  ok = writer->KvBatchDelete(keys);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+  RawRocksEngineTest::engine->Flush(cf_name);
+
+  pb::common::Range whole_range;
+  whole_range.set_start_key("SHRA");
+  whole_range.set_end_key("SHRC");
+  auto whole_stats = RawRocksEngineTest::engine->GetTombstoneStats(cf_name, {whole_range})[0];
+  EXPECT_GE(whole_stats.tombstone_count, keys.size());
+
+  pb::common::Range range1;
+  range1.set_start_key("SHRA");
+  range1.set_end_key("SHRB");
+  pb::common::Range range2;
+  range2.set_start_key("SHRB");
+  range2.set_end_key("SHRC");
+  auto stats = RawRocksEngineTest::engine->GetTombstoneStats(cf_name, {range2, range1});
+  EXPECT_EQ(2, stats.size());
+  // Shared file is split between ranges, not counted by both.
+  EXPECT_LE(stats[0].tombstone_count + stats[1].tombstone_count, whole_stats.tombstone_count);
+  EXPECT_LE(stats[0].entry_count + stats[1].entry_count, whole_stats.entry_count);
+
+  ok = writer->KvDeleteRange(whole_range);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+}
+
+TEST_F(RawRocksEngineTest, DeleteFilesInRange) {
+  const std::string &cf_name = kDefaultCf;
+  std::shared_ptr<RawEngine::Writer> writer = RawRocksEngineTest::engine->NewWriter(cf_name);
+
+  std::vector<pb::common::KeyValue> kvs;
+  for (int i = 0; i < 100; i++) {
+    pb::common::KeyValue kv;
+    kv.set_key(fmt::format("DELF{:04}", i));
+    kv.set_value("VALUE" + std::to_string(i));
+    kvs.push_back(kv);
+  }
+  butil::Status ok = writer->KvBatchPut(kvs);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+  RawRocksEngineTest::engine->Flush(cf_name);
+
+  pb::common::Range range;
+  range.set_start_key("DELF");
+  range.set_end_key("DELG");
+  ok = RawRocksEngineTest::engine->DeleteFilesInRange(cf_name, range);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+
+  // Files partially in range are left, delete range clean up the rest.
+  ok = writer->KvDeleteRange(range);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+
+  std::vector<pb::common::KeyValue> scan_kvs;
+  std::shared_ptr<RawEngine::Reader> reader = RawRocksEngineTest::engine->NewReader(cf_name);
+  ok = reader->KvScan(range.start_key(), range.end_key(), scan_kvs);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+  EXPECT_EQ(0, scan_kvs.size());
+
+  // Keys out of range are not affected.
+  std::string value;
+  ok = reader->KvGet("KEZ0", value);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+}
+
 TEST_F(RawRocksEngineTest, Iterator) {
   auto writer = RawRocksEngineTest::engine->NewWriter(kDefaultCf);
   pb::common::KeyValue kv;
@@ -2777,6 +2903,129 @@ TEST_F(RawRocksEngineTest, Iterator) {
   EXPECT_GE(count, 1);
 }
 
+TEST_F(RawRocksEngineTest, KvScanAndCountBound) {
+  auto writer = RawRocksEngineTest::engine->NewWriter(kDefaultCf);
+  auto reader = RawRocksEngineTest::engine->NewReader(kDefaultCf);
+  pb::common::KeyValue kv;
+  for (int i = 0; i < 10; ++i) {
+    kv.set_key(fmt::format("scanbound{:03}", i));
+    kv.set_value(fmt::format("value{}", i));
+    writer->KvPut(kv);
+  }
+
+  // End key is exclusive.
+  std::vector<pb::common::KeyValue> kvs;
+  butil::Status ok = reader->KvScan("scanbound002", "scanbound005", kvs);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+  ASSERT_EQ(3, kvs.size());
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(fmt::format("scanbound{:03}", i + 2), kvs[i].key());
+    EXPECT_EQ(fmt::format("value{}", i + 2), kvs[i].value());
+  }
+
+  uint64_t count = 0;
+  ok = reader->KvCount("scanbound002", "scanbound005", count);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+  EXPECT_EQ(3, count);
+
+  // End key between keys.
+  kvs.clear();
+  ok = reader->KvScan("scanbound007", "scanbound0085", kvs);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+  ASSERT_EQ(2, kvs.size());
+  EXPECT_EQ("scanbound008", kvs[1].key());
+
+  ok = reader->KvCount("scanbound000", "scanbound1", count);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+  EXPECT_EQ(10, count);
+
+  // Empty range.
+  kvs.clear();
+  ok = reader->KvScan("scanbound005", "scanbound005", kvs);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+  EXPECT_TRUE(kvs.empty());
+  ok = reader->KvCount("scanbound005", "scanbound005", count);
+  EXPECT_EQ(ok.error_code(), pb::error::Errno::OK);
+  EXPECT_EQ(0, count);
+}
+
+TEST_F(RawRocksEngineTest, IteratorBound) {
+  auto writer = RawRocksEngineTest::engine->NewWriter(kDefaultCf);
+  pb::common::KeyValue kv;
+  for (int i = 0; i < 10; ++i) {
+    kv.set_key(fmt::format("iterbound{:03}", i));
+    kv.set_value(GenRandomString(64));
+    writer->KvPut(kv);
+  }
+
+  IteratorOptions options;
+  options.lower_bound = "iterbound003";
+  options.upper_bound = "iterbound007";
+  options.readahead_size = Constant::kRocksdbBulkScanReadaheadSize;
+  options.fill_cache = false;
+  auto iter = RawRocksEngineTest::engine->NewIterator(kDefaultCf, options);
+
+  std::vector<std::string> keys;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    keys.emplace_back(iter->Key());
+  }
+  std::vector<std::string> expect_keys = {"iterbound003", "iterbound004", "iterbound005", "iterbound006"};
+  EXPECT_EQ(expect_keys, keys);
+
+  iter->SeekToLast();
+  ASSERT_TRUE(iter->Valid());
+  EXPECT_EQ("iterbound006", iter->Key());
+
+  // Seek before lower bound stop at lower bound.
+  iter->Seek("iterbound000");
+  ASSERT_TRUE(iter->Valid());
+  EXPECT_EQ("iterbound003", iter->Key());
+
+  iter->Seek("iterbound007");
+  EXPECT_FALSE(iter->Valid());
+
+  // Write after snapshot is invisible.
+  auto snapshot = RawRocksEngineTest::engine->GetSnapshot();
+  kv.set_key("iterbound0035");
+  writer->KvPut(kv);
+  auto snapshot_iter = RawRocksEngineTest::engine->NewIterator(kDefaultCf, snapshot, options);
+  int count = 0;
+  for (snapshot_iter->Seek("iterbound003"); snapshot_iter->Valid(); snapshot_iter->Next()) {
+    ++count;
+  }
+  EXPECT_EQ(4, count);
+
+  iter = RawRocksEngineTest::engine->NewIterator(kDefaultCf, options);
+  count = 0;
+  for (iter->Seek("iterbound003"); iter->Valid(); iter->Next()) {
+    ++count;
+  }
+  EXPECT_EQ(5, count);
+}
+
+TEST_F(RawRocksEngineTest, IteratorPrefixSameAsStart) {
+  auto writer = RawRocksEngineTest::engine->NewWriter(kDefaultCf);
+  pb::common::KeyValue kv;
+  kv.set_value(GenRandomString(64));
+  for (int i = 0; i < 5; ++i) {
+    kv.set_key(fmt::format("prefixaa{:03}", i));
+    writer->KvPut(kv);
+    kv.set_key(fmt::format("prefixab{:03}", i));
+    writer->KvPut(kv);
+  }
+
+  // Stop at the end of prefix "prefixaa" without upper bound.
+  IteratorOptions options;
+  options.prefix_same_as_start = true;
+  auto iter = RawRocksEngineTest::engine->NewIterator(kDefaultCf, options);
+  int count = 0;
+  for (iter->Seek("prefixaa000"); iter->Valid(); iter->Next()) {
+    EXPECT_TRUE(iter->Key().substr(0, 8) == "prefixaa");
+    ++count;
+  }
+  EXPECT_EQ(5, count);
+}
+
 // TEST_F(RawRocksEngineTest, Checkpoint) {
 //   auto writer = RawRocksEngineTest::engine->NewWriter(kDefaultCf);
 
@@ -0,0 +1,182 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "config/config.h"
+#include "config/yaml_config.h"
+#include "engine/raw_rocks_engine.h"
+#include "engine/rocks_resource.h"
+#include "fmt/core.h"
+#include "proto/common.pb.h"
+
+namespace dingodb {
+
+static const std::string kDefaultCf = "default";
+
+static std::shared_ptr<Config> GenConfig(const std::string& resource_content) {
+  const std::string content =
+      "store:\n"
+      "  path: ./rocks_resource_test\n"
+      "  base:\n"
+      "    block_size: 131072\n"
+      "    block_cache: 67108864\n"
+      "    write_buffer_size: 67108864\n"
+      "    prefix_extractor: 8\n"
+      "  column_families:\n"
+      "    - default\n" +
+      resource_content;
+
+  auto config = std::make_shared<YamlConfig>();
+  if (config->Load(content) != 0) {
+    return nullptr;
+  }
+  return config;
+}
+
+class RocksResourceTest : public testing::Test {
+ protected:
+  void TearDown() override {
+    // Leave default resource to other tests.
+    RocksResourceManager::GetInstance()->Init(GenConfig(""));
+  }
+};
+
+TEST_F(RocksResourceTest, Default) {
+  auto config = GenConfig("");
+  ASSERT_NE(nullptr, config);
+
+  auto* manager = RocksResourceManager::GetInstance();
+  ASSERT_TRUE(manager->Init(config));
+  EXPECT_EQ(nullptr, manager->GetBlockCache());
+  EXPECT_EQ(nullptr, manager->GetWriteBufferManager());
+  EXPECT_EQ(nullptr, manager->GetRateLimiter());
+}
+
+TEST_F(RocksResourceTest, LruCache) {
+  auto config = GenConfig(
+      "  resource:\n"
+      "    block_cache_type: lru\n"
+      "    block_cache_size: 33554432\n"
+      "    write_buffer_manager_size: 16777216\n"
+      "    write_buffer_charge_cache: 1\n"
+      "    rate_limit_bytes_per_sec: 10485760\n");
+  ASSERT_NE(nullptr, config);
+
+  auto* manager = RocksResourceManager::GetInstance();
+  ASSERT_TRUE(manager->Init(config));
+  ASSERT_NE(nullptr, manager->GetBlockCache());
+  EXPECT_EQ(33554432, manager->GetBlockCache()->GetCapacity());
+  ASSERT_NE(nullptr, manager->GetWriteBufferManager());
+  EXPECT_EQ(16777216, manager->GetWriteBufferManager()->buffer_size());
+  EXPECT_TRUE(manager->GetWriteBufferManager()->cost_to_cache());
+  ASSERT_NE(nullptr, manager->GetRateLimiter());
+  EXPECT_EQ(10485760, manager->GetRateLimiter()->GetBytesPerSecond());
+
+  // Init again without resource config reset all.
+  ASSERT_TRUE(manager->Init(GenConfig("")));
+  EXPECT_EQ(nullptr, manager->GetBlockCache());
+  EXPECT_EQ(nullptr, manager->GetWriteBufferManager());
+  EXPECT_EQ(nullptr, manager->GetRateLimiter());
+}
+
+TEST_F(RocksResourceTest, HyperClockCache) {
+  auto config = GenConfig(
+      "  resource:\n"
+      "    block_cache_type: hyper_clock\n"
+      "    block_cache_size: 33554432\n"
+      "    write_buffer_manager_size: 16777216\n");
+  ASSERT_NE(nullptr, config);
+
+  auto* manager = RocksResourceManager::GetInstance();
+  ASSERT_TRUE(manager->Init(config));
+  ASSERT_NE(nullptr, manager->GetBlockCache());
+  EXPECT_EQ(33554432, manager->GetBlockCache()->GetCapacity());
+  // Not charge to block cache by default.
+  ASSERT_NE(nullptr, manager->GetWriteBufferManager());
+  EXPECT_FALSE(manager->GetWriteBufferManager()->cost_to_cache());
+  EXPECT_EQ(nullptr, manager->GetRateLimiter());
+}
+
+TEST_F(RocksResourceTest, IllegalConfig) {
+  auto* manager = RocksResourceManager::GetInstance();
+
+  EXPECT_FALSE(manager->Init(GenConfig(
+      "  resource:\n"
+      "    block_cache_type: fifo\n"
+      "    block_cache_size: 33554432\n")));
+
+  EXPECT_FALSE(manager->Init(GenConfig(
+      "  resource:\n"
+      "    block_cache_size: -1\n")));
+
+  EXPECT_FALSE(manager->Init(GenConfig(
+      "  resource:\n"
+      "    write_buffer_manager_size: -1\n")));
+
+  EXPECT_FALSE(manager->Init(GenConfig(
+      "  resource:\n"
+      "    rate_limit_bytes_per_sec: -1\n")));
+
+  // Unparsable value fall back to default.
+  ASSERT_TRUE(manager->Init(GenConfig(
+      "  resource:\n"
+      "    block_cache_size: abc\n")));
+  EXPECT_EQ(nullptr, manager->GetBlockCache());
+}
+
+TEST_F(RocksResourceTest, SharedByEngine) {
+  auto config = GenConfig(
+      "  resource:\n"
+      "    block_cache_size: 33554432\n"
+      "    write_buffer_manager_size: 16777216\n"
+      "    write_buffer_charge_cache: 1\n");
+  ASSERT_NE(nullptr, config);
+
+  auto engine = std::make_shared<RawRocksEngine>();
+  ASSERT_TRUE(engine->Init(config));
+
+  auto* manager = RocksResourceManager::GetInstance();
+  auto block_cache = manager->GetBlockCache();
+  auto write_buffer_manager = manager->GetWriteBufferManager();
+  ASSERT_NE(nullptr, block_cache);
+  ASSERT_NE(nullptr, write_buffer_manager);
+
+  auto writer = engine->NewWriter(kDefaultCf);
+  pb::common::KeyValue kv;
+  for (int i = 0; i < 1000; ++i) {
+    kv.set_key(fmt::format("resource{:06}", i));
+    kv.set_value(std::string(256, 'v'));
+    ASSERT_TRUE(writer->KvPut(kv).ok());
+  }
+
+  // Memtable is accounted by write buffer manager and charged to the shared cache.
+  EXPECT_GT(write_buffer_manager->memory_usage(), 0);
+  EXPECT_GT(block_cache->GetUsage(), 0);
+
+  engine->Flush(kDefaultCf);
+  auto reader = engine->NewReader(kDefaultCf);
+  std::string value;
+  ASSERT_TRUE(reader->KvGet("resource000100", value).ok());
+  EXPECT_EQ(std::string(256, 'v'), value);
+
+  engine->Close();
+  engine->Destroy();
+}
+
+}  // namespace dingodb
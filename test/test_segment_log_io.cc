@@ -0,0 +1,158 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "butil/iobuf.h"
+#include "common/synchronization.h"
+#include "gflags/gflags.h"
+#include "log/segment_log_io.h"
+
+namespace dingodb {
+
+DECLARE_bool(segment_log_use_io_uring);
+DECLARE_uint32(segment_log_io_uring_depth);
+
+static const std::string kSegmentLogIoFile = "./segment_log_io_test";
+
+class SegmentLogIoTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    // Small ring, so concurrent requests exceed the ring size.
+    FLAGS_segment_log_use_io_uring = true;
+    FLAGS_segment_log_io_uring_depth = 4;
+    SegmentLogIo::GetInstance();
+  }
+
+  void SetUp() override {
+    fd = open(kSegmentLogIoFile.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    ASSERT_GE(fd, 0);
+  }
+
+  void TearDown() override {
+    close(fd);
+    std::remove(kSegmentLogIoFile.c_str());
+  }
+
+  int fd = -1;
+};
+
+TEST_F(SegmentLogIoTest, WriteRead) {
+  auto* log_io = SegmentLogIo::GetInstance();
+
+  butil::IOBuf header;
+  header.append("header");
+  butil::IOBuf data;
+  data.append(std::string(10000, 'd'));
+  butil::IOBuf empty;
+  butil::IOBuf* pieces[] = {&header, &empty, &data};
+  ASSERT_EQ(10006, log_io->Write(fd, pieces, 3, 0));
+  EXPECT_TRUE(header.empty());
+  EXPECT_TRUE(data.empty());
+  ASSERT_EQ(0, log_io->Fsync(fd));
+
+  butil::IOPortal portal;
+  ASSERT_EQ(10006, log_io->Read(fd, &portal, 0, 10006));
+  EXPECT_EQ("header" + std::string(10000, 'd'), portal.to_string());
+
+  // Read in the middle.
+  portal.clear();
+  ASSERT_EQ(4, log_io->Read(fd, &portal, 2, 4));
+  EXPECT_EQ("ader", portal.to_string());
+
+  // Read exceed end of file.
+  portal.clear();
+  ASSERT_EQ(6, log_io->Read(fd, &portal, 10000, 100));
+  EXPECT_EQ(std::string(6, 'd'), portal.to_string());
+
+  portal.clear();
+  EXPECT_EQ(0, log_io->Read(fd, &portal, 20000, 100));
+  EXPECT_EQ(0, log_io->Read(fd, &portal, 0, 0));
+  EXPECT_TRUE(portal.empty());
+}
+
+TEST_F(SegmentLogIoTest, WriteAtOffset) {
+  auto* log_io = SegmentLogIo::GetInstance();
+
+  butil::IOBuf data;
+  data.append("0123456789");
+  butil::IOBuf* pieces[] = {&data};
+  ASSERT_EQ(10, log_io->Write(fd, pieces, 1, 0));
+
+  data.append("abc");
+  ASSERT_EQ(3, log_io->Write(fd, pieces, 1, 4));
+
+  butil::IOPortal portal;
+  ASSERT_EQ(10, log_io->Read(fd, &portal, 0, 10));
+  EXPECT_EQ("0123abc789", portal.to_string());
+}
+
+TEST_F(SegmentLogIoTest, BadFd) {
+  auto* log_io = SegmentLogIo::GetInstance();
+
+  butil::IOBuf data;
+  data.append("data");
+  butil::IOBuf* pieces[] = {&data};
+  EXPECT_EQ(-1, log_io->Write(-1, pieces, 1, 0));
+
+  butil::IOPortal portal;
+  EXPECT_EQ(-1, log_io->Read(-1, &portal, 0, 10));
+  EXPECT_NE(0, log_io->Fsync(-1));
+}
+
+TEST_F(SegmentLogIoTest, ConcurrentWriteRead) {
+  auto* log_io = SegmentLogIo::GetInstance();
+  const int kConcurrency = 64;
+  const size_t kBlockSize = 4096;
+
+  std::atomic<int> fail_count(0);
+  std::vector<Bthread> bthreads(kConcurrency);
+  for (int i = 0; i < kConcurrency; ++i) {
+    bthreads[i].Run([&, i]() {
+      const std::string block(kBlockSize, static_cast<char>('a' + i % 26));
+      butil::IOBuf data;
+      data.append(block);
+      butil::IOBuf* pieces[] = {&data};
+      if (log_io->Write(fd, pieces, 1, i * kBlockSize) != static_cast<ssize_t>(kBlockSize)) {
+        fail_count.fetch_add(1);
+        return;
+      }
+      if (log_io->Fsync(fd) != 0) {
+        fail_count.fetch_add(1);
+        return;
+      }
+
+      butil::IOPortal portal;
+      if (log_io->Read(fd, &portal, i * kBlockSize, kBlockSize) != static_cast<ssize_t>(kBlockSize) ||
+          portal.to_string() != block) {
+        fail_count.fetch_add(1);
+      }
+    });
+  }
+  for (auto& bthread : bthreads) {
+    bthread.Join();
+  }
+
+  EXPECT_EQ(0, fail_count.load());
+}
+
+}  // namespace dingodb
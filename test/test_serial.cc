@@ -1354,6 +1354,47 @@ TEST_F(DingoSerialTest, stringPrefixSchema) {
   delete bs2;
 }
 
+TEST_F(DingoSerialTest, stringSchemaGroupBoundary) {
+  DingoSchema<optional<shared_ptr<string>>> b1;
+  b1.SetIndex(0);
+  b1.SetAllowNull(true);
+  b1.SetIsKey(true);
+
+  // Lengths around 8 bytes group boundary.
+  string prev_key;
+  for (int len = 0; len <= 17; len++) {
+    auto data = std::make_shared<string>(len, 'a');
+    Buf bf1(1, this->le);
+    b1.EncodeKey(&bf1, data);
+    string key = bf1.GetString();
+    EXPECT_EQ(1 + (len / 8 + 1) * 9 + 4, key.size());
+
+    Buf bf2(key, this->le);
+    auto data2 = b1.DecodeKey(&bf2);
+    ASSERT_TRUE(data2.has_value());
+    EXPECT_EQ(*data, *data2.value());
+
+    // Memcomparable, longer string with same prefix is bigger.
+    string key_prefix = key.substr(0, key.size() - 4);
+    if (!prev_key.empty()) {
+      EXPECT_LT(prev_key, key_prefix);
+    }
+    prev_key = key_prefix;
+  }
+
+  // Binary data and zero padding must not collide.
+  Buf bf3(1, this->le);
+  b1.EncodeKey(&bf3, std::make_shared<string>("ab\0\xff", 4));
+  Buf bf4(bf3.GetString(), this->le);
+  EXPECT_EQ(string("ab\0\xff", 4), *b1.DecodeKey(&bf4).value());
+
+  Buf bf5(1, this->le);
+  b1.EncodeKeyPrefix(&bf5, std::make_shared<string>("ab", 2));
+  Buf bf6(1, this->le);
+  b1.EncodeKeyPrefix(&bf6, std::make_shared<string>("ab\0", 3));
+  EXPECT_LT(bf5.GetString(), bf6.GetString());
+}
+
 TEST_F(DingoSerialTest, bufLeBe) {
   uint32_t int_data = 1543234;
   uint64_t long_data = -8237583920453957801;
@@ -1649,6 +1690,47 @@ TEST_F(DingoSerialTest, recordTest) {
   delete rd;
 }
 
+TEST_F(DingoSerialTest, recordBatchTest) {
+  InitVector();
+  auto schemas = GetSchemas();
+  RecordEncoder re(0, schemas, 0L, this->le);
+  InitRecord();
+
+  // Records differ in key, so every key value of the batch is distinct.
+  vector<vector<any>> records;
+  vector<vector<any>> columns(schemas->size());
+  for (int i = 0; i < 10; ++i) {
+    vector<any> record = *GetRecord();
+    record[0] = optional<int32_t>(i);
+    record[1] = optional<shared_ptr<string>>(std::make_shared<string>(i * 5, 'n'));
+    for (size_t j = 0; j < record.size(); ++j) {
+      columns[j].push_back(record[j]);
+    }
+    records.push_back(std::move(record));
+  }
+
+  RecordBatch batch;
+  EXPECT_EQ(0, re.EncodeBatch(records, batch));
+  ASSERT_EQ(records.size(), batch.Size());
+
+  RecordBatch columnar_batch;
+  EXPECT_EQ(0, re.EncodeColumnarBatch(columns, columnar_batch));
+  ASSERT_EQ(records.size(), columnar_batch.Size());
+
+  for (size_t i = 0; i < records.size(); ++i) {
+    string key;
+    string value;
+    EXPECT_EQ(0, re.Encode(records[i], key, value));
+    EXPECT_EQ(key, batch.Key(i));
+    EXPECT_EQ(value, batch.Value(i));
+    EXPECT_EQ(key, columnar_batch.Key(i));
+    EXPECT_EQ(value, columnar_batch.Value(i));
+  }
+
+  columns[0].pop_back();
+  EXPECT_EQ(-1, re.EncodeColumnarBatch(columns, columnar_batch));
+}
+
 TEST_F(DingoSerialTest, tabledefinitionTest) {
   auto td = std::make_shared<pb::meta::TableDefinition>();
   td->set_name("test");
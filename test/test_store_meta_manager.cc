@@ -14,11 +14,19 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "config/config_manager.h"
+#include "engine/raw_rocks_engine.h"
+#include "meta/meta_reader.h"
+#include "meta/meta_writer.h"
 #include "meta/store_meta_manager.h"
+#include "proto/common.pb.h"
+#include "server/server.h"
 
 class StoreRegionMetaTest : public testing::Test {
  protected:
@@ -43,4 +51,84 @@ TEST_F(StoreRegionMetaTest, AddRegion) {
   if (region != nullptr) {
     std::cout << "region id: " << region->Id() << std::endl;
   }
-}
\ No newline at end of file
+}
+class StoreRegionLeaderTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    auto *server = dingodb::Server::GetInstance();
+    server->SetRole(dingodb::pb::common::ClusterRole::STORE);
+    server->InitConfig(kFileName);
+
+    engine = std::make_shared<dingodb::RawRocksEngine>();
+    if (!engine->Init(dingodb::ConfigManager::GetInstance()->GetConfig(dingodb::pb::common::ClusterRole::STORE))) {
+      std::cout << "RawRocksEngine init failed" << std::endl;
+    }
+  }
+
+  static void TearDownTestSuite() {
+    engine->Close();
+    engine->Destroy();
+  }
+
+  static dingodb::store::RegionPtr BuildRegion(uint64_t region_id) {
+    dingodb::pb::common::RegionDefinition definition;
+    definition.set_id(region_id);
+    return dingodb::store::Region::New(definition);
+  }
+
+  inline static const std::string kFileName = "../../conf/store.yaml";
+  inline static std::shared_ptr<dingodb::RawRocksEngine> engine = nullptr;
+};
+
+TEST_F(StoreRegionLeaderTest, PersistLeaderId) {
+  uint64_t self_id = dingodb::Server::GetInstance()->Id();
+  {
+    auto store_region_meta = std::make_shared<dingodb::StoreRegionMeta>(
+        std::make_shared<dingodb::MetaReader>(engine), std::make_shared<dingodb::MetaWriter>(engine));
+    ASSERT_TRUE(store_region_meta->Init());
+    store_region_meta->AddRegion(BuildRegion(2001));
+    store_region_meta->AddRegion(BuildRegion(2002));
+    store_region_meta->UpdateLeaderId(2001, self_id);
+    store_region_meta->UpdateLeaderId(2002, self_id);
+    // Start following reset the leader.
+    store_region_meta->UpdateLeaderId(2002, 0);
+  }
+
+  // Reload as bootstrap.
+  auto store_region_meta = std::make_shared<dingodb::StoreRegionMeta>(std::make_shared<dingodb::MetaReader>(engine),
+                                                                      std::make_shared<dingodb::MetaWriter>(engine));
+  ASSERT_TRUE(store_region_meta->Init());
+  auto region1 = store_region_meta->GetRegion(2001);
+  ASSERT_NE(nullptr, region1);
+  EXPECT_EQ(self_id, region1->LeaderId());
+  auto region2 = store_region_meta->GetRegion(2002);
+  ASSERT_NE(nullptr, region2);
+  EXPECT_EQ(0, region2->LeaderId());
+
+  store_region_meta->DeleteRegion(2001);
+  store_region_meta->DeleteRegion(2002);
+}
+
+TEST_F(StoreRegionLeaderTest, SortRegionByRecoverPriority) {
+  uint64_t self_id = dingodb::Server::GetInstance()->Id();
+  std::vector<dingodb::store::RegionPtr> regions;
+  for (uint64_t region_id = 3001; region_id <= 3006; ++region_id) {
+    auto region = BuildRegion(region_id);
+    // led by self or other store before restart
+    if (region_id % 2 == 0) {
+      region->SetLeaderId(self_id);
+    } else if (region_id % 3 == 0) {
+      region->SetLeaderId(self_id + 1);
+    }
+    regions.push_back(region);
+  }
+
+  dingodb::Server::GetInstance()->SortRegionByRecoverPriority(regions);
+
+  // leaders first, keep the original order in same priority
+  std::vector<uint64_t> region_ids;
+  for (auto &region : regions) {
+    region_ids.push_back(region->Id());
+  }
+  EXPECT_EQ(std::vector<uint64_t>({3002, 3004, 3006, 3001, 3003, 3005}), region_ids);
+}
@@ -0,0 +1,286 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "butil/status.h"
+#include "common/synchronization.h"
+#include "fmt/core.h"
+#include "proto/error.pb.h"
+#include "proto/common.pb.h"
+#include "vector/vector_index.h"
+
+namespace dingodb {
+
+class VectorIndexTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite() { std::filesystem::create_directories(kIndexPath); }
+
+  static void TearDownTestSuite() { std::filesystem::remove_all(kIndexPath); }
+
+  static std::shared_ptr<VectorIndex> NewIndex(uint64_t id) {
+    pb::common::IndexParameter index_parameter;
+    index_parameter.set_index_type(pb::common::IndexType::INDEX_TYPE_VECTOR);
+    auto* vector_index_parameter = index_parameter.mutable_vector_index_parameter();
+    vector_index_parameter->set_vector_index_type(pb::common::VectorIndexType::VECTOR_INDEX_TYPE_HNSW);
+    auto* hnsw_parameter = vector_index_parameter->mutable_hnsw_parameter();
+    hnsw_parameter->set_dimension(kDimension);
+    hnsw_parameter->set_metric_type(pb::common::MetricType::METRIC_TYPE_L2);
+    hnsw_parameter->set_efconstruction(40);
+    hnsw_parameter->set_max_elements(kMaxElements);
+    hnsw_parameter->set_nlinks(16);
+
+    return VectorIndex::New(id, index_parameter);
+  }
+
+  static std::vector<float> RandomVector(std::mt19937& rng) {
+    std::uniform_real_distribution<float> distrib(-1.0F, 1.0F);
+    std::vector<float> vector(kDimension);
+    for (auto& value : vector) {
+      value = distrib(rng);
+    }
+    return vector;
+  }
+
+  static void AddVectors(std::shared_ptr<VectorIndex> vector_index, uint64_t start_id, int count, std::mt19937& rng) {
+    for (int i = 0; i < count; ++i) {
+      EXPECT_TRUE(vector_index->Add(start_id + i, RandomVector(rng)).ok());
+    }
+  }
+
+  static std::string SaveToFile(std::shared_ptr<VectorIndex> vector_index, const std::string& name,
+                                uint64_t& write_seq) {
+    std::string path = kIndexPath + "/" + name;
+    std::ofstream file(path, std::ios::binary);
+    uint64_t apply_log_index = 0;
+    auto status = vector_index->SaveToWriter(
+        [&file](const char* data, size_t size) -> butil::Status {
+          file.write(data, size);
+          return file ? butil::Status::OK() : butil::Status(pb::error::Errno::EINTERNAL, "write failed");
+        },
+        apply_log_index, write_seq);
+    EXPECT_TRUE(status.ok());
+    file.close();
+    return path;
+  }
+
+  static void ExpectSameSearch(std::shared_ptr<VectorIndex> index_a, std::shared_ptr<VectorIndex> index_b) {
+    std::mt19937 rng(7);
+    for (int i = 0; i < 50; ++i) {
+      auto query = RandomVector(rng);
+      std::vector<pb::common::VectorWithDistance> results_a;
+      std::vector<pb::common::VectorWithDistance> results_b;
+      EXPECT_TRUE(index_a->Search(query, 10, results_a).ok());
+      EXPECT_TRUE(index_b->Search(query, 10, results_b).ok());
+
+      ASSERT_EQ(results_a.size(), results_b.size());
+      for (size_t j = 0; j < results_a.size(); ++j) {
+        EXPECT_EQ(results_a[j].vector_with_id().id(), results_b[j].vector_with_id().id());
+        EXPECT_FLOAT_EQ(results_a[j].distance(), results_b[j].distance());
+      }
+    }
+  }
+
+  inline static const std::string kIndexPath = "./vector_index_test";
+  static constexpr uint32_t kDimension = 16;
+  static constexpr uint32_t kMaxElements = 10000;
+};
+
+TEST_F(VectorIndexTest, LoadMmap) {
+  std::mt19937 rng(1);
+  auto vector_index = NewIndex(1);
+  AddVectors(vector_index, 1, 2000, rng);
+  vector_index->Delete(100);
+
+  uint64_t write_seq = 0;
+  std::string path = SaveToFile(vector_index, "1.idx", write_seq);
+
+  auto heap_index = NewIndex(1);
+  ASSERT_TRUE(heap_index->Load(path).ok());
+  EXPECT_FALSE(heap_index->IsMmap());
+
+  auto mmap_index = NewIndex(1);
+  ASSERT_TRUE(mmap_index->LoadMmap(path).ok());
+  EXPECT_TRUE(mmap_index->IsMmap());
+  EXPECT_EQ(0, mmap_index->MmapDirtyCount());
+
+  ExpectSameSearch(heap_index, mmap_index);
+  ExpectSameSearch(vector_index, mmap_index);
+
+  // Deleted vector is not searched out.
+  std::vector<pb::common::VectorWithDistance> results;
+  EXPECT_TRUE(mmap_index->Search(std::vector<float>(kDimension, 0.0F), 2000, results).ok());
+  for (const auto& result : results) {
+    EXPECT_NE(100, result.vector_with_id().id());
+  }
+}
+
+TEST_F(VectorIndexTest, LoadMmapCorrupted) {
+  std::mt19937 rng(2);
+  auto vector_index = NewIndex(2);
+  AddVectors(vector_index, 1, 100, rng);
+
+  uint64_t write_seq = 0;
+  std::string path = SaveToFile(vector_index, "2.idx", write_seq);
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+
+  auto mmap_index = NewIndex(2);
+  EXPECT_FALSE(mmap_index->LoadMmap(path).ok());
+  EXPECT_FALSE(mmap_index->LoadMmap(kIndexPath + "/not_exist.idx").ok());
+  EXPECT_FALSE(mmap_index->IsMmap());
+}
+
+TEST_F(VectorIndexTest, Remap) {
+  std::mt19937 rng(3);
+  auto vector_index = NewIndex(3);
+  AddVectors(vector_index, 1, 1000, rng);
+
+  uint64_t write_seq = 0;
+  std::string path = SaveToFile(vector_index, "3_1.idx", write_seq);
+  auto mmap_index = NewIndex(3);
+  ASSERT_TRUE(mmap_index->LoadMmap(path).ok());
+
+  // Write after mmap load.
+  AddVectors(mmap_index, 1001, 500, rng);
+  mmap_index->Delete(1);
+  EXPECT_EQ(501, mmap_index->MmapDirtyCount());
+
+  path = SaveToFile(mmap_index, "3_2.idx", write_seq);
+  auto heap_index = NewIndex(3);
+  ASSERT_TRUE(heap_index->Load(path).ok());
+
+  // Changed after save, not remap.
+  AddVectors(mmap_index, 2001, 1, rng);
+  EXPECT_FALSE(mmap_index->Remap(path, write_seq));
+
+  path = SaveToFile(mmap_index, "3_3.idx", write_seq);
+  ASSERT_TRUE(heap_index->Load(path).ok());
+  EXPECT_TRUE(mmap_index->Remap(path, write_seq));
+  EXPECT_TRUE(mmap_index->IsMmap());
+  EXPECT_EQ(0, mmap_index->MmapDirtyCount());
+
+  ExpectSameSearch(heap_index, mmap_index);
+}
+
+TEST_F(VectorIndexTest, SaveWhileWriting) {
+  std::mt19937 rng(4);
+  auto vector_index = NewIndex(4);
+  std::vector<std::vector<float>> vectors;
+  for (int i = 0; i < 2000; ++i) {
+    vectors.push_back(RandomVector(rng));
+    ASSERT_TRUE(vector_index->Add(i + 1, vectors.back()).ok());
+  }
+
+  // Add and delete while saving.
+  std::atomic<bool> stop = false;
+  std::thread writer([&vector_index, &stop]() {
+    std::mt19937 writer_rng(5);
+    uint64_t id = 100000;
+    while (!stop.load()) {
+      vector_index->Add(id++, RandomVector(writer_rng));
+      vector_index->Delete(id - 50);
+    }
+  });
+
+  std::vector<std::string> paths;
+  for (int i = 0; i < 5; ++i) {
+    uint64_t write_seq = 0;
+    paths.push_back(SaveToFile(vector_index, fmt::format("4_{}.idx", i), write_seq));
+  }
+  stop.store(true);
+  writer.join();
+
+  // Every file is a closed graph, and contains all vectors written before save.
+  for (const auto& path : paths) {
+    auto heap_index = NewIndex(4);
+    ASSERT_TRUE(heap_index->Load(path).ok());
+    auto mmap_index = NewIndex(4);
+    ASSERT_TRUE(mmap_index->LoadMmap(path).ok());
+
+    for (int i = 0; i < 2000; i += 100) {
+      std::vector<pb::common::VectorWithDistance> results;
+      EXPECT_TRUE(mmap_index->Search(vectors[i], 10, results).ok());
+      bool found = false;
+      for (const auto& result : results) {
+        found = found || (result.vector_with_id().id() == i + 1 && result.distance() == 0.0F);
+      }
+      EXPECT_TRUE(found) << "vector " << i + 1;
+    }
+    ExpectSameSearch(heap_index, mmap_index);
+  }
+}
+
+TEST_F(VectorIndexTest, SearchDuringWrite) {
+  std::mt19937 rng(6);
+  auto vector_index = NewIndex(5);
+  AddVectors(vector_index, 1, 1000, rng);
+
+  std::atomic<int> search_failed = 0;
+  std::atomic<int> search_count = 0;
+  std::vector<Bthread> bthreads(9);
+  for (int i = 0; i < 4; ++i) {
+    bthreads[i].Run([&vector_index, i]() {
+      std::mt19937 writer_rng(100 + i);
+      uint64_t start_id = 10000 * (i + 1);
+      for (int j = 0; j < 1000; ++j) {
+        vector_index->Add(start_id + j, RandomVector(writer_rng));
+        if (j % 3 == 0) {
+          vector_index->Delete(start_id + j / 2);
+        }
+      }
+    });
+  }
+  for (int i = 4; i < 8; ++i) {
+    bthreads[i].Run([&vector_index, &search_failed, &search_count, i]() {
+      std::mt19937 search_rng(200 + i);
+      for (int j = 0; j < 500; ++j) {
+        std::vector<pb::common::VectorWithDistance> results;
+        auto status = vector_index->Search(RandomVector(search_rng), 10, results);
+        if (!status.ok() || results.empty() || results.size() > 10) {
+          ++search_failed;
+        }
+        ++search_count;
+      }
+    });
+  }
+  // Save take exclusive lock shortly.
+  bthreads[8].Run([&vector_index]() {
+    for (int j = 0; j < 3; ++j) {
+      uint64_t write_seq = 0;
+      SaveToFile(vector_index, fmt::format("5_{}.idx", j), write_seq);
+    }
+  });
+
+  for (auto& bthread : bthreads) {
+    bthread.Join();
+  }
+
+  EXPECT_EQ(0, search_failed.load());
+  EXPECT_EQ(2000, search_count.load());
+
+  std::vector<pb::common::VectorWithDistance> results;
+  EXPECT_TRUE(vector_index->Search(std::vector<float>(kDimension, 0.0F), 10, results).ok());
+  EXPECT_EQ(10, results.size());
+}
+
+}  // namespace dingodb
@@ -0,0 +1,200 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "proto/common.pb.h"
+#include "vector/vector_index.h"
+#include "vector/vector_quantization.h"
+
+namespace dingodb {
+
+static constexpr size_t kDimension = 64;
+
+static std::vector<float> RandomVector(std::mt19937& rng, float min_value, float max_value) {
+  std::uniform_real_distribution<float> distrib(min_value, max_value);
+  std::vector<float> vector(kDimension);
+  for (auto& value : vector) {
+    value = distrib(rng);
+  }
+  return vector;
+}
+
+static std::string Encode(const std::vector<float>& vector) {
+  std::string code(ScalarQuantizer::CodeSize(vector.size()), '\0');
+  ScalarQuantizer::Encode(vector.data(), vector.size(), code.data());
+  return code;
+}
+
+static float Step(const std::string& code) {
+  float step = 0;
+  memcpy(&step, code.data() + sizeof(float), sizeof(float));
+  return step;
+}
+
+static float L2Sqr(const std::vector<float>& a, const std::vector<float>& b) {
+  float result = 0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    result += (a[i] - b[i]) * (a[i] - b[i]);
+  }
+  return result;
+}
+
+static float InnerProduct(const std::vector<float>& a, const std::vector<float>& b) {
+  float result = 0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    result += a[i] * b[i];
+  }
+  return result;
+}
+
+TEST(ScalarQuantizerTest, EncodeDecode) {
+  EXPECT_EQ(sizeof(float) * 2 + kDimension, ScalarQuantizer::CodeSize(kDimension));
+
+  std::mt19937 rng(1);
+  for (int i = 0; i < 100; ++i) {
+    auto vector = RandomVector(rng, -10.0F, 30.0F);
+    auto code = Encode(vector);
+    float step = Step(code);
+    EXPECT_GT(step, 0);
+
+    std::vector<float> decoded(kDimension);
+    ScalarQuantizer::Decode(code.data(), kDimension, decoded.data());
+    for (size_t j = 0; j < kDimension; ++j) {
+      // Rounding error is at most half step.
+      EXPECT_NEAR(vector[j], decoded[j], step / 2 + 1e-5);
+    }
+
+    // Min and max are kept.
+    EXPECT_FLOAT_EQ(*std::min_element(vector.begin(), vector.end()),
+                    *std::min_element(decoded.begin(), decoded.end()));
+    EXPECT_NEAR(*std::max_element(vector.begin(), vector.end()), *std::max_element(decoded.begin(), decoded.end()),
+                1e-4);
+  }
+}
+
+TEST(ScalarQuantizerTest, EncodeDecodeConstant) {
+  std::vector<float> vector(kDimension, 0.75F);
+  auto code = Encode(vector);
+  EXPECT_EQ(0, Step(code));
+
+  std::vector<float> decoded(kDimension);
+  ScalarQuantizer::Decode(code.data(), kDimension, decoded.data());
+  for (size_t j = 0; j < kDimension; ++j) {
+    EXPECT_FLOAT_EQ(0.75F, decoded[j]);
+  }
+}
+
+TEST(Sq8SpaceTest, L2Distance) {
+  Sq8Space space(kDimension, false);
+  EXPECT_EQ(ScalarQuantizer::CodeSize(kDimension), space.get_data_size());
+  auto dist_func = space.get_dist_func();
+
+  std::mt19937 rng(2);
+  for (int i = 0; i < 100; ++i) {
+    auto vector_a = RandomVector(rng, -1.0F, 1.0F);
+    auto vector_b = RandomVector(rng, -1.0F, 1.0F);
+    auto code_a = Encode(vector_a);
+    auto code_b = Encode(vector_b);
+
+    float distance = dist_func(code_a.data(), code_b.data(), space.get_dist_func_param());
+
+    // Same as float distance of decoded vectors.
+    std::vector<float> decoded_a(kDimension);
+    std::vector<float> decoded_b(kDimension);
+    ScalarQuantizer::Decode(code_a.data(), kDimension, decoded_a.data());
+    ScalarQuantizer::Decode(code_b.data(), kDimension, decoded_b.data());
+    EXPECT_NEAR(L2Sqr(decoded_a, decoded_b), distance, 1e-3);
+
+    // Each dimension differ at most (step_a + step_b) / 2 from the original.
+    float max_error = std::sqrt(static_cast<float>(kDimension)) * (Step(code_a) + Step(code_b)) / 2;
+    EXPECT_NEAR(std::sqrt(L2Sqr(vector_a, vector_b)), std::sqrt(distance), max_error + 1e-4);
+  }
+
+  auto vector = RandomVector(rng, -1.0F, 1.0F);
+  auto code = Encode(vector);
+  EXPECT_NEAR(0, dist_func(code.data(), code.data(), space.get_dist_func_param()), 1e-6);
+}
+
+TEST(Sq8SpaceTest, InnerProductDistance) {
+  Sq8Space space(kDimension, true);
+  auto dist_func = space.get_dist_func();
+
+  std::mt19937 rng(3);
+  for (int i = 0; i < 100; ++i) {
+    auto vector_a = RandomVector(rng, -1.0F, 1.0F);
+    auto vector_b = RandomVector(rng, -1.0F, 1.0F);
+    auto code_a = Encode(vector_a);
+    auto code_b = Encode(vector_b);
+
+    float distance = dist_func(code_a.data(), code_b.data(), space.get_dist_func_param());
+
+    // |a*b - a'*b'| <= sum(|a| * |b - b'| + |b'| * |a - a'|), values are in [-1, 1].
+    float max_error = kDimension * (Step(code_a) + Step(code_b)) / 2;
+    EXPECT_NEAR(1.0F - InnerProduct(vector_a, vector_b), distance, max_error + 1e-4);
+  }
+}
+
+TEST(Sq8IndexTest, Search) {
+  pb::common::IndexParameter index_parameter;
+  index_parameter.set_index_type(pb::common::IndexType::INDEX_TYPE_VECTOR);
+  auto* vector_index_parameter = index_parameter.mutable_vector_index_parameter();
+  vector_index_parameter->set_vector_index_type(pb::common::VectorIndexType::VECTOR_INDEX_TYPE_HNSW_SQ8);
+  auto* hnsw_parameter = vector_index_parameter->mutable_hnsw_parameter();
+  hnsw_parameter->set_dimension(kDimension);
+  hnsw_parameter->set_metric_type(pb::common::MetricType::METRIC_TYPE_L2);
+  hnsw_parameter->set_efconstruction(100);
+  hnsw_parameter->set_max_elements(2000);
+  hnsw_parameter->set_nlinks(16);
+
+  auto vector_index = VectorIndex::New(1, index_parameter);
+  ASSERT_NE(nullptr, vector_index);
+  EXPECT_TRUE(vector_index->IsQuantized());
+
+  std::mt19937 rng(4);
+  std::vector<std::vector<float>> vectors;
+  for (int i = 0; i < 1000; ++i) {
+    vectors.push_back(RandomVector(rng, -1.0F, 1.0F));
+    ASSERT_TRUE(vector_index->Add(i + 1, vectors.back()).ok());
+  }
+
+  // Quantized search find the vector itself, result not carry the lossy vector.
+  int found_count = 0;
+  for (int i = 0; i < 1000; i += 10) {
+    std::vector<pb::common::VectorWithDistance> results;
+    ASSERT_TRUE(vector_index->Search(vectors[i], 10, results).ok());
+    ASSERT_FALSE(results.empty());
+    for (const auto& result : results) {
+      EXPECT_EQ(0, result.vector_with_id().vector().float_values_size());
+      if (result.vector_with_id().id() == static_cast<uint64_t>(i + 1)) {
+        ++found_count;
+      }
+    }
+  }
+  EXPECT_GE(found_count, 95);
+
+  // Dimension not match.
+  std::vector<pb::common::VectorWithDistance> results;
+  EXPECT_FALSE(vector_index->Search(std::vector<float>(kDimension + 1, 0.0F), 10, results).ok());
+}
+
+}  // namespace dingodb
@@ -0,0 +1,181 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bthread/bthread.h"
+#include "bthread/mutex.h"
+#include "butil/status.h"
+#include "common/constant.h"
+#include "common/context.h"
+#include "common/helper.h"
+#include "engine/engine.h"
+#include "engine/write_batcher.h"
+#include "engine/write_data.h"
+#include "proto/error.pb.h"
+#include "proto/store.pb.h"
+
+namespace dingodb {
+
+// Record writes instead of propose them.
+class FakeEngine : public Engine {
+ public:
+  bool Init(std::shared_ptr<Config> /*config*/) override { return true; }
+  std::string GetName() override { return "FAKE_ENGINE"; }
+  pb::common::Engine GetID() override { return pb::common::ENG_RAFT_STORE; }
+  std::shared_ptr<Snapshot> GetSnapshot() override { return nullptr; }
+  butil::Status DoSnapshot(std::shared_ptr<Context> /*ctx*/, uint64_t /*region_id*/) override {
+    return butil::Status();
+  }
+  butil::Status Write(std::shared_ptr<Context> /*ctx*/, std::shared_ptr<WriteData> /*write_data*/) override {
+    return butil::Status();
+  }
+  butil::Status AsyncWrite(std::shared_ptr<Context> ctx, std::shared_ptr<WriteData> write_data) override {
+    BAIDU_SCOPED_LOCK(mutex);
+    batch_sizes.push_back(ctx->BatchCtxs().size());
+    datum_sizes.push_back(write_data->Datums().size());
+    return status;
+  }
+  butil::Status AsyncWrite(std::shared_ptr<Context> /*ctx*/, std::shared_ptr<WriteData> write_data,
+                           WriteCbFunc /*cb*/) override {
+    BAIDU_SCOPED_LOCK(mutex);
+    batch_sizes.push_back(0);
+    datum_sizes.push_back(write_data->Datums().size());
+    return status;
+  }
+  std::shared_ptr<Reader> NewReader(const std::string& /*cf_name*/) override { return nullptr; }
+
+  bthread::Mutex mutex;
+  butil::Status status;
+  // Batch ctx count of every AsyncWrite, 0 is single write.
+  std::vector<size_t> batch_sizes;
+  std::vector<size_t> datum_sizes;
+};
+
+class CountClosure : public google::protobuf::Closure {
+ public:
+  explicit CountClosure(std::atomic<int>* count) : count_(count) {}
+  void Run() override {
+    count_->fetch_add(1);
+    delete this;
+  }
+
+ private:
+  std::atomic<int>* count_;
+};
+
+class WriteBatcherTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    engine = std::make_shared<FakeEngine>();
+    done_count.store(0);
+    cb_count.store(0);
+  }
+
+  WriteBatchEntry BuildEntry(const std::string& key, pb::store::KvPutResponse* response) {
+    WriteBatchEntry entry;
+    entry.ctx = std::make_shared<Context>(nullptr, new CountClosure(&done_count), response);
+    entry.ctx->SetRegionId(kRegionId);
+    pb::common::KeyValue kv;
+    kv.set_key(key);
+    kv.set_value("value");
+    entry.write_data = WriteDataBuilder::BuildWrite(Constant::kStoreDataCF, {kv});
+    entry.cb = [this](std::shared_ptr<Context> ctx, butil::Status status) {
+      cb_count.fetch_add(1);
+      if (!status.ok()) {
+        Helper::SetPbMessageError(status, ctx->Response());
+      }
+    };
+    return entry;
+  }
+
+  static const uint64_t kRegionId = 1001;
+  std::shared_ptr<FakeEngine> engine;
+  std::atomic<int> done_count;
+  std::atomic<int> cb_count;
+};
+
+TEST_F(WriteBatcherTest, MergeInWindow) {
+  auto batcher = std::make_shared<RegionWriteBatcher>(kRegionId, engine, 100 * 1000, 128, 1024 * 1024);
+  std::vector<pb::store::KvPutResponse> responses(3);
+  for (int i = 0; i < 3; ++i) {
+    batcher->Submit(BuildEntry("key" + std::to_string(i), &responses[i]), 8);
+  }
+  EXPECT_TRUE(engine->batch_sizes.empty());
+
+  bthread_usleep(500 * 1000);
+  BAIDU_SCOPED_LOCK(engine->mutex);
+  ASSERT_EQ(1, engine->batch_sizes.size());
+  EXPECT_EQ(3, engine->batch_sizes[0]);
+  EXPECT_EQ(3, engine->datum_sizes[0]);
+}
+
+TEST_F(WriteBatcherTest, FlushWhenFull) {
+  // Window is long enough, only full batch is flushed.
+  auto batcher = std::make_shared<RegionWriteBatcher>(kRegionId, engine, 60 * 1000 * 1000, 4, 1024 * 1024);
+  std::vector<pb::store::KvPutResponse> responses(6);
+  for (int i = 0; i < 6; ++i) {
+    batcher->Submit(BuildEntry("key" + std::to_string(i), &responses[i]), 8);
+  }
+
+  BAIDU_SCOPED_LOCK(engine->mutex);
+  ASSERT_EQ(1, engine->batch_sizes.size());
+  EXPECT_EQ(4, engine->batch_sizes[0]);
+}
+
+TEST_F(WriteBatcherTest, FlushSingleWrite) {
+  auto batcher = std::make_shared<RegionWriteBatcher>(kRegionId, engine, 10 * 1000, 128, 1024 * 1024);
+  pb::store::KvPutResponse response;
+  batcher->Submit(BuildEntry("key", &response), 8);
+
+  bthread_usleep(200 * 1000);
+  BAIDU_SCOPED_LOCK(engine->mutex);
+  ASSERT_EQ(1, engine->batch_sizes.size());
+  // Not merged, write with its own callback.
+  EXPECT_EQ(0, engine->batch_sizes[0]);
+}
+
+TEST_F(WriteBatcherTest, FlushFailed) {
+  engine->status = butil::Status(pb::error::ERAFT_NOTLEADER, "");
+  auto batcher = std::make_shared<RegionWriteBatcher>(kRegionId, engine, 60 * 1000 * 1000, 3, 1024 * 1024);
+  std::vector<pb::store::KvPutResponse> responses(3);
+  for (int i = 0; i < 3; ++i) {
+    batcher->Submit(BuildEntry("key" + std::to_string(i), &responses[i]), 8);
+  }
+
+  // Every merged write is responsed, with not leader error for redirect.
+  EXPECT_EQ(3, cb_count.load());
+  EXPECT_EQ(3, done_count.load());
+  for (const auto& response : responses) {
+    EXPECT_EQ(pb::error::ERAFT_NOTLEADER, response.error().errcode());
+    EXPECT_EQ("Not leader, please redirect leader.", response.error().errmsg());
+  }
+}
+
+TEST_F(WriteBatcherTest, SetPbMessageErrorLeader) {
+  pb::store::KvPutResponse response;
+  butil::EndPoint endpoint;
+  butil::str2endpoint("127.0.0.1:20001", &endpoint);
+  Helper::SetPbMessageErrorLeader(endpoint, static_cast<google::protobuf::Message*>(&response));
+
+  EXPECT_EQ("127.0.0.1", response.error().leader_location().host());
+  EXPECT_EQ(20001, response.error().leader_location().port());
+}
+
+}  // namespace dingodb